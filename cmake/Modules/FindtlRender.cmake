@@ -13,6 +13,7 @@
 # * tlRender::tlBaseApp
 # * tlRender::tlIO
 # * tlRender::tlTimeline
+# * tlRender::tlTimelineCPU
 # * tlRender::tlTimelineGL
 # * tlRender::tlTimelineUI
 # * tlRender::tlDevice
@@ -103,6 +104,7 @@ if(CMAKE_BUILD_TYPE MATCHES "^Debug$")
     find_library(tlRender_tlBaseApp_LIBRARY NAMES tlBaseApp)
     find_library(tlRender_tlIO_LIBRARY NAMES tlIO)
     find_library(tlRender_tlTimeline_LIBRARY NAMES tlTimeline)
+    find_library(tlRender_tlTimelineCPU_LIBRARY NAMES tlTimelineCPU)
     find_library(tlRender_tlTimelineUI_LIBRARY NAMES tlTimelineUI)
     find_library(tlRender_tlDevice_LIBRARY NAMES tlDevice)
     find_library(tlRender_tlGL_LIBRARY NAMES tlGL)
@@ -113,6 +115,7 @@ else()
     find_library(tlRender_tlBaseApp_LIBRARY NAMES tlBaseApp)
     find_library(tlRender_tlIO_LIBRARY NAMES tlIO)
     find_library(tlRender_tlTimeline_LIBRARY NAMES tlTimeline)
+    find_library(tlRender_tlTimelineCPU_LIBRARY NAMES tlTimelineCPU)
     find_library(tlRender_tlTimelineUI_LIBRARY NAMES tlTimelineUI)
     find_library(tlRender_tlDevice_LIBRARY NAMES tlDevice)
     find_library(tlRender_tlGL_LIBRARY NAMES tlGL)
@@ -126,6 +129,7 @@ set(tlRender_LIBRARIES
     ${tlRender_tlBaseApp_LIBRARY}
     ${tlRender_tlTimelineUI_LIBRARY}
     ${tlRender_tlTimeline_LIBRARY}
+    ${tlRender_tlTimelineCPU_LIBRARY}
     ${tlRender_tlDevice_LIBRARY}
     ${tlRender_tlTimelineGL_LIBRARY}
     ${tlRender_tlGL_LIBRARY}
@@ -153,6 +157,7 @@ find_package_handle_standard_args(
         tlRender_tlBaseApp_LIBRARY
         tlRender_tlIO_LIBRARY
         tlRender_tlTimeline_LIBRARY
+        tlRender_tlTimelineCPU_LIBRARY
         tlRender_tlTimelineGL_LIBRARY
         tlRender_tlTimelineUI_LIBRARY
         tlRender_tlDevice_LIBRARY
@@ -164,6 +169,7 @@ mark_as_advanced(
     tlRender_tlIO_LIBRARY
     tlRender_tlBaseApp_LIBRARY
     tlRender_tlTimeline_LIBRARY
+    tlRender_tlTimelineCPU_LIBRARY
     tlRender_tlTimelineGL_LIBRARY
     tlRender_tlTimelineUI_LIBRARY
     tlRender_tlDevice_LIBRARY
@@ -238,6 +244,14 @@ if(tlRender_FOUND AND NOT TARGET tlRender::tlTimeline)
         INTERFACE_INCLUDE_DIRECTORIES "${tlRender_INCLUDE_DIR}"
         INTERFACE_LINK_LIBRARIES "${tlRender_tTimeline_LIBRARIES}")
 endif()
+if(tlRender_FOUND AND NOT TARGET tlRender::tlTimelineCPU)
+    add_library(tlRender::tlTimelineCPU UNKNOWN IMPORTED)
+    set_target_properties(tlRender::tlTimelineCPU PROPERTIES
+        IMPORTED_LOCATION "${tlRender_tlTimelineCPU_LIBRARY}"
+        INTERFACE_COMPILE_DEFINITIONS "${tlRender_COMPILE_DEFINITIONS}"
+        INTERFACE_INCLUDE_DIRECTORIES "${tlRender_INCLUDE_DIR}"
+        INTERFACE_LINK_LIBRARIES "tlRender::tlTimeline")
+endif()
 if(tlRender_FOUND AND NOT TARGET tlRender::tlTimelineUI)
     add_library(tlRender::tlTimelineUI UNKNOWN IMPORTED)
     set_target_properties(tlRender::tlTimelineUI PROPERTIES
@@ -281,6 +295,7 @@ if(tlRender_FOUND AND NOT TARGET tlRender)
     target_link_libraries(tlRender INTERFACE tlRender::tlIO)
     target_link_libraries(tlRender INTERFACE tlRender::tlBaseApp)
     target_link_libraries(tlRender INTERFACE tlRender::tlTimeline)
+    target_link_libraries(tlRender INTERFACE tlRender::tlTimelineCPU)
     target_link_libraries(tlRender INTERFACE tlRender::tlTimelineGL)
     target_link_libraries(tlRender INTERFACE tlRender::tlTimelineUI)
     target_link_libraries(tlRender INTERFACE tlRender::tlDevice)
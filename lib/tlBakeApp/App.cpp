@@ -4,6 +4,7 @@
 
 #include <tlBakeApp/App.h>
 
+#include <tlTimelineCPU/Render.h>
 #include <tlTimelineGL/Render.h>
 
 #include <tlIO/System.h>
@@ -18,14 +19,92 @@
 #include <tlCore/StringFormat.h>
 #include <tlCore/Time.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
 namespace tl
 {
     namespace bake
     {
+        namespace
+        {
+            std::string quoteArg(const std::string& value)
+            {
+#if defined(_WINDOWS)
+                return "\"" + value + "\"";
+#else // _WINDOWS
+                std::string out = "'";
+                for (const char c : value)
+                {
+                    if ('\'' == c)
+                    {
+                        out += "'\\''";
+                    }
+                    else
+                    {
+                        out += c;
+                    }
+                }
+                out += "'";
+                return out;
+#endif // _WINDOWS
+            }
+
+            void removeOption(
+                std::vector<std::string>& args,
+                const std::string& name)
+            {
+                auto i = std::find(args.begin(), args.end(), name);
+                if (i != args.end())
+                {
+                    i = args.erase(i);
+                    if (i != args.end())
+                    {
+                        args.erase(i);
+                    }
+                }
+            }
+
+            std::string toString(const otime::TimeRange& value)
+            {
+                std::stringstream ss;
+                ss.imbue(std::locale::classic());
+                ss << std::setprecision(std::numeric_limits<double>::max_digits10) <<
+                    value.start_time().value() << "/" <<
+                    value.duration().value() << "/" <<
+                    value.duration().rate();
+                return ss.str();
+            }
+
+            FILE* openPipe(const std::string& command)
+            {
+#if defined(_WINDOWS)
+                // The command processor removes the outer quotes.
+                return _popen(("\"" + command + "\"").c_str(), "r");
+#else // _WINDOWS
+                return popen(command.c_str(), "r");
+#endif // _WINDOWS
+            }
+
+            int closePipe(FILE* f)
+            {
+#if defined(_WINDOWS)
+                return _pclose(f);
+#else // _WINDOWS
+                return pclose(f);
+#endif // _WINDOWS
+            }
+        }
+
         void App::_init(
             const std::vector<std::string>& argv,
             const std::shared_ptr<system::Context>& context)
         {
+            _argv = argv;
             BaseApp::_init(
                 argv,
                 context,
@@ -46,6 +125,11 @@ namespace tl
                         _options.inOutRange,
                         { "-inOutRange" },
                         "Set the in/out points range."),
+                    app::CmdLineValueOption<int>::create(
+                        _options.outputStartFrame,
+                        { "-outputStartFrame" },
+                        "Frame number of the first output frame.",
+                        string::Format("{0}").arg(_options.outputStartFrame)),
                     app::CmdLineValueOption<math::Size2i>::create(
                         _options.renderSize,
                         { "-renderSize", "-rs" },
@@ -96,6 +180,44 @@ namespace tl
                         { "-sequenceThreadCount" },
                         "Number of threads for image sequence I/O.",
                         string::Format("{0}").arg(_options.sequenceThreadCount)),
+                    app::CmdLineValueOption<int>::create(
+                        _options.sequenceWriteThreadCount,
+                        { "-sequenceWriteThreadCount" },
+                        "Number of threads for writing image sequences. Zero writes on the main thread.",
+                        string::Format("{0}").arg(_options.sequenceWriteThreadCount)),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.sequenceWriteMegabytes,
+                        { "-sequenceWriteMegabytes" },
+                        "Maximum amount of image data queued for writing image sequences in megabytes.",
+                        string::Format("{0}").arg(_options.sequenceWriteMegabytes)),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.readAhead,
+                        { "-readAhead" },
+                        "Number of frames requested ahead of the render.",
+                        string::Format("{0}").arg(_options.readAhead)),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.readbackCount,
+                        { "-readbackCount" },
+                        "Number of frames read back from the GPU asynchronously. Zero reads back each frame synchronously.",
+                        string::Format("{0}").arg(_options.readbackCount)),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.writeQueue,
+                        { "-writeQueue" },
+                        "Maximum number of frames queued for writing.",
+                        string::Format("{0}").arg(_options.writeQueue)),
+                    app::CmdLineFlagOption::create(
+                        _options.cpuRender,
+                        { "-cpuRender" },
+                        "Render on the CPU instead of with OpenGL. The CPU is also used when an OpenGL context cannot be created."),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.jobs,
+                        { "-jobs" },
+                        "Number of processes used to render. The time range is split into a chunk for each process. Movie chunks are concatenated without re-encoding.",
+                        string::Format("{0}").arg(_options.jobs)),
+                    app::CmdLineValueOption<std::string>::create(
+                        _options.renderTrace,
+                        { "-renderTrace" },
+                        "Write the OpenGL render timing to a JSON file in the Chrome trace format."),
 #if defined(TLRENDER_EXR)
                     app::CmdLineValueOption<float>::create(
                         _options.exrDWACompressionLevel,
@@ -161,7 +283,9 @@ namespace tl
         {}
 
         App::~App()
-        {}
+        {
+            _stopWriteThread();
+        }
 
         std::shared_ptr<App> App::create(
             const std::vector<std::string>& argv,
@@ -178,12 +302,33 @@ namespace tl
             {
                 _startTime = std::chrono::steady_clock::now();
 
-                // Create the window.
-                _window = gl::GLFWWindow::create(
-                    "test-patterns",
-                    math::Size2i(1, 1),
-                    _context,
-                    static_cast<int>(gl::GLFWWindowOptions::MakeCurrent));
+                // Render the time range in separate processes.
+                if (_options.jobs > 1 && _runJobs())
+                {
+                    return _exit;
+                }
+
+                // Create the window. Without an OpenGL context, for
+                // example on a machine without a GPU, the CPU renderer is
+                // used instead.
+                if (!_options.cpuRender)
+                {
+                    try
+                    {
+                        _window = gl::GLFWWindow::create(
+                            "test-patterns",
+                            math::Size2i(1, 1),
+                            _context,
+                            static_cast<int>(gl::GLFWWindowOptions::MakeCurrent));
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(
+                            string::Format("Cannot create an OpenGL context, using the CPU renderer: {0}").
+                                arg(e.what()),
+                            log::Type::Warning);
+                    }
+                }
 
                 // Read the timeline.
                 timeline::Options options;
@@ -204,7 +349,10 @@ namespace tl
                     arg(_timeRange.start_time().value()).
                     arg(_timeRange.end_time_inclusive().value()));
                 _inputTime = _timeRange.start_time();
-                _outputTime = otime::RationalTime(0.0, _timeRange.duration().rate());
+                _requestTime = _inputTime;
+                _outputTime = otime::RationalTime(
+                    _options.outputStartFrame,
+                    _timeRange.duration().rate());
 
                 // Render information.
                 const auto& info = _timeline->getIOInfo();
@@ -218,10 +366,29 @@ namespace tl
                 _print(string::Format("Render size: {0}").arg(_renderSize));
 
                 // Create the renderer.
-                _render = timeline_gl::Render::create(_context);
-                gl::OffscreenBufferOptions offscreenBufferOptions;
-                offscreenBufferOptions.colorType = gl::offscreenColorDefault;
-                _buffer = gl::OffscreenBuffer::create(_renderSize, offscreenBufferOptions);
+                if (_window)
+                {
+                    _glRender = timeline_gl::Render::create(_context);
+                    _glRender->setTimingEnabled(!_options.renderTrace.empty());
+                    _render = _glRender;
+                    gl::OffscreenBufferOptions offscreenBufferOptions;
+                    offscreenBufferOptions.colorType = gl::offscreenColorDefault;
+                    _buffer = gl::OffscreenBuffer::create(_renderSize, offscreenBufferOptions);
+                }
+                else
+                {
+                    _cpuRender = timeline_cpu::Render::create(_context);
+                    _render = _cpuRender;
+                }
+                if (_cpuRender)
+                {
+                    _print(string::Format("Renderer: CPU, {0} threads").
+                        arg(_cpuRender->getThreadCount()));
+                }
+                else
+                {
+                    _print("Renderer: OpenGL");
+                }
 
                 // Create the writer.
                 _writerPlugin = _context->getSystem<io::System>()->getPlugin(file::Path(_output));
@@ -243,26 +410,63 @@ namespace tl
                 _print(string::Format("Output info: {0} {1}").
                     arg(_outputInfo.size).
                     arg(_outputInfo.pixelType));
-                _outputImage = image::Image::create(_outputInfo);
                 ioInfo.video.push_back(_outputInfo);
                 ioInfo.videoTime = _timeRange;
-                _writer = _writerPlugin->write(file::Path(_output), ioInfo);
+                _writer = _writerPlugin->write(file::Path(_output), ioInfo, _getIOOptions());
                 if (!_writer)
                 {
                     throw std::runtime_error(string::Format("{0}: Cannot open").arg(_output));
                 }
 
+                // Create the buffers for reading back the frames.
+                if (_window && _options.readbackCount > 0)
+                {
+                    _asyncReadback = gl::AsyncReadback::create(
+                        _outputInfo,
+                        _options.readbackCount);
+                }
+
+                // Start the write thread.
+                _writeThread.running = true;
+                _writeThread.thread = std::thread(
+                    [this]
+                    {
+                        _writeThreadRun();
+                    });
+
                 // Start the main loop.
-                gl::OffscreenBufferBinding binding(_buffer);
-                while (_running)
                 {
-                    _tick();
+                    std::unique_ptr<gl::OffscreenBufferBinding> binding;
+                    if (_buffer)
+                    {
+                        binding.reset(new gl::OffscreenBufferBinding(_buffer));
+                    }
+                    while (_running)
+                    {
+                        _tick();
+                    }
+                    while (!_readbackTimes.empty())
+                    {
+                        _finishReadback();
+                    }
+                }
+
+                // Write the render timing.
+                if (_glRender && _glRender->isTimingEnabled())
+                {
+                    _glRender->setTimingEnabled(false);
+                    _getRenderTiming();
+                    timeline_gl::writeTrace(_options.renderTrace, _renderTiming);
+                    _print(string::Format("Render trace: {0}").arg(_options.renderTrace));
+                }
+                _stopWriteThread();
+                if (!_writeThread.error.empty())
+                {
+                    throw std::runtime_error(_writeThread.error);
                 }
+                _writer->flush();
 
-                const auto now = std::chrono::steady_clock::now();
-                const std::chrono::duration<float> diff = now - _startTime;
-                _print(string::Format("Seconds elapsed: {0}").arg(diff.count()));
-                _print(string::Format("Average FPS: {0}").arg(_timeRange.duration().value() / diff.count()));
+                _printStats();
             }
 
             return _exit;
@@ -281,6 +485,16 @@ namespace tl
                 ss << _options.sequenceThreadCount;
                 out["SequenceIO/ThreadCount"] = ss.str();
             }
+            {
+                std::stringstream ss;
+                ss << _options.sequenceWriteThreadCount;
+                out["SequenceIO/WriteThreadCount"] = ss.str();
+            }
+            {
+                std::stringstream ss;
+                ss << _options.sequenceWriteMegabytes * memory::megabyte;
+                out["SequenceIO/WriteByteCount"] = ss.str();
+            }
 
 #if defined(TLRENDER_EXR)
             {
@@ -348,23 +562,316 @@ namespace tl
             return out;
         }
 
+        bool App::_runJobs()
+        {
+            // Read the timeline.
+            timeline::Options options;
+            options.ioOptions = _getIOOptions();
+            _timeline = timeline::Timeline::create(_input, _context, options);
+            _timeRange = _timeline->getTimeRange();
+            if (time::isValid(_options.inOutRange))
+            {
+                _timeRange = _options.inOutRange;
+            }
+            _print(string::Format("In/out range: {0}-{1}").
+                arg(_timeRange.start_time().value()).
+                arg(_timeRange.end_time_inclusive().value()));
+
+            // Movies are rendered to a separate file for each job, image
+            // sequences are rendered directly to the output.
+            const file::Path outputPath(_output);
+            const bool movie = io::FileType::Movie ==
+                _context->getSystem<io::System>()->getFileType(outputPath.getExtension());
+#if !defined(TLRENDER_FFMPEG)
+            if (movie)
+            {
+                throw std::runtime_error(string::Format("{0}: Cannot concatenate movies").arg(_output));
+            }
+#endif // TLRENDER_FFMPEG
+
+            // Split the time range into chunks.
+            const int64_t frameCount = static_cast<int64_t>(_timeRange.duration().value());
+            const std::vector<otime::TimeRange> chunks = time::split(_timeRange, _options.jobs);
+            const int64_t jobCount = static_cast<int64_t>(chunks.size());
+            struct Job
+            {
+                otime::TimeRange timeRange;
+                std::string output;
+                std::string command;
+                int progress = 0;
+                std::string error;
+                int status = 0;
+                std::thread thread;
+            };
+            std::vector<Job> jobs(jobCount);
+            std::vector<std::string> args(
+                _argv.begin() + std::min(_argv.size(), size_t(1)),
+                _argv.end());
+            for (const auto& name : { "-jobs", "-inOutRange", "-outputStartFrame", "-renderTrace" })
+            {
+                removeOption(args, name);
+            }
+            const std::string exe = !_argv.empty() ? _argv[0] : _getCmdLineName();
+            for (int64_t i = 0; i < jobCount; ++i)
+            {
+                Job& job = jobs[i];
+                job.timeRange = chunks[i];
+                const int64_t start = static_cast<int64_t>(
+                    job.timeRange.start_time().value() - _timeRange.start_time().value());
+                job.output = _output;
+                if (movie)
+                {
+                    job.output = string::Format("{0}{1}.job{2}.tmp{3}").
+                        arg(outputPath.getDirectory()).
+                        arg(outputPath.getBaseName() + outputPath.getNumber()).
+                        arg(i).
+                        arg(outputPath.getExtension());
+                }
+
+                std::vector<std::string> jobArgs = args;
+                auto j = std::find(jobArgs.rbegin(), jobArgs.rend(), _output);
+                if (j != jobArgs.rend())
+                {
+                    *j = job.output;
+                }
+                jobArgs.push_back("-inOutRange");
+                jobArgs.push_back(toString(job.timeRange));
+                if (!movie)
+                {
+                    jobArgs.push_back("-outputStartFrame");
+                    jobArgs.push_back(string::Format("{0}").
+                        arg(_options.outputStartFrame + start));
+                }
+                if (!_options.renderTrace.empty())
+                {
+                    // Each job writes a separate render trace.
+                    const file::Path tracePath(_options.renderTrace);
+                    jobArgs.push_back("-renderTrace");
+                    jobArgs.push_back(string::Format("{0}{1}.job{2}{3}").
+                        arg(tracePath.getDirectory()).
+                        arg(tracePath.getBaseName() + tracePath.getNumber()).
+                        arg(i).
+                        arg(tracePath.getExtension()));
+                }
+                job.command = quoteArg(exe);
+                for (const auto& arg : jobArgs)
+                {
+                    job.command += " " + quoteArg(arg);
+                }
+                job.command += " 2>&1";
+            }
+            _print(string::Format("Jobs: {0}").arg(jobCount));
+
+            // Run the jobs. The output of each job is forwarded, and the
+            // progress is combined.
+            std::mutex mutex;
+            int progress = 0;
+            for (int64_t i = 0; i < jobCount; ++i)
+            {
+                jobs[i].thread = std::thread(
+                    [this, &jobs, &mutex, &progress, frameCount, i]
+                    {
+                        Job& job = jobs[i];
+                        FILE* f = openPipe(job.command);
+                        if (!f)
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            job.error = "Cannot start the process";
+                            job.status = -1;
+                            return;
+                        }
+                        const std::string completePrefix = "Complete: ";
+                        const std::string errorPrefix = "ERROR: ";
+                        char buf[string::cBufferSize];
+                        while (fgets(buf, string::cBufferSize, f))
+                        {
+                            const std::string line = string::removeTrailingNewlines(std::string(buf));
+                            std::unique_lock<std::mutex> lock(mutex);
+                            if (0 == line.compare(0, completePrefix.size(), completePrefix))
+                            {
+                                job.progress = std::atoi(line.c_str() + completePrefix.size());
+                                int64_t complete = 0;
+                                for (const auto& k : jobs)
+                                {
+                                    complete += k.progress *
+                                        static_cast<int64_t>(k.timeRange.duration().value());
+                                }
+                                const int value = static_cast<int>(complete / frameCount);
+                                if (value > progress)
+                                {
+                                    progress = value;
+                                    _print(string::Format("Complete: {0}%").arg(progress));
+                                    std::fflush(stdout);
+                                }
+                            }
+                            else
+                            {
+                                if (0 == line.compare(0, errorPrefix.size(), errorPrefix))
+                                {
+                                    job.error = line.substr(errorPrefix.size());
+                                }
+                                _print(string::Format("[job {0}] {1}").arg(i).arg(line));
+                            }
+                        }
+                        const int status = closePipe(f);
+                        std::unique_lock<std::mutex> lock(mutex);
+                        job.status = status;
+                    });
+            }
+            for (auto& job : jobs)
+            {
+                job.thread.join();
+            }
+
+            // Check for errors.
+            std::vector<std::string> errors;
+            for (size_t i = 0; i < jobs.size(); ++i)
+            {
+                if (jobs[i].status != 0)
+                {
+                    std::string error = jobs[i].error;
+                    if (error.empty())
+                    {
+                        error = string::Format("Exit status {0}").arg(jobs[i].status);
+                    }
+                    errors.push_back(string::Format("Job {0} failed: {1}").
+                        arg(i).
+                        arg(error));
+                }
+            }
+
+            bool out = true;
+#if defined(TLRENDER_FFMPEG)
+            // Concatenate the movies. If the movies cannot be stream copied
+            // the output is rendered again in a single process.
+            if (movie)
+            {
+                if (errors.empty())
+                {
+                    std::vector<std::string> fileNames;
+                    for (const auto& job : jobs)
+                    {
+                        fileNames.push_back(job.output);
+                    }
+                    try
+                    {
+                        ffmpeg::concat(fileNames, _output);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(
+                            string::Format("Cannot concatenate the job movies, rendering in a single process: {0}").
+                                arg(e.what()),
+                            log::Type::Warning);
+                        out = false;
+                    }
+                }
+                for (const auto& job : jobs)
+                {
+                    file::rm(job.output);
+                }
+            }
+#endif // TLRENDER_FFMPEG
+
+            if (!errors.empty())
+            {
+                throw std::runtime_error(string::join(errors, '\n'));
+            }
+            if (!out)
+            {
+                _timeline.reset();
+                return false;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> diff = now - _startTime;
+            _print(string::Format("Seconds elapsed: {0}").arg(diff.count()));
+            _print(string::Format("Average FPS: {0}").arg(frameCount / diff.count()));
+            return out;
+        }
+
         void App::_tick()
         {
             _context->tick();
 
             _printProgress();
 
+            // Request the video ahead of the render so the frames are
+            // decoded while the previous frames are rendered and written.
+            const size_t readAhead = std::max(_options.readAhead, size_t(1));
+            while (_videoRequests.size() < readAhead &&
+                _requestTime <= _timeRange.end_time_inclusive())
+            {
+                _videoRequests.push_back(_timeline->getVideo(_requestTime));
+                _requestTime += otime::RationalTime(1, _requestTime.rate());
+            }
+
             // Render the video.
+            const auto t0 = std::chrono::steady_clock::now();
+            const auto videoData = _videoRequests.front().future.get();
+            _videoRequests.pop_front();
+            const auto t1 = std::chrono::steady_clock::now();
             _render->begin(_renderSize);
             _render->setOCIOOptions(_options.ocioOptions);
             _render->setLUTOptions(_options.lutOptions);
-            const auto videoData = _timeline->getVideo(_inputTime).future.get();
             _render->drawVideo(
                 { videoData },
                 { math::Box2i(0, 0, _renderSize.w, _renderSize.h) });
             _render->end();
+            const auto t2 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> decodeWaitDiff = t1 - t0;
+            const std::chrono::duration<double> renderDiff = t2 - t1;
+            _stats.decodeWaitTime += decodeWaitDiff.count();
+            _stats.renderTime += renderDiff.count();
+            _getRenderTiming();
+
+            // Read back the frame.
+            _readback();
+
+            // Advance the time.
+            _inputTime += otime::RationalTime(1, _inputTime.rate());
+            if (_inputTime > _timeRange.end_time_inclusive())
+            {
+                _running = false;
+            }
+            _outputTime += otime::RationalTime(1, _outputTime.rate());
+        }
+
+        void App::_readback()
+        {
+            if (_cpuRender)
+            {
+                auto image = _getWriteImage();
+                const auto t0 = std::chrono::steady_clock::now();
+                _cpuRender->read(image);
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<double> diff = t1 - t0;
+                _stats.readbackTime += diff.count();
+                _writeVideo(_outputTime, image);
+                return;
+            }
+
+            if (_asyncReadback)
+            {
+                // Copy out the oldest frame when all of the buffers are in
+                // use.
+                if (_asyncReadback->isFull())
+                {
+                    _finishReadback();
+                }
+
+                // Start reading back the frame.
+                const auto t0 = std::chrono::steady_clock::now();
+                _glRender->beginStage(timeline_gl::RenderStage::Readback);
+                _asyncReadback->start();
+                _glRender->endStage();
+                _readbackTimes.push_back(_outputTime);
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<double> diff = t1 - t0;
+                _stats.readbackTime += diff.count();
+                return;
+            }
 
-            // Write the frame.
             glPixelStorei(GL_PACK_ALIGNMENT, _outputInfo.layout.alignment);
 #if defined(TLRENDER_API_GL_4_1)
             glPixelStorei(GL_PACK_SWAP_BYTES, _outputInfo.layout.endian != memory::getEndian());
@@ -375,6 +882,9 @@ namespace tl
             {
                 throw std::runtime_error(string::Format("{0}: Cannot open").arg(_output));
             }
+            auto image = _getWriteImage();
+            const auto t0 = std::chrono::steady_clock::now();
+            _glRender->beginStage(timeline_gl::RenderStage::Readback);
             glReadPixels(
                 0,
                 0,
@@ -382,16 +892,136 @@ namespace tl
                 _outputInfo.size.h,
                 format,
                 type,
-                _outputImage->getData());
-            _writer->writeVideo(_outputTime, _outputImage);
+                image->getData());
+            _glRender->endStage();
+            const auto t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> diff = t1 - t0;
+            _stats.readbackTime += diff.count();
+            _writeVideo(_outputTime, image);
+        }
 
-            // Advance the time.
-            _inputTime += otime::RationalTime(1, _inputTime.rate());
-            if (_inputTime > _timeRange.end_time_inclusive())
+        void App::_finishReadback()
+        {
+            const otime::RationalTime time = _readbackTimes.front();
+            _readbackTimes.pop_front();
+            auto image = _getWriteImage();
+            const auto t0 = std::chrono::steady_clock::now();
+            _glRender->beginStage(timeline_gl::RenderStage::Readback);
+            _asyncReadback->finish(image);
+            _glRender->endStage();
+            const auto t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> diff = t1 - t0;
+            _stats.readbackTime += diff.count();
+            _writeVideo(time, image);
+        }
+
+        std::shared_ptr<image::Image> App::_getWriteImage()
+        {
+            std::shared_ptr<image::Image> out;
             {
-                _running = false;
+                std::unique_lock<std::mutex> lock(_writeThread.mutex);
+                if (!_writeThread.images.empty())
+                {
+                    out = _writeThread.images.back();
+                    _writeThread.images.pop_back();
+                }
+            }
+            if (!out)
+            {
+                out = image::Image::create(_outputInfo);
+            }
+            return out;
+        }
+
+        void App::_writeVideo(
+            const otime::RationalTime& time,
+            const std::shared_ptr<image::Image>& image)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            {
+                std::unique_lock<std::mutex> lock(_writeThread.mutex);
+                const size_t writeQueue = std::max(_options.writeQueue, size_t(1));
+                _writeThread.cv.wait(
+                    lock,
+                    [this, writeQueue]
+                    {
+                        return
+                            _writeThread.queue.size() < writeQueue ||
+                            !_writeThread.error.empty();
+                    });
+                if (!_writeThread.error.empty())
+                {
+                    throw std::runtime_error(_writeThread.error);
+                }
+                _writeThread.queue.push_back(std::make_pair(time, image));
+            }
+            _writeThread.cv.notify_all();
+            const auto t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> diff = t1 - t0;
+            _stats.writeWaitTime += diff.count();
+        }
+
+        void App::_writeThreadRun()
+        {
+            while (true)
+            {
+                std::pair<otime::RationalTime, std::shared_ptr<image::Image> > item;
+                {
+                    std::unique_lock<std::mutex> lock(_writeThread.mutex);
+                    _writeThread.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return
+                                !_writeThread.queue.empty() ||
+                                !_writeThread.running;
+                        });
+                    if (_writeThread.queue.empty())
+                    {
+                        break;
+                    }
+                    item = _writeThread.queue.front();
+                    _writeThread.queue.pop_front();
+                }
+                _writeThread.cv.notify_all();
+
+                const auto t0 = std::chrono::steady_clock::now();
+                std::string error;
+                try
+                {
+                    _writer->writeVideo(item.first, item.second);
+                }
+                catch (const std::exception& e)
+                {
+                    error = e.what();
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<double> diff = t1 - t0;
+                {
+                    std::unique_lock<std::mutex> lock(_writeThread.mutex);
+                    _writeThread.writeTime += diff.count();
+                    _writeThread.images.push_back(item.second);
+                    if (!error.empty() && _writeThread.error.empty())
+                    {
+                        _writeThread.error = error;
+                        _writeThread.queue.clear();
+                    }
+                }
+                _writeThread.cv.notify_all();
+            }
+        }
+
+        void App::_stopWriteThread()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_writeThread.mutex);
+                _writeThread.running = false;
+            }
+            _writeThread.cv.notify_all();
+            if (_writeThread.thread.joinable())
+            {
+                _writeThread.thread.join();
             }
-            _outputTime += otime::RationalTime(1, _outputTime.rate());
         }
 
         void App::_printProgress()
@@ -401,6 +1031,50 @@ namespace tl
             if (d >= 100 && c % (d / 100) == 0)
             {
                 _print(string::Format("Complete: {0}%").arg(static_cast<int>(c / static_cast<float>(d) * 100)));
+
+                // Flush the progress, when running as a job the output is a
+                // pipe which is block buffered.
+                std::fflush(stdout);
+            }
+        }
+
+        void App::_printStats()
+        {
+            const auto now = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> diff = now - _startTime;
+            const double seconds = diff.count();
+            _print(string::Format("Seconds elapsed: {0}").arg(seconds));
+            _print(string::Format("Average FPS: {0}").arg(_timeRange.duration().value() / seconds));
+            const std::vector<std::pair<std::string, double> > stages =
+            {
+                { "Decode wait", _stats.decodeWaitTime },
+                { "Render", _stats.renderTime },
+                { "Readback", _stats.readbackTime },
+                { "Write wait", _stats.writeWaitTime },
+                { "Write", _writeThread.writeTime }
+            };
+            for (const auto& stage : stages)
+            {
+                _print(string::Format("{0}: {1} seconds, {2}%").
+                    arg(stage.first).
+                    arg(stage.second).
+                    arg(seconds > 0.0 ? static_cast<int>(stage.second / seconds * 100.0) : 0));
+            }
+        }
+
+        void App::_getRenderTiming()
+        {
+            // The renderer only keeps the most recent frames, so copy the
+            // new frames each tick.
+            if (_glRender && !_options.renderTrace.empty())
+            {
+                for (const auto& i : _glRender->getTiming())
+                {
+                    if (_renderTiming.empty() || i.frame > _renderTiming.back().frame)
+                    {
+                        _renderTiming.push_back(i);
+                    }
+                }
             }
         }
     }
@@ -4,8 +4,11 @@
 
 #include <tlBaseApp/BaseApp.h>
 
+#include <tlGL/AsyncReadback.h>
 #include <tlGL/OffscreenBuffer.h>
 
+#include <tlTimelineGL/RenderTiming.h>
+
 #include <tlTimeline/IRender.h>
 #include <tlTimeline/Timeline.h>
 
@@ -20,6 +23,11 @@
 #include <tlIO/USD.h>
 #endif // TLRENDER_USD
 
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
 namespace tl
 {
     namespace gl
@@ -27,6 +35,16 @@ namespace tl
         class GLFWWindow;
     }
 
+    namespace timeline_cpu
+    {
+        class Render;
+    }
+
+    namespace timeline_gl
+    {
+        class Render;
+    }
+
     //! tlbake application
     namespace bake
     {
@@ -34,12 +52,21 @@ namespace tl
         struct Options
         {
             otime::TimeRange inOutRange = time::invalidTimeRange;
+            int outputStartFrame = 0;
             math::Size2i renderSize;
             image::PixelType outputPixelType = image::PixelType::None;
             timeline::OCIOOptions ocioOptions;
             timeline::LUTOptions lutOptions;
             float sequenceDefaultSpeed = io::sequenceDefaultSpeed;
             int sequenceThreadCount = io::sequenceThreadCount;
+            int sequenceWriteThreadCount = io::sequenceWriteThreadCount;
+            size_t sequenceWriteMegabytes = io::sequenceWriteByteCount / memory::megabyte;
+            size_t readAhead = 16;
+            size_t readbackCount = 3;
+            size_t writeQueue = 4;
+            bool cpuRender = false;
+            size_t jobs = 1;
+            std::string renderTrace;
 
 #if defined(TLRENDER_EXR)
             exr::Compression exrCompression = exr::Compression::ZIP;
@@ -87,9 +114,25 @@ namespace tl
         private:
             io::Options _getIOOptions() const;
 
+            //! Render the time range in separate processes. Returns false if
+            //! the job movies cannot be concatenated, the output is then
+            //! rendered in a single process.
+            bool _runJobs();
+
             void _tick();
+            void _readback();
+            void _finishReadback();
+            std::shared_ptr<image::Image> _getWriteImage();
+            void _writeVideo(
+                const otime::RationalTime&,
+                const std::shared_ptr<image::Image>&);
+            void _writeThreadRun();
+            void _stopWriteThread();
             void _printProgress();
+            void _printStats();
+            void _getRenderTiming();
 
+            std::vector<std::string> _argv;
             std::string _input;
             std::string _output;
             Options _options;
@@ -99,16 +142,49 @@ namespace tl
             image::Info _outputInfo;
             otime::TimeRange _timeRange = time::invalidTimeRange;
             otime::RationalTime _inputTime = time::invalidTime;
+            otime::RationalTime _requestTime = time::invalidTime;
             otime::RationalTime _outputTime = time::invalidTime;
+            std::list<timeline::VideoRequest> _videoRequests;
 
             std::shared_ptr<gl::GLFWWindow> _window;
             std::shared_ptr<io::IPlugin> _usdPlugin;
             std::shared_ptr<timeline::IRender> _render;
+            std::shared_ptr<timeline_cpu::Render> _cpuRender;
+            std::shared_ptr<timeline_gl::Render> _glRender;
             std::shared_ptr<gl::OffscreenBuffer> _buffer;
 
             std::shared_ptr<io::IPlugin> _writerPlugin;
             std::shared_ptr<io::IWrite> _writer;
-            std::shared_ptr<image::Image> _outputImage;
+
+            // Frames are read back asynchronously, the oldest frame is
+            // copied out when all of the readback buffers are in use.
+            std::shared_ptr<gl::AsyncReadback> _asyncReadback;
+            std::list<otime::RationalTime> _readbackTimes;
+
+            // Frames are written by a separate thread. The queue is
+            // bounded so the render waits when the writer falls behind.
+            struct WriteThread
+            {
+                std::list<std::pair<otime::RationalTime, std::shared_ptr<image::Image> > > queue;
+                std::vector<std::shared_ptr<image::Image> > images;
+                std::string error;
+                double writeTime = 0.0;
+                bool running = false;
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::thread thread;
+            };
+            WriteThread _writeThread;
+
+            struct Stats
+            {
+                double decodeWaitTime = 0.0;
+                double renderTime = 0.0;
+                double readbackTime = 0.0;
+                double writeWaitTime = 0.0;
+            };
+            Stats _stats;
+            std::list<timeline_gl::RenderTiming> _renderTiming;
 
             bool _running = true;
             std::chrono::steady_clock::time_point _startTime;
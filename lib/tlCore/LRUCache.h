@@ -35,6 +35,9 @@ namespace tl
             bool contains(const T& key) const;
             bool get(const T& key, U& value) const;
 
+            //! Get a value without marking it as recently used.
+            bool peek(const T& key, U& value) const;
+
             void add(const T& key, const U& value, size_t size = 1);
             void remove(const T& key);
             void clear();
@@ -70,6 +70,18 @@ namespace tl
             return i != _map.end();
         }
 
+        template<typename T, typename U>
+        inline bool LRUCache<T, U>::peek(const T& key, U& value) const
+        {
+            auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                value = i->second.first;
+                return true;
+            }
+            return false;
+        }
+
         template<typename T, typename U>
         inline void LRUCache<T, U>::add(const T& key, const U& value, size_t size)
         {
@@ -58,6 +58,29 @@ namespace tl
             return out;
         }
 
+        std::vector<otime::TimeRange> split(const otime::TimeRange& value, size_t count)
+        {
+            std::vector<otime::TimeRange> out;
+            if (value != invalidTimeRange)
+            {
+                const int64_t frameCount = static_cast<int64_t>(value.duration().value());
+                const int64_t chunkCount = std::max(
+                    std::min(static_cast<int64_t>(count), frameCount),
+                    int64_t(1));
+                const double rate = value.duration().rate();
+                const double startTime = value.start_time().rescaled_to(rate).value();
+                for (int64_t i = 0; i < chunkCount; ++i)
+                {
+                    const int64_t start = frameCount * i / chunkCount;
+                    const int64_t end = frameCount * (i + 1) / chunkCount;
+                    out.push_back(otime::TimeRange(
+                        otime::RationalTime(startTime + start, rate),
+                        otime::RationalTime(end - start, rate)));
+                }
+            }
+            return out;
+        }
+
         void sleep(
             const std::chrono::microseconds& value,
             const std::chrono::steady_clock::time_point& t0,
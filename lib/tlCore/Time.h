@@ -49,6 +49,11 @@ namespace tl
         //! Split a time range at into seconds.
         std::vector<otime::TimeRange> seconds(const otime::TimeRange&);
 
+        //! Split a time range into chunks of whole frames. The number of
+        //! chunks is clamped to the number of frames, and the remainder is
+        //! spread over the chunks. The chunks use the rate of the duration.
+        std::vector<otime::TimeRange> split(const otime::TimeRange&, size_t count);
+
         //! Sleep for a given time.
         void sleep(const std::chrono::microseconds&);
 
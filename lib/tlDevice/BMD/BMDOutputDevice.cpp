@@ -921,6 +921,7 @@ namespace tl
             // Render the video.
             if (p.thread.offscreenBuffer)
             {
+                p.thread.render->flush();
                 gl::OffscreenBufferBinding binding(p.thread.offscreenBuffer);
 
                 timeline::RenderOptions renderOptions;
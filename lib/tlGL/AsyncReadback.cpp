@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlGL/AsyncReadback.h>
+
+#include <tlGL/GL.h>
+#include <tlGL/Util.h>
+
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tl
+{
+    namespace gl
+    {
+        struct AsyncReadback::Private
+        {
+            image::Info info;
+            size_t byteCount = 0;
+            unsigned int format = GL_NONE;
+            unsigned int type = GL_NONE;
+
+            struct Buffer
+            {
+#if defined(TLRENDER_API_GL_4_1)
+                GLuint pbo = 0;
+                GLsync sync = nullptr;
+#elif defined(TLRENDER_API_GLES_2)
+                std::shared_ptr<image::Image> image;
+#endif // TLRENDER_API_GL_4_1
+            };
+            std::vector<Buffer> buffers;
+            size_t first = 0;
+            size_t pending = 0;
+        };
+
+        void AsyncReadback::_init(const image::Info& info, size_t count)
+        {
+            TLRENDER_P();
+            p.info = info;
+            p.byteCount = image::getDataByteCount(info);
+            p.format = getReadPixelsFormat(info.pixelType);
+            p.type = getReadPixelsType(info.pixelType);
+            if (!info.isValid() || GL_NONE == p.format || GL_NONE == p.type)
+            {
+                throw std::runtime_error(string::Format("Cannot read back the pixel type: {0}").
+                    arg(info.pixelType));
+            }
+            p.buffers.resize(std::max(count, size_t(1)));
+            for (auto& buffer : p.buffers)
+            {
+#if defined(TLRENDER_API_GL_4_1)
+                glGenBuffers(1, &buffer.pbo);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.pbo);
+                glBufferData(
+                    GL_PIXEL_PACK_BUFFER,
+                    p.byteCount,
+                    NULL,
+                    GL_STREAM_READ);
+#elif defined(TLRENDER_API_GLES_2)
+                buffer.image = image::Image::create(info);
+#endif // TLRENDER_API_GL_4_1
+            }
+#if defined(TLRENDER_API_GL_4_1)
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif // TLRENDER_API_GL_4_1
+        }
+
+        AsyncReadback::AsyncReadback() :
+            _p(new Private)
+        {}
+
+        AsyncReadback::~AsyncReadback()
+        {
+#if defined(TLRENDER_API_GL_4_1)
+            TLRENDER_P();
+            for (auto& buffer : p.buffers)
+            {
+                if (buffer.sync)
+                {
+                    glDeleteSync(buffer.sync);
+                }
+                if (buffer.pbo)
+                {
+                    glDeleteBuffers(1, &buffer.pbo);
+                }
+            }
+#endif // TLRENDER_API_GL_4_1
+        }
+
+        std::shared_ptr<AsyncReadback> AsyncReadback::create(
+            const image::Info& info,
+            size_t count)
+        {
+            auto out = std::shared_ptr<AsyncReadback>(new AsyncReadback);
+            out->_init(info, count);
+            return out;
+        }
+
+        const image::Info& AsyncReadback::getInfo() const
+        {
+            return _p->info;
+        }
+
+        size_t AsyncReadback::getCount() const
+        {
+            return _p->buffers.size();
+        }
+
+        size_t AsyncReadback::getPendingCount() const
+        {
+            return _p->pending;
+        }
+
+        bool AsyncReadback::isFull() const
+        {
+            return _p->pending >= _p->buffers.size();
+        }
+
+        void AsyncReadback::start(int x, int y)
+        {
+            TLRENDER_P();
+            if (p.pending >= p.buffers.size())
+            {
+                throw std::runtime_error("The readback buffers are full");
+            }
+            auto& buffer = p.buffers[(p.first + p.pending) % p.buffers.size()];
+            glPixelStorei(GL_PACK_ALIGNMENT, p.info.layout.alignment);
+#if defined(TLRENDER_API_GL_4_1)
+            glPixelStorei(GL_PACK_SWAP_BYTES, p.info.layout.endian != memory::getEndian());
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.pbo);
+            glReadPixels(
+                x,
+                y,
+                p.info.size.w,
+                p.info.size.h,
+                p.format,
+                p.type,
+                NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            buffer.sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+            // Flush so the fence is signaled without waiting on it.
+            glFlush();
+#elif defined(TLRENDER_API_GLES_2)
+            glReadPixels(
+                x,
+                y,
+                p.info.size.w,
+                p.info.size.h,
+                p.format,
+                p.type,
+                buffer.image->getData());
+#endif // TLRENDER_API_GL_4_1
+            ++p.pending;
+        }
+
+        bool AsyncReadback::isReady() const
+        {
+            TLRENDER_P();
+            bool out = false;
+            if (p.pending > 0)
+            {
+#if defined(TLRENDER_API_GL_4_1)
+                const auto& buffer = p.buffers[p.first];
+                GLint status = GL_UNSIGNALED;
+                glGetSynciv(buffer.sync, GL_SYNC_STATUS, 1, NULL, &status);
+                out = GL_SIGNALED == status;
+#elif defined(TLRENDER_API_GLES_2)
+                out = true;
+#endif // TLRENDER_API_GL_4_1
+            }
+            return out;
+        }
+
+        void AsyncReadback::finish(const std::shared_ptr<image::Image>& image)
+        {
+            TLRENDER_P();
+            if (0 == p.pending)
+            {
+                throw std::runtime_error("No readbacks have been started");
+            }
+            if (image->getDataByteCount() != p.byteCount)
+            {
+                throw std::runtime_error("The readback image size does not match");
+            }
+            auto& buffer = p.buffers[p.first];
+            p.first = (p.first + 1) % p.buffers.size();
+            --p.pending;
+#if defined(TLRENDER_API_GL_4_1)
+            GLenum status = GL_TIMEOUT_EXPIRED;
+            while (GL_TIMEOUT_EXPIRED == status)
+            {
+                status = glClientWaitSync(
+                    buffer.sync,
+                    GL_SYNC_FLUSH_COMMANDS_BIT,
+                    1000000000);
+            }
+            glDeleteSync(buffer.sync);
+            buffer.sync = nullptr;
+            if (GL_WAIT_FAILED == status)
+            {
+                throw std::runtime_error("Cannot wait for the readback");
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.pbo);
+            if (void* data = glMapBufferRange(
+                GL_PIXEL_PACK_BUFFER,
+                0,
+                p.byteCount,
+                GL_MAP_READ_BIT))
+            {
+                memcpy(image->getData(), data, p.byteCount);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            else
+            {
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                throw std::runtime_error("Cannot map the readback buffer");
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#elif defined(TLRENDER_API_GLES_2)
+            memcpy(image->getData(), buffer.image->getData(), p.byteCount);
+#endif // TLRENDER_API_GL_4_1
+        }
+    }
+}
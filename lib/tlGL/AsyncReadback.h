@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Image.h>
+
+namespace tl
+{
+    namespace gl
+    {
+        //! Default number of asynchronous readbacks.
+        const size_t asyncReadbackCountDefault = 3;
+
+        //! Asynchronous readback of the pixels of the current framebuffer.
+        //!
+        //! The pixels are read into a ring of pixel buffer objects, and a
+        //! fence is used to find out when each read has finished. This lets
+        //! the pixels of one frame be copied out while the following frames
+        //! are rendered, instead of waiting for each frame to finish.
+        //!
+        //! Readbacks are finished in the order they were started. Without
+        //! pixel buffer objects (OpenGL ES 2) the pixels are read back
+        //! immediately.
+        class AsyncReadback : public std::enable_shared_from_this<AsyncReadback>
+        {
+            TLRENDER_NON_COPYABLE(AsyncReadback);
+
+        protected:
+            void _init(const image::Info&, size_t count);
+
+            AsyncReadback();
+
+        public:
+            ~AsyncReadback();
+
+            //! Create a new asynchronous readback. An exception is thrown if
+            //! the pixel type cannot be read back.
+            static std::shared_ptr<AsyncReadback> create(
+                const image::Info&,
+                size_t count = asyncReadbackCountDefault);
+
+            //! Get the image information.
+            const image::Info& getInfo() const;
+
+            //! Get the number of buffers in the ring.
+            size_t getCount() const;
+
+            //! Get the number of readbacks that have been started but not
+            //! finished.
+            size_t getPendingCount() const;
+
+            //! Get whether all of the buffers are in use. The oldest readback
+            //! must be finished before another one can be started.
+            bool isFull() const;
+
+            //! Start reading back the pixels of the current framebuffer.
+            void start(int x = 0, int y = 0);
+
+            //! Get whether the oldest readback has finished without
+            //! waiting.
+            bool isReady() const;
+
+            //! Finish the oldest readback, waiting if necessary, and copy the
+            //! pixels to the given image. The rows are stored bottom to top.
+            void finish(const std::shared_ptr<image::Image>&);
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -22,6 +22,7 @@ namespace tl
             "Pos2_F32",
             "Pos2_F32_UV_U16",
             "Pos2_F32_Color_F32",
+            "Pos2_F32_UV_F32_Color_F32",
             "Pos3_F32",
             "Pos3_F32_UV_U16",
             "Pos3_F32_UV_U16_Normal_U10",
@@ -57,6 +58,7 @@ namespace tl
                 2 * sizeof(float),
                 2 * sizeof(float) + 2 * sizeof(uint16_t),
                 2 * sizeof(float) + 4 * sizeof(float),
+                2 * sizeof(float) + 2 * sizeof(float) + 4 * sizeof(float),
                 3 * sizeof(float),
                 3 * sizeof(float) + 2 * sizeof(uint16_t),
                 3 * sizeof(float) + 2 * sizeof(uint16_t) + sizeof(PackedNormal),
@@ -159,6 +161,39 @@ namespace tl
                     }
                 }
                 break;
+            case gl::VBOType::Pos2_F32_UV_F32_Color_F32:
+                for (size_t i = range.getMin(); i <= range.getMax(); ++i)
+                {
+                    const geom::Vertex2* vertices[] =
+                    {
+                        &mesh.triangles[i].v[0],
+                        &mesh.triangles[i].v[1],
+                        &mesh.triangles[i].v[2]
+                    };
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        const size_t v = vertices[k]->v;
+                        float* pf = reinterpret_cast<float*>(p);
+                        pf[0] = v ? mesh.v[v - 1].x : 0.F;
+                        pf[1] = v ? mesh.v[v - 1].y : 0.F;
+                        p += 2 * sizeof(float);
+
+                        const size_t t = vertices[k]->t;
+                        pf = reinterpret_cast<float*>(p);
+                        pf[0] = t ? mesh.t[t - 1].x : 0.F;
+                        pf[1] = t ? mesh.t[t - 1].y : 0.F;
+                        p += 2 * sizeof(float);
+
+                        const size_t c = vertices[k]->c;
+                        pf = reinterpret_cast<float*>(p);
+                        pf[0] = c ? mesh.c[c - 1].x : 1.F;
+                        pf[1] = c ? mesh.c[c - 1].y : 1.F;
+                        pf[2] = c ? mesh.c[c - 1].z : 1.F;
+                        pf[3] = c ? mesh.c[c - 1].w : 1.F;
+                        p += 4 * sizeof(float);
+                    }
+                }
+                break;
             default: break;
             }
             return out;
@@ -484,6 +519,14 @@ namespace tl
                 glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(byteCount), (GLvoid*)8);
                 glEnableVertexAttribArray(1);
                 break;
+            case VBOType::Pos2_F32_UV_F32_Color_F32:
+                glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(byteCount), (GLvoid*)0);
+                glEnableVertexAttribArray(0);
+                glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(byteCount), (GLvoid*)8);
+                glEnableVertexAttribArray(1);
+                glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(byteCount), (GLvoid*)16);
+                glEnableVertexAttribArray(2);
+                break;
             case VBOType::Pos3_F32:
                 glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(byteCount), (GLvoid*)0);
                 glEnableVertexAttribArray(0);
@@ -16,6 +16,18 @@ namespace tl
 {
     namespace gl
     {
+        bool ShaderBinary::operator == (const ShaderBinary& other) const
+        {
+            return
+                format == other.format &&
+                data == other.data;
+        }
+
+        bool ShaderBinary::operator != (const ShaderBinary& other) const
+        {
+            return !(*this == other);
+        }
+
         struct Shader::Private
         {
             std::string vertexSource;
@@ -85,6 +97,9 @@ namespace tl
             p.program = glCreateProgram();
             glAttachShader(p.program, p.vertex);
             glAttachShader(p.program, p.fragment);
+#if defined(TLRENDER_API_GL_4_1)
+            glProgramParameteri(p.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif // TLRENDER_API_GL_4_1
             glLinkProgram(p.program);
             glGetProgramiv(p.program, GL_LINK_STATUS, &success);
             if (!success)
@@ -95,6 +110,27 @@ namespace tl
             }
         }
 
+        void Shader::_init(const ShaderBinary& binary)
+        {
+#if defined(TLRENDER_API_GL_4_1)
+            TLRENDER_P();
+            p.program = glCreateProgram();
+            glProgramBinary(
+                p.program,
+                binary.format,
+                binary.data.data(),
+                binary.data.size());
+            int success = 0;
+            glGetProgramiv(p.program, GL_LINK_STATUS, &success);
+            if (!success)
+            {
+                throw std::runtime_error("Cannot load shader program binary");
+            }
+#elif defined(TLRENDER_API_GLES_2)
+            throw std::runtime_error("Shader program binaries are not supported");
+#endif // TLRENDER_API_GL_4_1
+        }
+
         Shader::Shader() :
             _p(new Private)
         {}
@@ -130,6 +166,18 @@ namespace tl
             return out;
         }
 
+        std::shared_ptr<Shader> Shader::create(
+            const std::string& vertexSource,
+            const std::string& fragmentSource,
+            const ShaderBinary& binary)
+        {
+            auto out = std::shared_ptr<Shader>(new Shader);
+            out->_p->vertexSource = vertexSource;
+            out->_p->fragmentSource = fragmentSource;
+            out->_init(binary);
+            return out;
+        }
+
         const std::string& Shader::getVertexSource() const
         {
             return _p->vertexSource;
@@ -145,6 +193,30 @@ namespace tl
             return _p->program;
         }
 
+        ShaderBinary Shader::getBinary() const
+        {
+            ShaderBinary out;
+#if defined(TLRENDER_API_GL_4_1)
+            TLRENDER_P();
+            GLint size = 0;
+            glGetProgramiv(p.program, GL_PROGRAM_BINARY_LENGTH, &size);
+            if (size > 0)
+            {
+                out.data.resize(size);
+                GLenum format = 0;
+                glGetProgramBinary(
+                    p.program,
+                    size,
+                    &size,
+                    &format,
+                    out.data.data());
+                out.data.resize(size);
+                out.format = format;
+            }
+#endif // TLRENDER_API_GL_4_1
+            return out;
+        }
+
         void Shader::bind()
         {
             glUseProgram(_p->program);
@@ -17,6 +17,16 @@ namespace tl
 {
     namespace gl
     {
+        //! OpenGL shader program binary.
+        struct ShaderBinary
+        {
+            unsigned int format = 0;
+            std::vector<uint8_t> data;
+
+            bool operator == (const ShaderBinary&) const;
+            bool operator != (const ShaderBinary&) const;
+        };
+
         //! OpenGL shader.
         class Shader : public std::enable_shared_from_this<Shader>
         {
@@ -24,6 +34,7 @@ namespace tl
 
         protected:
             void _init();
+            void _init(const ShaderBinary&);
 
             Shader();
 
@@ -35,6 +46,14 @@ namespace tl
                 const std::string& vertexSource,
                 const std::string& fragmentSource);
 
+            //! Create a new shader from a program binary. An exception is
+            //! thrown if the binary cannot be loaded, for example if it was
+            //! created by a different driver.
+            static std::shared_ptr<Shader> create(
+                const std::string& vertexSource,
+                const std::string& fragmentSource,
+                const ShaderBinary&);
+
             //! Get the vertex shader source.
             const std::string& getVertexSource() const;
 
@@ -44,6 +63,10 @@ namespace tl
             //! Get the OpenGL shader program.
             unsigned int getProgram() const;
 
+            //! Get the program binary. The binary is empty if program
+            //! binaries are not supported.
+            ShaderBinary getBinary() const;
+
             //! Bind the shader.
             void bind();
 
@@ -0,0 +1,370 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlGL/ShaderCache.h>
+
+#include <tlGL/GL.h>
+
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/LRUCache.h>
+#include <tlCore/Path.h>
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+
+namespace fs = std::filesystem;
+
+namespace tl
+{
+    namespace gl
+    {
+        bool ShaderSource::operator == (const ShaderSource& other) const
+        {
+            return
+                vertex == other.vertex &&
+                fragment == other.fragment;
+        }
+
+        bool ShaderSource::operator != (const ShaderSource& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool ShaderCacheStats::operator == (const ShaderCacheStats& other) const
+        {
+            return
+                memoryHits == other.memoryHits &&
+                diskHits == other.diskHits &&
+                misses == other.misses &&
+                count == other.count;
+        }
+
+        bool ShaderCacheStats::operator != (const ShaderCacheStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        namespace
+        {
+            // FNV-1a hash, used instead of std::hash since the keys are
+            // written to disk.
+            void hash(uint64_t& value, const std::string& s)
+            {
+                // Include the terminating null so the strings are
+                // separated.
+                for (size_t i = 0; i <= s.size(); ++i)
+                {
+                    value ^= static_cast<uint8_t>(s.c_str()[i]);
+                    value *= 1099511628211ULL;
+                }
+            }
+
+            // Get the OpenGL vendor, renderer, and version strings.
+            std::vector<std::string> getDriverStrings()
+            {
+                std::vector<std::string> out;
+                for (const GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+                {
+                    if (const GLubyte* s = glGetString(name))
+                    {
+                        out.push_back(reinterpret_cast<const char*>(s));
+                    }
+                }
+                return out;
+            }
+
+            std::string getKey(
+                const ShaderSource& source,
+                const std::vector<std::string>& driverStrings)
+            {
+                uint64_t value = 14695981039346656037ULL;
+                hash(value, source.vertex);
+                hash(value, source.fragment);
+                for (const auto& i : driverStrings)
+                {
+                    hash(value, i);
+                }
+                char buf[17];
+                snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(value));
+                return buf;
+            }
+
+            const char magic[] = { 't', 'l', 'S', 'B' };
+            const uint32_t version = 1;
+        }
+
+        std::string getShaderCacheKey(const ShaderSource& source)
+        {
+            return getKey(source, getDriverStrings());
+        }
+
+        struct ShaderCache::Private
+        {
+            std::string path;
+            memory::LRUCache<std::string, ShaderBinary> binaries;
+            ShaderCacheStats stats;
+            bool driverInit = false;
+            std::vector<std::string> driverStrings;
+            mutable std::mutex mutex;
+        };
+
+        void ShaderCache::_init(const std::string& path, size_t max, size_t diskMax)
+        {
+            TLRENDER_P();
+            p.path = path;
+            if (!p.path.empty())
+            {
+                if (!file::exists(p.path))
+                {
+                    file::mkdir(p.path);
+                }
+                _prune(diskMax);
+            }
+            p.binaries.setMax(max);
+        }
+
+        ShaderCache::ShaderCache() :
+            _p(new Private)
+        {}
+
+        ShaderCache::~ShaderCache()
+        {}
+
+        std::shared_ptr<ShaderCache> ShaderCache::create(
+            const std::string& path,
+            size_t max,
+            size_t diskMax)
+        {
+            auto out = std::shared_ptr<ShaderCache>(new ShaderCache);
+            out->_init(path, max, diskMax);
+            return out;
+        }
+
+        const std::string& ShaderCache::getPath() const
+        {
+            return _p->path;
+        }
+
+        size_t ShaderCache::getMax() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.binaries.getMax();
+        }
+
+        void ShaderCache::setMax(size_t value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.binaries.setMax(value);
+        }
+
+        bool ShaderCache::contains(const ShaderSource& source) const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return
+                p.driverInit &&
+                p.binaries.contains(getKey(source, p.driverStrings));
+        }
+
+        std::shared_ptr<Shader> ShaderCache::getShader(const ShaderSource& source)
+        {
+            TLRENDER_P();
+
+            // The driver strings are read the first time a shader is
+            // requested, since an OpenGL context is current then.
+            std::string key;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (!p.driverInit)
+                {
+                    p.driverInit = true;
+                    p.driverStrings = getDriverStrings();
+                }
+                key = getKey(source, p.driverStrings);
+            }
+
+            // Try the program binary in memory.
+            std::shared_ptr<Shader> out;
+            ShaderBinary binary;
+            bool found = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                found = p.binaries.get(key, binary);
+            }
+            if (found)
+            {
+                try
+                {
+                    out = Shader::create(source.vertex, source.fragment, binary);
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    ++(p.stats.memoryHits);
+                }
+                catch (const std::exception&)
+                {}
+            }
+
+            // Try the program binary on disk.
+            if (!out && _read(key, binary))
+            {
+                try
+                {
+                    out = Shader::create(source.vertex, source.fragment, binary);
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.binaries.add(key, binary);
+                    ++(p.stats.diskHits);
+                }
+                catch (const std::exception&)
+                {}
+            }
+
+            // Compile the source code.
+            if (!out)
+            {
+                out = Shader::create(source.vertex, source.fragment);
+                binary = out->getBinary();
+                if (!binary.data.empty())
+                {
+                    _write(key, binary);
+                }
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (!binary.data.empty())
+                {
+                    p.binaries.add(key, binary);
+                }
+                ++(p.stats.misses);
+            }
+
+            return out;
+        }
+
+        ShaderCacheStats ShaderCache::getStats() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            ShaderCacheStats out = p.stats;
+            out.count = p.binaries.getCount();
+            return out;
+        }
+
+        void ShaderCache::clear()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.binaries.clear();
+        }
+
+        bool ShaderCache::_read(const std::string& key, ShaderBinary& binary)
+        {
+            TLRENDER_P();
+            bool out = false;
+            if (!p.path.empty())
+            {
+                const std::string fileName = file::Path(p.path, key + ".bin").get();
+                if (file::exists(fileName))
+                {
+                    try
+                    {
+                        auto io = file::FileIO::create(fileName, file::Mode::Read);
+                        char fileMagic[4];
+                        io->read(fileMagic, 4);
+                        uint32_t fileVersion = 0;
+                        io->readU32(&fileVersion);
+                        if (memcmp(fileMagic, magic, 4) != 0 || fileVersion != version)
+                        {
+                            throw std::runtime_error("Invalid shader binary");
+                        }
+                        uint32_t format = 0;
+                        io->readU32(&format);
+                        binary.format = format;
+                        uint32_t size = 0;
+                        io->readU32(&size);
+                        binary.data.resize(size);
+                        io->read(binary.data.data(), size);
+                        out = true;
+
+                        // Update the modification time, the least recently
+                        // used binaries are removed first.
+                        std::error_code ec;
+                        fs::last_write_time(
+                            fs::path(fileName),
+                            fs::file_time_type::clock::now(),
+                            ec);
+                    }
+                    catch (const std::exception&)
+                    {
+                        // The binary is compiled again and overwritten.
+                    }
+                }
+            }
+            return out;
+        }
+
+        void ShaderCache::_write(const std::string& key, const ShaderBinary& binary)
+        {
+            TLRENDER_P();
+            if (!p.path.empty())
+            {
+                // Write to a temporary file first so a partially written
+                // file is never read.
+                const std::string fileName = file::Path(p.path, key + ".bin").get();
+                const std::string tmpFileName = string::Format("{0}.{1}.tmp").
+                    arg(fileName).
+                    arg(reinterpret_cast<uintptr_t>(&binary));
+                try
+                {
+                    {
+                        auto io = file::FileIO::create(tmpFileName, file::Mode::Write);
+                        io->write(magic, 4);
+                        io->writeU32(version);
+                        io->writeU32(binary.format);
+                        io->writeU32(binary.data.size());
+                        io->write(binary.data.data(), binary.data.size());
+                    }
+                    file::rm(fileName);
+                    std::rename(tmpFileName.c_str(), fileName.c_str());
+                }
+                catch (const std::exception&)
+                {
+                    file::rm(tmpFileName);
+                }
+            }
+        }
+
+        void ShaderCache::_prune(size_t diskMax)
+        {
+            TLRENDER_P();
+            std::error_code ec;
+            std::vector<std::pair<fs::file_time_type, fs::path> > files;
+            for (const auto& i : fs::directory_iterator(fs::path(p.path), ec))
+            {
+                const fs::path& path = i.path();
+                if (".tmp" == path.extension())
+                {
+                    // Remove temporary files left by an interrupted write.
+                    fs::remove(path, ec);
+                }
+                else if (".bin" == path.extension())
+                {
+                    files.push_back(std::make_pair(fs::last_write_time(path, ec), path));
+                }
+            }
+            if (files.size() > diskMax)
+            {
+                // Remove the least recently used program binaries.
+                std::sort(files.begin(), files.end());
+                for (size_t i = 0; i < files.size() - diskMax; ++i)
+                {
+                    fs::remove(files[i].second, ec);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlGL/Shader.h>
+
+namespace tl
+{
+    namespace gl
+    {
+        //! Shader source code.
+        struct ShaderSource
+        {
+            std::string vertex;
+            std::string fragment;
+
+            bool operator == (const ShaderSource&) const;
+            bool operator != (const ShaderSource&) const;
+        };
+
+        //! Shader cache statistics.
+        struct ShaderCacheStats
+        {
+            size_t memoryHits = 0;
+            size_t diskHits = 0;
+            size_t misses = 0;
+
+            //! Number of program binaries in memory.
+            size_t count = 0;
+
+            bool operator == (const ShaderCacheStats&) const;
+            bool operator != (const ShaderCacheStats&) const;
+        };
+
+        //! Get a shader cache key. The key is a hash of the source code and
+        //! the OpenGL vendor, renderer, and version strings, so the OpenGL
+        //! context must be current.
+        std::string getShaderCacheKey(const ShaderSource&);
+
+        //! Shader cache.
+        //!
+        //! The program binaries of compiled shaders are kept in memory, and
+        //! if a directory is given they are also written to disk, so shaders
+        //! do not need to be compiled again when they are used later or the
+        //! next time the application is run. Binaries that cannot be loaded,
+        //! for example after a driver update, are compiled again and
+        //! overwritten. When the cache is created, the least recently used
+        //! binaries on disk are removed to keep the maximum number.
+        //!
+        //! Each shader from the cache is a separate program, so shaders with
+        //! the same source code do not share uniform values.
+        //!
+        //! Program binaries are not supported with OpenGL ES 2, shaders are
+        //! always compiled.
+        //!
+        //! The OpenGL driver strings used for the keys are read the first
+        //! time a shader is requested, getShader() must be called with an
+        //! OpenGL context current.
+        //!
+        //! The cache may be used from multiple threads.
+        class ShaderCache : public std::enable_shared_from_this<ShaderCache>
+        {
+            TLRENDER_NON_COPYABLE(ShaderCache);
+
+        protected:
+            void _init(const std::string& path, size_t max, size_t diskMax);
+
+            ShaderCache();
+
+        public:
+            ~ShaderCache();
+
+            //! Create a new shader cache. If the path is empty the
+            //! program binaries are not written to disk. The maximum
+            //! number of program binaries is given separately for memory
+            //! and disk.
+            static std::shared_ptr<ShaderCache> create(
+                const std::string& path = std::string(),
+                size_t max = 100,
+                size_t diskMax = 1000);
+
+            //! Get the directory for the program binaries.
+            const std::string& getPath() const;
+
+            //! Get the maximum number of program binaries in memory.
+            size_t getMax() const;
+
+            //! Set the maximum number of program binaries in memory.
+            void setMax(size_t);
+
+            //! Get whether the program binary for a shader is in memory.
+            //! This does not require an OpenGL context.
+            bool contains(const ShaderSource&) const;
+
+            //! Get a shader, from a program binary in memory or on disk if
+            //! possible, otherwise by compiling the source code.
+            std::shared_ptr<Shader> getShader(const ShaderSource&);
+
+            //! Get the statistics.
+            ShaderCacheStats getStats() const;
+
+            //! Remove the program binaries from memory.
+            void clear();
+
+        private:
+            bool _read(const std::string& key, ShaderBinary&);
+            void _write(const std::string& key, const ShaderBinary&);
+            void _prune(size_t diskMax);
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
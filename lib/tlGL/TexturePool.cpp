@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlGL/TexturePool.h>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <mutex>
+
+namespace tl
+{
+    namespace gl
+    {
+        bool TexturePoolStats::operator == (const TexturePoolStats& other) const
+        {
+            return
+                textureHits == other.textureHits &&
+                textureMisses == other.textureMisses &&
+                bufferHits == other.bufferHits &&
+                bufferMisses == other.bufferMisses &&
+                evictions == other.evictions &&
+                count == other.count &&
+                byteCount == other.byteCount;
+        }
+
+        bool TexturePoolStats::operator != (const TexturePoolStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        size_t getByteCount(const math::Size2i& size, const OffscreenBufferOptions& options)
+        {
+            size_t out = image::getDataByteCount(image::Info(size.w, size.h, options.colorType));
+            size_t depthStencil = 0;
+            switch (options.depth)
+            {
+            case OffscreenDepth::_16: depthStencil = 2; break;
+            case OffscreenDepth::_24: depthStencil = 3; break;
+            case OffscreenDepth::_32: depthStencil = 4; break;
+            default: break;
+            }
+            if (OffscreenStencil::_8 == options.stencil)
+            {
+                depthStencil += 1;
+            }
+            out += depthStencil * std::max(size.w, 0) * std::max(size.h, 0);
+            size_t samples = 1;
+            switch (options.sampling)
+            {
+            case OffscreenSampling::_2: samples = 2; break;
+            case OffscreenSampling::_4: samples = 4; break;
+            case OffscreenSampling::_8: samples = 8; break;
+            case OffscreenSampling::_16: samples = 16; break;
+            default: break;
+            }
+            return out * samples;
+        }
+
+        namespace
+        {
+            bool isCompatible(const image::Info& a, const image::Info& b)
+            {
+                // Only compare the information that is used to create and
+                // copy to the texture.
+                return
+                    a.size == b.size &&
+                    a.pixelType == b.pixelType &&
+                    a.layout == b.layout;
+            }
+        }
+
+        struct TexturePool::Private
+        {
+            size_t max = 0;
+
+            struct Item
+            {
+                std::shared_ptr<Texture> texture;
+                TextureOptions textureOptions;
+                std::shared_ptr<OffscreenBuffer> buffer;
+                size_t byteCount = 0;
+            };
+
+            // The idle objects, ordered from the most to the least recently
+            // used. The mutex protects the list since objects can be
+            // returned from any thread.
+            std::list<Item> idle;
+            TexturePoolStats stats;
+            mutable std::mutex mutex;
+        };
+
+        void TexturePool::_init(size_t max)
+        {
+            _p->max = max;
+        }
+
+        TexturePool::TexturePool() :
+            _p(new Private)
+        {}
+
+        TexturePool::~TexturePool()
+        {}
+
+        std::shared_ptr<TexturePool> TexturePool::create(size_t max)
+        {
+            auto out = std::shared_ptr<TexturePool>(new TexturePool);
+            out->_init(max);
+            return out;
+        }
+
+        size_t TexturePool::getMax() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.max;
+        }
+
+        void TexturePool::setMax(size_t value)
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.max = value;
+            }
+            _maxUpdate();
+        }
+
+        std::shared_ptr<Texture> TexturePool::getTexture(
+            const image::Info& info,
+            const TextureOptions& options)
+        {
+            TLRENDER_P();
+            _maxUpdate();
+            std::shared_ptr<Texture> texture;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                for (auto i = p.idle.begin(); i != p.idle.end(); ++i)
+                {
+                    if (i->texture &&
+                        isCompatible(i->texture->getInfo(), info) &&
+                        i->textureOptions == options)
+                    {
+                        texture = i->texture;
+                        p.stats.byteCount -= i->byteCount;
+                        p.idle.erase(i);
+                        break;
+                    }
+                }
+                if (texture)
+                {
+                    ++(p.stats.textureHits);
+                }
+                else
+                {
+                    ++(p.stats.textureMisses);
+                }
+            }
+            if (!texture)
+            {
+                texture = Texture::create(info, options);
+            }
+            std::weak_ptr<TexturePool> weak(shared_from_this());
+            const size_t byteCount = image::getDataByteCount(texture->getInfo());
+            return std::shared_ptr<Texture>(
+                texture.get(),
+                [weak, texture, options, byteCount](Texture*) mutable
+                {
+                    if (auto pool = weak.lock())
+                    {
+                        std::unique_lock<std::mutex> lock(pool->_p->mutex);
+                        pool->_p->idle.push_front({ texture, options, nullptr, byteCount });
+                        pool->_p->stats.byteCount += byteCount;
+                    }
+                    texture.reset();
+                });
+        }
+
+        std::shared_ptr<OffscreenBuffer> TexturePool::getOffscreenBuffer(
+            const math::Size2i& size,
+            const OffscreenBufferOptions& options)
+        {
+            TLRENDER_P();
+            _maxUpdate();
+            std::shared_ptr<OffscreenBuffer> buffer;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                for (auto i = p.idle.begin(); i != p.idle.end(); ++i)
+                {
+                    if (i->buffer &&
+                        i->buffer->getSize() == size &&
+                        i->buffer->getOptions() == options)
+                    {
+                        buffer = i->buffer;
+                        p.stats.byteCount -= i->byteCount;
+                        p.idle.erase(i);
+                        break;
+                    }
+                }
+                if (buffer)
+                {
+                    ++(p.stats.bufferHits);
+                }
+                else
+                {
+                    ++(p.stats.bufferMisses);
+                }
+            }
+            if (!buffer)
+            {
+                buffer = OffscreenBuffer::create(size, options);
+            }
+            std::weak_ptr<TexturePool> weak(shared_from_this());
+            const size_t byteCount = getByteCount(size, options);
+            return std::shared_ptr<OffscreenBuffer>(
+                buffer.get(),
+                [weak, buffer, byteCount](OffscreenBuffer*) mutable
+                {
+                    if (auto pool = weak.lock())
+                    {
+                        std::unique_lock<std::mutex> lock(pool->_p->mutex);
+                        pool->_p->idle.push_front({ nullptr, TextureOptions(), buffer, byteCount });
+                        pool->_p->stats.byteCount += byteCount;
+                    }
+                    buffer.reset();
+                });
+        }
+
+        TexturePoolStats TexturePool::getStats() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            TexturePoolStats out = p.stats;
+            out.count = p.idle.size();
+            return out;
+        }
+
+        void TexturePool::clear()
+        {
+            TLRENDER_P();
+            std::list<Private::Item> idle;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                idle = std::move(p.idle);
+                p.idle.clear();
+                p.stats.byteCount = 0;
+            }
+        }
+
+        void TexturePool::_maxUpdate()
+        {
+            TLRENDER_P();
+            // The objects are deleted outside of the lock.
+            std::list<Private::Item> evicted;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                while (p.stats.byteCount > p.max && !p.idle.empty())
+                {
+                    p.stats.byteCount -= p.idle.back().byteCount;
+                    evicted.splice(evicted.begin(), p.idle, std::prev(p.idle.end()));
+                    ++(p.stats.evictions);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlGL/OffscreenBuffer.h>
+#include <tlGL/Texture.h>
+
+namespace tl
+{
+    namespace gl
+    {
+        //! Texture pool statistics.
+        struct TexturePoolStats
+        {
+            size_t textureHits = 0;
+            size_t textureMisses = 0;
+            size_t bufferHits = 0;
+            size_t bufferMisses = 0;
+            size_t evictions = 0;
+
+            //! Number of idle textures and offscreen buffers.
+            size_t count = 0;
+
+            //! Size of the idle textures and offscreen buffers in bytes.
+            size_t byteCount = 0;
+
+            bool operator == (const TexturePoolStats&) const;
+            bool operator != (const TexturePoolStats&) const;
+        };
+
+        //! Get the estimated size of an offscreen buffer in bytes.
+        size_t getByteCount(const math::Size2i&, const OffscreenBufferOptions&);
+
+        //! Pool of textures and offscreen buffers.
+        //!
+        //! Textures are recycled by image information and options, and
+        //! offscreen buffers by size and options. When the last reference to
+        //! a texture or offscreen buffer from the pool is released it is
+        //! returned to the pool instead of being deleted. The least recently
+        //! used idle objects are deleted when the size of the idle objects
+        //! exceeds the maximum.
+        //!
+        //! Idle objects are only deleted by the functions that get objects
+        //! from the pool or set the maximum, so those must be called with
+        //! the OpenGL context current.
+        class TexturePool : public std::enable_shared_from_this<TexturePool>
+        {
+            TLRENDER_NON_COPYABLE(TexturePool);
+
+        protected:
+            void _init(size_t max);
+
+            TexturePool();
+
+        public:
+            ~TexturePool();
+
+            //! Create a new texture pool.
+            static std::shared_ptr<TexturePool> create(size_t max);
+
+            //! Get the maximum size of the idle objects in bytes.
+            size_t getMax() const;
+
+            //! Set the maximum size of the idle objects in bytes.
+            void setMax(size_t);
+
+            //! Get a texture.
+            std::shared_ptr<Texture> getTexture(
+                const image::Info&,
+                const TextureOptions& = TextureOptions());
+
+            //! Get an offscreen buffer.
+            std::shared_ptr<OffscreenBuffer> getOffscreenBuffer(
+                const math::Size2i&,
+                const OffscreenBufferOptions&);
+
+            //! Get the statistics.
+            TexturePoolStats getStats() const;
+
+            //! Delete the idle objects.
+            void clear();
+
+        private:
+            void _maxUpdate();
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
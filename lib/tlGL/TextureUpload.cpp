@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlGL/TextureUpload.h>
+
+#include <tlGL/GL.h>
+
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tl
+{
+    namespace gl
+    {
+        struct TextureUpload::Private
+        {
+#if defined(TLRENDER_API_GL_4_1)
+            struct Buffer
+            {
+                GLuint pbo = 0;
+                size_t byteCount = 0;
+                GLsync sync = nullptr;
+            };
+            std::vector<Buffer> buffers;
+            size_t current = 0;
+
+            void wait(Buffer&);
+#endif // TLRENDER_API_GL_4_1
+            size_t count = 0;
+            std::weak_ptr<log::System> logSystem;
+        };
+
+#if defined(TLRENDER_API_GL_4_1)
+        void TextureUpload::Private::wait(Buffer& buffer)
+        {
+            if (buffer.sync)
+            {
+                GLenum status = GL_TIMEOUT_EXPIRED;
+                while (GL_TIMEOUT_EXPIRED == status)
+                {
+                    status = glClientWaitSync(
+                        buffer.sync,
+                        GL_SYNC_FLUSH_COMMANDS_BIT,
+                        1000000000);
+                }
+                glDeleteSync(buffer.sync);
+                buffer.sync = nullptr;
+            }
+        }
+#endif // TLRENDER_API_GL_4_1
+
+        void TextureUpload::_init(
+            size_t count,
+            const std::weak_ptr<log::System>& logSystem)
+        {
+            TLRENDER_P();
+            p.count = std::max(count, size_t(1));
+            p.logSystem = logSystem;
+#if defined(TLRENDER_API_GL_4_1)
+            p.buffers.resize(p.count);
+            for (auto& buffer : p.buffers)
+            {
+                glGenBuffers(1, &buffer.pbo);
+            }
+#endif // TLRENDER_API_GL_4_1
+        }
+
+        TextureUpload::TextureUpload() :
+            _p(new Private)
+        {}
+
+        TextureUpload::~TextureUpload()
+        {
+#if defined(TLRENDER_API_GL_4_1)
+            TLRENDER_P();
+            for (auto& buffer : p.buffers)
+            {
+                if (buffer.sync)
+                {
+                    glDeleteSync(buffer.sync);
+                }
+                if (buffer.pbo)
+                {
+                    glDeleteBuffers(1, &buffer.pbo);
+                }
+            }
+#endif // TLRENDER_API_GL_4_1
+        }
+
+        std::shared_ptr<TextureUpload> TextureUpload::create(
+            size_t count,
+            const std::weak_ptr<log::System>& logSystem)
+        {
+            auto out = std::shared_ptr<TextureUpload>(new TextureUpload);
+            out->_init(count, logSystem);
+            return out;
+        }
+
+        size_t TextureUpload::getCount() const
+        {
+            return _p->count;
+        }
+
+        size_t TextureUpload::getByteCount() const
+        {
+            size_t out = 0;
+#if defined(TLRENDER_API_GL_4_1)
+            for (const auto& buffer : _p->buffers)
+            {
+                out += buffer.byteCount;
+            }
+#endif // TLRENDER_API_GL_4_1
+            return out;
+        }
+
+        void TextureUpload::copy(
+            const std::shared_ptr<image::Image>& image,
+            const std::shared_ptr<Texture>& texture,
+            int x,
+            int y)
+        {
+            copy(image->getData(), image->getInfo(), texture, x, y);
+        }
+
+        void TextureUpload::copy(
+            const uint8_t* data,
+            const image::Info& info,
+            const std::shared_ptr<Texture>& texture,
+            int x,
+            int y)
+        {
+#if defined(TLRENDER_API_GL_4_1)
+            TLRENDER_P();
+            auto& buffer = p.buffers[p.current];
+            p.current = (p.current + 1) % p.buffers.size();
+
+            // Wait for the previous upload from this buffer, this normally
+            // has finished by the time the ring wraps around.
+            p.wait(buffer);
+
+            const size_t byteCount = image::getDataByteCount(info);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.pbo);
+            if (byteCount > buffer.byteCount)
+            {
+                glBufferData(
+                    GL_PIXEL_UNPACK_BUFFER,
+                    byteCount,
+                    NULL,
+                    GL_STREAM_DRAW);
+                buffer.byteCount = byteCount;
+            }
+            // If the buffer cannot be mapped the texture is updated
+            // directly from the image data.
+            const void* pixels = NULL;
+            if (void* bufferData = glMapBufferRange(
+                GL_PIXEL_UNPACK_BUFFER,
+                0,
+                byteCount,
+                GL_MAP_WRITE_BIT |
+                GL_MAP_INVALIDATE_BUFFER_BIT |
+                GL_MAP_UNSYNCHRONIZED_BIT))
+            {
+                memcpy(bufferData, data, byteCount);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            }
+            else
+            {
+                if (auto logSystem = p.logSystem.lock())
+                {
+                    logSystem->print(
+                        "tl::gl::TextureUpload",
+                        string::Format("Cannot map the upload buffer: {0} bytes").arg(byteCount),
+                        log::Type::Error);
+                }
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                pixels = data;
+            }
+            glBindTexture(GL_TEXTURE_2D, texture->getID());
+            glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
+            glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != memory::getEndian());
+            glTexSubImage2D(
+                GL_TEXTURE_2D,
+                0,
+                x,
+                y,
+                info.size.w,
+                info.size.h,
+                getTextureFormat(info.pixelType),
+                getTextureType(info.pixelType),
+                pixels);
+            if (!pixels)
+            {
+                buffer.sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+#elif defined(TLRENDER_API_GLES_2)
+            glBindTexture(GL_TEXTURE_2D, texture->getID());
+            glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
+            glTexSubImage2D(
+                GL_TEXTURE_2D,
+                0,
+                x,
+                y,
+                info.size.w,
+                info.size.h,
+                getTextureFormat(info.pixelType),
+                getTextureType(info.pixelType),
+                data);
+#endif // TLRENDER_API_GL_4_1
+        }
+
+        void TextureUpload::finish()
+        {
+#if defined(TLRENDER_API_GL_4_1)
+            TLRENDER_P();
+            for (auto& buffer : p.buffers)
+            {
+                p.wait(buffer);
+            }
+#elif defined(TLRENDER_API_GLES_2)
+            glFinish();
+#endif // TLRENDER_API_GL_4_1
+        }
+    }
+}
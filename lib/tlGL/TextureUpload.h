@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlGL/Texture.h>
+
+#include <tlCore/LogSystem.h>
+
+namespace tl
+{
+    namespace gl
+    {
+        //! Default number of texture upload buffers.
+        const size_t textureUploadCountDefault = 3;
+
+        //! Texture uploads through a ring of pixel buffer objects.
+        //!
+        //! Each upload is copied into the next buffer in the ring and a
+        //! fence is inserted after the texture is updated. A buffer is only
+        //! written again once its fence has signaled, so the buffers can be
+        //! mapped without synchronizing with the driver, and the copy from
+        //! the buffer to the texture runs asynchronously while the following
+        //! uploads are prepared.
+        //!
+        //! Without pixel buffer objects (OpenGL ES 2) the textures are
+        //! updated directly.
+        class TextureUpload : public std::enable_shared_from_this<TextureUpload>
+        {
+            TLRENDER_NON_COPYABLE(TextureUpload);
+
+        protected:
+            void _init(size_t count, const std::weak_ptr<log::System>&);
+
+            TextureUpload();
+
+        public:
+            ~TextureUpload();
+
+            //! Create a new texture upload. Failures to map the buffers are
+            //! reported to the log system.
+            static std::shared_ptr<TextureUpload> create(
+                size_t count = textureUploadCountDefault,
+                const std::weak_ptr<log::System>& = std::weak_ptr<log::System>());
+
+            //! Get the number of buffers in the ring.
+            size_t getCount() const;
+
+            //! Get the total size of the buffers in bytes.
+            size_t getByteCount() const;
+
+            //! \name Copy
+            //! Copy image data to a texture.
+            ///@{
+
+            void copy(
+                const std::shared_ptr<image::Image>&,
+                const std::shared_ptr<Texture>&,
+                int x = 0,
+                int y = 0);
+            void copy(
+                const uint8_t*,
+                const image::Info&,
+                const std::shared_ptr<Texture>&,
+                int x = 0,
+                int y = 0);
+
+            ///@}
+
+            //! Wait for all of the uploads to finish.
+            void finish();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -4,6 +4,8 @@
 
 #include <tlIO/Cache.h>
 
+#include <tlCore/FileIO.h>
+#include <tlCore/FileInfo.h>
 #include <tlCore/LRUCache.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
@@ -21,6 +23,14 @@ namespace tl
             std::vector<std::string> s;
             s.push_back(path.get());
             s.push_back(path.getNumber());
+            if (path.isSequence())
+            {
+                s.push_back(path.getSequenceString());
+            }
+            const file::FileInfo fileInfo(path);
+            s.push_back(string::Format("{0}:{1}").
+                arg(fileInfo.getTime()).
+                arg(fileInfo.getSize()));
             for (const auto& i : options)
             {
                 s.push_back(string::Format("{0}:{1}").arg(i.first).arg(i.second));
@@ -79,11 +89,13 @@ namespace tl
             size_t max = memory::gigabyte;
             memory::LRUCache<std::string, VideoData> video;
             memory::LRUCache<std::string, AudioData> audio;
+            memory::LRUCache<std::string, Info> info;
             std::mutex mutex;
         };
 
         void Cache::_init()
         {
+            _p->info.setMax(infoCacheMax);
             _maxUpdate();
         }
 
@@ -186,12 +198,89 @@ namespace tl
             return p.audio.get(key, audioData);
         }
 
+        size_t Cache::getInfoMax() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.info.getMax();
+        }
+
+        void Cache::setInfoMax(size_t value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.info.setMax(value);
+        }
+
+        void Cache::addInfo(const std::string& key, const Info& info)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.info.add(key, info);
+        }
+
+        bool Cache::containsInfo(const std::string& key) const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.info.contains(key);
+        }
+
+        bool Cache::getInfo(const std::string& key, Info& info) const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.info.get(key, info);
+        }
+
+        void Cache::readInfo(const std::string& fileName)
+        {
+            TLRENDER_P();
+            auto io = file::FileIO::create(fileName, file::Mode::Read);
+            const std::string contents = file::readContents(io);
+            const auto json = nlohmann::json::parse(contents);
+            std::vector<std::pair<std::string, Info> > entries;
+            for (const auto& i : json.at("entries"))
+            {
+                entries.push_back(std::make_pair(
+                    i.at("key").get<std::string>(),
+                    i.at("info").get<Info>()));
+            }
+            std::unique_lock<std::mutex> lock(p.mutex);
+            for (const auto& i : entries)
+            {
+                p.info.add(i.first, i.second);
+            }
+        }
+
+        void Cache::writeInfo(const std::string& fileName) const
+        {
+            TLRENDER_P();
+            std::vector<std::string> keys;
+            std::vector<Info> values;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                keys = p.info.getKeys();
+                values = p.info.getValues();
+            }
+            nlohmann::json entries = nlohmann::json::array();
+            for (size_t i = 0; i < keys.size() && i < values.size(); ++i)
+            {
+                entries.push_back({ { "key", keys[i] }, { "info", values[i] } });
+            }
+            const nlohmann::json json = { { "entries", entries } };
+            const std::string contents = json.dump();
+            auto io = file::FileIO::create(fileName, file::Mode::Write);
+            io->write(contents.c_str(), contents.size());
+        }
+
         void Cache::clear()
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
             p.video.clear();
             p.audio.clear();
+            p.info.clear();
         }
 
         void Cache::_maxUpdate()
@@ -12,7 +12,12 @@ namespace tl
 {
     namespace io
     {
-        //! Get an I/O information cache key.
+        //! Default maximum number of I/O information cache entries.
+        const size_t infoCacheMax = 10000;
+
+        //! Get an I/O information cache key. The key includes the file
+        //! modification time and size, and the frame range for sequences,
+        //! so that entries are not re-used when the files change on disk.
         std::string getInfoCacheKey(
             const file::Path&,
             const Options&);
@@ -80,6 +85,28 @@ namespace tl
             //! Get audio from the cache.
             bool getAudio(const std::string& key, AudioData&) const;
 
+            //! Get the maximum number of information entries.
+            size_t getInfoMax() const;
+
+            //! Set the maximum number of information entries.
+            void setInfoMax(size_t);
+
+            //! Add I/O information to the cache.
+            void addInfo(const std::string& key, const Info&);
+
+            //! Get whether the cache contains I/O information.
+            bool containsInfo(const std::string& key) const;
+
+            //! Get I/O information from the cache.
+            bool getInfo(const std::string& key, Info&) const;
+
+            //! Read the I/O information entries from a file. Entries read
+            //! from the file are added to the current entries.
+            void readInfo(const std::string& fileName);
+
+            //! Write the I/O information entries to a file.
+            void writeInfo(const std::string& fileName) const;
+
             //! Clear the cache.
             void clear();
 
@@ -6,6 +6,7 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/Error.h>
+#include <tlCore/File.h>
 #include <tlCore/LogSystem.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
@@ -20,7 +21,10 @@ extern "C"
 #include <libavutil/mastering_display_metadata.h>
 }
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <fstream>
 
 namespace tl
 {
@@ -378,6 +382,318 @@ namespace tl
             return std::string(buf);
         }
 
+        namespace
+        {
+            struct ConcatData
+            {
+                ~ConcatData()
+                {
+                    if (output)
+                    {
+                        if (output->pb && !(output->oformat->flags & AVFMT_NOFILE))
+                        {
+                            avio_closep(&output->pb);
+                        }
+                        avformat_free_context(output);
+                    }
+                    if (input)
+                    {
+                        avformat_close_input(&input);
+                    }
+                    if (options)
+                    {
+                        av_dict_free(&options);
+                    }
+                    if (!listFileName.empty())
+                    {
+                        file::rm(listFileName);
+                    }
+                }
+
+                std::string listFileName;
+                AVDictionary* options = nullptr;
+                AVFormatContext* input = nullptr;
+                AVFormatContext* output = nullptr;
+            };
+
+            struct ConcatInput
+            {
+                ~ConcatInput()
+                {
+                    if (p)
+                    {
+                        avformat_close_input(&p);
+                    }
+                }
+
+                AVFormatContext* p = nullptr;
+            };
+
+            bool isConcatCompatible(const AVCodecParameters* a, const AVCodecParameters* b)
+            {
+                return
+                    a->codec_type == b->codec_type &&
+                    a->codec_id == b->codec_id &&
+                    a->profile == b->profile &&
+                    a->format == b->format &&
+                    a->width == b->width &&
+                    a->height == b->height &&
+                    0 == av_cmp_q(a->sample_aspect_ratio, b->sample_aspect_ratio) &&
+                    a->field_order == b->field_order &&
+                    a->color_range == b->color_range &&
+                    a->color_primaries == b->color_primaries &&
+                    a->color_trc == b->color_trc &&
+                    a->color_space == b->color_space &&
+                    a->sample_rate == b->sample_rate &&
+                    0 == av_channel_layout_compare(&a->ch_layout, &b->ch_layout) &&
+                    a->extradata_size == b->extradata_size &&
+                    (0 == a->extradata_size ||
+                        0 == memcmp(a->extradata, b->extradata, a->extradata_size));
+            }
+
+            // Check that the files can be concatenated by copying the
+            // packets: the streams and codec parameters must match the
+            // first file, the video of each file must start on a key
+            // frame, and the audio must be PCM. Compressed audio codecs
+            // like AAC start each file with encoder priming samples, which
+            // would be heard as gaps at the joins.
+            void checkConcat(const std::vector<std::string>& fileNames)
+            {
+                std::vector<std::unique_ptr<ConcatInput> > inputs;
+                for (const auto& fileName : fileNames)
+                {
+                    auto input = std::make_unique<ConcatInput>();
+                    int r = avformat_open_input(&input->p, fileName.c_str(), nullptr, nullptr);
+                    if (r < 0)
+                    {
+                        throw std::runtime_error(string::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(getErrorLabel(r)));
+                    }
+                    r = avformat_find_stream_info(input->p, nullptr);
+                    if (r < 0)
+                    {
+                        throw std::runtime_error(string::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(getErrorLabel(r)));
+                    }
+                    inputs.push_back(std::move(input));
+                }
+                if (inputs.empty())
+                {
+                    throw std::runtime_error("No files to concatenate");
+                }
+
+                const AVFormatContext* first = inputs.front()->p;
+                for (unsigned int i = 0; i < first->nb_streams; ++i)
+                {
+                    const AVCodecParameters* codecpar = first->streams[i]->codecpar;
+                    if (AVMEDIA_TYPE_AUDIO == codecpar->codec_type &&
+                        (codecpar->codec_id < AV_CODEC_ID_FIRST_AUDIO ||
+                            codecpar->codec_id >= AV_CODEC_ID_ADPCM_IMA_QT))
+                    {
+                        throw std::runtime_error(string::Format(
+                            "{0}: Cannot concatenate {1} audio without re-encoding").
+                            arg(fileNames.front()).
+                            arg(avcodec_get_name(codecpar->codec_id)));
+                    }
+                }
+                for (size_t i = 1; i < inputs.size(); ++i)
+                {
+                    AVFormatContext* input = inputs[i]->p;
+                    const std::string& fileName = fileNames[i];
+                    if (input->nb_streams != first->nb_streams)
+                    {
+                        throw std::runtime_error(string::Format(
+                            "{0}: Cannot concatenate, the streams do not match {1}").
+                            arg(fileName).
+                            arg(fileNames.front()));
+                    }
+                    for (unsigned int j = 0; j < input->nb_streams; ++j)
+                    {
+                        if (!isConcatCompatible(
+                            input->streams[j]->codecpar,
+                            first->streams[j]->codecpar))
+                        {
+                            throw std::runtime_error(string::Format(
+                                "{0}: Cannot concatenate, the codec parameters of stream {1} do not match {2}").
+                                arg(fileName).
+                                arg(j).
+                                arg(fileNames.front()));
+                        }
+                    }
+
+                    // Check the first packet of each video stream.
+                    std::vector<bool> checked(input->nb_streams, false);
+                    for (unsigned int j = 0; j < input->nb_streams; ++j)
+                    {
+                        checked[j] = input->streams[j]->codecpar->codec_type != AVMEDIA_TYPE_VIDEO;
+                    }
+                    Packet packet;
+                    while (std::find(checked.begin(), checked.end(), false) != checked.end() &&
+                        av_read_frame(input, packet.p) >= 0)
+                    {
+                        const int index = packet.p->stream_index;
+                        if (index >= 0 &&
+                            index < static_cast<int>(checked.size()) &&
+                            !checked[index])
+                        {
+                            if (!(packet.p->flags & AV_PKT_FLAG_KEY))
+                            {
+                                throw std::runtime_error(string::Format(
+                                    "{0}: Cannot concatenate, stream {1} does not start with a key frame").
+                                    arg(fileName).
+                                    arg(index));
+                            }
+                            checked[index] = true;
+                        }
+                        av_packet_unref(packet.p);
+                    }
+                }
+            }
+        }
+
+        void concat(
+            const std::vector<std::string>& fileNames,
+            const std::string& output)
+        {
+            checkConcat(fileNames);
+
+            ConcatData data;
+
+            // Write the list of files for the concat demuxer.
+            data.listFileName = output + ".concat.txt";
+            {
+                std::ofstream f(data.listFileName);
+                for (const auto& fileName : fileNames)
+                {
+                    std::string escaped;
+                    for (const char c : fileName)
+                    {
+                        if ('\'' == c)
+                        {
+                            escaped += "'\\''";
+                        }
+                        else
+                        {
+                            escaped += c;
+                        }
+                    }
+                    f << "file '" << escaped << "'" << std::endl;
+                }
+                if (!f)
+                {
+                    throw std::runtime_error(
+                        string::Format("{0}: Cannot write").arg(data.listFileName));
+                }
+            }
+
+            // Open the input.
+            const AVInputFormat* avInputFormat = av_find_input_format("concat");
+            if (!avInputFormat)
+            {
+                throw std::runtime_error("Cannot find the FFmpeg concat demuxer");
+            }
+            av_dict_set(&data.options, "safe", "0", 0);
+            int r = avformat_open_input(
+                &data.input,
+                data.listFileName.c_str(),
+                avInputFormat,
+                &data.options);
+            if (r < 0)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(data.listFileName).
+                    arg(getErrorLabel(r)));
+            }
+            r = avformat_find_stream_info(data.input, nullptr);
+            if (r < 0)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(data.listFileName).
+                    arg(getErrorLabel(r)));
+            }
+
+            // Open the output, copying the streams of the input.
+            r = avformat_alloc_output_context2(&data.output, NULL, NULL, output.c_str());
+            if (r < 0)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(output).
+                    arg(getErrorLabel(r)));
+            }
+            for (unsigned int i = 0; i < data.input->nb_streams; ++i)
+            {
+                const AVStream* inputStream = data.input->streams[i];
+                AVStream* outputStream = avformat_new_stream(data.output, nullptr);
+                if (!outputStream)
+                {
+                    throw std::runtime_error(
+                        string::Format("{0}: Cannot allocate stream").arg(output));
+                }
+                r = avcodec_parameters_copy(outputStream->codecpar, inputStream->codecpar);
+                if (r < 0)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").
+                        arg(output).
+                        arg(getErrorLabel(r)));
+                }
+                outputStream->codecpar->codec_tag = 0;
+                outputStream->time_base = inputStream->time_base;
+                outputStream->avg_frame_rate = inputStream->avg_frame_rate;
+                outputStream->r_frame_rate = inputStream->r_frame_rate;
+            }
+            av_dict_copy(&data.output->metadata, data.input->metadata, 0);
+            if (!(data.output->oformat->flags & AVFMT_NOFILE))
+            {
+                r = avio_open(&data.output->pb, output.c_str(), AVIO_FLAG_WRITE);
+                if (r < 0)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").
+                        arg(output).
+                        arg(getErrorLabel(r)));
+                }
+            }
+            r = avformat_write_header(data.output, nullptr);
+            if (r < 0)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(output).
+                    arg(getErrorLabel(r)));
+            }
+
+            // Copy the packets.
+            Packet packet;
+            while (av_read_frame(data.input, packet.p) >= 0)
+            {
+                const int index = packet.p->stream_index;
+                if (index < 0 || index >= static_cast<int>(data.output->nb_streams))
+                {
+                    av_packet_unref(packet.p);
+                    continue;
+                }
+                av_packet_rescale_ts(
+                    packet.p,
+                    data.input->streams[index]->time_base,
+                    data.output->streams[index]->time_base);
+                packet.p->pos = -1;
+                r = av_interleaved_write_frame(data.output, packet.p);
+                if (r < 0)
+                {
+                    throw std::runtime_error(string::Format("{0}: {1}").
+                        arg(output).
+                        arg(getErrorLabel(r)));
+                }
+            }
+            r = av_write_trailer(data.output);
+            if (r < 0)
+            {
+                throw std::runtime_error(string::Format("{0}: {1}").
+                    arg(output).
+                    arg(getErrorLabel(r)));
+            }
+        }
+
         std::weak_ptr<log::System> Plugin::_logSystemWeak;
 
         void Plugin::_init(
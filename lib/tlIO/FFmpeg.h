@@ -72,6 +72,29 @@ namespace tl
         //! Number of threads.
         const size_t threadCount = 0;
 
+        //! Number of video conversion threads used when writing. Zero
+        //! converts and encodes on the calling thread.
+        const size_t writeThreadCount = 2;
+
+        //! Maximum number of video frames queued when writing.
+        const size_t writeQueueSize = 8;
+
+        //! Write pipeline statistics.
+        struct WriteStats
+        {
+            size_t frameCount = 0;
+            size_t queueCount = 0;
+            size_t queueMax = 0;
+            size_t packetCount = 0;
+            size_t packetMax = 0;
+
+            //! Time spent in each stage in seconds.
+            double blockedTime = 0.0;
+            double convertTime = 0.0;
+            double encodeTime = 0.0;
+            double muxTime = 0.0;
+        };
+
         //! Software scaler flags.
         const int swsScaleFlags = SWS_SPLINE | SWS_ACCURATE_RND | SWS_FULL_CHR_H_INT | SWS_FULL_CHR_H_INP;
 
@@ -106,6 +129,15 @@ namespace tl
         //! Get a label for a FFmpeg error code.
         std::string getErrorLabel(int);
 
+        //! Concatenate movie files without re-encoding, using the FFmpeg
+        //! concat demuxer. The files must have the same streams and codec
+        //! parameters, the video of each file must start with a key frame,
+        //! and the audio must be PCM. An exception is thrown before the
+        //! output is written if the files cannot be stream copied.
+        void concat(
+            const std::vector<std::string>& fileNames,
+            const std::string& output);
+
         //! FFmpeg reader
         class Read : public io::IRead
         {
@@ -190,10 +222,25 @@ namespace tl
                 const std::shared_ptr<audio::Audio>&,
                 const io::Options& = io::Options()) override;
 
+            void flush() override;
+
+            //! Get the write pipeline statistics.
+            WriteStats getStats() const;
+
         private:
+            void _convert(
+                SwsContext*,
+                const otime::RationalTime&,
+                const std::shared_ptr<image::Image>&,
+                AVFrame*);
             void _encode(AVCodecContext*, const AVStream*,
                          const AVFrame*, AVPacket*);
+            void _writePacket(AVPacket*);
             void _flushAudio();
+            void _convertThread(SwsContext*);
+            void _encodeThread();
+            void _muxThread();
+            void _stopPipeline();
 
             TLRENDER_PRIVATE();
         };
@@ -407,6 +407,10 @@ namespace tl
                 {
                     request->promise.set_value(p.info);
                 }
+                if (!infoRequests.empty())
+                {
+                    _requestFinished();
+                }
 
                 // Check the cache.
                 io::VideoData videoData;
@@ -421,6 +425,7 @@ namespace tl
                     {
                         videoRequest->promise.set_value(videoData);
                         videoRequest.reset();
+                        _requestFinished();
                     }
                 }
 
@@ -473,6 +478,7 @@ namespace tl
                     _addToCache(data, videoRequest->time,
                                 videoRequest->options);
                     videoRequest->promise.set_value(data);
+                    _requestFinished();
                     p.videoThread.currentTime += otime::RationalTime(1.0, p.info.videoTime.duration().rate());
                 }
 
@@ -552,6 +558,7 @@ namespace tl
                     {
                         request->promise.set_value(audioData);
                         request.reset();
+                        _requestFinished();
                     }
                 }
 
@@ -598,6 +605,7 @@ namespace tl
                             audioData.audio->getSampleCount() - offset);
                     }
                     request->promise.set_value(audioData);
+                    _requestFinished();
 
                     if (_cache)
                     {
@@ -657,6 +665,10 @@ namespace tl
             {
                 request->promise.set_value(io::VideoData());
             }
+            if (!infoRequests.empty() || !videoRequests.empty())
+            {
+                _requestFinished();
+            }
         }
 
         void Read::_cancelAudioRequests()
@@ -671,6 +683,10 @@ namespace tl
             {
                 request->promise.set_value(io::AudioData());
             }
+            if (!requests.empty())
+            {
+                _requestFinished();
+            }
         }
     }
 }
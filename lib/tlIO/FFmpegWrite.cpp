@@ -2,9 +2,14 @@
 // Copyright (c) 2021-2024 Darby Johnston
 // All rights reserved.
 
+#include <condition_variable>
+#include <cstring>
 #include <fstream>
+#include <list>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #include <tlCore/Math.h>
@@ -651,6 +656,62 @@ namespace tl
 #endif
                 return out;
             }
+
+            SwsContext* createSwsContext(
+                const image::Size& size,
+                AVPixelFormat avPixelFormatIn,
+                const AVCodecContext* avCodecContext)
+            {
+                SwsContext* out = sws_alloc_context();
+                if (!out)
+                    return nullptr;
+                av_opt_set_defaults(out);
+                av_opt_set_int(out, "srcw", size.w, AV_OPT_SEARCH_CHILDREN);
+                av_opt_set_int(out, "srch", size.h, AV_OPT_SEARCH_CHILDREN);
+                av_opt_set_int(out, "src_format", avPixelFormatIn, AV_OPT_SEARCH_CHILDREN);
+                av_opt_set_int(out, "dstw", size.w, AV_OPT_SEARCH_CHILDREN);
+                av_opt_set_int(out, "dsth", size.h, AV_OPT_SEARCH_CHILDREN);
+                av_opt_set_int(out, "dst_format", avCodecContext->pix_fmt, AV_OPT_SEARCH_CHILDREN);
+                av_opt_set_int(out, "sws_flags", swsScaleFlags, AV_OPT_SEARCH_CHILDREN);
+                av_opt_set_int(out, "threads", 0, AV_OPT_SEARCH_CHILDREN);
+                if (sws_init_context(out, nullptr, nullptr) < 0)
+                {
+                    sws_freeContext(out);
+                    return nullptr;
+                }
+
+                // Handle matrices and color space details
+                int in_full, out_full, brightness, contrast, saturation;
+                const int *inv_table, *table;
+
+                sws_getColorspaceDetails(
+                    out, (int**)&inv_table, &in_full,
+                    (int**)&table, &out_full, &brightness, &contrast,
+                    &saturation);
+
+                inv_table = sws_getCoefficients(avCodecContext->colorspace);
+                table = sws_getCoefficients(AVCOL_SPC_BT709);
+
+                // We use the full range, and we set -color_range to 2
+                // ( as we set AV_COL_RANGE_JPEG )
+                in_full =
+                    (avCodecContext->color_range == AVCOL_RANGE_JPEG);
+                out_full =
+                    (avCodecContext->color_range == AVCOL_RANGE_JPEG);
+
+                sws_setColorspaceDetails(
+                    out, inv_table, in_full, table, out_full,
+                    brightness, contrast, saturation);
+
+                return out;
+            }
+
+            double toSeconds(const std::chrono::steady_clock::time_point& t)
+            {
+                const std::chrono::duration<double> diff =
+                    std::chrono::steady_clock::now() - t;
+                return diff.count();
+            }
             
         }  // empty namespace
         
@@ -682,6 +743,42 @@ namespace tl
             size_t  sampleRate = 0;
             std::shared_ptr<audio::AudioResample> resample;
             std::vector<uint8_t*> flatPointers;
+
+            // Video pipeline
+            size_t writeThreadCount = ffmpeg::writeThreadCount;
+            size_t writeQueueSize = ffmpeg::writeQueueSize;
+            bool pipelined = false;
+            struct ConvertJob
+            {
+                size_t index = 0;
+                otime::RationalTime time = time::invalidTime;
+                std::shared_ptr<image::Image> image;
+            };
+            struct PipelineMutex
+            {
+                std::list<ConvertJob> convertJobs;
+                std::map<size_t, AVFrame*> encodeFrames;
+                std::list<AVPacket*> packets;
+                size_t submitIndex = 0;
+                size_t encodeIndex = 0;
+                size_t inFlight = 0;
+                bool muxing = false;
+                bool stopped = false;
+                bool convertDone = false;
+                bool encodeDone = false;
+                std::string error;
+                WriteStats stats;
+                mutable std::mutex mutex;
+            };
+            PipelineMutex pipelineMutex;
+            std::condition_variable convertCV;
+            std::condition_variable encodeCV;
+            std::condition_variable muxCV;
+            std::condition_variable doneCV;
+            std::vector<SwsContext*> convertSwsContexts;
+            std::vector<std::thread> convertThreads;
+            std::thread encodeThread;
+            std::thread muxThread;
             
             bool opened = false;
         };
@@ -710,9 +807,23 @@ namespace tl
                         "{0}: Could not allocate output context")
                     .arg(p.fileName));
             
+            auto option = options.find("FFmpeg/WriteThreadCount");
+            if (option != options.end())
+            {
+                std::stringstream ss(option->second);
+                ss >> p.writeThreadCount;
+            }
+            option = options.find("FFmpeg/WriteQueueSize");
+            if (option != options.end())
+            {
+                std::stringstream ss(option->second);
+                ss >> p.writeQueueSize;
+                p.writeQueueSize = std::max(p.writeQueueSize, size_t(1));
+            }
+            
             AVCodec* avCodec = nullptr;
             AVCodecID avAudioCodecID = AV_CODEC_ID_AAC;
-            auto option = options.find("FFmpeg/AudioCodec");
+            option = options.find("FFmpeg/AudioCodec");
             if (option != options.end())
             {
                 AudioCodec audioCodec;
@@ -1595,49 +1706,27 @@ namespace tl
                     throw std::runtime_error(string::Format("{0}: Incompatible pixel type").arg(p.fileName));
                     break;
                 }
-                p.swsContext = sws_alloc_context();
-                if (!p.swsContext)
+                if (0 == p.writeThreadCount)
                 {
-                    throw std::runtime_error(string::Format("{0}: Cannot allocate context").arg(p.fileName));
+                    p.swsContext = createSwsContext(
+                        videoInfo.size, p.avPixelFormatIn, p.avCodecContext);
+                    if (!p.swsContext)
+                    {
+                        throw std::runtime_error(string::Format("{0}: Cannot initialize sws context").arg(p.fileName));
+                    }
                 }
-                av_opt_set_defaults(p.swsContext);
-                r = av_opt_set_int(p.swsContext, "srcw", videoInfo.size.w, AV_OPT_SEARCH_CHILDREN);
-                r = av_opt_set_int(p.swsContext, "srch", videoInfo.size.h, AV_OPT_SEARCH_CHILDREN);
-                r = av_opt_set_int(p.swsContext, "src_format", p.avPixelFormatIn, AV_OPT_SEARCH_CHILDREN);
-                r = av_opt_set_int(p.swsContext, "dstw", videoInfo.size.w, AV_OPT_SEARCH_CHILDREN);
-                r = av_opt_set_int(p.swsContext, "dsth", videoInfo.size.h, AV_OPT_SEARCH_CHILDREN);
-                r = av_opt_set_int(p.swsContext, "dst_format", p.avCodecContext->pix_fmt, AV_OPT_SEARCH_CHILDREN);
-                r = av_opt_set_int(p.swsContext, "sws_flags", swsScaleFlags, AV_OPT_SEARCH_CHILDREN);
-                r = av_opt_set_int(p.swsContext, "threads", 0, AV_OPT_SEARCH_CHILDREN);
-                r = sws_init_context(p.swsContext, nullptr, nullptr);
-                if (r < 0)
+
+                // Each conversion thread needs its own scaler context.
+                for (size_t i = 0; i < p.writeThreadCount; ++i)
                 {
-                    throw std::runtime_error(string::Format("{0}: Cannot initialize sws context").arg(p.fileName));
+                    SwsContext* swsContext = createSwsContext(
+                        videoInfo.size, p.avPixelFormatIn, p.avCodecContext);
+                    if (!swsContext)
+                    {
+                        throw std::runtime_error(string::Format("{0}: Cannot initialize sws context").arg(p.fileName));
+                    }
+                    p.convertSwsContexts.push_back(swsContext);
                 }
-
-                    
-                // Handle matrices and color space details
-                int in_full, out_full, brightness, contrast, saturation;
-                const int *inv_table, *table;
-
-                sws_getColorspaceDetails(
-                    p.swsContext, (int**)&inv_table, &in_full,
-                    (int**)&table, &out_full, &brightness, &contrast,
-                    &saturation);
-
-                inv_table = sws_getCoefficients(p.avCodecContext->colorspace);
-                table = sws_getCoefficients(AVCOL_SPC_BT709);
-
-                // We use the full range, and we set -color_range to 2
-                // ( as we set AV_COL_RANGE_JPEG )
-                in_full =
-                    (p.avCodecContext->color_range == AVCOL_RANGE_JPEG);
-                out_full =
-                    (p.avCodecContext->color_range == AVCOL_RANGE_JPEG);
-
-                sws_setColorspaceDetails(
-                    p.swsContext, inv_table, in_full, table, out_full,
-                    brightness, contrast, saturation);
             }
             
             if (p.avFormatContext->nb_streams == 0)
@@ -1666,8 +1755,32 @@ namespace tl
                         .arg(getErrorLabel(r)));
             }
 
-            
+
             p.opened = true;
+
+            // Start the video pipeline.
+            if (!p.convertSwsContexts.empty())
+            {
+                p.pipelined = true;
+                for (auto swsContext : p.convertSwsContexts)
+                {
+                    p.convertThreads.push_back(std::thread(
+                        [this, swsContext]
+                        {
+                            _convertThread(swsContext);
+                        }));
+                }
+                p.encodeThread = std::thread(
+                    [this]
+                    {
+                        _encodeThread();
+                    });
+                p.muxThread = std::thread(
+                    [this]
+                    {
+                        _muxThread();
+                    });
+            }
         }
 
         Write::Write() :
@@ -1678,6 +1791,17 @@ namespace tl
         {
             TLRENDER_P();
 
+            // Drain the video pipeline before flushing the encoders.
+            try
+            {
+                flush();
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR(e.what());
+            }
+            _stopPipeline();
+
             if (p.opened)
             {
                 // We need to enclose this in a try block as _encode can throw
@@ -1719,6 +1843,10 @@ namespace tl
             {
                 sws_freeContext(p.swsContext);
             }
+            for (auto swsContext : p.convertSwsContexts)
+            {
+                sws_freeContext(swsContext);
+            }
             if (p.avFrame2)
             {
                 av_frame_free(&p.avFrame2);
@@ -1779,80 +1907,57 @@ namespace tl
             const io::Options&)
         {
             TLRENDER_P();
-            
-            const auto& info = image->getInfo();
-            av_image_fill_arrays(
-                p.avFrame2->data,
-                p.avFrame2->linesize,
-                image->getData(),
-                p.avPixelFormatIn,
-                info.size.w,
-                info.size.h,
-                info.layout.alignment);
 
-            // Flip the image vertically.
-            switch (info.pixelType)
-            {
-            case image::PixelType::L_U8:
-            case image::PixelType::L_U16:
-            case image::PixelType::RGB_U8:
-            case image::PixelType::RGB_U16:
-            case image::PixelType::RGBA_U8:
-            case image::PixelType::RGBA_U16:
+            if (!p.pipelined)
             {
-                const size_t channelCount = image::getChannelCount(info.pixelType);
-                for (size_t i = 0; i < channelCount; i++)
+                int r = av_frame_make_writable(p.avFrame);
+                if (r < 0)
                 {
-                    p.avFrame2->data[i] += p.avFrame2->linesize[i] * (info.size.h - 1);
-                    p.avFrame2->linesize[i] = -p.avFrame2->linesize[i];
+                    throw std::runtime_error(
+                        string::Format(
+                            "Could not make video frame writable at time {0}.")
+                            .arg(time));
                 }
-                break;
-            }
-            case image::PixelType::YUV_420P_U8:
-            case image::PixelType::YUV_422P_U8:
-            case image::PixelType::YUV_444P_U8:
-            case image::PixelType::YUV_420P_U16:
-            case image::PixelType::YUV_422P_U16:
-            case image::PixelType::YUV_444P_U16:
-                //! \bug How do we flip YUV data?
-                throw std::runtime_error(
-                    string::Format("{0}: Incompatible pixel type")
-                        .arg(p.fileName));
-                break;
-            default:
-                throw std::runtime_error(
-                    string::Format("{0}: Incompatible pixel type")
-                        .arg(p.fileName));
-                break;
+                _convert(p.swsContext, time, image, p.avFrame);
+                _encode(
+                    p.avCodecContext, p.avVideoStream, p.avFrame,
+                    p.avPacket);
+                return;
             }
 
-            int r = av_frame_make_writable(p.avFrame);
-            if (r < 0)
+            // The caller is free to re-use the image after this call
+            // returns, so the conversion threads work on a copy.
+            auto copy = image::Image::create(image->getInfo());
+            copy->setTags(image->getTags());
+            memcpy(copy->getData(), image->getData(), image->getDataByteCount());
+
+            const auto t0 = std::chrono::steady_clock::now();
             {
-                throw std::runtime_error(
-                    string::Format(
-                        "Could not make video frame writable at time {0}.")
-                        .arg(time));
+                std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+                p.doneCV.wait(
+                    lock,
+                    [this]
+                    {
+                        return
+                            _p->pipelineMutex.inFlight < _p->writeQueueSize ||
+                            !_p->pipelineMutex.error.empty();
+                    });
+                if (!p.pipelineMutex.error.empty())
+                {
+                    throw std::runtime_error(p.pipelineMutex.error);
+                }
+                Private::ConvertJob job;
+                job.index = p.pipelineMutex.submitIndex++;
+                job.time = time;
+                job.image = copy;
+                p.pipelineMutex.convertJobs.push_back(job);
+                ++p.pipelineMutex.inFlight;
+                auto& stats = p.pipelineMutex.stats;
+                stats.blockedTime += toSeconds(t0);
+                stats.queueCount = p.pipelineMutex.inFlight;
+                stats.queueMax = std::max(stats.queueMax, stats.queueCount);
             }
-
-            sws_scale(
-                p.swsContext,
-                (uint8_t const* const*)p.avFrame2->data,
-                p.avFrame2->linesize,
-                0,
-                p.avVideoStream->codecpar->height,
-                p.avFrame->data,
-                p.avFrame->linesize);
-
-            const auto timeRational = time::toRational(p.avSpeed);
-            p.avFrame->pts = av_rescale_q(
-                time.value() - p.videoStartTime.value(),
-                { timeRational.second, timeRational.first },
-                p.avVideoStream->time_base);
-
-            _encode(
-                    p.avCodecContext, p.avVideoStream, p.avFrame,
-                    p.avPacket);
+            p.convertCV.notify_one();
         }
 
         void Write::writeAudio(
@@ -2046,17 +2151,364 @@ namespace tl
 
                 packet->stream_index = stream->index; // Needed
 
-                r = av_interleaved_write_frame(p.avFormatContext, packet);
-                if (r < 0)
+                _writePacket(packet);
+            }
+        
+        }
+
+        void Write::flush()
+        {
+            TLRENDER_P();
+            if (!p.pipelined)
+                return;
+            std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+            p.doneCV.wait(
+                lock,
+                [this]
+                {
+                    return
+                        (0 == _p->pipelineMutex.inFlight &&
+                         _p->pipelineMutex.packets.empty() &&
+                         !_p->pipelineMutex.muxing) ||
+                        !_p->pipelineMutex.error.empty();
+                });
+            if (!p.pipelineMutex.error.empty())
+            {
+                throw std::runtime_error(p.pipelineMutex.error);
+            }
+        }
+
+        WriteStats Write::getStats() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+            return p.pipelineMutex.stats;
+        }
+
+        void Write::_convert(
+            SwsContext* swsContext,
+            const otime::RationalTime& time,
+            const std::shared_ptr<image::Image>& image,
+            AVFrame* avFrame)
+        {
+            TLRENDER_P();
+
+            const auto& info = image->getInfo();
+            uint8_t* data[4] = { nullptr, nullptr, nullptr, nullptr };
+            int linesize[4] = { 0, 0, 0, 0 };
+            av_image_fill_arrays(
+                data,
+                linesize,
+                image->getData(),
+                p.avPixelFormatIn,
+                info.size.w,
+                info.size.h,
+                info.layout.alignment);
+
+            // Flip the image vertically.
+            switch (info.pixelType)
+            {
+            case image::PixelType::L_U8:
+            case image::PixelType::L_U16:
+            case image::PixelType::RGB_U8:
+            case image::PixelType::RGB_U16:
+            case image::PixelType::RGBA_U8:
+            case image::PixelType::RGBA_U16:
+            {
+                // Packed formats only use the first plane.
+                data[0] += linesize[0] * (info.size.h - 1);
+                linesize[0] = -linesize[0];
+                break;
+            }
+            case image::PixelType::YUV_420P_U8:
+            case image::PixelType::YUV_422P_U8:
+            case image::PixelType::YUV_444P_U8:
+            case image::PixelType::YUV_420P_U16:
+            case image::PixelType::YUV_422P_U16:
+            case image::PixelType::YUV_444P_U16:
+                //! \bug How do we flip YUV data?
+                throw std::runtime_error(
+                    string::Format("{0}: Incompatible pixel type")
+                        .arg(p.fileName));
+                break;
+            default:
+                throw std::runtime_error(
+                    string::Format("{0}: Incompatible pixel type")
+                        .arg(p.fileName));
+                break;
+            }
+
+            sws_scale(
+                swsContext,
+                (uint8_t const* const*)data,
+                linesize,
+                0,
+                p.avVideoStream->codecpar->height,
+                avFrame->data,
+                avFrame->linesize);
+
+            const auto timeRational = time::toRational(p.avSpeed);
+            avFrame->pts = av_rescale_q(
+                time.value() - p.videoStartTime.value(),
+                { timeRational.second, timeRational.first },
+                p.avVideoStream->time_base);
+        }
+
+        void Write::_writePacket(AVPacket* packet)
+        {
+            TLRENDER_P();
+            if (p.pipelined)
+            {
+                // Hand the packet to the muxer thread.
+                AVPacket* clone = av_packet_clone(packet);
+                av_packet_unref(packet);
+                if (!clone)
                 {
                     throw std::runtime_error(
-                        string::Format("{0}: Cannot write frame - {1}")
-                        .arg(p.fileName)
-                        .arg(getErrorLabel(r)));
+                        string::Format("{0}: Cannot allocate packet")
+                        .arg(p.fileName));
                 }
-                av_packet_unref(packet);
+                {
+                    std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+                    p.pipelineMutex.packets.push_back(clone);
+                    auto& stats = p.pipelineMutex.stats;
+                    stats.packetCount = p.pipelineMutex.packets.size();
+                    stats.packetMax = std::max(stats.packetMax, stats.packetCount);
+                }
+                p.muxCV.notify_one();
+                return;
             }
-        
+
+            int r = av_interleaved_write_frame(p.avFormatContext, packet);
+            if (r < 0)
+            {
+                throw std::runtime_error(
+                    string::Format("{0}: Cannot write frame - {1}")
+                    .arg(p.fileName)
+                    .arg(getErrorLabel(r)));
+            }
+            av_packet_unref(packet);
+        }
+
+        void Write::_convertThread(SwsContext* swsContext)
+        {
+            TLRENDER_P();
+            while (true)
+            {
+                Private::ConvertJob job;
+                {
+                    std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+                    p.convertCV.wait(
+                        lock,
+                        [this]
+                        {
+                            return
+                                !_p->pipelineMutex.convertJobs.empty() ||
+                                _p->pipelineMutex.stopped;
+                        });
+                    if (p.pipelineMutex.convertJobs.empty())
+                        break;
+                    job = p.pipelineMutex.convertJobs.front();
+                    p.pipelineMutex.convertJobs.pop_front();
+                }
+
+                const auto t0 = std::chrono::steady_clock::now();
+                AVFrame* avFrame = av_frame_alloc();
+                std::string error;
+                try
+                {
+                    if (!avFrame)
+                    {
+                        throw std::runtime_error(string::Format("{0}: Cannot allocate frame").arg(p.fileName));
+                    }
+                    avFrame->format = p.avVideoStream->codecpar->format;
+                    avFrame->width = p.avVideoStream->codecpar->width;
+                    avFrame->height = p.avVideoStream->codecpar->height;
+                    int r = av_frame_get_buffer(avFrame, 0);
+                    if (r < 0)
+                    {
+                        throw std::runtime_error(
+                            string::Format("{0}: av_frame_get_buffer - {1}")
+                                .arg(p.fileName)
+                                .arg(getErrorLabel(r)));
+                    }
+                    _convert(swsContext, job.time, job.image, avFrame);
+                }
+                catch (const std::exception& e)
+                {
+                    error = e.what();
+                    av_frame_free(&avFrame);
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+                    if (!error.empty())
+                    {
+                        p.pipelineMutex.error = error;
+                    }
+                    // A null frame keeps the encoder in order on errors.
+                    p.pipelineMutex.encodeFrames[job.index] = avFrame;
+                    p.pipelineMutex.stats.convertTime += toSeconds(t0);
+                }
+                p.encodeCV.notify_one();
+                if (!error.empty())
+                {
+                    p.doneCV.notify_all();
+                }
+            }
+        }
+
+        void Write::_encodeThread()
+        {
+            TLRENDER_P();
+            while (true)
+            {
+                AVFrame* avFrame = nullptr;
+                {
+                    std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+                    p.encodeCV.wait(
+                        lock,
+                        [this]
+                        {
+                            const auto& frames = _p->pipelineMutex.encodeFrames;
+                            return
+                                (!frames.empty() &&
+                                 frames.begin()->first == _p->pipelineMutex.encodeIndex) ||
+                                _p->pipelineMutex.convertDone;
+                        });
+                    auto& frames = p.pipelineMutex.encodeFrames;
+                    if (frames.empty() ||
+                        frames.begin()->first != p.pipelineMutex.encodeIndex)
+                        break;
+                    avFrame = frames.begin()->second;
+                    frames.erase(frames.begin());
+                    ++p.pipelineMutex.encodeIndex;
+                }
+
+                const auto t0 = std::chrono::steady_clock::now();
+                std::string error;
+                if (avFrame)
+                {
+                    try
+                    {
+                        _encode(
+                            p.avCodecContext, p.avVideoStream, avFrame,
+                            p.avPacket);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        error = e.what();
+                    }
+                    av_frame_free(&avFrame);
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+                    if (!error.empty())
+                    {
+                        p.pipelineMutex.error = error;
+                    }
+                    --p.pipelineMutex.inFlight;
+                    auto& stats = p.pipelineMutex.stats;
+                    stats.encodeTime += toSeconds(t0);
+                    stats.queueCount = p.pipelineMutex.inFlight;
+                    ++stats.frameCount;
+                }
+                p.doneCV.notify_all();
+            }
+        }
+
+        void Write::_muxThread()
+        {
+            TLRENDER_P();
+            while (true)
+            {
+                AVPacket* packet = nullptr;
+                {
+                    std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+                    p.muxCV.wait(
+                        lock,
+                        [this]
+                        {
+                            return
+                                !_p->pipelineMutex.packets.empty() ||
+                                _p->pipelineMutex.encodeDone;
+                        });
+                    if (p.pipelineMutex.packets.empty())
+                        break;
+                    packet = p.pipelineMutex.packets.front();
+                    p.pipelineMutex.packets.pop_front();
+                    p.pipelineMutex.muxing = true;
+                }
+
+                const auto t0 = std::chrono::steady_clock::now();
+                const int r = av_interleaved_write_frame(p.avFormatContext, packet);
+                av_packet_free(&packet);
+
+                {
+                    std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+                    if (r < 0)
+                    {
+                        p.pipelineMutex.error =
+                            string::Format("{0}: Cannot write frame - {1}")
+                            .arg(p.fileName)
+                            .arg(getErrorLabel(r));
+                    }
+                    p.pipelineMutex.muxing = false;
+                    auto& stats = p.pipelineMutex.stats;
+                    stats.muxTime += toSeconds(t0);
+                    stats.packetCount = p.pipelineMutex.packets.size();
+                }
+                p.doneCV.notify_all();
+            }
+        }
+
+        void Write::_stopPipeline()
+        {
+            TLRENDER_P();
+            if (!p.pipelined)
+                return;
+            {
+                std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+                p.pipelineMutex.stopped = true;
+            }
+            p.convertCV.notify_all();
+            for (auto& thread : p.convertThreads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            {
+                std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+                p.pipelineMutex.convertDone = true;
+            }
+            p.encodeCV.notify_all();
+            if (p.encodeThread.joinable())
+            {
+                p.encodeThread.join();
+            }
+            {
+                std::unique_lock<std::mutex> lock(p.pipelineMutex.mutex);
+                p.pipelineMutex.encodeDone = true;
+            }
+            p.muxCV.notify_all();
+            if (p.muxThread.joinable())
+            {
+                p.muxThread.join();
+            }
+            for (auto& i : p.pipelineMutex.encodeFrames)
+            {
+                av_frame_free(&i.second);
+            }
+            p.pipelineMutex.encodeFrames.clear();
+            for (auto packet : p.pipelineMutex.packets)
+            {
+                av_packet_free(&packet);
+            }
+            p.pipelineMutex.packets.clear();
+            p.pipelined = false;
         }
 
 
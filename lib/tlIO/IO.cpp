@@ -17,5 +17,118 @@ namespace tl
             }
             return out;
         }
+
+        namespace
+        {
+            nlohmann::json imageInfoToJSON(const image::Info& value)
+            {
+                return
+                {
+                    { "name", value.name },
+                    { "compression", value.compression },
+                    { "isLossyCompression", value.isLossyCompression },
+                    { "isValidDeepCompression", value.isValidDeepCompression },
+                    { "compressionNumScanlines", value.compressionNumScanlines },
+                    { "size", value.size },
+                    { "pixelAspectRatio", value.size.pixelAspectRatio },
+                    { "pixelType", value.pixelType },
+                    { "videoLevels", value.videoLevels },
+                    { "yuvCoefficients", value.yuvCoefficients },
+                    { "mirror", { value.layout.mirror.x, value.layout.mirror.y } },
+                    { "alignment", value.layout.alignment },
+                    { "endian", value.layout.endian }
+                };
+            }
+
+            image::Info imageInfoFromJSON(const nlohmann::json& json)
+            {
+                image::Info out;
+                json.at("name").get_to(out.name);
+                json.at("compression").get_to(out.compression);
+                json.at("isLossyCompression").get_to(out.isLossyCompression);
+                json.at("isValidDeepCompression").get_to(out.isValidDeepCompression);
+                json.at("compressionNumScanlines").get_to(out.compressionNumScanlines);
+                json.at("size").get_to(out.size);
+                json.at("pixelAspectRatio").get_to(out.size.pixelAspectRatio);
+                json.at("pixelType").get_to(out.pixelType);
+                json.at("videoLevels").get_to(out.videoLevels);
+                json.at("yuvCoefficients").get_to(out.yuvCoefficients);
+                json.at("mirror").at(0).get_to(out.layout.mirror.x);
+                json.at("mirror").at(1).get_to(out.layout.mirror.y);
+                json.at("alignment").get_to(out.layout.alignment);
+                json.at("endian").get_to(out.layout.endian);
+                return out;
+            }
+
+            nlohmann::json audioInfoToJSON(const audio::Info& value)
+            {
+                nlohmann::json out =
+                {
+                    { "name", value.name },
+                    { "channelCount", value.channelCount },
+                    { "dataType", value.dataType },
+                    { "sampleRate", value.sampleRate },
+                    { "currentTrack", value.currentTrack },
+                    { "trackCount", value.trackCount }
+                };
+                nlohmann::json tracks = nlohmann::json::array();
+                for (const auto& i : value.audioInfo)
+                {
+                    if (i)
+                    {
+                        tracks.push_back(audioInfoToJSON(*i));
+                    }
+                }
+                out["audioInfo"] = tracks;
+                return out;
+            }
+
+            audio::Info audioInfoFromJSON(const nlohmann::json& json)
+            {
+                audio::Info out;
+                json.at("name").get_to(out.name);
+                json.at("channelCount").get_to(out.channelCount);
+                json.at("dataType").get_to(out.dataType);
+                json.at("sampleRate").get_to(out.sampleRate);
+                json.at("currentTrack").get_to(out.currentTrack);
+                json.at("trackCount").get_to(out.trackCount);
+                for (const auto& i : json.at("audioInfo"))
+                {
+                    out.audioInfo.push_back(
+                        std::make_shared<audio::Info>(audioInfoFromJSON(i)));
+                }
+                return out;
+            }
+        }
+
+        void to_json(nlohmann::json& json, const Info& value)
+        {
+            nlohmann::json video = nlohmann::json::array();
+            for (const auto& i : value.video)
+            {
+                video.push_back(imageInfoToJSON(i));
+            }
+            json =
+            {
+                { "video", video },
+                { "videoTime", value.videoTime },
+                { "audio", audioInfoToJSON(value.audio) },
+                { "audioTime", value.audioTime },
+                { "tags", value.tags }
+            };
+        }
+
+        void from_json(const nlohmann::json& json, Info& value)
+        {
+            value.video.clear();
+            for (const auto& i : json.at("video"))
+            {
+                value.video.push_back(imageInfoFromJSON(i));
+            }
+            json.at("videoTime").get_to(value.videoTime);
+            value.audio = audioInfoFromJSON(json.at("audio"));
+            json.at("audioTime").get_to(value.audioTime);
+            json.at("tags").get_to(value.tags);
+        }
     }
 }
@@ -86,6 +86,15 @@ namespace tl
 
         //! Merge options.
         Options merge(const Options&, const Options&);
+
+        //! \name Serialize
+        ///@{
+
+        void to_json(nlohmann::json&, const Info&);
+
+        void from_json(const nlohmann::json&, Info&);
+
+        ///@}
     }
 }
 
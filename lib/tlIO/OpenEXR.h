@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ImfCompression.h>
+#include <ImfForward.h>
 
 #include <tlIO/SequenceIO.h>
 
@@ -106,6 +107,7 @@ namespace tl
                 const io::Options&) override;
 
             void _writeLayer(
+                Imf::MultiPartOutputFile&,
                 const std::shared_ptr<image::Image>& image,
                 int layerId = 0);
 
@@ -38,7 +38,6 @@ namespace tl
         
         struct Write::Private
         {
-            Imf::MultiPartOutputFile* outputFile = nullptr;
             image::PixelType pixelType = image::PixelType::RGBA_F16;
         };
         
@@ -91,7 +90,9 @@ namespace tl
         {}
 
         Write::~Write()
-        {}
+        {
+            _finish();
+        }
 
         std::shared_ptr<Write> Write::create(
             const file::Path& path,
@@ -105,6 +106,7 @@ namespace tl
         }
 
         void Write::_writeLayer(
+            Imf::MultiPartOutputFile& outputFile,
             const std::shared_ptr<image::Image>& image,
             int layerId)
         {
@@ -112,8 +114,8 @@ namespace tl
             
             const uint8_t channelCount = getChannelCount(p.pixelType);
             const uint8_t bitDepth = getBitDepth(p.pixelType) / 8;
-            Imf::OutputPart out(*p.outputFile, layerId);
-            const Imf::Header& header = p.outputFile->header(layerId);
+            Imf::OutputPart out(outputFile, layerId);
+            const Imf::Header& header = outputFile.header(layerId);
             const Imath::Box2i& dataWindow = header.dataWindow();
             const Imath::Box2i& displayWindow = header.displayWindow();
 
@@ -123,10 +125,10 @@ namespace tl
             size_t yStride = xStride * width;
             
             const uint8_t* base = reinterpret_cast<const uint8_t*>(image->getData());
-            uint8_t* flip = new uint8_t[height * yStride];
-            flipImageY(flip, base, height, yStride);
+            std::vector<uint8_t> flip(height * yStride);
+            flipImageY(flip.data(), base, height, yStride);
             
-            uint8_t* dest = flip;
+            uint8_t* dest = flip.data();
 
             Imf::FrameBuffer fb;
             auto ci = header.channels().begin();
@@ -142,7 +144,6 @@ namespace tl
 
             out.setFrameBuffer(fb);
             out.writePixels(height);
-            delete [] flip;
         }
     
         void Write::_writeVideo(
@@ -218,16 +219,16 @@ namespace tl
             std::vector<Imf::Header> headers;
             headers.push_back(header);
             
+            // The output file is local since frames may be written by
+            // multiple threads.
             const int numParts = static_cast<int>(headers.size());
-            p.outputFile = new Imf::MultiPartOutputFile(
+            auto outputFile = std::make_unique<Imf::MultiPartOutputFile>(
                 fileName.c_str(), &headers[0], numParts);
 
             for (int part = 0; part < numParts; ++part)
             {
-                _writeLayer(image, part);
+                _writeLayer(*outputFile, image, part);
             }
-
-            delete p.outputFile;
         }
     }
 }
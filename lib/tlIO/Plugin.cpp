@@ -60,6 +60,21 @@ namespace tl
             return std::future<AudioData>();
         }
 
+        void IRead::setRequestCallback(const std::function<void(void)>& value)
+        {
+            std::unique_lock<std::mutex> lock(_requestCallbackMutex);
+            _requestCallback = value;
+        }
+
+        void IRead::_requestFinished()
+        {
+            std::unique_lock<std::mutex> lock(_requestCallbackMutex);
+            if (_requestCallback)
+            {
+                _requestCallback();
+            }
+        }
+
         void IWrite::_init(
             const file::Path& path,
             const Options& options,
@@ -8,7 +8,9 @@
 
 #include <tlCore/FileIO.h>
 
+#include <functional>
 #include <future>
+#include <mutex>
 #include <set>
 
 namespace tl
@@ -85,8 +87,21 @@ namespace tl
             //! Cancel pending requests.
             virtual void cancelRequests() = 0;
 
+            //! Set a callback that is called when a request has finished.
+            //! The callback is called from the reader's threads after the
+            //! future is ready, so the caller can wait for the results
+            //! instead of polling.
+            void setRequestCallback(const std::function<void(void)>&);
+
         protected:
+            //! Call the request callback.
+            void _requestFinished();
+
             std::vector<file::MemoryRead> _memory;
+
+        private:
+            std::function<void(void)> _requestCallback;
+            std::mutex _requestCallbackMutex;
         };
 
         //! Base class for writers.
@@ -116,6 +131,9 @@ namespace tl
                 const std::shared_ptr<audio::Audio>&,
                 const Options& = Options()) {};
 
+            //! Wait for any pending writes to finish.
+            virtual void flush() {};
+
         protected:
             Info _info;
         };
@@ -15,6 +15,13 @@ namespace tl
 {
     namespace raw
     {
+        TLRENDER_ENUM_IMPL(
+            Quality,
+            "Full",
+            "Half",
+            "Preview");
+        TLRENDER_ENUM_SERIALIZE_IMPL(Quality);
+
         Plugin::Plugin()
         {}
 
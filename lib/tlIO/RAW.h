@@ -16,7 +16,39 @@ namespace tl
     //! https://www.libraw.org/
     namespace raw
     {
+        //! Decode quality.
+        enum class Quality
+        {
+            Full,    //!< Full resolution demosaic
+            Half,    //!< Half resolution demosaic
+            Preview, //!< Embedded preview image, falling back to Half
+
+            Count,
+            First = Full
+        };
+        TLRENDER_ENUM(Quality);
+        TLRENDER_ENUM_SERIALIZE(Quality);
+
+        //! Delay before reduced quality frames are refined.
+        const std::chrono::milliseconds refineDelay(250);
+
+        //! Maximum number of frames waiting to be refined. When there are
+        //! too many the oldest are discarded.
+        const size_t refineMax = 64;
+
         //! RAW reader.
+        //!
+        //! Options:
+        //! - "RAW/Quality": the decode quality (Full, Half, Preview)
+        //! - "RAW/Refine": when a reduced quality frame is read, decode it
+        //!   at full quality once the reader is idle and replace the frame
+        //!   in the cache (0, 1)
+        //!
+        //! Refined frames only replace the frames in the I/O cache. Frames
+        //! that have already been read by a timeline player are kept in the
+        //! player's video cache at reduced quality; call
+        //! timeline::Player::clearCache() to read them again from the I/O
+        //! cache.
         class Read : public io::ISequenceRead
         {
         protected:
@@ -56,6 +88,11 @@ namespace tl
                 const file::MemoryRead*,
                 const otime::RationalTime&,
                 const io::Options&) override;
+
+        private:
+            void _refineThread();
+
+            TLRENDER_PRIVATE();
         };
 
         //! RAW plugin.
@@ -10,12 +10,21 @@
 //
 
 #include <tlIO/RAW.h>
+#if defined(TLRENDER_JPEG)
+#include <tlIO/JPEG.h>
+#endif // TLRENDER_JPEG
 
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
 #include <libraw/libraw.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <list>
+#include <thread>
+
 #define LIBRAW_ERROR(function, ret)                 \
     if (ret)                                        \
     {                                               \
@@ -70,6 +79,96 @@ namespace tl
     {
         namespace
         {
+#if defined(TLRENDER_JPEG)
+            bool jpegOpen(
+                const uint8_t* memoryPtr,
+                size_t memorySize,
+                jpeg_decompress_struct* decompress,
+                jpeg::ErrorStruct* error)
+            {
+                if (::setjmp(error->jump))
+                {
+                    return false;
+                }
+                jpeg_create_decompress(decompress);
+                jpeg_mem_src(decompress, memoryPtr, memorySize);
+                if (!jpeg_read_header(decompress, static_cast<boolean>(1)))
+                {
+                    return false;
+                }
+                decompress->out_color_space = JCS_RGB;
+                if (!jpeg_start_decompress(decompress))
+                {
+                    return false;
+                }
+                return true;
+            }
+
+            bool jpegScanline(
+                jpeg_decompress_struct* decompress,
+                uint8_t* out,
+                jpeg::ErrorStruct* error)
+            {
+                if (::setjmp(error->jump))
+                {
+                    return false;
+                }
+                JSAMPROW p[] = { (JSAMPLE*)(out) };
+                if (!jpeg_read_scanlines(decompress, p, 1))
+                {
+                    return false;
+                }
+                return true;
+            }
+
+            //! Decode an embedded JPEG preview.
+            std::shared_ptr<image::Image> jpegDecode(
+                const uint8_t* data,
+                size_t size)
+            {
+                std::shared_ptr<image::Image> out;
+                jpeg_decompress_struct decompress;
+                std::memset(&decompress, 0, sizeof(jpeg_decompress_struct));
+                jpeg::ErrorStruct error;
+                decompress.err = jpeg_std_error(&error.pub);
+                error.pub.error_exit = jpeg::errorFunc;
+                error.pub.emit_message = jpeg::warningFunc;
+                if (jpegOpen(data, size, &decompress, &error) &&
+                    3 == decompress.out_color_components)
+                {
+                    image::Info info(
+                        decompress.output_width,
+                        decompress.output_height,
+                        image::PixelType::RGB_U8);
+                    info.layout.mirror.y = true;
+                    out = image::Image::create(info);
+                    uint8_t* p = out->getData();
+                    const size_t scanlineByteCount = info.size.w * 3;
+                    for (uint16_t y = 0; y < info.size.h; ++y, p += scanlineByteCount)
+                    {
+                        if (!jpegScanline(&decompress, p, &error))
+                        {
+                            out.reset();
+                            break;
+                        }
+                    }
+                }
+                jpeg_destroy_decompress(&decompress);
+                return out;
+            }
+#endif // TLRENDER_JPEG
+
+            Quality getQuality(const io::Options& options)
+            {
+                Quality out = Quality::Full;
+                auto i = options.find("RAW/Quality");
+                if (i != options.end())
+                {
+                    std::stringstream ss(i->second);
+                    ss >> out;
+                }
+                return out;
+            }
 
             class File
             {
@@ -86,8 +185,10 @@ namespace tl
                         }
                     
                         _memory = memory;
-                    
-                        _openFile(fileName);
+
+                        // The information does not require unpacking the
+                        // RAW data.
+                        _openFile(fileName, false);
                     
                         _info.video.resize(1);
                         auto& info = _info.video[0];
@@ -175,13 +276,25 @@ namespace tl
 
                 io::VideoData read(
                     const std::string& fileName,
-                    const otime::RationalTime& time)
+                    const otime::RationalTime& time,
+                    Quality quality)
                     {
-                        int ret;
                         io::VideoData out;
                         out.time = time;
-                        const auto& info = _info.video[0];
-                        out.image = image::Image::create(info);
+                        if (Quality::Preview == quality)
+                        {
+                            out.image = _readPreview(fileName);
+                            if (!out.image)
+                            {
+                                quality = Quality::Half;
+                            }
+                        }
+                        if (!out.image)
+                        {
+                            out.image = _readImage(
+                                fileName,
+                                Quality::Half == quality);
+                        }
 
                         auto tags = _info.tags;
                         tags["otioClipName"] = fileName;
@@ -190,8 +303,24 @@ namespace tl
                             ss << time;
                             tags["otioClipTime"] = ss.str();
                         }
+                        {
+                            std::stringstream ss;
+                            ss << quality;
+                            tags["raw:Quality"] = ss.str();
+                        }
                         out.image->setTags(tags);
 
+                        return out;
+                    }
+
+            protected:
+                std::shared_ptr<image::Image> _readImage(
+                    const std::string& fileName,
+                    bool halfSize)
+                    {
+                        int ret;
+                        std::shared_ptr<image::Image> out;
+
                         auto& params(_processor->imgdata.params);
     
                         // Output 16-bit images
@@ -243,6 +372,10 @@ namespace tl
                         params.gamm[0] = 1.0 / 2.4;
                         params.gamm[1] = 12.92;
 
+                        // Quick demosaic for reduced quality.
+                        params.half_size = halfSize ? 1 : 0;
+                        params.use_fuji_rotate = halfSize ? 0 : 1;
+
                         _openFile(fileName);
                     
                         float old_max_thr = params.adjust_maximum_thr;
@@ -285,15 +418,27 @@ namespace tl
                             throw std::runtime_error("Not a bitmap image");
                         }
 
+                        image::Info info(
+                            _image->width,
+                            _image->height,
+                            image::PixelType::RGB_U16);
+                        info.size.pixelAspectRatio =
+                            _info.video[0].size.pixelAspectRatio;
+                        info.layout.mirror.y = true;
+                        info.layout.endian = memory::Endian::LSB;
+                        out = image::Image::create(info);
+
                         if (_image->colors == 3)
                         {
-                            memcpy(out.image->getData(), _image->data,
-                                   _image->data_size);
+                            memcpy(out->getData(), _image->data,
+                                   std::min(
+                                       static_cast<size_t>(_image->data_size),
+                                       out->getDataByteCount()));
                         }
                         else if (_image->colors == 1)
                         {
                             uint16_t* data = reinterpret_cast<uint16_t*>(
-                                out.image->getData());
+                                out->getData());
                             for (size_t i = 0; i < _image->data_size; ++i)
                             {
                                 const size_t j = i * 3;
@@ -304,6 +449,7 @@ namespace tl
                         }
                         else
                         {
+                            _processor->dcraw_clear_mem(_image);
                             throw std::runtime_error(
                                 "Unsupport color depth");
                         }
@@ -313,8 +459,52 @@ namespace tl
                         return out;
                     }
 
-            protected:
-                void _openFile(const std::string& fileName)
+                std::shared_ptr<image::Image> _readPreview(
+                    const std::string& fileName)
+                    {
+                        std::shared_ptr<image::Image> out;
+                        _openFile(fileName, false);
+                        int ret = _processor->unpack_thumb();
+                        if (ret != LIBRAW_SUCCESS)
+                        {
+                            _processor->recycle();
+                            return out;
+                        }
+                        libraw_processed_image_t* thumb =
+                            _processor->dcraw_make_mem_thumb(&ret);
+                        if (thumb)
+                        {
+                            switch (thumb->type)
+                            {
+                            case LIBRAW_IMAGE_BITMAP:
+                                if (3 == thumb->colors && 8 == thumb->bits)
+                                {
+                                    image::Info info(
+                                        thumb->width,
+                                        thumb->height,
+                                        image::PixelType::RGB_U8);
+                                    info.layout.mirror.y = true;
+                                    out = image::Image::create(info);
+                                    memcpy(out->getData(), thumb->data,
+                                           std::min(
+                                               static_cast<size_t>(thumb->data_size),
+                                               out->getDataByteCount()));
+                                }
+                                break;
+#if defined(TLRENDER_JPEG)
+                            case LIBRAW_IMAGE_JPEG:
+                                out = jpegDecode(thumb->data, thumb->data_size);
+                                break;
+#endif // TLRENDER_JPEG
+                            default: break;
+                            }
+                            _processor->dcraw_clear_mem(thumb);
+                        }
+                        _processor->recycle();
+                        return out;
+                    }
+
+                void _openFile(const std::string& fileName, bool unpack = true)
                 {
                     std::lock_guard<std::mutex> lock(_mutex);
                     int ret;
@@ -339,8 +529,11 @@ namespace tl
                     }
                         
                     // Let us unpack the image
-                    ret = _processor->unpack();
-                    LIBRAW_ERROR(unpack, ret);
+                    if (unpack)
+                    {
+                        ret = _processor->unpack();
+                        LIBRAW_ERROR(unpack, ret);
+                    }
 
                     ret = _processor->adjust_sizes_info_only();
                     LIBRAW_ERROR(adjust_sizes_info_only, ret);
@@ -391,6 +584,30 @@ namespace tl
 
         std::mutex File::_mutex;
 
+        struct Read::Private
+        {
+            struct RefineRequest
+            {
+                std::string fileName;
+                const file::MemoryRead* memory = nullptr;
+                otime::RationalTime time = time::invalidTime;
+                io::Options options;
+            };
+
+            struct Mutex
+            {
+                std::list<RefineRequest> requests;
+                std::chrono::steady_clock::time_point lastRead;
+                size_t readsInProgress = 0;
+                bool stopped = false;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+
+            std::condition_variable cv;
+            std::thread thread;
+        };
+
         void Read::_init(
             const file::Path& path,
             const std::vector<file::MemoryRead>& memory,
@@ -399,13 +616,34 @@ namespace tl
             const std::weak_ptr<log::System>& logSystem)
         {
             ISequenceRead::_init(path, memory, options, cache, logSystem);
+
+            TLRENDER_P();
+            if (_cache)
+            {
+                p.thread = std::thread(
+                    [this]
+                    {
+                        _refineThread();
+                    });
+            }
         }
 
-        Read::Read()
+        Read::Read() :
+            _p(new Private)
         {}
 
         Read::~Read()
         {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.stopped = true;
+            }
+            p.cv.notify_one();
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
             _finish();
         }
 
@@ -449,7 +687,138 @@ namespace tl
             const otime::RationalTime& time,
             const io::Options& options)
         {
-            return File(fileName, memory).read(fileName, time);
+            TLRENDER_P();
+            const Quality quality = getQuality(options);
+            bool refine = Quality::Full != quality;
+            auto i = options.find("RAW/Refine");
+            if (i != options.end())
+            {
+                int value = 0;
+                std::stringstream ss(i->second);
+                ss >> value;
+                refine &= value != 0;
+            }
+
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                ++p.mutex.readsInProgress;
+            }
+            io::VideoData out;
+            try
+            {
+                out = File(fileName, memory).read(fileName, time, quality);
+            }
+            catch (const std::exception&)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    --p.mutex.readsInProgress;
+                    p.mutex.lastRead = std::chrono::steady_clock::now();
+                }
+                p.cv.notify_one();
+                throw;
+            }
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                --p.mutex.readsInProgress;
+                p.mutex.lastRead = std::chrono::steady_clock::now();
+                if (refine && p.thread.joinable())
+                {
+                    // Replace any request for the same frame, and discard
+                    // the oldest requests when there are too many.
+                    auto& requests = p.mutex.requests;
+                    requests.remove_if(
+                        [&time](const Private::RefineRequest& value)
+                        {
+                            return value.time == time;
+                        });
+                    Private::RefineRequest request;
+                    request.fileName = fileName;
+                    request.memory = memory;
+                    request.time = time;
+                    request.options = options;
+                    requests.push_back(request);
+                    while (requests.size() > refineMax)
+                    {
+                        requests.pop_front();
+                    }
+                }
+            }
+            p.cv.notify_one();
+            return out;
+        }
+
+        void Read::_refineThread()
+        {
+            TLRENDER_P();
+            while (true)
+            {
+                Private::RefineRequest request;
+                {
+                    // Wait until there are no reads in progress, the reads
+                    // notify when they finish.
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return
+                                (!_p->mutex.requests.empty() &&
+                                 0 == _p->mutex.readsInProgress) ||
+                                _p->mutex.stopped;
+                        });
+                    if (p.mutex.stopped)
+                        break;
+
+                    // Wait until nothing has been read for a while. If
+                    // another read starts, go back to waiting for it.
+                    const auto idle = p.mutex.lastRead + refineDelay;
+                    if (std::chrono::steady_clock::now() < idle)
+                    {
+                        p.cv.wait_until(
+                            lock,
+                            idle,
+                            [this]
+                            {
+                                return
+                                    _p->mutex.readsInProgress > 0 ||
+                                    _p->mutex.stopped;
+                            });
+                        continue;
+                    }
+
+                    // Refine the most recent frame first.
+                    request = p.mutex.requests.back();
+                    p.mutex.requests.pop_back();
+                }
+
+                try
+                {
+                    // Skip frames that are no longer in the cache.
+                    const std::string cacheKey = io::getVideoCacheKey(
+                        _path,
+                        request.time,
+                        _options,
+                        request.options);
+                    if (!_cache->containsVideo(cacheKey))
+                        continue;
+
+                    io::VideoData videoData = File(
+                        request.fileName,
+                        request.memory).read(
+                            request.fileName,
+                            request.time,
+                            Quality::Full);
+
+                    // Replace the reduced quality frame in the cache.
+                    if (_cache->containsVideo(cacheKey))
+                    {
+                        _cache->addVideo(cacheKey, videoData);
+                    }
+                }
+                catch (const std::exception&)
+                {}
+            }
         }
     }
 }
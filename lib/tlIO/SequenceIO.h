@@ -6,6 +6,8 @@
 
 #include <tlIO/Plugin.h>
 
+#include <tlCore/Memory.h>
+
 namespace tl
 {
     namespace io
@@ -19,6 +21,20 @@ namespace tl
         //! Timeout for requests.
         const std::chrono::milliseconds sequenceRequestTimeout(5);
 
+        //! Number of threads for writing. Zero writes on the calling thread.
+        const size_t sequenceWriteThreadCount = 0;
+
+        //! Maximum number of image bytes queued for writing.
+        const size_t sequenceWriteByteCount = memory::gigabyte;
+
+        //! Image sequence write error.
+        struct SequenceWriteError
+        {
+            otime::RationalTime time = time::invalidTime;
+            std::string fileName;
+            std::string message;
+        };
+
         //! Base class for image sequence readers.
         class ISequenceRead : public IRead
         {
@@ -90,6 +106,16 @@ namespace tl
                 const std::shared_ptr<image::Image>&,
                 const Options& = Options()) override;
 
+            //! Wait for the pending writes to finish. An exception is
+            //! thrown if any frames failed to write since the last flush.
+            void flush() override;
+
+            //! Wait for the pending writes to finish.
+            void wait();
+
+            //! Get the errors from all of the frames that failed to write.
+            std::vector<SequenceWriteError> getErrors() const;
+
         protected:
             virtual void _writeVideo(
                 const std::string& fileName,
@@ -97,7 +123,12 @@ namespace tl
                 const std::shared_ptr<image::Image>&,
                 const Options&) = 0;
 
+            //! \bug This must be called in the sub-class destructor.
+            void _finish();
+
         private:
+            void _thread();
+
             TLRENDER_PRIVATE();
         };
     }
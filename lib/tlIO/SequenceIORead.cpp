@@ -63,10 +63,24 @@ namespace tl
                     TLRENDER_P();
                     try
                     {
-                        p.info = _getInfo(
-                            path.get(-1, file::PathType::Path),
-                            !_memory.empty() ? &_memory[0] : nullptr);
-                        p.addTags(p.info);
+                        // Sequences read from disk can use the information
+                        // cache to skip reading the file header.
+                        std::string infoKey;
+                        if (_cache && _memory.empty())
+                        {
+                            infoKey = getInfoCacheKey(_path, _options);
+                        }
+                        if (infoKey.empty() || !_cache->getInfo(infoKey, p.info))
+                        {
+                            p.info = _getInfo(
+                                path.get(-1, file::PathType::Path),
+                                !_memory.empty() ? &_memory[0] : nullptr);
+                            p.addTags(p.info);
+                            if (!infoKey.empty())
+                            {
+                                _cache->addInfo(infoKey, p.info);
+                            }
+                        }
                         _thread();
                     }
                     catch (const std::exception& e)
@@ -175,6 +189,7 @@ namespace tl
         {
             TLRENDER_P();
             p.thread.running = false;
+            p.thread.cv.notify_one();
             if (p.thread.thread.joinable())
             {
                 p.thread.thread.join();
@@ -199,10 +214,12 @@ namespace tl
                         {
                             return
                                 !_p->mutex.infoRequests.empty() ||
-                                !_p->mutex.videoRequests.empty() ||
-                                !_p->thread.videoRequestsInProgress.empty();
+                                (!_p->mutex.videoRequests.empty() &&
+                                    _p->thread.videoRequestsInProgress.size() < _p->threadCount) ||
+                                _p->mutex.videoRequestsFinished;
                         }))
                     {
+                        p.mutex.videoRequestsFinished = false;
                         infoRequests = std::move(p.mutex.infoRequests);
                         while (!p.mutex.videoRequests.empty() &&
                             (p.thread.videoRequestsInProgress.size() + videoRequests.size()) < p.threadCount)
@@ -214,9 +231,11 @@ namespace tl
                 }
 
                 // Information rquests.
+                bool requestsFinished = false;
                 for (const auto& request : infoRequests)
                 {
                     request->promise.set_value(p.info);
+                    requestsFinished = true;
                 }
 
                 // Initialize video requests.
@@ -247,6 +266,7 @@ namespace tl
                             {
                                 readSequence = false;
                                 request->promise.set_value(videoData);
+                                requestsFinished = true;
                             }
                         }
                     }
@@ -268,9 +288,12 @@ namespace tl
                         }
                         const otime::RationalTime time = request->time;
                         const Options options = request->options;
+                        // The request is kept alive by the list of requests
+                        // in progress until the task has finished.
+                        Private::VideoRequest* requestPtr = request.get();
                         request->future = std::async(
                             std::launch::async,
-                            [this, seq, fileName, time, options]
+                            [this, seq, fileName, time, options, requestPtr]
                             {
                                 VideoData out;
                                 try
@@ -287,41 +310,53 @@ namespace tl
                                 {
                                     //! \todo How should this be handled?
                                 }
-                                return out;
+                                {
+                                    std::unique_lock<std::mutex> lock(_p->mutex.mutex);
+                                    requestPtr->videoData = out;
+                                    requestPtr->finished = true;
+                                    _p->mutex.videoRequestsFinished = true;
+                                }
+                                _p->thread.cv.notify_one();
                             });
                         p.thread.videoRequestsInProgress.push_back(request);
                     }
                 }
 
                 // Check for finished video requests.
-                //if (!p.thread.videoRequestsInProgress.empty())
-                //{
-                //    std::cout << "in progress: " << p.thread.videoRequestsInProgress.size() << std::endl;
-                //}
-                auto requestIt = p.thread.videoRequestsInProgress.begin();
-                while (requestIt != p.thread.videoRequestsInProgress.end())
+                std::list<std::shared_ptr<Private::VideoRequest> > finishedRequests;
                 {
-                    if ((*requestIt)->future.valid() &&
-                        (*requestIt)->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    auto requestIt = p.thread.videoRequestsInProgress.begin();
+                    while (requestIt != p.thread.videoRequestsInProgress.end())
                     {
-                        //std::cout << "finished: " << requestIt->time << std::endl;
-                        auto videoData = (*requestIt)->future.get();
-                        (*requestIt)->promise.set_value(videoData);
-                        
-                        if (_cache)
+                        if ((*requestIt)->finished)
                         {
-                            const std::string cacheKey = getVideoCacheKey(
-                                _path,
-                                (*requestIt)->time,
-                                _options,
-                                (*requestIt)->options);
-                            _cache->addVideo(cacheKey, videoData);
+                            finishedRequests.push_back(*requestIt);
+                            requestIt = p.thread.videoRequestsInProgress.erase(requestIt);
+                            continue;
                         }
+                        ++requestIt;
+                    }
+                }
+                for (const auto& request : finishedRequests)
+                {
+                    request->promise.set_value(request->videoData);
+                    requestsFinished = true;
 
-                        requestIt = p.thread.videoRequestsInProgress.erase(requestIt);
-                        continue;
+                    if (_cache)
+                    {
+                        const std::string cacheKey = getVideoCacheKey(
+                            _path,
+                            request->time,
+                            _options,
+                            request->options);
+                        _cache->addVideo(cacheKey, request->videoData);
                     }
-                    ++requestIt;
+                }
+                finishedRequests.clear();
+                if (requestsFinished)
+                {
+                    _requestFinished();
                 }
 
                 // Logging.
@@ -361,11 +396,17 @@ namespace tl
                 data.time = request->time;
                 if (request->future.valid())
                 {
-                    data = request->future.get();
+                    request->future.wait();
+                    data = request->videoData;
                 }
                 request->promise.set_value(data);
             }
+            const bool requestsFinished = !p.thread.videoRequestsInProgress.empty();
             p.thread.videoRequestsInProgress.clear();
+            if (requestsFinished)
+            {
+                _requestFinished();
+            }
         }
 
         void ISequenceRead::_cancelRequests()
@@ -386,6 +427,10 @@ namespace tl
             {
                 request->promise.set_value(VideoData());
             }
+            if (!infoRequests.empty() || !videoRequests.empty())
+            {
+                _requestFinished();
+            }
         }
 
         void ISequenceRead::Private::addTags(Info& info)
@@ -40,13 +40,18 @@ namespace tl
                 otime::RationalTime time = time::invalidTime;
                 Options options;
                 std::promise<VideoData> promise;
-                std::future<VideoData> future;
+                std::future<void> future;
+
+                // Set by the read task when it has finished.
+                VideoData videoData;
+                bool finished = false;
             };
 
             struct Mutex
             {
                 std::list<std::shared_ptr<InfoRequest> > infoRequests;
                 std::list<std::shared_ptr<VideoRequest> > videoRequests;
+                bool videoRequestsFinished = false;
                 bool stopped = false;
                 std::mutex mutex;
             };
@@ -9,8 +9,12 @@
 #include <tlCore/LogSystem.h>
 #include <tlCore/StringFormat.h>
 
+#include <condition_variable>
 #include <cstring>
+#include <list>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 namespace tl
 {
@@ -25,6 +29,31 @@ namespace tl
             std::string extension;
 
             float defaultSpeed = sequenceDefaultSpeed;
+            size_t threadCount = sequenceWriteThreadCount;
+            size_t byteCount = sequenceWriteByteCount;
+
+            struct Request
+            {
+                std::string fileName;
+                otime::RationalTime time = time::invalidTime;
+                std::shared_ptr<image::Image> image;
+                Options options;
+            };
+
+            struct Mutex
+            {
+                std::list<Request> requests;
+                size_t inFlightCount = 0;
+                size_t inFlightByteCount = 0;
+                std::vector<SequenceWriteError> errors;
+                size_t errorsReported = 0;
+                bool stopped = false;
+                mutable std::mutex mutex;
+            };
+            Mutex mutex;
+            std::condition_variable requestCV;
+            std::condition_variable doneCV;
+            std::vector<std::thread> threads;
         };
 
         void ISequenceWrite::_init(
@@ -37,12 +66,33 @@ namespace tl
 
             TLRENDER_P();
 
-            const auto i = options.find("SequenceIO/DefaultSpeed");
+            auto i = options.find("SequenceIO/DefaultSpeed");
             if (i != options.end())
             {
                 std::stringstream ss(i->second);
                 ss >> p.defaultSpeed;
             }
+            i = options.find("SequenceIO/WriteThreadCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.threadCount;
+            }
+            i = options.find("SequenceIO/WriteByteCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.byteCount;
+            }
+
+            for (size_t j = 0; j < p.threadCount; ++j)
+            {
+                p.threads.push_back(std::thread(
+                    [this]
+                    {
+                        _thread();
+                    }));
+            }
         }
 
         ISequenceWrite::ISequenceWrite() :
@@ -57,11 +107,181 @@ namespace tl
             const std::shared_ptr<image::Image>& image,
             const Options& options)
         {
-            _writeVideo(
-                _path.get(static_cast<int>(time.value())),
-                time,
-                image,
-                merge(options, _options));
+            TLRENDER_P();
+            const std::string fileName = _path.get(static_cast<int>(time.value()));
+            if (p.threads.empty())
+            {
+                _writeVideo(
+                    fileName,
+                    time,
+                    image,
+                    merge(options, _options));
+                return;
+            }
+
+            // The caller is free to re-use the image after this call
+            // returns, so the threads write a copy.
+            Private::Request request;
+            request.fileName = fileName;
+            request.time = time;
+            request.image = image::Image::create(image->getInfo());
+            request.image->setTags(image->getTags());
+            memcpy(
+                request.image->getData(),
+                image->getData(),
+                image->getDataByteCount());
+            request.options = merge(options, _options);
+            const size_t byteCount = image->getDataByteCount();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+
+                // Always allow at least one frame in flight so images
+                // larger than the budget can still be written.
+                p.doneCV.wait(
+                    lock,
+                    [this, byteCount]
+                    {
+                        return
+                            0 == _p->mutex.inFlightCount ||
+                            _p->mutex.inFlightByteCount + byteCount <= _p->byteCount;
+                    });
+                p.mutex.requests.push_back(std::move(request));
+                ++p.mutex.inFlightCount;
+                p.mutex.inFlightByteCount += byteCount;
+            }
+            p.requestCV.notify_one();
+        }
+
+        void ISequenceWrite::flush()
+        {
+            TLRENDER_P();
+            wait();
+            std::vector<SequenceWriteError> errors;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                errors.insert(
+                    errors.end(),
+                    p.mutex.errors.begin() + p.mutex.errorsReported,
+                    p.mutex.errors.end());
+                p.mutex.errorsReported = p.mutex.errors.size();
+            }
+            if (!errors.empty())
+            {
+                throw std::runtime_error(string::Format(
+                    "{0} frame(s) failed to write, first error: {1}: {2}").
+                    arg(errors.size()).
+                    arg(errors.front().fileName).
+                    arg(errors.front().message));
+            }
+        }
+
+        void ISequenceWrite::wait()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.doneCV.wait(
+                lock,
+                [this]
+                {
+                    return 0 == _p->mutex.inFlightCount;
+                });
+        }
+
+        std::vector<SequenceWriteError> ISequenceWrite::getErrors() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.errors;
+        }
+
+        void ISequenceWrite::_finish()
+        {
+            TLRENDER_P();
+            if (p.threads.empty())
+                return;
+            wait();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.stopped = true;
+            }
+            p.requestCV.notify_all();
+            for (auto& thread : p.threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            p.threads.clear();
+
+            // Report any errors that were not picked up by flush().
+            if (auto logSystem = _logSystem.lock())
+            {
+                for (size_t i = p.mutex.errorsReported; i < p.mutex.errors.size(); ++i)
+                {
+                    const auto& error = p.mutex.errors[i];
+                    logSystem->print(
+                        "tl::io::ISequenceWrite",
+                        string::Format("{0}: {1}").
+                            arg(error.fileName).
+                            arg(error.message),
+                        log::Type::Error);
+                }
+            }
+            p.mutex.errorsReported = p.mutex.errors.size();
+        }
+
+        void ISequenceWrite::_thread()
+        {
+            TLRENDER_P();
+            while (true)
+            {
+                Private::Request request;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.requestCV.wait(
+                        lock,
+                        [this]
+                        {
+                            return
+                                !_p->mutex.requests.empty() ||
+                                _p->mutex.stopped;
+                        });
+                    if (p.mutex.requests.empty())
+                        break;
+                    request = std::move(p.mutex.requests.front());
+                    p.mutex.requests.pop_front();
+                }
+
+                std::string message;
+                try
+                {
+                    _writeVideo(
+                        request.fileName,
+                        request.time,
+                        request.image,
+                        request.options);
+                }
+                catch (const std::exception& e)
+                {
+                    message = e.what();
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    if (!message.empty())
+                    {
+                        SequenceWriteError error;
+                        error.time = request.time;
+                        error.fileName = request.fileName;
+                        error.message = message;
+                        p.mutex.errors.push_back(error);
+                    }
+                    --p.mutex.inFlightCount;
+                    p.mutex.inFlightByteCount -= request.image->getDataByteCount();
+                }
+                p.doneCV.notify_all();
+            }
         }
     }
 }
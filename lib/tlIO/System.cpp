@@ -217,6 +217,35 @@ namespace tl
             return nullptr;
         }
 
+        bool System::getInfo(
+            const file::Path& path,
+            const std::vector<file::MemoryRead>& memory,
+            const Options& options,
+            Info& out)
+        {
+            TLRENDER_P();
+            std::string key;
+            if (memory.empty())
+            {
+                key = getInfoCacheKey(path, options);
+                if (p.cache->getInfo(key, out))
+                {
+                    return true;
+                }
+            }
+            auto read = this->read(path, memory, options);
+            if (!read)
+            {
+                return false;
+            }
+            out = read->getInfo().get();
+            if (!key.empty() && (!out.video.empty() || out.audio.isValid()))
+            {
+                p.cache->addInfo(key, out);
+            }
+            return true;
+        }
+
         std::shared_ptr<IWrite> System::write(
             const file::Path& path,
             const Info& info,
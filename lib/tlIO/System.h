@@ -67,6 +67,16 @@ namespace tl
                 const std::vector<file::MemoryRead>&,
                 const Options& = Options());
 
+            //! Get the information for the given path. The I/O cache is
+            //! checked first and the path is only opened if the information
+            //! is not cached. Paths read from memory are not cached. Returns
+            //! false if no plugin can read the path.
+            bool getInfo(
+                const file::Path&,
+                const std::vector<file::MemoryRead>&,
+                const Options&,
+                Info&);
+
             //! Create a writer for the given path.
             std::shared_ptr<IWrite> write(
                 const file::Path&,
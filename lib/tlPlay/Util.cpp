@@ -49,5 +49,25 @@ namespace tl
                 arg(TLRENDER_VERSION);
             return file::Path(appDirPath, fileName).get();
         }
+
+        std::string infoCacheName(
+            const std::string& appName,
+            const std::string& appDirPath)
+        {
+            const std::string fileName = string::Format("{0}.{1}.info.json").
+                arg(appName).
+                arg(TLRENDER_VERSION);
+            return file::Path(appDirPath, fileName).get();
+        }
+
+        std::string shaderCacheName(
+            const std::string& appName,
+            const std::string& appDirPath)
+        {
+            const std::string fileName = string::Format("{0}.{1}.shaders").
+                arg(appName).
+                arg(TLRENDER_VERSION);
+            return file::Path(appDirPath, fileName).get();
+        }
     }
 }
@@ -24,5 +24,15 @@ namespace tl
         std::string settingsName(
             const std::string& appName,
             const std::string& appDirPath);
+
+        //! Get the I/O information cache file name.
+        std::string infoCacheName(
+            const std::string& appName,
+            const std::string& appDirPath);
+
+        //! Get the shader cache directory name.
+        std::string shaderCacheName(
+            const std::string& appName,
+            const std::string& appDirPath);
     }
 }
@@ -23,8 +23,12 @@
 #include <tlUI/FileBrowser.h>
 #include <tlUI/RecentFilesModel.h>
 
+#include <tlTimelineGL/OCIOCache.h>
+
 #include <tlTimeline/Util.h>
 
+#include <tlGL/ShaderCache.h>
+
 #if defined(TLRENDER_BMD)
 #include <tlDevice/BMDDevicesModel.h>
 #include <tlDevice/BMDOutputDevice.h>
@@ -47,6 +51,9 @@ namespace tl
             std::shared_ptr<file::FileLogSystem> fileLogSystem;
             std::string settingsFileName;
             std::shared_ptr<play::Settings> settings;
+            std::string infoCacheFileName;
+            std::shared_ptr<gl::ShaderCache> shaderCache;
+            std::shared_ptr<timeline_gl::OCIOCache> ocioCache;
             std::shared_ptr<play::FilesModel> filesModel;
             std::vector<std::shared_ptr<play::FilesModelItem> > files;
             std::vector<std::shared_ptr<play::FilesModelItem> > activeFiles;
@@ -121,6 +128,9 @@ namespace tl
 
             _fileLogInit(logFileName);
             _settingsInit(settingsFileName);
+            _infoCacheInit(play::infoCacheName(appName, appDocsPath));
+            p.shaderCache = gl::ShaderCache::create(play::shaderCacheName(appName, appDocsPath));
+            p.ocioCache = timeline_gl::OCIOCache::create();
             _modelsInit();
             _devicesInit();
             _observersInit();
@@ -141,6 +151,21 @@ namespace tl
                 p.settings->setValue("FileBrowser/Path", fileBrowserSystem->getPath());
                 p.settings->setValue("FileBrowser/Options", fileBrowserSystem->getOptions());
             }
+            if (!p.infoCacheFileName.empty())
+            {
+                try
+                {
+                    auto ioSystem = _context->getSystem<io::System>();
+                    ioSystem->getCache()->writeInfo(p.infoCacheFileName);
+                }
+                catch (const std::exception& e)
+                {
+                    _log(string::Format("Cannot write information cache: {0}: {1}").
+                        arg(p.infoCacheFileName).
+                        arg(e.what()),
+                        log::Type::Error);
+                }
+            }
         }
 
         std::shared_ptr<App> App::create(
@@ -240,6 +265,16 @@ namespace tl
             return _p->toolsModel;
         }
 
+        const std::shared_ptr<gl::ShaderCache>& App::getShaderCache() const
+        {
+            return _p->shaderCache;
+        }
+
+        const std::shared_ptr<timeline_gl::OCIOCache>& App::getOCIOCache() const
+        {
+            return _p->ocioCache;
+        }
+
         const std::shared_ptr<MainWindow>& App::getMainWindow() const
         {
             return _p->mainWindow;
@@ -349,6 +384,27 @@ namespace tl
             p.fileLogSystem = file::FileLogSystem::create(logFileName2, _context);
         }
 
+        void App::_infoCacheInit(const std::string& infoCacheFileName)
+        {
+            TLRENDER_P();
+            p.infoCacheFileName = infoCacheFileName;
+            if (file::exists(p.infoCacheFileName))
+            {
+                try
+                {
+                    auto ioSystem = _context->getSystem<io::System>();
+                    ioSystem->getCache()->readInfo(p.infoCacheFileName);
+                }
+                catch (const std::exception& e)
+                {
+                    _log(string::Format("Cannot read information cache: {0}: {1}").
+                        arg(p.infoCacheFileName).
+                        arg(e.what()),
+                        log::Type::Error);
+                }
+            }
+        }
+
         void App::_settingsInit(const std::string& settingsFileName)
         {
             TLRENDER_P();
@@ -418,6 +474,7 @@ namespace tl
                 timeline::PlayerOptions().audioBufferFrameCount);
             p.settings->setDefaultValue("Performance/VideoRequestCount", 16);
             p.settings->setDefaultValue("Performance/AudioRequestCount", 16);
+            p.settings->setDefaultValue("Performance/TextureUploadCount", 4);
 
             p.settings->setDefaultValue("OpenGL/ShareContexts", true);
 
@@ -939,6 +996,8 @@ namespace tl
                                     p.settings->getValue<timeline::TimerMode>("Performance/TimerMode");
                                 playerOptions.audioBufferFrameCount =
                                     p.settings->getValue<size_t>("Performance/AudioBufferFrameCount");
+                                playerOptions.readAheadVideoCount =
+                                    p.settings->getValue<size_t>("Performance/TextureUploadCount");
                                 player = timeline::Player::create(timeline, _context, playerOptions);
                             }
                             catch (const std::exception& e)
@@ -18,6 +18,16 @@ namespace tl
     }
 #endif // TLRENDER_BMD
 
+    namespace gl
+    {
+        class ShaderCache;
+    }
+
+    namespace timeline_gl
+    {
+        class OCIOCache;
+    }
+
     namespace ui
     {
         class RecentFilesModel;
@@ -96,6 +106,12 @@ namespace tl
             //! Get the tools model.
             const std::shared_ptr<ToolsModel>& getToolsModel() const;
 
+            //! Get the shader cache.
+            const std::shared_ptr<gl::ShaderCache>& getShaderCache() const;
+
+            //! Get the OpenColorIO cache.
+            const std::shared_ptr<timeline_gl::OCIOCache>& getOCIOCache() const;
+
             //! Get the main window.
             const std::shared_ptr<MainWindow>& getMainWindow() const;
 
@@ -119,6 +135,7 @@ namespace tl
         private:
             void _fileLogInit(const std::string&);
             void _settingsInit(const std::string&);
+            void _infoCacheInit(const std::string&);
             void _modelsInit();
             void _devicesInit();
             void _observersInit();
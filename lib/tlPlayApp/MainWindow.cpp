@@ -64,8 +64,13 @@
 #include <tlDevice/BMDOutputDevice.h>
 #endif // TLRENDER_BMD
 
+#include <tlTimelineGL/ShaderCompiler.h>
+#include <tlTimelineGL/TextureStream.h>
+
 #include <tlTimeline/TimeUnits.h>
 
+#include <tlGL/GLFWWindow.h>
+
 #include <tlCore/Timer.h>
 
 namespace tl
@@ -101,6 +106,8 @@ namespace tl
             std::shared_ptr<ui::DoubleModel> speedModel;
             timelineui::ItemOptions itemOptions;
             std::shared_ptr<timeline::Player> player;
+            std::shared_ptr<timeline_gl::TextureStream> textureStream;
+            std::shared_ptr<timeline_gl::ShaderCompiler> shaderCompiler;
 
             std::shared_ptr<Viewport> viewport;
             std::shared_ptr<timelineui::TimelineWidget> timelineWidget;
@@ -157,6 +164,7 @@ namespace tl
             std::shared_ptr<observer::ValueObserver<double> > speedObserver2;
             std::shared_ptr<observer::ValueObserver<timeline::Playback> > playbackObserver;
             std::shared_ptr<observer::ValueObserver<otime::RationalTime> > currentTimeObserver;
+            std::shared_ptr<observer::ListObserver<timeline::VideoData> > readAheadVideoObserver;
             std::shared_ptr<observer::ValueObserver<timeline::CompareOptions> > compareOptionsObserver;
             std::shared_ptr<observer::ValueObserver<timeline::OCIOOptions> > ocioOptionsObserver;
             std::shared_ptr<observer::ValueObserver<timeline::LUTOptions> > lutOptionsObserver;
@@ -179,6 +187,17 @@ namespace tl
 
             p.app = app;
 
+            p.shaderCompiler = timeline_gl::ShaderCompiler::create(
+                gl::GLFWWindow::create(
+                    "tl::play_app::ShaderCompiler",
+                    math::Size2i(1, 1),
+                    context,
+                    static_cast<int>(gl::GLFWWindowOptions::None),
+                    getGLFWWindow()),
+                app->getShaderCache());
+            setShaderCompiler(p.shaderCompiler);
+            setOCIOCache(app->getOCIOCache());
+
             p.settings = app->getSettings();
             p.settings->setDefaultValue("Window/Options", WindowOptions());
             p.settings->setDefaultValue("Timeline/Input",
@@ -761,6 +780,7 @@ namespace tl
             p.speedObserver.reset();
             p.playbackObserver.reset();
             p.currentTimeObserver.reset();
+            p.readAheadVideoObserver.reset();
 
             p.player = value;
 
@@ -794,15 +814,50 @@ namespace tl
                     {
                         _p->currentTimeEdit->setValue(value);
                     });
+
+                p.readAheadVideoObserver = observer::ListObserver<timeline::VideoData>::create(
+                    p.player->observeReadAheadVideo(),
+                    [this](const std::vector<timeline::VideoData>& value)
+                    {
+                        _readAheadVideoUpdate(value);
+                    });
             }
             else
             {
+                _readAheadVideoUpdate({});
                 p.speedModel->setValue(0.0);
                 p.playbackButtonGroup->setChecked(0, true);
                 p.currentTimeEdit->setValue(time::invalidTime);
             }
         }
 
+        void MainWindow::_readAheadVideoUpdate(const std::vector<timeline::VideoData>& value)
+        {
+            TLRENDER_P();
+
+            // The texture stream and the window that provides its OpenGL
+            // context are only created once there is video to stream.
+            if (!p.textureStream && !value.empty())
+            {
+                if (auto context = _context.lock())
+                {
+                    p.textureStream = timeline_gl::TextureStream::create(
+                        gl::GLFWWindow::create(
+                            "tl::play_app::TextureStream",
+                            math::Size2i(1, 1),
+                            context,
+                            static_cast<int>(gl::GLFWWindowOptions::None),
+                            getGLFWWindow()),
+                        context->getLogSystem());
+                    setTextureStream(p.textureStream);
+                }
+            }
+            if (p.textureStream)
+            {
+                p.textureStream->setVideo(value);
+            }
+        }
+
         void MainWindow::_showSpeedPopup()
         {
             TLRENDER_P();
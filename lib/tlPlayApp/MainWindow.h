@@ -85,6 +85,7 @@ namespace tl
 
         private:
             void _playerUpdate(const std::shared_ptr<timeline::Player>&);
+            void _readAheadVideoUpdate(const std::vector<timeline::VideoData>&);
             void _showSpeedPopup();
             void _showAudioPopup();
             void _windowOptionsUpdate();
@@ -41,6 +41,9 @@ namespace tl
             Window::_init("tlplay 2", context, shareContexts ? window : nullptr);
             TLRENDER_P();
 
+            setShaderCache(app->getShaderCache());
+            setOCIOCache(app->getOCIOCache());
+
             p.viewport = timelineui::TimelineViewport::create(context);
             p.viewport->setParent(shared_from_this());
 
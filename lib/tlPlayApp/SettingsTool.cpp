@@ -726,6 +726,7 @@ namespace tl
             std::shared_ptr<ui::IntEdit> audioBufferFramesEdit;
             std::shared_ptr<ui::IntEdit> videoRequestsEdit;
             std::shared_ptr<ui::IntEdit> audioRequestsEdit;
+            std::shared_ptr<ui::IntEdit> textureUploadsEdit;
             std::shared_ptr<ui::VerticalLayout> layout;
 
             std::shared_ptr<observer::ValueObserver<std::string> > settingsObserver;
@@ -755,6 +756,9 @@ namespace tl
             p.audioRequestsEdit = ui::IntEdit::create(context);
             p.audioRequestsEdit->setRange(math::IntRange(1, 64));
 
+            p.textureUploadsEdit = ui::IntEdit::create(context);
+            p.textureUploadsEdit->setRange(math::IntRange(0, 16));
+
             p.layout = ui::VerticalLayout::create(context, shared_from_this());
             p.layout->setMarginRole(ui::SizeRole::MarginSmall);
             p.layout->setSpacingRole(ui::SizeRole::SpacingSmall);
@@ -777,6 +781,10 @@ namespace tl
             gridLayout->setGridPos(label, 3, 0);
             p.audioRequestsEdit->setParent(gridLayout);
             gridLayout->setGridPos(p.audioRequestsEdit, 3, 1);
+            label = ui::Label::create("Texture uploads:", context, gridLayout);
+            gridLayout->setGridPos(label, 4, 0);
+            p.textureUploadsEdit->setParent(gridLayout);
+            gridLayout->setGridPos(p.textureUploadsEdit, 4, 1);
 
             _settingsUpdate(std::string());
 
@@ -812,6 +820,12 @@ namespace tl
                 {
                     _p->settings->setValue("Performance/AudioRequestCount", value);
                 });
+
+            p.textureUploadsEdit->setCallback(
+                [this](int value)
+                {
+                    _p->settings->setValue("Performance/TextureUploadCount", value);
+                });
         }
 
         PerformanceSettingsWidget::PerformanceSettingsWidget() :
@@ -866,6 +880,11 @@ namespace tl
                 p.audioRequestsEdit->setValue(
                     p.settings->getValue<size_t>("Performance/AudioRequestCount"));
             }
+            if ("Performance/TextureUploadCount" == name || name.empty())
+            {
+                p.textureUploadsEdit->setValue(
+                    p.settings->getValue<size_t>("Performance/TextureUploadCount"));
+            }
         }
 
         struct OpenGLSettingsWidget::Private
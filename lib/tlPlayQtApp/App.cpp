@@ -45,6 +45,7 @@
 #endif // TLRENDER_USD
 
 #include <tlCore/AudioSystem.h>
+#include <tlCore/File.h>
 #include <tlCore/FileLogSystem.h>
 #include <tlCore/Math.h>
 #include <tlCore/StringFormat.h>
@@ -70,6 +71,7 @@ namespace tl
             std::shared_ptr<file::FileLogSystem> fileLogSystem;
             std::string settingsFileName;
             std::shared_ptr<play::Settings> settings;
+            std::string infoCacheFileName;
             std::shared_ptr<timeline::TimeUnitsModel> timeUnitsModel;
             QScopedPointer<qt::TimeObject> timeObject;
             std::shared_ptr<play::FilesModel> filesModel;
@@ -154,6 +156,7 @@ namespace tl
 
             _fileLogInit(logFileName);
             _settingsInit(settingsFileName);
+            _infoCacheInit(play::infoCacheName(appName, appDocsPath));
             _modelsInit();
             _devicesInit();
             _observersInit();
@@ -167,7 +170,24 @@ namespace tl
         }
 
         App::~App()
-        {}
+        {
+            TLRENDER_P();
+            if (!p.infoCacheFileName.empty())
+            {
+                try
+                {
+                    auto ioSystem = _context->getSystem<io::System>();
+                    ioSystem->getCache()->writeInfo(p.infoCacheFileName);
+                }
+                catch (const std::exception& e)
+                {
+                    _log(string::Format("Cannot write information cache: {0}: {1}").
+                        arg(p.infoCacheFileName).
+                        arg(e.what()),
+                        log::Type::Error);
+                }
+            }
+        }
 
         const std::shared_ptr<timeline::TimeUnitsModel>& App::timeUnitsModel() const
         {
@@ -332,6 +352,27 @@ namespace tl
             p.fileLogSystem = file::FileLogSystem::create(logFileName2, _context);
         }
 
+        void App::_infoCacheInit(const std::string& infoCacheFileName)
+        {
+            TLRENDER_P();
+            p.infoCacheFileName = infoCacheFileName;
+            if (file::exists(p.infoCacheFileName))
+            {
+                try
+                {
+                    auto ioSystem = _context->getSystem<io::System>();
+                    ioSystem->getCache()->readInfo(p.infoCacheFileName);
+                }
+                catch (const std::exception& e)
+                {
+                    _log(string::Format("Cannot read information cache: {0}: {1}").
+                        arg(p.infoCacheFileName).
+                        arg(e.what()),
+                        log::Type::Error);
+                }
+            }
+        }
+
         void App::_settingsInit(const std::string& settingsFileName)
         {
             TLRENDER_P();
@@ -132,6 +132,7 @@ namespace tl
         private:
             void _fileLogInit(const std::string&);
             void _settingsInit(const std::string&);
+            void _infoCacheInit(const std::string&);
             void _modelsInit();
             void _devicesInit();
             void _observersInit();
@@ -434,6 +434,7 @@ namespace tl
 
                     if (p.buffer)
                     {
+                        p.render->flush();
                         gl::OffscreenBufferBinding binding(p.buffer);
                         timeline::RenderOptions renderOptions;
                         renderOptions.colorBuffer = p.colorBuffer;
@@ -454,6 +454,7 @@ namespace tl
 
                     if (p.render && p.buffer)
                     {
+                        p.render->flush();
                         gl::OffscreenBufferBinding binding(p.buffer);
                         timeline::RenderOptions renderOptions;
                         renderOptions.clearColor = p.style->getColorRole(ui::ColorRole::Window);
@@ -5,9 +5,18 @@
 #include <tlTimeline/Edit.h>
 
 #include <tlTimeline/MemoryReference.h>
+#include <tlTimeline/TrackIndex.h>
+#include <tlTimeline/Util.h>
 
 #include <tlCore/StringFormat.h>
 
+#include <opentimelineio/gap.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+
 namespace tl
 {
     namespace timeline
@@ -181,6 +190,7 @@ namespace tl
                 {
                     RawMemoryData::_init(value);
                     _file_io = value->file_io();
+                    _compressed_data = value->compressed_data();
                 }
 
                 ZipMemoryData()
@@ -201,11 +211,13 @@ namespace tl
                     if (auto ref = dynamic_cast<ZipMemoryReference*>(value))
                     {
                         ref->set_file_io(_file_io);
+                        ref->set_compressed_data(_compressed_data);
                     }
                 }
 
             private:
                 std::shared_ptr<file::FileIO> _file_io;
+                std::shared_ptr<ZipCompressedData> _compressed_data;
             };
 
             class ZipMemorySequenceData : public RawMemorySequenceData
@@ -215,6 +227,7 @@ namespace tl
                 {
                     RawMemorySequenceData::_init(value);
                     _file_io = value->file_io();
+                    _compressed_data = value->compressed_data();
                 }
 
                 ZipMemorySequenceData()
@@ -233,14 +246,16 @@ namespace tl
                 void copy(otio::MediaReference* value) override
                 {
                     RawMemorySequenceData::copy(value);
-                    if (auto ref = dynamic_cast<ZipMemoryReference*>(value))
+                    if (auto ref = dynamic_cast<ZipMemorySequenceReference*>(value))
                     {
                         ref->set_file_io(_file_io);
+                        ref->set_compressed_data(_compressed_data);
                     }
                 }
 
             private:
                 std::shared_ptr<file::FileIO> _file_io;
+                std::shared_ptr<ZipCompressedData> _compressed_data;
             };
         }
 
@@ -349,5 +364,451 @@ namespace tl
             }
             return out;
         }
+
+        namespace
+        {
+            // Tolerance for comparing times converted to seconds.
+            const double epsilon = 1.0 / 100000.0;
+
+            std::string getKey(const otio::Item* item)
+            {
+                std::string out;
+                if (auto clip = dynamic_cast<const otio::Clip*>(item))
+                {
+                    std::stringstream ss;
+                    ss << "Clip\n" << clip->name() << "\n" << clip->enabled() << "\n";
+                    if (auto ref = clip->media_reference())
+                    {
+                        ss << ref->to_json_string() << "\n";
+                    }
+                    for (const auto& effect : clip->effects())
+                    {
+                        ss << effect->to_json_string() << "\n";
+                    }
+                    out = ss.str();
+                }
+                else if (!dynamic_cast<const otio::Gap*>(item))
+                {
+                    // Other items, like nested stacks, only match themselves.
+                    std::stringstream ss;
+                    ss << "Item\n" << item;
+                    out = ss.str();
+                }
+                return out;
+            }
+
+            struct Segment
+            {
+                std::string key;
+                std::string transitions;
+                double offset = 0.0;
+                double start = 0.0;
+                double end = 0.0;
+                double inEnd = 0.0;
+                double outStart = 0.0;
+            };
+
+            struct TrackData
+            {
+                bool enabled = true;
+                TrackIndex index;
+                std::vector<Segment> segments;
+                std::map<std::string, std::vector<size_t> > keys;
+            };
+
+            TrackData getTrackData(const TrackIndex& index)
+            {
+                TrackData out;
+                out.enabled = index.getTrack() && index.getTrack()->enabled();
+                out.index = index;
+                const auto& items = out.index.getItems();
+                std::map<const otio::Item*, size_t> itemToSegment;
+                for (size_t i = 0; i < items.size(); ++i)
+                {
+                    const auto& item = items[i];
+                    Segment segment;
+                    segment.key = getKey(item.item);
+                    segment.start = item.range.start_time().to_seconds();
+                    segment.end = item.range.end_time_exclusive().to_seconds();
+                    if (item.clip)
+                    {
+                        segment.offset = item.clip->trimmed_range().start_time().to_seconds() - segment.start;
+                    }
+                    segment.inEnd = segment.start;
+                    segment.outStart = segment.end;
+                    if (item.inTransition)
+                    {
+                        segment.inEnd += item.inTransition->out_offset().to_seconds();
+                    }
+                    if (item.outTransition)
+                    {
+                        segment.outStart -= item.outTransition->in_offset().to_seconds();
+                    }
+                    out.segments.push_back(segment);
+                    out.keys[segment.key].push_back(i);
+                    itemToSegment[item.item] = i;
+                }
+
+                // The transitions depend on the neighbouring clips.
+                for (size_t i = 0; i < items.size(); ++i)
+                {
+                    const auto& item = items[i];
+                    std::stringstream ss;
+                    const std::vector<std::pair<otio::Transition*, otio::Clip*> > transitions =
+                    {
+                        { item.inTransition, item.inClip },
+                        { item.outTransition, item.outClip }
+                    };
+                    for (const auto& transition : transitions)
+                    {
+                        if (transition.first)
+                        {
+                            ss << transition.first->transition_type() << " " <<
+                                transition.first->in_offset().to_seconds() << " " <<
+                                transition.first->out_offset().to_seconds() << "\n";
+                            const auto j = itemToSegment.find(transition.second);
+                            if (j != itemToSegment.end())
+                            {
+                                const auto& segment = out.segments[j->second];
+                                ss << segment.key << segment.offset << "\n";
+                            }
+                        }
+                    }
+                    out.segments[i].transitions = ss.str();
+                }
+                return out;
+            }
+
+            const Segment* getSegment(const TrackData& track, double seconds)
+            {
+                const Segment* out = nullptr;
+                std::vector<const TrackIndexItem*> items;
+                track.index.find(seconds, seconds, items);
+                const auto& indexItems = track.index.getItems();
+                for (const auto item : items)
+                {
+                    const auto& segment = track.segments[item - indexItems.data()];
+                    if (seconds >= segment.start && seconds < segment.end)
+                    {
+                        out = &segment;
+                        break;
+                    }
+                }
+                return out;
+            }
+
+            bool isEmpty(const Segment* value)
+            {
+                return !value || (value->key.empty() && value->transitions.empty());
+            }
+
+            bool isSame(
+                const Segment* a,
+                double aSeconds,
+                const Segment* b,
+                double bSeconds)
+            {
+                const bool aEmpty = isEmpty(a);
+                const bool bEmpty = isEmpty(b);
+                if (aEmpty || bEmpty)
+                    return aEmpty && bEmpty;
+                if (a->key != b->key || a->transitions != b->transitions)
+                    return false;
+
+                // Compare the media times, or for gaps the times relative
+                // to the start of the gap.
+                const double aTime = aSeconds + (a->key.empty() ? -a->start : a->offset);
+                const double bTime = bSeconds + (b->key.empty() ? -b->start : b->offset);
+                if (std::fabs(aTime - bTime) > epsilon)
+                    return false;
+
+                // Compare the positions within the transitions.
+                const bool aIn = aSeconds < a->inEnd;
+                const bool bIn = bSeconds < b->inEnd;
+                if (aIn != bIn ||
+                    (aIn && std::fabs((aSeconds - a->start) - (bSeconds - b->start)) > epsilon))
+                    return false;
+                const bool aOut = aSeconds >= a->outStart;
+                const bool bOut = bSeconds >= b->outStart;
+                if (aOut != bOut ||
+                    (aOut && std::fabs((a->end - aSeconds) - (b->end - bSeconds)) > epsilon))
+                    return false;
+                return true;
+            }
+
+            std::vector<std::pair<double, double> > getChanged(
+                const std::vector<TrackData>& from,
+                const std::vector<TrackData>& to)
+            {
+                std::vector<std::pair<double, double> > ranges;
+                for (size_t i = 0; i < from.size() && i < to.size(); ++i)
+                {
+                    std::vector<double> times = { 0.0 };
+                    for (const auto* track : { &from[i], &to[i] })
+                    {
+                        for (const auto& segment : track->segments)
+                        {
+                            times.push_back(segment.start);
+                            times.push_back(segment.end);
+                            times.push_back(segment.inEnd);
+                            times.push_back(segment.outStart);
+                        }
+                    }
+                    std::sort(times.begin(), times.end());
+                    times.erase(std::unique(times.begin(), times.end()), times.end());
+                    for (size_t j = 0; j + 1 < times.size(); ++j)
+                    {
+                        const double t = (times[j] + times[j + 1]) / 2.0;
+                        if (!isSame(getSegment(from[i], t), t, getSegment(to[i], t), t))
+                        {
+                            ranges.push_back(std::make_pair(times[j], times[j + 1]));
+                        }
+                    }
+                }
+
+                // Merge the ranges.
+                std::sort(ranges.begin(), ranges.end());
+                std::vector<std::pair<double, double> > out;
+                for (const auto& range : ranges)
+                {
+                    if (!out.empty() && range.first <= out.back().second + epsilon)
+                    {
+                        out.back().second = std::max(out.back().second, range.second);
+                    }
+                    else
+                    {
+                        out.push_back(range);
+                    }
+                }
+                return out;
+            }
+
+            bool contains(
+                const std::vector<std::pair<double, double> >& ranges,
+                double start,
+                double end)
+            {
+                // The ranges are sorted and do not overlap, so only the last
+                // range that starts before the end can intersect.
+                auto i = std::lower_bound(
+                    ranges.begin(),
+                    ranges.end(),
+                    end,
+                    [](const std::pair<double, double>& a, double b)
+                    {
+                        return a.first < b;
+                    });
+                return i != ranges.begin() && (i - 1)->second > start;
+            }
+
+            std::vector<otime::TimeRange> toTimeRanges(
+                const std::vector<std::pair<double, double> >& ranges,
+                const otime::RationalTime& start,
+                double rate)
+            {
+                std::vector<otime::TimeRange> out;
+                for (const auto& range : ranges)
+                {
+                    const double a = std::floor((start.to_seconds() + range.first) * rate + epsilon);
+                    const double b = std::ceil((start.to_seconds() + range.second) * rate - epsilon);
+                    out.push_back(otime::TimeRange(
+                        otime::RationalTime(a, rate),
+                        otime::RationalTime(b - a, rate)));
+                }
+                return out;
+            }
+        }
+
+        struct EditDiff::Private
+        {
+            bool allChanged = true;
+            otime::RationalTime start = time::invalidTime;
+            std::vector<TrackData> fromVideo;
+            std::vector<TrackData> toVideo;
+            std::vector<std::pair<double, double> > videoChanged;
+            std::vector<std::pair<double, double> > audioChanged;
+            std::vector<otime::TimeRange> videoRanges;
+            std::vector<otime::TimeRange> audioRanges;
+        };
+
+        void EditDiff::_init(
+            const otio::SerializableObject::Retainer<otio::Timeline>& from,
+            const otio::SerializableObject::Retainer<otio::Timeline>& to)
+        {
+            TLRENDER_P();
+            if (!to.value)
+                return;
+            const otime::TimeRange toRange = getTimeRange(to.value);
+            if (!time::isValid(toRange))
+                return;
+            const double rate = toRange.duration().rate();
+            p.start = toRange.start_time();
+
+            // Tracks can only be compared between different timelines with
+            // the same structure, timelines edited in place are considered
+            // to have changed everywhere.
+            bool valid = from.value && from.value != to.value;
+            otime::TimeRange fromRange = time::invalidTimeRange;
+            if (valid)
+            {
+                fromRange = getTimeRange(from.value);
+                valid =
+                    time::isValid(fromRange) &&
+                    fromRange.start_time() == toRange.start_time();
+            }
+            std::vector<TrackData> fromAudio;
+            std::vector<TrackData> toAudio;
+            if (valid)
+            {
+                for (const auto& i : createTrackIndexes(from.value, otio::Track::Kind::video))
+                {
+                    p.fromVideo.push_back(getTrackData(i));
+                }
+                for (const auto& i : createTrackIndexes(to.value, otio::Track::Kind::video))
+                {
+                    p.toVideo.push_back(getTrackData(i));
+                }
+                for (const auto& i : createTrackIndexes(from.value, otio::Track::Kind::audio))
+                {
+                    fromAudio.push_back(getTrackData(i));
+                }
+                for (const auto& i : createTrackIndexes(to.value, otio::Track::Kind::audio))
+                {
+                    toAudio.push_back(getTrackData(i));
+                }
+                valid =
+                    p.fromVideo.size() == p.toVideo.size() &&
+                    fromAudio.size() == toAudio.size();
+                for (size_t i = 0; valid && i < p.fromVideo.size(); ++i)
+                {
+                    valid = p.fromVideo[i].enabled == p.toVideo[i].enabled;
+                }
+                for (size_t i = 0; valid && i < fromAudio.size(); ++i)
+                {
+                    valid = fromAudio[i].enabled == toAudio[i].enabled;
+                }
+            }
+
+            if (valid)
+            {
+                p.allChanged = false;
+                p.videoChanged = getChanged(p.fromVideo, p.toVideo);
+                p.audioChanged = getChanged(fromAudio, toAudio);
+            }
+            else
+            {
+                p.fromVideo.clear();
+                p.toVideo.clear();
+                double duration = toRange.duration().to_seconds();
+                if (time::isValid(fromRange))
+                {
+                    duration = std::max(duration, fromRange.duration().to_seconds());
+                }
+                p.videoChanged.push_back(std::make_pair(0.0, duration));
+                p.audioChanged.push_back(std::make_pair(0.0, duration));
+            }
+            p.videoRanges = toTimeRanges(p.videoChanged, p.start, rate);
+            p.audioRanges = toTimeRanges(p.audioChanged, p.start, rate);
+        }
+
+        EditDiff::EditDiff() :
+            _p(new Private)
+        {}
+
+        EditDiff::~EditDiff()
+        {}
+
+        std::shared_ptr<EditDiff> EditDiff::create(
+            const otio::SerializableObject::Retainer<otio::Timeline>& from,
+            const otio::SerializableObject::Retainer<otio::Timeline>& to)
+        {
+            auto out = std::shared_ptr<EditDiff>(new EditDiff);
+            out->_init(from, to);
+            return out;
+        }
+
+        bool EditDiff::isAllChanged() const
+        {
+            return _p->allChanged;
+        }
+
+        const std::vector<otime::TimeRange>& EditDiff::getVideoRanges() const
+        {
+            return _p->videoRanges;
+        }
+
+        const std::vector<otime::TimeRange>& EditDiff::getAudioRanges() const
+        {
+            return _p->audioRanges;
+        }
+
+        bool EditDiff::isVideoChanged(const otime::RationalTime& value) const
+        {
+            TLRENDER_P();
+            if (p.allChanged)
+                return true;
+            const double seconds = (value - p.start).to_seconds();
+            return contains(p.videoChanged, seconds, seconds + epsilon);
+        }
+
+        bool EditDiff::isAudioChanged(const otime::TimeRange& value) const
+        {
+            TLRENDER_P();
+            if (p.allChanged)
+                return true;
+            const double seconds = (value.start_time() - p.start).to_seconds();
+            return contains(p.audioChanged, seconds, seconds + value.duration().to_seconds());
+        }
+
+        otime::RationalTime EditDiff::mapVideo(const otime::RationalTime& value) const
+        {
+            TLRENDER_P();
+            if (p.allChanged)
+                return time::invalidTime;
+            const double seconds = (value - p.start).to_seconds();
+            if (!contains(p.videoChanged, seconds, seconds + epsilon))
+                return value;
+
+            // Find the clip on the first track with video at the given time
+            // in the edited timeline, and check whether all of the tracks
+            // show the same video at the new time.
+            for (size_t i = 0; i < p.fromVideo.size(); ++i)
+            {
+                const Segment* from = getSegment(p.fromVideo[i], seconds);
+                if (isEmpty(from))
+                    continue;
+                const auto j = p.toVideo[i].keys.find(from->key);
+                if (j != p.toVideo[i].keys.end())
+                {
+                    for (const size_t k : j->second)
+                    {
+                        const Segment& to = p.toVideo[i].segments[k];
+                        const double seconds2 = seconds + from->offset - to.offset;
+                        if (seconds2 < to.start || seconds2 >= to.end)
+                            continue;
+                        bool same = true;
+                        for (size_t l = 0; same && l < p.fromVideo.size(); ++l)
+                        {
+                            same = isSame(
+                                getSegment(p.fromVideo[l], seconds),
+                                seconds,
+                                getSegment(p.toVideo[l], seconds2),
+                                seconds2);
+                        }
+                        if (same)
+                        {
+                            const double frame = (p.start.to_seconds() + seconds2) * value.rate();
+                            const double frameRounded = std::round(frame);
+                            if (std::fabs(frame - frameRounded) < 0.01)
+                            {
+                                return otime::RationalTime(frameRounded, value.rate());
+                            }
+                        }
+                    }
+                }
+                break;
+            }
+            return time::invalidTime;
+        }
     }
 }
@@ -9,6 +9,8 @@
 #include <opentimelineio/clip.h>
 #include <opentimelineio/timeline.h>
 
+#include <memory>
+
 namespace tl
 {
     namespace timeline
@@ -32,5 +34,57 @@ namespace tl
         otio::SerializableObject::Retainer<otio::Timeline> move(
             const otio::SerializableObject::Retainer<otio::Timeline>&,
             const std::vector<MoveData>&);
+
+        //! Differences between a timeline and an edited version of it.
+        //!
+        //! The tracks of both timelines are compared item by item to find
+        //! the time ranges that are affected by the edit. Video frames
+        //! outside of those ranges are unchanged, and video frames of clips
+        //! that were moved can be mapped to their new times.
+        //!
+        //! If the timelines are the same object, or the tracks cannot be
+        //! matched, everything is considered changed.
+        class EditDiff : public std::enable_shared_from_this<EditDiff>
+        {
+            TLRENDER_NON_COPYABLE(EditDiff);
+
+        protected:
+            void _init(
+                const otio::SerializableObject::Retainer<otio::Timeline>& from,
+                const otio::SerializableObject::Retainer<otio::Timeline>& to);
+
+            EditDiff();
+
+        public:
+            ~EditDiff();
+
+            //! Create a new edit difference.
+            static std::shared_ptr<EditDiff> create(
+                const otio::SerializableObject::Retainer<otio::Timeline>& from,
+                const otio::SerializableObject::Retainer<otio::Timeline>& to);
+
+            //! Get whether everything changed.
+            bool isAllChanged() const;
+
+            //! Get the changed video time ranges.
+            const std::vector<otime::TimeRange>& getVideoRanges() const;
+
+            //! Get the changed audio time ranges.
+            const std::vector<otime::TimeRange>& getAudioRanges() const;
+
+            //! Get whether the video at the given time changed.
+            bool isVideoChanged(const otime::RationalTime&) const;
+
+            //! Get whether the audio in the given time range changed.
+            bool isAudioChanged(const otime::TimeRange&) const;
+
+            //! Map a time in the original timeline to the time in the edited
+            //! timeline that shows the same video frame. An invalid time is
+            //! returned if the frame is no longer in the timeline.
+            otime::RationalTime mapVideo(const otime::RationalTime&) const;
+
+        private:
+            TLRENDER_PRIVATE();
+        };
     }
 }
@@ -18,5 +18,8 @@ namespace tl
 
         IRender::~IRender()
         {}
+
+        void IRender::flush()
+        {}
     }
 }
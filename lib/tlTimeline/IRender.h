@@ -41,6 +41,11 @@ namespace tl
             //! Finish a render.
             virtual void end() = 0;
 
+            //! Flush any pending drawing. This should be called before the
+            //! OpenGL state is changed outside of the renderer, for example
+            //! binding a different frame buffer.
+            virtual void flush();
+
             //! Get the render size.
             virtual math::Size2i getRenderSize() const = 0;
 
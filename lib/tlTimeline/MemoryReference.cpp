@@ -4,6 +4,17 @@
 
 #include <tlTimeline/MemoryReference.h>
 
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#include <zlib.h>
+
 namespace tl
 {
     namespace timeline
@@ -159,6 +170,139 @@ namespace tl
             _memory = memory;
         }
 
+        namespace
+        {
+            std::shared_ptr<MemoryReferenceData> inflateEntry(
+                const ZipCompressedData::Entry& entry)
+            {
+                auto out = std::make_shared<MemoryReferenceData>(entry.uncompressed_size);
+                z_stream stream;
+                memset(&stream, 0, sizeof(z_stream));
+                if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+                {
+                    throw std::runtime_error("Cannot initialize zlib");
+                }
+
+                // Zip entries may be larger than the zlib buffer sizes, so
+                // feed the data in chunks.
+                const size_t chunk = std::numeric_limits<uInt>::max();
+                const uint8_t* in = entry.data;
+                size_t inSize = entry.size;
+                uint8_t* outData = out->data();
+                size_t outSize = out->size();
+                int r = Z_OK;
+                do
+                {
+                    if (0 == stream.avail_in && inSize > 0)
+                    {
+                        stream.next_in = const_cast<Bytef*>(in);
+                        stream.avail_in = static_cast<uInt>(std::min(inSize, chunk));
+                        in += stream.avail_in;
+                        inSize -= stream.avail_in;
+                    }
+                    if (0 == stream.avail_out && outSize > 0)
+                    {
+                        stream.next_out = outData;
+                        stream.avail_out = static_cast<uInt>(std::min(outSize, chunk));
+                        outData += stream.avail_out;
+                        outSize -= stream.avail_out;
+                    }
+                    r = inflate(&stream, Z_NO_FLUSH);
+                } while (Z_OK == r);
+                inflateEnd(&stream);
+                if (r != Z_STREAM_END)
+                {
+                    throw std::runtime_error("Cannot decompress zip entry");
+                }
+                return out;
+            }
+        }
+
+        ZipCompressedData::ZipCompressedData(
+            const std::vector<Entry>& entries,
+            const std::weak_ptr<log::System>& logSystem) :
+            _entries(entries),
+            _logSystem(logSystem)
+        {}
+
+        ZipCompressedData::~ZipCompressedData()
+        {}
+
+        const std::vector<ZipCompressedData::Entry>& ZipCompressedData::entries() const noexcept
+        {
+            return _entries;
+        }
+
+        const std::vector<std::shared_ptr<MemoryReferenceData> >& ZipCompressedData::decompress()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!_decompressed)
+            {
+                _decompressed = true;
+                _data.resize(_entries.size());
+                std::vector<size_t> indices;
+                for (size_t i = 0; i < _entries.size(); ++i)
+                {
+                    if (_entries[i].data)
+                    {
+                        indices.push_back(i);
+                    }
+                }
+                std::atomic<size_t> index(0);
+                std::vector<std::string> errors;
+                std::mutex errorsMutex;
+                std::vector<std::thread> threads;
+                const size_t threadCount = std::min(
+                    static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)),
+                    indices.size());
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    threads.push_back(std::thread(
+                        [this, &indices, &index, &errors, &errorsMutex]
+                        {
+                            size_t j = index++;
+                            while (j < indices.size())
+                            {
+                                const Entry& entry = _entries[indices[j]];
+                                try
+                                {
+                                    _data[indices[j]] = inflateEntry(entry);
+                                }
+                                catch (const std::exception& e)
+                                {
+                                    std::unique_lock<std::mutex> lock(errorsMutex);
+                                    errors.push_back(string::Format("{0}: {1}").
+                                        arg(entry.name).
+                                        arg(e.what()));
+                                }
+                                j = index++;
+                            }
+                        }));
+                }
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+                if (auto logSystem = _logSystem.lock())
+                {
+                    for (const auto& error : errors)
+                    {
+                        logSystem->print(
+                            "tl::timeline::ZipCompressedData",
+                            error,
+                            log::Type::Error);
+                    }
+                }
+            }
+            return _data;
+        }
+
+        bool ZipCompressedData::isDecompressed() const
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            return _decompressed;
+        }
+
         ZipMemoryReference::ZipMemoryReference(
             const std::shared_ptr<file::FileIO>& file_io,
             const std::string& target_url,
@@ -183,6 +327,16 @@ namespace tl
             _file_io = file_io;
         }
 
+        const std::shared_ptr<ZipCompressedData>& ZipMemoryReference::compressed_data() const noexcept
+        {
+            return _compressed_data;
+        }
+
+        void ZipMemoryReference::set_compressed_data(const std::shared_ptr<ZipCompressedData>& value)
+        {
+            _compressed_data = value;
+        }
+
         ZipMemorySequenceReference::ZipMemorySequenceReference(
             const std::shared_ptr<file::FileIO>& file_io,
             const std::string& target_url,
@@ -206,5 +360,15 @@ namespace tl
         {
             _file_io = file_io;
         }
+
+        const std::shared_ptr<ZipCompressedData>& ZipMemorySequenceReference::compressed_data() const noexcept
+        {
+            return _compressed_data;
+        }
+
+        void ZipMemorySequenceReference::set_compressed_data(const std::shared_ptr<ZipCompressedData>& value)
+        {
+            _compressed_data = value;
+        }
     }
 }
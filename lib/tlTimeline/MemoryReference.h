@@ -5,12 +5,14 @@
 #pragma once
 
 #include <tlCore/FileIO.h>
+#include <tlCore/LogSystem.h>
 #include <tlCore/Time.h>
 
 #include <opentimelineio/mediaReference.h>
 #include <opentimelineio/timeline.h>
 
 #include <memory>
+#include <mutex>
 
 namespace tl
 {
@@ -154,6 +156,53 @@ namespace tl
             std::vector<std::shared_ptr<MemoryReferenceData> > _memory;
         };
 
+        //! Compressed zip file entries for .otioz support. Media in .otioz
+        //! files is normally stored without compression and read directly
+        //! from the memory mapped file, only compressed entries need to be
+        //! decompressed.
+        class ZipCompressedData
+        {
+            TLRENDER_NON_COPYABLE(ZipCompressedData);
+
+        public:
+            //! Zip file entry.
+            struct Entry
+            {
+                //! Entry name used for error messages.
+                std::string name;
+
+                //! Compressed data, or null if the entry is not compressed.
+                const uint8_t* data = nullptr;
+                size_t size = 0;
+                size_t uncompressed_size = 0;
+            };
+
+            ZipCompressedData(
+                const std::vector<Entry>& = {},
+                const std::weak_ptr<log::System>& = std::weak_ptr<log::System>());
+
+            ~ZipCompressedData();
+
+            const std::vector<Entry>& entries() const noexcept;
+
+            //! Get the decompressed data. The compressed entries are
+            //! decompressed in parallel the first time this function is
+            //! called. Entries that are not compressed, or that could not be
+            //! decompressed, are null. Decompression errors are printed to
+            //! the log.
+            const std::vector<std::shared_ptr<MemoryReferenceData> >& decompress();
+
+            //! Get whether the entries have been decompressed.
+            bool isDecompressed() const;
+
+        private:
+            std::vector<Entry> _entries;
+            std::weak_ptr<log::System> _logSystem;
+            std::vector<std::shared_ptr<MemoryReferenceData> > _data;
+            bool _decompressed = false;
+            mutable std::mutex _mutex;
+        };
+
         //! Zip file memory reference for .otioz support.
         class ZipMemoryReference : public RawMemoryReference
         {
@@ -176,10 +225,15 @@ namespace tl
 
             void set_file_io(const std::shared_ptr<file::FileIO>&);
 
+            const std::shared_ptr<ZipCompressedData>& compressed_data() const noexcept;
+
+            void set_compressed_data(const std::shared_ptr<ZipCompressedData>&);
+
         protected:
             virtual ~ZipMemoryReference();
 
             std::shared_ptr<file::FileIO> _file_io;
+            std::shared_ptr<ZipCompressedData> _compressed_data;
         };
 
         //! Zip file memory sequence reference for .otioz support.
@@ -204,10 +258,15 @@ namespace tl
 
             void set_file_io(const std::shared_ptr<file::FileIO>&);
 
+            const std::shared_ptr<ZipCompressedData>& compressed_data() const noexcept;
+
+            void set_compressed_data(const std::shared_ptr<ZipCompressedData>&);
+
         protected:
             virtual ~ZipMemorySequenceReference();
 
             std::shared_ptr<file::FileIO> _file_io;
+            std::shared_ptr<ZipCompressedData> _compressed_data;
         };
     }
 }
@@ -12,6 +12,8 @@
 
 #include <tlCore/AudioSystem.h>
 
+#include <algorithm>
+
 namespace tl
 {
     namespace timeline
@@ -83,6 +85,7 @@ namespace tl
 
             p.playerOptions = playerOptions;
             p.timeline = timeline;
+            p.otioTimeline = timeline->getTimeline();
             p.ioInfo = p.timeline->getIOInfo();
 
             // Create observers.
@@ -100,6 +103,7 @@ namespace tl
             p.videoLayer = observer::Value<int>::create(0);
             p.compareVideoLayers = observer::List<int>::create();
             p.currentVideoData = observer::List<VideoData>::create();
+            p.readAheadVideoData = observer::List<VideoData>::create();
             p.volume = observer::Value<float>::create(1.F);
             p.mute = observer::Value<bool>::create(false);
             p.channelMute = observer::List<int>::create();
@@ -107,6 +111,7 @@ namespace tl
             p.currentAudioData = observer::List<AudioData>::create();
             p.cacheOptions = observer::Value<PlayerCacheOptions>::create(playerOptions.cache);
             p.cacheInfo = observer::Value<PlayerCacheInfo>::create();
+            p.dropInfo = observer::Value<PlayerDropInfo>::create();
             auto weak = std::weak_ptr<Player>(shared_from_this());
             p.timelineObserver = observer::ValueObserver<bool>::create(
                 p.timeline->observeTimelineChanges(),
@@ -114,10 +119,30 @@ namespace tl
                 {
                     if (auto player = weak.lock())
                     {
-                        player->clearCache();
+                        // Compare the new timeline with the previous one so
+                        // only the frames affected by the edit are cleared
+                        // from the cache.
+                        auto otioTimeline = player->_p->timeline->getTimeline();
+                        auto edit = EditDiff::create(player->_p->otioTimeline, otioTimeline);
+                        player->_p->otioTimeline = otioTimeline;
+                        if (edit->isAllChanged())
+                        {
+                            player->clearCache();
+                        }
+                        else
+                        {
+                            {
+                                std::unique_lock<std::mutex> lock(player->_p->mutex.mutex);
+                                player->_p->mutex.edits.push_back(edit);
+                            }
+                            player->_p->notifyThread();
+                        }
                     }
                 });
 
+            // Wake the thread when requests have finished.
+            p.addRequestCallback(p.timeline);
+
             // Create a new thread.
             if (playerOptions.playback == Playback::Reverse)
                 p.mutex.cacheDirection = CacheDirection::Reverse;
@@ -194,15 +219,15 @@ namespace tl
 #endif // TLRENDER_AUDIO
 
                     p.thread.cacheTimer = std::chrono::steady_clock::now();
+                    p.thread.dropTimer = std::chrono::steady_clock::now();
                     p.thread.logTimer = std::chrono::steady_clock::now();
                     while (p.thread.running)
                     {
-                        const auto t0 = std::chrono::steady_clock::now();
-
                         // Get mutex protected values.
                         std::vector<std::shared_ptr<Timeline> > compare;
                         bool clearRequests = false;
                         bool clearCache = false;
+                        std::vector<std::shared_ptr<EditDiff> > edits;
                         {
                             std::unique_lock<std::mutex> lock(p.mutex.mutex);
                             p.thread.playback = p.mutex.playback;
@@ -218,6 +243,8 @@ namespace tl
                             p.mutex.clearRequests = false;
                             clearCache = p.mutex.clearCache;
                             p.mutex.clearCache = false;
+                            edits = std::move(p.mutex.edits);
+                            p.mutex.edits.clear();
                             p.thread.cacheDirection = p.mutex.cacheDirection;
                             p.thread.cacheOptions = p.mutex.cacheOptions;
                         }
@@ -234,12 +261,21 @@ namespace tl
                         {
                             p.clearCache();
                         }
+                        else
+                        {
+                            for (const auto& edit : edits)
+                            {
+                                p.editCache(edit);
+                            }
+                        }
 
                         // Update the cache.
                         p.cacheUpdate();
 
                         // Update the current video data.
                         updateVideoData();
+                        p.readAheadUpdate();
+                        p.dropInfoUpdate();
 
                         // Update the current audio data.
                         if (p.ioInfo.audio.isValid())
@@ -266,7 +302,7 @@ namespace tl
                         }
 
                         // Logging.
-                        auto t1 = std::chrono::steady_clock::now();
+                        const auto t1 = std::chrono::steady_clock::now();
                         const std::chrono::duration<double> diff = t1 - p.thread.logTimer;
                         if (diff.count() > 10.0)
                         {
@@ -275,11 +311,21 @@ namespace tl
                             {
                                 p.log(context);
                             }
-                            t1 = std::chrono::steady_clock::now();
                         }
 
-                        // Sleep for a bit.
-                        time::sleep(p.playerOptions.sleepTimeout, t0, t1);
+                        // Wait for requests to finish or the state to
+                        // change.
+                        {
+                            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                            p.thread.cv.wait_for(
+                                lock,
+                                p.playerOptions.sleepTimeout,
+                                [this]
+                                {
+                                    return _p->mutex.wake || !_p->thread.running;
+                                });
+                            p.mutex.wake = false;
+                        }
                     }
 
                     p.clearRequests();
@@ -293,11 +339,22 @@ namespace tl
         Player::~Player()
         {
             TLRENDER_P();
-            p.thread.running = false;
+            {
+                // Set the flag with the mutex locked so the thread cannot
+                // miss the notification between checking the predicate and
+                // waiting.
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.thread.running = false;
+            }
+            p.thread.cv.notify_one();
             if (p.thread.thread.joinable())
             {
                 p.thread.thread.join();
             }
+            for (const auto& i : p.requestCallbacks)
+            {
+                i.first->removeRequestCallback(i.second);
+            }
 #if defined(TLRENDER_AUDIO)
             if (p.thread.rtAudio && p.thread.rtAudio->isStreamOpen())
             {
@@ -330,11 +387,16 @@ namespace tl
             const auto& timeRange = p.timeline->getTimeRange();
             if (!p.ioInfo.video.empty())
             {
-                const auto i = p.thread.videoDataCache.find(p.thread.currentTime);
-                if (i != p.thread.videoDataCache.end())
+                if (PlaybackPolicy::RealTime == p.playerOptions.playbackPolicy &&
+                    p.thread.playback != Playback::Stop &&
+                    timeRange.contains(p.thread.currentTime))
+                {
+                    p.realTimeUpdate();
+                }
+                else if (const auto videoData = p.thread.videoDataCache.get(p.thread.currentTime))
                 {
                     std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                    p.mutex.currentVideoData = i->second;
+                    p.mutex.currentVideoData = *videoData;
                 }
                 else if (p.thread.playback != Playback::Stop)
                 {
@@ -512,6 +574,8 @@ namespace tl
                             CacheDirection::Forward :
                             CacheDirection::Reverse;
                         p.mutex.clearRequests = true;
+                        p.mutex.wake = true;
+                        p.thread.cv.notify_one();
                     }
                     p.resetAudioTime();
                 }
@@ -520,6 +584,8 @@ namespace tl
                     std::unique_lock<std::mutex> lock(p.mutex.mutex);
                     p.mutex.playback = value;
                     p.mutex.clearRequests = true;
+                    p.mutex.wake = true;
+                    p.thread.cv.notify_one();
                 }
             }
         }
@@ -575,6 +641,8 @@ namespace tl
                     std::unique_lock<std::mutex> lock(p.mutex.mutex);
                     p.mutex.currentTime = tmp;
                     p.mutex.clearRequests = true;
+                    p.mutex.wake = true;
+                    p.thread.cv.notify_one();
                 }
                 p.resetAudioTime();
             }
@@ -673,6 +741,8 @@ namespace tl
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
                 p.mutex.inOutRange = value;
                 p.mutex.clearRequests = true;
+                p.mutex.wake = true;
+                p.thread.cv.notify_one();
             }
         }
 
@@ -721,12 +791,28 @@ namespace tl
         void Player::setCompare(const std::vector<std::shared_ptr<Timeline> >& value)
         {
             TLRENDER_P();
+            const auto prev = p.compare->get();
             if (p.compare->setIfChanged(value))
             {
-                std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                p.mutex.compare = value;
-                p.mutex.clearRequests = true;
-                p.mutex.clearCache = true;
+                for (const auto& i : prev)
+                {
+                    if (i != p.timeline &&
+                        std::find(value.begin(), value.end(), i) == value.end())
+                    {
+                        p.removeRequestCallback(i);
+                    }
+                }
+                for (const auto& i : value)
+                {
+                    p.addRequestCallback(i);
+                }
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.mutex.compare = value;
+                    p.mutex.clearRequests = true;
+                    p.mutex.clearCache = true;
+                }
+                p.notifyThread();
             }
         }
 
@@ -749,6 +835,8 @@ namespace tl
                 p.mutex.compareTime = value;
                 p.mutex.clearRequests = true;
                 p.mutex.clearCache = true;
+                p.mutex.wake = true;
+                p.thread.cv.notify_one();
             }
         }
 
@@ -771,6 +859,8 @@ namespace tl
                 p.mutex.ioOptions = value;
                 p.mutex.clearRequests = true;
                 p.mutex.clearCache = true;
+                p.mutex.wake = true;
+                p.thread.cv.notify_one();
             }
         }
 
@@ -793,6 +883,8 @@ namespace tl
                 p.mutex.videoLayer = value;
                 p.mutex.clearRequests = true;
                 p.mutex.clearCache = true;
+                p.mutex.wake = true;
+                p.thread.cv.notify_one();
             }
         }
 
@@ -815,6 +907,8 @@ namespace tl
                 p.mutex.compareVideoLayers = value;
                 p.mutex.clearRequests = true;
                 p.mutex.clearCache = true;
+                p.mutex.wake = true;
+                p.thread.cv.notify_one();
             }
         }
 
@@ -828,6 +922,16 @@ namespace tl
             return _p->currentVideoData;
         }
 
+        const std::vector<VideoData>& Player::getReadAheadVideo() const
+        {
+            return _p->readAheadVideoData->get();
+        }
+
+        std::shared_ptr<observer::IList<VideoData> > Player::observeReadAheadVideo() const
+        {
+            return _p->readAheadVideoData;
+        }
+
         float Player::getVolume() const
         {
             return _p->volume->get();
@@ -885,6 +989,8 @@ namespace tl
             {
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
                 p.mutex.audioOffset = value;
+                p.mutex.wake = true;
+                p.thread.cv.notify_one();
             }
         }
 
@@ -911,10 +1017,23 @@ namespace tl
         void Player::setCacheOptions(const PlayerCacheOptions& value)
         {
             TLRENDER_P();
+            if (CacheMode::InOut == value.mode)
+            {
+                const size_t byteCount = p.getInOutByteCount(p.inOutRange->get(), 0.0);
+                if (byteCount > value.memoryBudget)
+                {
+                    throw std::runtime_error(string::Format(
+                        "The in/out range needs {0}MB which does not fit in the {1}MB cache budget").
+                        arg(byteCount / memory::megabyte).
+                        arg(value.memoryBudget / memory::megabyte));
+                }
+            }
             if (p.cacheOptions->setIfChanged(value))
             {
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
                 p.mutex.cacheOptions = value;
+                p.mutex.wake = true;
+                p.thread.cv.notify_one();
             }
         }
 
@@ -923,12 +1042,17 @@ namespace tl
             return _p->cacheInfo;
         }
 
+        std::shared_ptr<observer::IValue<PlayerDropInfo> > Player::observeDropInfo() const
+        {
+            return _p->dropInfo;
+        }
+
         void Player::updateVideoCache(const otime::RationalTime& time)
         {
             TLRENDER_P();
             {
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                p.thread.videoDataCache.erase(time);
+                p.thread.videoDataCache.remove(time);
                 p.forwardRequests(
                     time, time, otime::RationalTime(1.0, time.rate()), true);
             }
@@ -946,6 +1070,8 @@ namespace tl
             std::unique_lock<std::mutex> lock(p.mutex.mutex);
             p.mutex.clearRequests = true;
             p.mutex.clearCache = true;
+            p.mutex.wake = true;
+            p.thread.cv.notify_one();
         }
 
         void Player::tick()
@@ -1004,18 +1130,29 @@ namespace tl
 
             // Sync with the thread.
             std::vector<VideoData> currentVideoData;
+            std::vector<VideoData> readAheadVideoData;
             std::vector<AudioData> currentAudioData;
             PlayerCacheInfo cacheInfo;
+            PlayerDropInfo dropInfo;
             {
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                p.mutex.currentTime = p.currentTime->get();
+                if (p.currentTime->get() != p.mutex.currentTime)
+                {
+                    p.mutex.currentTime = p.currentTime->get();
+                    p.mutex.wake = true;
+                    p.thread.cv.notify_one();
+                }
                 currentVideoData = p.mutex.currentVideoData;
+                readAheadVideoData = p.mutex.readAheadVideoData;
                 currentAudioData = p.mutex.currentAudioData;
                 cacheInfo = p.mutex.cacheInfo;
+                dropInfo = p.mutex.dropInfo;
             }
             p.currentVideoData->setIfChanged(currentVideoData);
+            p.readAheadVideoData->setIfChanged(readAheadVideoData);
             p.currentAudioData->setIfChanged(currentAudioData);
             p.cacheInfo->setIfChanged(cacheInfo);
+            p.dropInfo->setIfChanged(dropInfo);
         }
     }
 }
@@ -17,7 +17,8 @@ namespace tl
         //! Timeline player cache information.
         struct PlayerCacheInfo
         {
-            //! Video cache percentage used.
+            //! Video cache percentage used. In the in/out cache mode this
+            //! is the fill progress of the in/out range.
             float videoPercentage = 0.F;
 
             //! Cached video frames.
@@ -26,10 +27,62 @@ namespace tl
             //! Cached audio frames.
             std::vector<otime::TimeRange> audioFrames;
 
+            //! Effective cache read ahead.
+            otime::RationalTime readAhead = time::invalidTime;
+
+            //! Effective cache read behind.
+            otime::RationalTime readBehind = time::invalidTime;
+
+            //! Cached video size in bytes.
+            size_t videoByteCount = 0;
+
+            //! Range pinned in the cache by the in/out cache mode.
+            otime::TimeRange pinnedRange = time::invalidTimeRange;
+
+            //! Cache error, for example when the in/out range does not fit
+            //! in the memory budget.
+            std::string error;
+
             bool operator == (const PlayerCacheInfo&) const;
             bool operator != (const PlayerCacheInfo&) const;
         };
 
+        //! Number of video request latency histogram bins.
+        const size_t playerRequestLatencyBins = 11;
+
+        //! Timeline player frame drop information for the real-time
+        //! playback policy, and video request latency.
+        struct PlayerDropInfo
+        {
+            //! Frames that were not ready by their presentation deadline
+            //! and were never shown.
+            size_t droppedFrames = 0;
+
+            //! Frames that missed their presentation deadline but were
+            //! shown before the next frame was due.
+            size_t lateFrames = 0;
+
+            //! Dropped frames for each second of playback, oldest first.
+            std::vector<size_t> droppedFramesPerSecond;
+
+            //! Late frames for each second of playback, oldest first.
+            std::vector<size_t> lateFramesPerSecond;
+
+            //! Frame step of the read ahead requests. This is larger than
+            //! one when decoding cannot keep up with playback.
+            size_t requestStep = 1;
+
+            //! Histogram of the time from a video request to the video data
+            //! being received. Bin N counts the latencies below 2^N
+            //! milliseconds, and the last bin counts the latencies of 512
+            //! milliseconds and more. This is updated for all playback
+            //! policies.
+            std::vector<size_t> requestLatency;
+
+            bool operator == (const PlayerDropInfo&) const;
+            bool operator != (const PlayerDropInfo&) const;
+        };
+
         //! Playback loop modes.
         enum class Loop
         {
@@ -273,6 +326,14 @@ namespace tl
             //! Observe the current video data.
             std::shared_ptr<observer::IList<VideoData> > observeCurrentVideo() const;
 
+            //! Get the cached video data for the frames following the
+            //! current time, in playback order. The number of frames is set
+            //! with PlayerOptions::readAheadVideoCount.
+            const std::vector<VideoData>& getReadAheadVideo() const;
+
+            //! Observe the read ahead video data.
+            std::shared_ptr<observer::IList<VideoData> > observeReadAheadVideo() const;
+
             ///@}
 
             //! \name Audio
@@ -331,11 +392,16 @@ namespace tl
             //! Observe the cache options.
             std::shared_ptr<observer::IValue<PlayerCacheOptions> > observeCacheOptions() const;
 
-            //! Set the cache options.
+            //! Set the cache options. Throws an exception if the in/out
+            //! cache mode is used and the in/out range does not fit in
+            //! the memory budget.
             void setCacheOptions(const PlayerCacheOptions&);
 
             //! Observe the cache information.
             std::shared_ptr<observer::IValue<PlayerCacheInfo> > observeCacheInfo() const;
+
+            //! Observe the frame drop information.
+            std::shared_ptr<observer::IValue<PlayerDropInfo> > observeDropInfo() const;
             
             //! Update Video Cache Time.
             void updateVideoCache(const otime::RationalTime& time);
@@ -11,12 +11,33 @@ namespace tl
             return
                 videoPercentage == other.videoPercentage &&
                 videoFrames == other.videoFrames &&
-                audioFrames == other.audioFrames;
+                audioFrames == other.audioFrames &&
+                readAhead == other.readAhead &&
+                readBehind == other.readBehind &&
+                videoByteCount == other.videoByteCount &&
+                pinnedRange == other.pinnedRange &&
+                error == other.error;
         }
 
         inline bool PlayerCacheInfo::operator != (const PlayerCacheInfo& other) const
         {
             return !(*this == other);
         }
+
+        inline bool PlayerDropInfo::operator == (const PlayerDropInfo& other) const
+        {
+            return
+                droppedFrames == other.droppedFrames &&
+                lateFrames == other.lateFrames &&
+                droppedFramesPerSecond == other.droppedFramesPerSecond &&
+                lateFramesPerSecond == other.lateFramesPerSecond &&
+                requestStep == other.requestStep &&
+                requestLatency == other.requestLatency;
+        }
+
+        inline bool PlayerDropInfo::operator != (const PlayerDropInfo& other) const
+        {
+            return !(*this == other);
+        }
     }
 }
@@ -16,5 +16,11 @@ namespace tl
         
         TLRENDER_ENUM_IMPL(TimerMode, "System", "Audio");
         TLRENDER_ENUM_SERIALIZE_IMPL(TimerMode);
+
+        TLRENDER_ENUM_IMPL(PlaybackPolicy, "Wait", "RealTime");
+        TLRENDER_ENUM_SERIALIZE_IMPL(PlaybackPolicy);
+
+        TLRENDER_ENUM_IMPL(CacheMode, "Time", "Memory", "InOut");
+        TLRENDER_ENUM_SERIALIZE_IMPL(CacheMode);
     }
 }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <tlCore/Memory.h>
 #include <tlCore/Time.h>
 
 namespace tl
@@ -35,15 +36,51 @@ namespace tl
         TLRENDER_ENUM(TimerMode);
         TLRENDER_ENUM_SERIALIZE(TimerMode);
 
+        //! Playback policies.
+        enum class PlaybackPolicy
+        {
+            Wait,     //!< Wait for frames that are not ready
+            RealTime, //!< Keep real-time playback and drop frames that are not ready
+
+            Count,
+            First = Wait
+        };
+        TLRENDER_ENUM(PlaybackPolicy);
+        TLRENDER_ENUM_SERIALIZE(PlaybackPolicy);
+
+        //! Timeline player cache modes.
+        enum class CacheMode
+        {
+            Time,   //!< Cache a fixed time ahead of and behind the current time
+            Memory, //!< Size the cache from a memory budget
+            InOut,  //!< Cache and keep the whole in/out range
+
+            Count,
+            First = Time
+        };
+        TLRENDER_ENUM(CacheMode);
+        TLRENDER_ENUM_SERIALIZE(CacheMode);
+
         //! Timeline player cache options.
         struct PlayerCacheOptions
-        {            
-            //! Cache read ahead.
+        {
+            //! Cache mode.
+            CacheMode mode = CacheMode::Time;
+
+            //! Cache read ahead. In the memory mode this is the read ahead
+            //! used until the frame size has been measured.
             otime::RationalTime readAhead = otime::RationalTime(2.0, 1.0);
 
-            //! Cache read behind.
+            //! Cache read behind. In the memory mode this is the maximum
+            //! read behind.
             otime::RationalTime readBehind = otime::RationalTime(0.5, 1.0);
 
+            //! Memory budget in bytes for the memory and in/out modes.
+            size_t memoryBudget = 4 * memory::gigabyte;
+
+            //! Maximum read ahead for the memory mode.
+            otime::RationalTime readAheadMax = otime::RationalTime(60.0, 1.0);
+
             bool operator == (const PlayerCacheOptions&) const;
             bool operator != (const PlayerCacheOptions&) const;
         };
@@ -57,14 +94,19 @@ namespace tl
             //! Timer mode.
             TimerMode timerMode = TimerMode::System;
 
+            //! Playback policy.
+            PlaybackPolicy playbackPolicy = PlaybackPolicy::Wait;
+
             //! Audio buffer frame count.
             size_t audioBufferFrameCount = 2048;
 
             //! Timeout for muting the audio when playback stutters.
             std::chrono::milliseconds muteTimeout = std::chrono::milliseconds(500);
 
-            //! Timeout to sleep each tick.
-            std::chrono::milliseconds sleepTimeout = std::chrono::milliseconds(5);
+            //! Maximum time the player thread waits for requests to finish or
+            //! for the state to change. The thread is woken as soon as either
+            //! happens, the timeout is only a fallback.
+            std::chrono::milliseconds sleepTimeout = std::chrono::milliseconds(100);
 
             //! Current time.
             otime::RationalTime currentTime = time::invalidTime;
@@ -72,6 +114,11 @@ namespace tl
             //! Start playback direction.
             Playback playback = Playback::Forward;
 
+            //! Number of cached frames following the current time that are
+            //! provided by Player::observeReadAheadVideo(), for example to
+            //! upload them to the GPU before they are displayed.
+            size_t readAheadVideoCount = 0;
+
             bool operator == (const PlayerOptions&) const;
             bool operator != (const PlayerOptions&) const;
         };
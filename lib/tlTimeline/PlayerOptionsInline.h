@@ -9,8 +9,11 @@ namespace tl
         inline bool PlayerCacheOptions::operator == (const PlayerCacheOptions& other) const
         {
             return
+                mode == other.mode &&
                 readAhead == other.readAhead &&
-                readBehind == other.readBehind;
+                readBehind == other.readBehind &&
+                memoryBudget == other.memoryBudget &&
+                readAheadMax == other.readAheadMax;
         }
 
         inline bool PlayerCacheOptions::operator != (const PlayerCacheOptions& other) const
@@ -23,10 +26,12 @@ namespace tl
             return
                 cache == other.cache &&
                 timerMode == other.timerMode &&
+                playbackPolicy == other.playbackPolicy &&
                 audioBufferFrameCount == other.audioBufferFrameCount &&
                 muteTimeout == other.muteTimeout &&
                 sleepTimeout == other.sleepTimeout &&
-                currentTime == other.currentTime;
+                currentTime == other.currentTime &&
+                readAheadVideoCount == other.readAheadVideoCount;
         }
 
         inline bool PlayerOptions::operator != (const PlayerOptions& other) const
@@ -8,12 +8,31 @@
 
 #include <tlCore/StringFormat.h>
 
+#include <cmath>
+#include <limits>
+
 namespace tl
 {
     namespace timeline
     {
         namespace
         {
+            // Maximum frame step for the real-time playback policy.
+            const size_t requestStepMax = 8;
+
+            // Number of seconds kept in the frame drop history.
+            const size_t dropHistory = 60;
+
+            size_t getRequestLatencyBin(double ms)
+            {
+                size_t out = 0;
+                for (double i = 1.0; ms >= i && out < playerRequestLatencyBins - 1; i *= 2.0)
+                {
+                    ++out;
+                }
+                return out;
+            }
+
             inline float fadeValue(double sample, double in, double out)
             {
                 return (sample - in) / (out - in);
@@ -113,9 +132,10 @@ namespace tl
             std::vector<std::vector<uint64_t> > ids(1 + thread.compare.size());
             for (const auto& i : thread.videoDataRequests)
             {
-                for (size_t j = 0; j < i.second.size() && j < ids.size(); ++j)
+                const auto& requests = i.second.requests;
+                for (size_t j = 0; j < requests.size() && j < ids.size(); ++j)
                 {
-                    ids[j].push_back(i.second[j].id);
+                    ids[j].push_back(requests[j].id);
                 }
             }
             for (const auto& i : thread.audioDataRequests)
@@ -144,15 +164,275 @@ namespace tl
             }
         }
         
+        void Player::Private::editCache(const std::shared_ptr<EditDiff>& edit)
+        {
+            // Cancel the requests for video that changed. Requests for
+            // video that did not change give the same result with either
+            // timeline.
+            std::vector<std::vector<uint64_t> > ids(1 + thread.compare.size());
+            auto videoRequestIt = thread.videoDataRequests.begin();
+            while (videoRequestIt != thread.videoDataRequests.end())
+            {
+                if (edit->isVideoChanged(videoRequestIt->first))
+                {
+                    const auto& requests = videoRequestIt->second.requests;
+                    for (size_t i = 0; i < requests.size() && i < ids.size(); ++i)
+                    {
+                        ids[i].push_back(requests[i].id);
+                    }
+                    videoRequestIt = thread.videoDataRequests.erase(videoRequestIt);
+                }
+                else
+                {
+                    ++videoRequestIt;
+                }
+            }
+
+            // Keep the cached video that did not change, and move the
+            // cached video of clips that moved. The compare timelines are
+            // not edited, so the video can only be moved without them.
+            for (auto& i : thread.videoDataCache.take())
+            {
+                const otime::RationalTime time = thread.compare.empty() ?
+                    edit->mapVideo(i.first) :
+                    (edit->isVideoChanged(i.first) ? time::invalidTime : i.first);
+                if (!time::isValid(time) ||
+                    thread.videoDataCache.contains(time) ||
+                    thread.videoDataRequests.find(time) != thread.videoDataRequests.end())
+                    continue;
+                for (auto& videoData : i.second)
+                {
+                    videoData.time = time;
+                }
+                thread.videoDataCache.add(time, std::move(i.second));
+            }
+
+            // Remove the audio that changed.
+            const otime::TimeRange& timeRange = timeline->getTimeRange();
+            const double start = timeRange.start_time().rescaled_to(1.0).value();
+            auto audioRequestIt = thread.audioDataRequests.begin();
+            while (audioRequestIt != thread.audioDataRequests.end())
+            {
+                const otime::TimeRange range(
+                    otime::RationalTime(start + audioRequestIt->first, 1.0),
+                    otime::RationalTime(1.0, 1.0));
+                if (edit->isAudioChanged(range))
+                {
+                    ids[0].push_back(audioRequestIt->second.id);
+                    audioRequestIt = thread.audioDataRequests.erase(audioRequestIt);
+                }
+                else
+                {
+                    ++audioRequestIt;
+                }
+            }
+            {
+                std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                auto audioCacheIt = audioMutex.audioDataCache.begin();
+                while (audioCacheIt != audioMutex.audioDataCache.end())
+                {
+                    const otime::TimeRange range(
+                        otime::RationalTime(start + audioCacheIt->first, 1.0),
+                        otime::RationalTime(1.0, 1.0));
+                    if (edit->isAudioChanged(range))
+                    {
+                        audioCacheIt = audioMutex.audioDataCache.erase(audioCacheIt);
+                    }
+                    else
+                    {
+                        ++audioCacheIt;
+                    }
+                }
+            }
+
+            timeline->cancelRequests(ids[0]);
+            for (size_t i = 0; i < thread.compare.size(); ++i)
+            {
+                thread.compare[i]->cancelRequests(ids[i + 1]);
+            }
+        }
+
+        void Player::Private::cancelVideoRequests(const std::vector<otime::RationalTime>& times)
+        {
+            std::vector<std::vector<uint64_t> > ids(1 + thread.compare.size());
+            for (const auto& time : times)
+            {
+                const auto i = thread.videoDataRequests.find(time);
+                if (i != thread.videoDataRequests.end())
+                {
+                    const auto& requests = i->second.requests;
+                    for (size_t j = 0; j < requests.size() && j < ids.size(); ++j)
+                    {
+                        ids[j].push_back(requests[j].id);
+                    }
+                    thread.videoDataRequests.erase(i);
+                }
+            }
+            if (!ids[0].empty())
+            {
+                timeline->cancelRequests(ids[0]);
+            }
+            for (size_t i = 0; i < thread.compare.size(); ++i)
+            {
+                if (!ids[i + 1].empty())
+                {
+                    thread.compare[i]->cancelRequests(ids[i + 1]);
+                }
+            }
+        }
+
+        void Player::Private::cancelVideoRequestsOutside(
+            const std::vector<otime::TimeRange>& ranges,
+            bool includeCurrentTime)
+        {
+            // The first range is the current time.
+            const auto begin = ranges.begin() + (includeCurrentTime || ranges.empty() ? 0 : 1);
+            std::vector<otime::RationalTime> cancel;
+            for (const auto& i : thread.videoDataRequests)
+            {
+                const otime::RationalTime t = i.first;
+                const auto j = std::find_if(
+                    begin,
+                    ranges.end(),
+                    [t](const otime::TimeRange& value)
+                    {
+                        return value.contains(t);
+                    });
+                if (j == ranges.end())
+                {
+                    cancel.push_back(t);
+                }
+            }
+            cancelVideoRequests(cancel);
+        }
+
+        size_t Player::Private::getVideoRequestMax() const
+        {
+            // Without compare all of the requests are issued at once and
+            // the timeline schedules them. With compare the number of
+            // frames in flight is limited to what the timelines can decode
+            // at the same time, so a fast stream cannot run ahead of a slow
+            // one and take the decode threads that the slow one needs to
+            // complete the frames.
+            size_t out = std::numeric_limits<size_t>::max();
+            if (!thread.compare.empty())
+            {
+                out = timeline->getOptions().videoRequestCount;
+                for (const auto& i : thread.compare)
+                {
+                    out = std::min(out, i->getOptions().videoRequestCount);
+                }
+                out = std::max(out, size_t(1));
+            }
+            return out;
+        }
+
+        void Player::Private::realTimeUpdate()
+        {
+            // A new frame is due, check whether the previous one was
+            // shown.
+            if (thread.currentTime != thread.deadlineTime)
+            {
+                if (time::isValid(thread.deadlineTime) &&
+                    thread.deadlineMissed &&
+                    thread.presentedTime != thread.deadlineTime)
+                {
+                    ++thread.dropInfo.droppedFrames;
+                    ++thread.secondDroppedFrames;
+                }
+                thread.deadlineTime = thread.currentTime;
+                thread.deadlineMissed = false;
+            }
+
+            if (const auto videoData = thread.videoDataCache.get(thread.currentTime))
+            {
+                if (thread.presentedTime != thread.currentTime)
+                {
+                    if (thread.deadlineMissed)
+                    {
+                        ++thread.dropInfo.lateFrames;
+                        ++thread.secondLateFrames;
+                    }
+                    thread.presentedTime = thread.currentTime;
+                    std::unique_lock<std::mutex> lock(mutex.mutex);
+                    mutex.currentVideoData = *videoData;
+                }
+            }
+            else
+            {
+                // Keep showing the previous frame and let the playback
+                // clock run, instead of waiting for the frame.
+                thread.deadlineMissed = true;
+            }
+        }
+
+        void Player::Private::readAheadUpdate()
+        {
+            std::vector<VideoData> videoData;
+            if (playerOptions.readAheadVideoCount > 0 &&
+                time::isValid(thread.currentTime) &&
+                time::isValid(thread.inOutRange))
+            {
+                const otime::RationalTime inc(
+                    Playback::Reverse == thread.playback ? -1.0 : 1.0,
+                    thread.inOutRange.duration().rate());
+                otime::RationalTime t = thread.currentTime;
+                for (size_t i = 0; i < playerOptions.readAheadVideoCount; ++i)
+                {
+                    t = timeline::loop(t + inc, thread.inOutRange);
+                    if (t == thread.currentTime)
+                    {
+                        break;
+                    }
+                    if (const auto cached = thread.videoDataCache.get(t))
+                    {
+                        videoData.insert(videoData.end(), cached->begin(), cached->end());
+                    }
+                }
+            }
+            std::unique_lock<std::mutex> lock(mutex.mutex);
+            mutex.readAheadVideoData = videoData;
+        }
+
+        void Player::Private::dropInfoUpdate()
+        {
+            const auto now = std::chrono::steady_clock::now();
+            const std::chrono::duration<float> diff = now - thread.dropTimer;
+            if (diff.count() >= 1.F)
+            {
+                thread.dropTimer = now;
+                if (PlaybackPolicy::RealTime == playerOptions.playbackPolicy &&
+                    thread.playback != Playback::Stop)
+                {
+                    auto& dropped = thread.dropInfo.droppedFramesPerSecond;
+                    auto& late = thread.dropInfo.lateFramesPerSecond;
+                    dropped.push_back(thread.secondDroppedFrames);
+                    late.push_back(thread.secondLateFrames);
+                    if (dropped.size() > dropHistory)
+                    {
+                        dropped.erase(dropped.begin());
+                        late.erase(late.begin());
+                    }
+                }
+                thread.secondDroppedFrames = 0;
+                thread.secondLateFrames = 0;
+                thread.dropInfo.requestStep = thread.requestStep;
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                mutex.dropInfo = thread.dropInfo;
+            }
+        }
+
         void Player::Private::reverseRequests(const otime::RationalTime& start,
                                               const otime::RationalTime& end,
                                               const otime::RationalTime& inc)
         {
             const otime::TimeRange& timeRange = timeline->getTimeRange();
+            const size_t requestMax = getVideoRequestMax();
             for (auto time = start; time >= end; time -= inc)
             {
-                const auto i = thread.videoDataCache.find(time);
-                if (i == thread.videoDataCache.end())
+                if (thread.videoDataRequests.size() >= requestMax)
+                    break;
+                if (!thread.videoDataCache.contains(time))
                 {
                     const auto j = thread.videoDataRequests.find(time);
                     if (j == thread.videoDataRequests.end())
@@ -160,7 +440,9 @@ namespace tl
                         // std::cerr << thread.cacheDirection
                         //           << "\t\tBACK video request: "
                         //           << time << std::endl;
-                        auto& request = thread.videoDataRequests[time];
+                        auto& frameRequest = thread.videoDataRequests[time];
+                        frameRequest.timer = std::chrono::steady_clock::now();
+                        auto& request = frameRequest.requests;
                         request.clear();
                         io::Options ioOptions2 = thread.ioOptions;
                         ioOptions2["Layer"] = string::Format("{0}").arg(thread.videoLayer);
@@ -189,15 +471,19 @@ namespace tl
                                               const bool clearFrame)
         {
             const otime::TimeRange& timeRange = timeline->getTimeRange();
+            const size_t requestMax = getVideoRequestMax();
             for (otime::RationalTime time = start; time <= end; time += inc)
             {
-                const auto i = thread.videoDataCache.find(time);
-                if (i == thread.videoDataCache.end())
+                if (!clearFrame && thread.videoDataRequests.size() >= requestMax)
+                    break;
+                if (!thread.videoDataCache.contains(time))
                 {
                     const auto j = thread.videoDataRequests.find(time);
                     if (j == thread.videoDataRequests.end())
                     {
-                        auto& request = thread.videoDataRequests[time];
+                        auto& frameRequest = thread.videoDataRequests[time];
+                        frameRequest.timer = std::chrono::steady_clock::now();
+                        auto& request = frameRequest.requests;
                         request.clear();
                         io::Options ioOptions2 = thread.ioOptions;
                         ioOptions2["Layer"] = string::Format("{0}").arg(thread.videoLayer);
@@ -228,9 +514,10 @@ namespace tl
             auto videoDataRequestsIt = thread.videoDataRequests.begin();
             while (videoDataRequestsIt != thread.videoDataRequests.end())
             {
+                auto& requests = videoDataRequestsIt->second.requests;
                 bool ready = true;
-                for (auto videoDataRequestIt = videoDataRequestsIt->second.begin();
-                    videoDataRequestIt != videoDataRequestsIt->second.end();
+                for (auto videoDataRequestIt = requests.begin();
+                    videoDataRequestIt != requests.end();
                     ++videoDataRequestIt)
                 {
                     ready &= videoDataRequestIt->future.valid() &&
@@ -239,16 +526,35 @@ namespace tl
                 if (ready)
                 {
                     const otime::RationalTime time = videoDataRequestsIt->first;
-                    auto& videoDataCache = thread.videoDataCache[time];
-                    videoDataCache.clear();
-                    for (auto videoDataRequestIt = videoDataRequestsIt->second.begin();
-                        videoDataRequestIt != videoDataRequestsIt->second.end();
+                    std::vector<VideoData> videoDataList;
+                    for (auto videoDataRequestIt = requests.begin();
+                        videoDataRequestIt != requests.end();
                         ++videoDataRequestIt)
                     {
                         auto videoData = videoDataRequestIt->future.get();
                         videoData.time = time;
-                        videoDataCache.push_back(videoData);
+                        videoDataList.push_back(videoData);
+                    }
+
+                    // Keep a running average of the frame size for the
+                    // memory cache mode.
+                    const double byteCount = getByteCount(videoDataList);
+                    thread.frameByteCount = thread.frameByteCount > 0.0 ?
+                        (thread.frameByteCount * .9 + byteCount * .1) :
+                        byteCount;
+                    ++thread.decodedFrames;
+
+                    // Add the request latency to the histogram.
+                    const std::chrono::duration<double, std::milli> diff =
+                        std::chrono::steady_clock::now() - videoDataRequestsIt->second.timer;
+                    auto& requestLatency = thread.dropInfo.requestLatency;
+                    if (requestLatency.size() != playerRequestLatencyBins)
+                    {
+                        requestLatency.resize(playerRequestLatencyBins, 0);
                     }
+                    ++requestLatency[getRequestLatencyBin(diff.count())];
+
+                    thread.videoDataCache.add(time, std::move(videoDataList));
                     videoDataRequestsIt = thread.videoDataRequests.erase(videoDataRequestsIt);
                 }
                 else
@@ -257,23 +563,87 @@ namespace tl
                 }
             }
         }
+
+        void Player::Private::notifyThread()
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                mutex.wake = true;
+            }
+            thread.cv.notify_one();
+        }
+
+        void Player::Private::addRequestCallback(const std::shared_ptr<Timeline>& value)
+        {
+            if (requestCallbacks.find(value) == requestCallbacks.end())
+            {
+                requestCallbacks[value] = value->addRequestCallback(
+                    [this]
+                    {
+                        notifyThread();
+                    });
+            }
+        }
+
+        void Player::Private::removeRequestCallback(const std::shared_ptr<Timeline>& value)
+        {
+            const auto i = requestCallbacks.find(value);
+            if (i != requestCallbacks.end())
+            {
+                i->first->removeRequestCallback(i->second);
+                requestCallbacks.erase(i);
+            }
+        }
         
         void Player::Private::cacheUpdate()
         {
             // Get the video ranges to be cached.
             const otime::TimeRange& timeRange = timeline->getTimeRange();
-            const otime::RationalTime readAheadDivided(
-                thread.cacheOptions.readAhead.value() / static_cast<double>(1 + thread.compare.size()),
-                thread.cacheOptions.readAhead.rate());
-            const otime::RationalTime readAheadRescaled = readAheadDivided.
-                rescaled_to(timeRange.duration().rate()).
-                floor();
-            const otime::RationalTime readBehindDivided(
-                thread.cacheOptions.readBehind.value() / static_cast<double>(1 + thread.compare.size()),
-                thread.cacheOptions.readBehind.rate());
-            const otime::RationalTime readBehindRescaled = readBehindDivided.
-                rescaled_to(timeRange.duration().rate()).
-                floor();
+            const double rate = timeRange.duration().rate();
+            // Fall back to the memory mode if the in/out range does not
+            // fit in the budget.
+            CacheMode cacheMode = thread.cacheOptions.mode;
+            if (CacheMode::InOut == cacheMode && !thread.cacheError.empty())
+            {
+                cacheMode = CacheMode::Memory;
+            }
+            switch (cacheMode)
+            {
+            case CacheMode::Memory:
+                // The window is adjusted by memoryCacheUpdate(). When the
+                // mode changes, start again with the read ahead and behind,
+                // limited by the budget if the frame size is known.
+                if (cacheMode != thread.cacheMode ||
+                    !time::isValid(thread.readAhead) ||
+                    !time::isValid(thread.readBehind))
+                {
+                    thread.readAhead = thread.cacheOptions.readAhead.rescaled_to(rate).floor();
+                    thread.readBehind = thread.cacheOptions.readBehind.rescaled_to(rate).floor();
+                    memoryCacheUpdate(0.0);
+                }
+                break;
+            case CacheMode::InOut:
+                thread.readAhead = thread.inOutRange.duration().rescaled_to(rate);
+                thread.readBehind = otime::RationalTime(0.0, rate);
+                break;
+            default:
+                thread.readAhead = otime::RationalTime(
+                    thread.cacheOptions.readAhead.value() / static_cast<double>(1 + thread.compare.size()),
+                    thread.cacheOptions.readAhead.rate()).
+                    rescaled_to(rate).
+                    floor();
+                thread.readBehind = otime::RationalTime(
+                    thread.cacheOptions.readBehind.value() / static_cast<double>(1 + thread.compare.size()),
+                    thread.cacheOptions.readBehind.rate()).
+                    rescaled_to(rate).
+                    floor();
+                break;
+            }
+            thread.cacheMode = cacheMode;
+            const otime::RationalTime readAheadRescaled = thread.readAhead;
+            const otime::RationalTime readBehindRescaled = thread.requestStep > 1 ?
+                otime::RationalTime(0.0, rate) :
+                thread.readBehind;
             otime::TimeRange videoRange = time::invalidTimeRange;
             switch (thread.cacheDirection)
             {
@@ -293,10 +663,46 @@ namespace tl
             //           << thread.cacheDirection << std::endl;
             // std::cout << "in out range: " << thread.inOutRange << std::endl;
             // std::cout << "video range: " << videoRange << std::endl;
-            auto videoRanges = timeline::loopCache(
-                videoRange,
-                thread.inOutRange,
-                thread.cacheDirection);
+            std::vector<otime::TimeRange> videoRanges;
+            if (CacheMode::InOut == cacheMode)
+            {
+                // Pin the whole in/out range. The range is split at the
+                // current time so the frames are requested in playback
+                // order starting from the current time, and all of the
+                // requests are issued at once so the timeline can keep
+                // all of its request threads busy.
+                const otime::RationalTime one(1.0, rate);
+                const otime::RationalTime start = thread.inOutRange.start_time();
+                const otime::RationalTime end = thread.inOutRange.end_time_inclusive();
+                const otime::RationalTime current = thread.inOutRange.contains(thread.currentTime) ?
+                    thread.currentTime :
+                    start;
+                switch (thread.cacheDirection)
+                {
+                case CacheDirection::Forward:
+                    videoRanges.push_back(otime::TimeRange::range_from_start_end_time_inclusive(current, end));
+                    if (current > start)
+                    {
+                        videoRanges.push_back(otime::TimeRange::range_from_start_end_time_inclusive(start, current - one));
+                    }
+                    break;
+                case CacheDirection::Reverse:
+                    videoRanges.push_back(otime::TimeRange::range_from_start_end_time_inclusive(start, current));
+                    if (current < end)
+                    {
+                        videoRanges.push_back(otime::TimeRange::range_from_start_end_time_inclusive(current + one, end));
+                    }
+                    break;
+                default: break;
+                }
+            }
+            else
+            {
+                videoRanges = timeline::loopCache(
+                    videoRange,
+                    thread.inOutRange,
+                    thread.cacheDirection);
+            }
             videoRanges.insert(
                 videoRanges.begin(),
                 otime::TimeRange(
@@ -305,7 +711,9 @@ namespace tl
 
             //! If we are at the start either playing backwards or stopping,
             //! we need to loop the cache read behind to the end (for looping).
-            if (mutex.playback != Playback::Forward &&
+            if (CacheMode::InOut != cacheMode &&
+                videoRanges.size() > 1 &&
+                mutex.playback != Playback::Forward &&
                 loop->get() == Loop::Loop &&
                 videoRanges[1].start_time() == thread.inOutRange.start_time())
             {
@@ -359,32 +767,25 @@ namespace tl
                 thread.inOutRange.end_time_inclusive() + audioOffsetAhead).
                     clamped(timeRange);
             //std::cout << "in out audio range: " << inOutAudioRange << std::endl;
-            const auto audioRanges = timeline::loopCache(
-                audioRange,
-                inOutAudioRange,
-                thread.cacheDirection);
+            const auto audioRanges = CacheMode::InOut == cacheMode ?
+                std::vector<otime::TimeRange>({ inOutAudioRange }) :
+                timeline::loopCache(
+                    audioRange,
+                    inOutAudioRange,
+                    thread.cacheDirection);
 
-            // Remove old video from the cache.
-            auto videoCacheIt = thread.videoDataCache.begin();
-            while (videoCacheIt != thread.videoDataCache.end())
+            // Remove old video from the cache. The frames outside of the
+            // window are removed first so they cannot replace frames in
+            // the window when the ring buffer shrinks.
+            double windowFrames = 0.0;
+            for (const auto& range : videoRanges)
             {
-                const otime::RationalTime t = videoCacheIt->first;
-                const auto j = std::find_if(
-                    videoRanges.begin(),
-                    videoRanges.end(),
-                    [t](const otime::TimeRange& value)
-                    {
-                        return value.contains(t);
-                    });
-                if (j == videoRanges.end())
-                {
-                    videoCacheIt = thread.videoDataCache.erase(videoCacheIt);
-                }
-                else
-                {
-                    ++videoCacheIt;
-                }
+                windowFrames += range.duration().rescaled_to(rate).value();
             }
+            thread.videoDataCache.removeOutside(videoRanges);
+            thread.videoDataCache.setWindow(
+                thread.inOutRange,
+                static_cast<size_t>(std::ceil(windowFrames)));
 
             // Remove old audio from the cache.
             {
@@ -417,8 +818,56 @@ namespace tl
             }
 
             // Get uncached video.
-            if (!ioInfo.video.empty())
+            if (!ioInfo.video.empty() && thread.requestStep > 1)
             {
+                // Decoding cannot keep up, cancel the requests outside of
+                // the window and request every Nth frame after the current
+                // time. The current frame is not requested again since it
+                // is already too late. The frames are aligned to the step
+                // so the same frames are requested each tick.
+                cancelVideoRequestsOutside(videoRanges, false);
+                const double step = thread.requestStep;
+                const otime::RationalTime inc(step, rate);
+                for (size_t i = 1; i < videoRanges.size(); ++i)
+                {
+                    const auto& range = videoRanges[i];
+                    switch (thread.cacheDirection)
+                    {
+                    case CacheDirection::Forward:
+                    {
+                        const otime::RationalTime first = range.contains(thread.currentTime) ?
+                            thread.currentTime + otime::RationalTime(1.0, rate) :
+                            range.start_time();
+                        const otime::RationalTime start(
+                            std::ceil(first.value() / step) * step,
+                            rate);
+                        forwardRequests(start, range.end_time_inclusive(), inc);
+                        break;
+                    }
+                    case CacheDirection::Reverse:
+                    {
+                        const otime::RationalTime first = range.contains(thread.currentTime) ?
+                            thread.currentTime - otime::RationalTime(1.0, rate) :
+                            range.end_time_inclusive();
+                        const otime::RationalTime start(
+                            std::floor(first.value() / step) * step,
+                            rate);
+                        reverseRequests(start, range.start_time(), inc);
+                        break;
+                    }
+                    default: break;
+                    }
+                }
+            }
+            else if (!ioInfo.video.empty())
+            {
+                // With compare the number of frames in flight is limited,
+                // cancel the requests that have left the window so they do
+                // not hold on to the decode threads.
+                if (!thread.compare.empty())
+                {
+                    cancelVideoRequestsOutside(videoRanges, true);
+                }
                 for (const auto& range : videoRanges)
                 {
                     switch (thread.cacheDirection)
@@ -428,7 +877,8 @@ namespace tl
                         // If we are stopped, and we are looping, we have to
                         // check the last video range we added at the end of
                         // the timeline to read it backwards
-                        if (mutex.playback == Playback::Stop &&
+                        if (CacheMode::InOut != cacheMode &&
+                            mutex.playback == Playback::Stop &&
                             loop->get() == Loop::Loop &&
                             range.start_time() != thread.inOutRange.start_time() &&
                             range.end_time_inclusive() == thread.inOutRange.end_time_inclusive())
@@ -547,14 +997,35 @@ namespace tl
             if (diff.count() > .5F)
             {
                 thread.cacheTimer = now;
-                std::vector<otime::RationalTime> cachedVideoFrames;
-                for (const auto& i : thread.videoDataCache)
+                decodeRateUpdate(diff.count());
+                if (CacheMode::InOut == thread.cacheOptions.mode && thread.frameByteCount > 0.0)
+                {
+                    // Check the in/out range against the budget with the
+                    // measured frame size.
+                    const size_t byteCount = getInOutByteCount(
+                        thread.inOutRange,
+                        thread.frameByteCount);
+                    thread.cacheError.clear();
+                    if (byteCount > thread.cacheOptions.memoryBudget)
+                    {
+                        thread.cacheError = string::Format(
+                            "The in/out range needs {0}MB which does not fit in the {1}MB cache budget").
+                            arg(byteCount / memory::megabyte).
+                            arg(thread.cacheOptions.memoryBudget / memory::megabyte);
+                    }
+                }
+                else
+                {
+                    thread.cacheError.clear();
+                }
+                if (CacheMode::Memory == cacheMode)
                 {
-                    cachedVideoFrames.push_back(i.first);
+                    memoryCacheUpdate(diff.count());
                 }
-                const float cachedVideoPercentage = cachedVideoFrames.size() /
-                    static_cast<float>(readAheadDivided.rescaled_to(timeRange.duration().rate()).value() +
-                        readBehindDivided.rescaled_to(timeRange.duration().rate()).value()) *
+                const size_t cachedVideoByteCount = thread.videoDataCache.getByteCount();
+                const float cachedVideoPercentage = thread.videoDataCache.getCount() /
+                    std::max(1.F, static_cast<float>(
+                        thread.readAhead.value() + thread.readBehind.value())) *
                     100.F;
                 std::vector<otime::RationalTime> cachedAudioFrames;
                 {
@@ -566,7 +1037,7 @@ namespace tl
                             1.0));
                     }
                 }
-                auto cachedVideoRanges = toRanges(cachedVideoFrames);
+                const auto cachedVideoRanges = thread.videoDataCache.getRanges();
                 auto cachedAudioRanges = toRanges(cachedAudioFrames);
                 for (auto& i : cachedAudioRanges)
                 {
@@ -580,10 +1051,127 @@ namespace tl
                     mutex.cacheInfo.videoPercentage = cachedVideoPercentage;
                     mutex.cacheInfo.videoFrames = cachedVideoRanges;
                     mutex.cacheInfo.audioFrames = cachedAudioRanges;
+                    mutex.cacheInfo.readAhead = thread.readAhead;
+                    mutex.cacheInfo.readBehind = thread.readBehind;
+                    mutex.cacheInfo.videoByteCount = cachedVideoByteCount;
+                    mutex.cacheInfo.pinnedRange = CacheMode::InOut == cacheMode ?
+                        thread.inOutRange :
+                        time::invalidTimeRange;
+                    mutex.cacheInfo.error = thread.cacheError;
                 }
             }
         }
 
+        double Player::Private::getPlayRate()
+        {
+            double out = 0.0;
+            if (thread.playback != Playback::Stop)
+            {
+                std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                out = audioMutex.speed;
+            }
+            return out;
+        }
+
+        void Player::Private::decodeRateUpdate(double elapsed)
+        {
+            // Measure the decode throughput while there are outstanding
+            // requests, an idle decoder says nothing about its speed.
+            if (elapsed > 0.0 && thread.decodedFrames > 0 && !thread.videoDataRequests.empty())
+            {
+                const double decodeRate = thread.decodedFrames / elapsed;
+                thread.decodeRate = thread.decodeRate > 0.0 ?
+                    (thread.decodeRate * .75 + decodeRate * .25) :
+                    decodeRate;
+            }
+            thread.decodedFrames = 0;
+
+            // With the real-time playback policy, only request every Nth
+            // frame when decoding cannot keep up with playback, so the
+            // requests target frames that can be ready in time.
+            thread.requestStep = 1;
+            const double playRate = getPlayRate();
+            if (PlaybackPolicy::RealTime == playerOptions.playbackPolicy &&
+                thread.decodeRate > 0.0 &&
+                thread.decodeRate < playRate)
+            {
+                thread.requestStep = std::min(
+                    static_cast<size_t>(std::ceil(playRate / thread.decodeRate)),
+                    requestStepMax);
+            }
+        }
+
+        void Player::Private::memoryCacheUpdate(double elapsed)
+        {
+            const double rate = timeline->getTimeRange().duration().rate();
+            if (thread.frameByteCount <= 0.0)
+                return;
+
+            // Find the number of frames that fit in the budget. The read
+            // behind takes at most a quarter of it, the rest is read ahead.
+            const double budgetFrames = std::floor(
+                thread.cacheOptions.memoryBudget / thread.frameByteCount);
+            const double readBehind = std::min(
+                thread.cacheOptions.readBehind.rescaled_to(rate).floor().value(),
+                std::floor(budgetFrames / 4.0));
+            const double readAheadMax = std::max(
+                1.0,
+                thread.cacheOptions.readAheadMax.rescaled_to(rate).floor().value());
+            const double readAhead = math::clamp(
+                budgetFrames - readBehind - 1.0,
+                1.0,
+                readAheadMax);
+
+            // Shrink the read ahead immediately so the cache stays within
+            // the budget. Grow it only as fast as the decoder can fill it
+            // on top of playback, so new requests stay close to the
+            // current time.
+            double value = thread.readAhead.value();
+            if (readAhead < value)
+            {
+                value = readAhead;
+            }
+            else if (readAhead > value)
+            {
+                const double growth = std::max(1.0, (thread.decodeRate - getPlayRate()) * elapsed);
+                value = std::min(readAhead, std::floor(value + growth));
+            }
+            thread.readAhead = otime::RationalTime(value, rate);
+            thread.readBehind = otime::RationalTime(std::max(0.0, readBehind), rate);
+        }
+
+        size_t Player::Private::getInOutByteCount(
+            const otime::TimeRange& range,
+            double frameByteCount) const
+        {
+            // Without a measured frame size, estimate it from the I/O
+            // information. This is only called from the main thread in
+            // that case, since it uses the observers.
+            if (frameByteCount <= 0.0)
+            {
+                const int layer = videoLayer->get();
+                if (layer >= 0 && layer < static_cast<int>(ioInfo.video.size()))
+                {
+                    frameByteCount += image::getDataByteCount(ioInfo.video[layer]);
+                }
+                else if (!ioInfo.video.empty())
+                {
+                    frameByteCount += image::getDataByteCount(ioInfo.video.front());
+                }
+                for (const auto& timeline : compare->get())
+                {
+                    const auto& info = timeline->getIOInfo();
+                    if (!info.video.empty())
+                    {
+                        frameByteCount += image::getDataByteCount(info.video.front());
+                    }
+                }
+            }
+            const double frames = range.duration().rescaled_to(
+                timeline->getTimeRange().duration().rate()).value();
+            return static_cast<size_t>(frameByteCount * frames);
+        }
+
         void Player::Private::log(const std::shared_ptr<system::Context>& context)
         {
             const std::string id = string::Format("tl::timeline::Player {0}").arg(this);
@@ -657,6 +1245,16 @@ namespace tl
                 ioOptionStrings.push_back(string::Format("{0}:{1}").arg(i.first).arg(i.second));
             }
 
+            std::vector<std::string> requestLatencyStrings;
+            const auto& requestLatency = thread.dropInfo.requestLatency;
+            for (size_t i = 0; i < requestLatency.size(); ++i)
+            {
+                requestLatencyStrings.push_back(string::Format("{0}{1}ms:{2}").
+                    arg(i < requestLatency.size() - 1 ? "<" : ">=").
+                    arg(i < requestLatency.size() - 1 ? (1 << i) : (1 << (i - 1))).
+                    arg(requestLatency[i]));
+            }
+
             auto logSystem = context->getLogSystem();
             logSystem->print(id, string::Format(
                 "\n"
@@ -664,23 +1262,27 @@ namespace tl
                 "    Current time: {1}\n"
                 "    In/out range: {2}\n"
                 "    I/O options: {3}\n"
-                "    Cache: {4} read ahead, {5} read behind\n"
-                "    Video: {6} requests, {7} cached\n"
-                "    Audio: {8} requests, {9} cached\n"
-                "    {10}\n"
-                "    {11}\n"
-                "    {12}\n"
+                "    Cache: {4} read ahead, {5} read behind, {6} mode\n"
+                "    Video: {7} requests, {8} cached, {9}MB\n"
+                "    Audio: {10} requests, {11} cached\n"
+                "    Video request latency: {12}\n"
+                "    {13}\n"
+                "    {14}\n"
+                "    {15}\n"
                 "    (T=current time, V=cached video, A=cached audio)").
                 arg(timeline->getPath().get()).
                 arg(currentTime).
                 arg(inOutRange).
                 arg(string::join(ioOptionStrings, ", ")).
-                arg(cacheOptions->get().readAhead).
-                arg(cacheOptions->get().readBehind).
+                arg(cacheInfo.readAhead).
+                arg(cacheInfo.readBehind).
+                arg(cacheOptions->get().mode).
                 arg(thread.videoDataRequests.size()).
-                arg(thread.videoDataCache.size()).
+                arg(thread.videoDataCache.getCount()).
+                arg(cacheInfo.videoByteCount / memory::megabyte).
                 arg(thread.audioDataRequests.size()).
                 arg(audioDataCacheSize).
+                arg(string::join(requestLatencyStrings, ", ")).
                 arg(currentTimeDisplay).
                 arg(cachedVideoFramesDisplay).
                 arg(cachedAudioFramesDisplay));
@@ -6,6 +6,8 @@
 
 #include <tlTimeline/Player.h>
 
+#include <tlTimeline/Edit.h>
+#include <tlTimeline/PlayerVideoCache.h>
 #include <tlTimeline/Util.h>
 
 #include <tlCore/AudioResample.h>
@@ -16,6 +18,8 @@
 #endif // TLRENDER_AUDIO
 
 #include <atomic>
+#include <condition_variable>
+#include <map>
 #include <mutex>
 #include <thread>
 
@@ -35,10 +39,28 @@ namespace tl
                                  const otime::RationalTime& inc,
                                  const bool clearFrame = false);
             void clearRequests();
+            void cancelVideoRequests(const std::vector<otime::RationalTime>&);
+            void cancelVideoRequestsOutside(
+                const std::vector<otime::TimeRange>&,
+                bool includeCurrentTime);
+            size_t getVideoRequestMax() const;
             void clearCache();
+            void editCache(const std::shared_ptr<EditDiff>&);
             void cacheUpdate();
+            double getPlayRate();
+            void decodeRateUpdate(double elapsed);
+            void memoryCacheUpdate(double elapsed);
+            size_t getInOutByteCount(
+                const otime::TimeRange&,
+                double frameByteCount) const;
 
             void finishedVideoRequests();
+            void notifyThread();
+            void addRequestCallback(const std::shared_ptr<Timeline>&);
+            void removeRequestCallback(const std::shared_ptr<Timeline>&);
+            void realTimeUpdate();
+            void readAheadUpdate();
+            void dropInfoUpdate();
             
             void resetAudioTime();
 #if defined(TLRENDER_AUDIO)
@@ -58,6 +80,7 @@ namespace tl
 
             PlayerOptions playerOptions;
             std::shared_ptr<Timeline> timeline;
+            otio::SerializableObject::Retainer<otio::Timeline> otioTimeline;
             io::Info ioInfo;
 
             std::shared_ptr<observer::Value<double> > speed;
@@ -71,6 +94,7 @@ namespace tl
             std::shared_ptr<observer::Value<int> > videoLayer;
             std::shared_ptr<observer::List<int> > compareVideoLayers;
             std::shared_ptr<observer::List<VideoData> > currentVideoData;
+            std::shared_ptr<observer::List<VideoData> > readAheadVideoData;
             std::shared_ptr<observer::Value<float> > volume;
             std::shared_ptr<observer::Value<bool> > mute;
             std::shared_ptr<observer::List<int> > channelMute;
@@ -78,8 +102,13 @@ namespace tl
             std::shared_ptr<observer::List<AudioData> > currentAudioData;
             std::shared_ptr<observer::Value<PlayerCacheOptions> > cacheOptions;
             std::shared_ptr<observer::Value<PlayerCacheInfo> > cacheInfo;
+            std::shared_ptr<observer::Value<PlayerDropInfo> > dropInfo;
             std::shared_ptr<observer::ValueObserver<bool> > timelineObserver;
 
+            // The request callbacks added to the timelines. Timelines can be
+            // shared between players, so each player only removes its own.
+            std::map<std::shared_ptr<Timeline>, uint64_t> requestCallbacks;
+
             struct Mutex
             {
                 Playback playback = Playback::Stop;
@@ -93,13 +122,17 @@ namespace tl
                 int videoLayer = 0;
                 std::vector<int> compareVideoLayers;
                 std::vector<VideoData> currentVideoData;
+                std::vector<VideoData> readAheadVideoData;
                 double audioOffset = 0.0;
                 std::vector<AudioData> currentAudioData;
                 bool clearRequests = false;
                 bool clearCache = false;
+                std::vector<std::shared_ptr<EditDiff> > edits;
                 CacheDirection cacheDirection = CacheDirection::Forward;
                 PlayerCacheOptions cacheOptions;
                 PlayerCacheInfo cacheInfo;
+                PlayerDropInfo dropInfo;
+                bool wake = false;
                 std::mutex mutex;
             };
             Mutex mutex;
@@ -131,14 +164,48 @@ namespace tl
                 CacheDirection cacheDirection = CacheDirection::Forward;
                 PlayerCacheOptions cacheOptions;
 
-                std::map<otime::RationalTime, std::vector<VideoRequest> > videoDataRequests;
-                std::map<otime::RationalTime, std::vector<VideoData> > videoDataCache;
+                // Effective cache mode and window at the timeline rate.
+                CacheMode cacheMode = CacheMode::Time;
+                otime::RationalTime readAhead = time::invalidTime;
+                otime::RationalTime readBehind = time::invalidTime;
+
+                // Average size of a cached frame in bytes, and the decode
+                // throughput in frames per second.
+                double frameByteCount = 0.0;
+                size_t decodedFrames = 0;
+                double decodeRate = 0.0;
+
+                // Error when the in/out range does not fit in the budget.
+                std::string cacheError;
+
+                // Presentation deadlines for the real-time playback policy.
+                otime::RationalTime deadlineTime = time::invalidTime;
+                bool deadlineMissed = false;
+                otime::RationalTime presentedTime = time::invalidTime;
+                size_t requestStep = 1;
+                PlayerDropInfo dropInfo;
+                size_t secondDroppedFrames = 0;
+                size_t secondLateFrames = 0;
+                std::chrono::steady_clock::time_point dropTimer;
+
+                // The video requests for a frame, one for the timeline and
+                // one for each compared timeline. The requests are scheduled
+                // as a unit and the frame is only cached when all of them
+                // have finished.
+                struct VideoFrameRequest
+                {
+                    std::vector<VideoRequest> requests;
+                    std::chrono::steady_clock::time_point timer;
+                };
+                std::map<otime::RationalTime, VideoFrameRequest> videoDataRequests;
+                PlayerVideoCache videoDataCache;
 #if defined(TLRENDER_AUDIO)
                 std::unique_ptr<RtAudio> rtAudio;
 #endif // TLRENDER_AUDIO
                 std::map<int64_t, AudioRequest> audioDataRequests;
                 std::chrono::steady_clock::time_point cacheTimer;
                 std::chrono::steady_clock::time_point logTimer;
+                std::condition_variable cv;
                 std::atomic<bool> running;
                 std::thread thread;
             };
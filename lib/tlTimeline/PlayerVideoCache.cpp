@@ -0,0 +1,347 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/PlayerVideoCache.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace tl
+{
+    namespace timeline
+    {
+        size_t getByteCount(const std::vector<VideoData>& value)
+        {
+            size_t out = 0;
+            for (const auto& videoData : value)
+            {
+                for (const auto& layer : videoData.layers)
+                {
+                    if (layer.image)
+                    {
+                        out += layer.image->getDataByteCount();
+                    }
+                    if (layer.imageB)
+                    {
+                        out += layer.imageB->getDataByteCount();
+                    }
+                }
+            }
+            return out;
+        }
+
+        namespace
+        {
+            // Get the smallest divisor of the duration that is at least as
+            // large as the window.
+            size_t getRingCapacity(int64_t duration, size_t window)
+            {
+                if (duration <= 0)
+                    return 0;
+                const size_t size = static_cast<size_t>(duration);
+                if (window >= size)
+                    return size;
+                size_t out = size;
+                for (size_t i = 1; i * i <= size; ++i)
+                {
+                    if (0 == size % i)
+                    {
+                        if (i >= window)
+                        {
+                            out = std::min(out, i);
+                        }
+                        const size_t j = size / i;
+                        if (j >= window)
+                        {
+                            out = std::min(out, j);
+                        }
+                    }
+                }
+                return out;
+            }
+        }
+
+        PlayerVideoCache::PlayerVideoCache()
+        {}
+
+        void PlayerVideoCache::setWindow(const otime::TimeRange& inOutRange, size_t frames)
+        {
+            const double rate = inOutRange.duration().rate();
+            const int64_t inOutStart = static_cast<int64_t>(std::round(inOutRange.start_time().value()));
+            const int64_t inOutDuration = static_cast<int64_t>(std::round(inOutRange.duration().value()));
+            const size_t capacity = getRingCapacity(inOutDuration, std::max(frames, size_t(1)));
+            if (rate == _rate &&
+                inOutStart == _inOutStart &&
+                inOutDuration == _inOutDuration &&
+                capacity == _ring.size())
+                return;
+
+            auto items = take();
+            _rate = rate;
+            _inOutStart = inOutStart;
+            _inOutDuration = inOutDuration;
+            _ring = std::vector<Slot>(capacity);
+            for (auto& i : items)
+            {
+                add(i.first, std::move(i.second));
+            }
+        }
+
+        size_t PlayerVideoCache::getCapacity() const
+        {
+            return _ring.size();
+        }
+
+        bool PlayerVideoCache::contains(const otime::RationalTime& time) const
+        {
+            return _getSlot(_getFrame(time)) != nullptr;
+        }
+
+        const std::vector<VideoData>* PlayerVideoCache::get(const otime::RationalTime& time) const
+        {
+            const Slot* slot = _getSlot(_getFrame(time));
+            return slot ? &slot->videoData : nullptr;
+        }
+
+        void PlayerVideoCache::add(const otime::RationalTime& time, std::vector<VideoData> videoData)
+        {
+            if (_rate <= 0.0)
+            {
+                _rate = time.rate();
+            }
+            const int64_t frame = _getFrame(time);
+            Slot* slot = nullptr;
+            if (!_ring.empty() &&
+                frame >= _inOutStart &&
+                frame < _inOutStart + _inOutDuration)
+            {
+                slot = &_ring[(frame - _inOutStart) % _ring.size()];
+            }
+            else
+            {
+                slot = &_outside[frame];
+            }
+            if (slot->valid)
+            {
+                _remove(*slot);
+            }
+            slot->valid = true;
+            slot->frame = frame;
+            slot->time = time;
+            slot->byteCount = timeline::getByteCount(videoData);
+            slot->videoData = std::move(videoData);
+            _addRange(frame);
+            ++_count;
+            _byteCount += slot->byteCount;
+        }
+
+        void PlayerVideoCache::remove(const otime::RationalTime& time)
+        {
+            const int64_t frame = _getFrame(time);
+            if (Slot* slot = _getSlot(frame))
+            {
+                _remove(*slot);
+                _outside.erase(frame);
+            }
+        }
+
+        void PlayerVideoCache::removeOutside(const std::vector<otime::TimeRange>& ranges)
+        {
+            std::vector<std::pair<int64_t, int64_t> > window;
+            for (const auto& range : ranges)
+            {
+                window.push_back(std::make_pair(
+                    _getFrame(range.start_time()),
+                    _getFrame(range.end_time_inclusive())));
+            }
+            std::sort(window.begin(), window.end());
+
+            // Subtract the window from the cached ranges, only the frames
+            // that are left need to be visited.
+            std::vector<std::pair<int64_t, int64_t> > outside;
+            for (const auto& range : _ranges)
+            {
+                int64_t cursor = range.first;
+                for (const auto& i : window)
+                {
+                    if (i.second < cursor)
+                        continue;
+                    if (i.first > range.second)
+                        break;
+                    if (i.first > cursor)
+                    {
+                        outside.push_back(std::make_pair(cursor, i.first - 1));
+                    }
+                    cursor = std::max(cursor, i.second + 1);
+                    if (cursor > range.second)
+                        break;
+                }
+                if (cursor <= range.second)
+                {
+                    outside.push_back(std::make_pair(cursor, range.second));
+                }
+            }
+            for (const auto& range : outside)
+            {
+                for (int64_t frame = range.first; frame <= range.second; ++frame)
+                {
+                    if (Slot* slot = _getSlot(frame))
+                    {
+                        _remove(*slot);
+                        _outside.erase(frame);
+                    }
+                }
+            }
+        }
+
+        std::vector<std::pair<otime::RationalTime, std::vector<VideoData> > > PlayerVideoCache::take()
+        {
+            std::vector<std::pair<otime::RationalTime, std::vector<VideoData> > > out;
+            out.reserve(_count);
+            for (auto& slot : _ring)
+            {
+                if (slot.valid)
+                {
+                    out.push_back(std::make_pair(slot.time, std::move(slot.videoData)));
+                }
+            }
+            for (auto& i : _outside)
+            {
+                if (i.second.valid)
+                {
+                    out.push_back(std::make_pair(i.second.time, std::move(i.second.videoData)));
+                }
+            }
+            clear();
+            return out;
+        }
+
+        void PlayerVideoCache::clear()
+        {
+            for (auto& slot : _ring)
+            {
+                slot = Slot();
+            }
+            _outside.clear();
+            _ranges.clear();
+            _count = 0;
+            _byteCount = 0;
+        }
+
+        size_t PlayerVideoCache::getCount() const
+        {
+            return _count;
+        }
+
+        size_t PlayerVideoCache::getByteCount() const
+        {
+            return _byteCount;
+        }
+
+        std::vector<otime::TimeRange> PlayerVideoCache::getRanges() const
+        {
+            std::vector<otime::TimeRange> out;
+            out.reserve(_ranges.size());
+            for (const auto& i : _ranges)
+            {
+                out.push_back(otime::TimeRange::range_from_start_end_time_inclusive(
+                    otime::RationalTime(i.first, _rate),
+                    otime::RationalTime(i.second, _rate)));
+            }
+            return out;
+        }
+
+        int64_t PlayerVideoCache::_getFrame(const otime::RationalTime& time) const
+        {
+            return static_cast<int64_t>(std::round(
+                _rate > 0.0 ? time.rescaled_to(_rate).value() : time.value()));
+        }
+
+        PlayerVideoCache::Slot* PlayerVideoCache::_getSlot(int64_t frame)
+        {
+            return const_cast<Slot*>(static_cast<const PlayerVideoCache*>(this)->_getSlot(frame));
+        }
+
+        const PlayerVideoCache::Slot* PlayerVideoCache::_getSlot(int64_t frame) const
+        {
+            const Slot* out = nullptr;
+            if (!_ring.empty() &&
+                frame >= _inOutStart &&
+                frame < _inOutStart + _inOutDuration)
+            {
+                out = &_ring[(frame - _inOutStart) % _ring.size()];
+            }
+            else
+            {
+                const auto i = _outside.find(frame);
+                if (i != _outside.end())
+                {
+                    out = &i->second;
+                }
+            }
+            return out && out->valid && out->frame == frame ? out : nullptr;
+        }
+
+        void PlayerVideoCache::_remove(Slot& slot)
+        {
+            _removeRange(slot.frame);
+            --_count;
+            _byteCount -= slot.byteCount;
+            slot = Slot();
+        }
+
+        void PlayerVideoCache::_addRange(int64_t frame)
+        {
+            auto next = _ranges.upper_bound(frame);
+            const bool mergeNext = next != _ranges.end() && next->first == frame + 1;
+            if (next != _ranges.begin())
+            {
+                auto prev = std::prev(next);
+                if (prev->second >= frame)
+                    return;
+                if (prev->second + 1 == frame)
+                {
+                    prev->second = mergeNext ? next->second : frame;
+                    if (mergeNext)
+                    {
+                        _ranges.erase(next);
+                    }
+                    return;
+                }
+            }
+            if (mergeNext)
+            {
+                const int64_t end = next->second;
+                _ranges.erase(next);
+                _ranges[frame] = end;
+            }
+            else
+            {
+                _ranges[frame] = frame;
+            }
+        }
+
+        void PlayerVideoCache::_removeRange(int64_t frame)
+        {
+            auto i = _ranges.upper_bound(frame);
+            if (i == _ranges.begin())
+                return;
+            --i;
+            if (i->second < frame)
+                return;
+            const int64_t start = i->first;
+            const int64_t end = i->second;
+            _ranges.erase(i);
+            if (start < frame)
+            {
+                _ranges[start] = frame - 1;
+            }
+            if (frame < end)
+            {
+                _ranges[frame + 1] = end;
+            }
+        }
+    }
+}
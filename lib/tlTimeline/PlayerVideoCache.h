@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/Video.h>
+
+#include <map>
+#include <utility>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Get the size of video data in bytes.
+        size_t getByteCount(const std::vector<VideoData>&);
+
+        //! Timeline player video cache.
+        //!
+        //! Frames inside the in/out range are stored in a ring buffer
+        //! indexed by frame number. The capacity is a divisor of the in/out
+        //! duration at least as large as the cache window, so the frames of
+        //! a window that wraps around the in/out points never share a slot.
+        //! Frames outside of the in/out range are stored in a map. The
+        //! cached ranges and the size in bytes are updated as frames are
+        //! added and removed.
+        class PlayerVideoCache
+        {
+        public:
+            PlayerVideoCache();
+
+            //! Set the in/out range and the maximum number of frames in the
+            //! cache window. The cached frames are kept, but when the ring
+            //! buffer shrinks frames that map to the same slot replace each
+            //! other, so remove the frames outside of the window first.
+            void setWindow(const otime::TimeRange& inOutRange, size_t frames);
+
+            //! Get the ring buffer capacity.
+            size_t getCapacity() const;
+
+            //! Get whether the cache contains the given time.
+            bool contains(const otime::RationalTime&) const;
+
+            //! Get the video data for the given time, or null if it is not
+            //! cached.
+            const std::vector<VideoData>* get(const otime::RationalTime&) const;
+
+            //! Add video data, replacing any video data in the same slot.
+            void add(const otime::RationalTime&, std::vector<VideoData>);
+
+            //! Remove the video data for the given time.
+            void remove(const otime::RationalTime&);
+
+            //! Remove the video data outside of the given ranges.
+            void removeOutside(const std::vector<otime::TimeRange>&);
+
+            //! Remove and return all of the video data.
+            std::vector<std::pair<otime::RationalTime, std::vector<VideoData> > > take();
+
+            //! Clear the cache.
+            void clear();
+
+            //! Get the number of cached frames.
+            size_t getCount() const;
+
+            //! Get the size of the cached video data in bytes.
+            size_t getByteCount() const;
+
+            //! Get the cached ranges.
+            std::vector<otime::TimeRange> getRanges() const;
+
+        private:
+            struct Slot
+            {
+                bool valid = false;
+                int64_t frame = 0;
+                otime::RationalTime time = time::invalidTime;
+                std::vector<VideoData> videoData;
+                size_t byteCount = 0;
+            };
+
+            int64_t _getFrame(const otime::RationalTime&) const;
+            Slot* _getSlot(int64_t frame);
+            const Slot* _getSlot(int64_t frame) const;
+            void _remove(Slot&);
+            void _addRange(int64_t frame);
+            void _removeRange(int64_t frame);
+
+            double _rate = 0.0;
+            int64_t _inOutStart = 0;
+            int64_t _inOutDuration = 0;
+            std::vector<Slot> _ring;
+            std::map<int64_t, Slot> _outside;
+            std::map<int64_t, int64_t> _ranges;
+            size_t _count = 0;
+            size_t _byteCount = 0;
+        };
+    }
+}
@@ -26,6 +26,12 @@ namespace tl
             //! Texture cache byte count.
             size_t textureCacheByteCount = memory::gigabyte / 4;
 
+            //! Texture pool byte count.
+            size_t texturePoolByteCount = memory::gigabyte / 8;
+
+            //! Batch primitives into fewer draw calls.
+            bool batchPrimitives = true;
+
             bool operator == (const RenderOptions&) const;
             bool operator != (const RenderOptions&) const;
         };
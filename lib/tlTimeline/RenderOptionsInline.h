@@ -12,7 +12,9 @@ namespace tl
                 clear == other.clear &&
                 clearColor == other.clearColor &&
                 colorBuffer == other.colorBuffer &&
-                textureCacheByteCount == other.textureCacheByteCount;
+                textureCacheByteCount == other.textureCacheByteCount &&
+                texturePoolByteCount == other.texturePoolByteCount &&
+                batchPrimitives == other.batchPrimitives;
         }
 
         inline bool RenderOptions::operator != (const RenderOptions& other) const
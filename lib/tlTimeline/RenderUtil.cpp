@@ -19,6 +19,7 @@ namespace tl
         {
             TLRENDER_P();
             p.render = render;
+            p.render->flush();
             p.size = render->getRenderSize();
         }
 
@@ -39,6 +40,7 @@ namespace tl
         {
             TLRENDER_P();
             p.render = render;
+            p.render->flush();
             p.viewport = render->getViewport();
         }
 
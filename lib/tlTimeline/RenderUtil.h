@@ -10,7 +10,8 @@ namespace tl
 {
     namespace timeline
     {
-        //! Set and restore the render size.
+        //! Set and restore the render size. The render is flushed so the
+        //! OpenGL state can be changed outside of the renderer.
         class RenderSizeState
         {
         public:
@@ -22,7 +23,8 @@ namespace tl
             TLRENDER_PRIVATE();
         };
 
-        //! Set and restore the viewport.
+        //! Set and restore the viewport. The render is flushed so the OpenGL
+        //! state can be changed outside of the renderer.
         class ViewportState
         {
         public:
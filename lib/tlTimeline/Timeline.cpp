@@ -19,7 +19,7 @@ namespace tl
     {
         namespace
         {
-            const size_t readCacheMax = 10;
+            const size_t readCacheMin = 10;
         }
 
         TLRENDER_ENUM_IMPL(
@@ -38,6 +38,9 @@ namespace tl
                 videoRequestCount == other.videoRequestCount &&
                 audioRequestCount == other.audioRequestCount &&
                 requestTimeout == other.requestTimeout &&
+                probeThreadCount == other.probeThreadCount &&
+                readerMax == other.readerMax &&
+                readerLookAhead == other.readerLookAhead &&
                 ioOptions == other.ioOptions &&
                 pathOptions == other.pathOptions;
         }
@@ -47,6 +50,24 @@ namespace tl
             return !(*this == other);
         }
 
+        bool ReadStats::operator == (const ReadStats& other) const
+        {
+            return
+                readerMax == other.readerMax &&
+                readerCount == other.readerCount &&
+                opens == other.opens &&
+                lookAheadOpens == other.lookAheadOpens &&
+                hits == other.hits &&
+                evictions == other.evictions &&
+                openTime == other.openTime &&
+                infoWaitTime == other.infoWaitTime;
+        }
+
+        bool ReadStats::operator != (const ReadStats& other) const
+        {
+            return !(*this == other);
+        }
+
         void Timeline::_init(
             const otio::SerializableObject::Retainer<otio::Timeline>& otioTimeline,
             const std::shared_ptr<system::Context>& context,
@@ -70,6 +91,12 @@ namespace tl
                     arg(options.audioRequestCount));
                 lines.push_back(string::Format("    Request timeout: {0}ms").
                     arg(options.requestTimeout.count()));
+                lines.push_back(string::Format("    Probe thread count: {0}").
+                    arg(options.probeThreadCount));
+                lines.push_back(string::Format("    Reader max: {0}").
+                    arg(options.readerMax));
+                lines.push_back(string::Format("    Reader look ahead: {0}").
+                    arg(options.readerLookAhead));
                 for (const auto& i : options.ioOptions)
                 {
                     lines.push_back(string::Format("    AV I/O {0}: {1}").
@@ -86,6 +113,7 @@ namespace tl
             p.context = context;
             p.otioTimeline = otioTimeline;
             p.timelineChanges = observer::Value<bool>::create(false);
+            p.timelineReady = observer::Value<bool>::create(false);
             const auto i = otioTimeline->metadata().find("tlRender");
             if (i != otioTimeline->metadata().end())
             {
@@ -107,7 +135,8 @@ namespace tl
                 {}
             }
             p.options = options;
-            p.readCache.setMax(readCacheMax);
+            p.readCache.setMax(std::min(readCacheMin, options.readerMax));
+            p.mutex.readStats.readerMax = p.readCache.getMax();
 
             // Get information about the timeline.
             p.timeRange = timeline::getTimeRange(p.otioTimeline.value);
@@ -170,6 +199,15 @@ namespace tl
                 arg(p.ioInfo.audio.dataType).
                 arg(p.ioInfo.audio.sampleRate));
 
+            // Probe the rest of the clips in the background, only the
+            // information of the first clips is needed to create the
+            // timeline.
+            p.startProbe();
+            if (p.probe.items.empty())
+            {
+                p.timelineReady->setIfChanged(true);
+            }
+
             // Create a new thread.
             p.mutex.otioTimeline = p.otioTimeline;
             p.thread.running = true;
@@ -193,11 +231,26 @@ namespace tl
         Timeline::~Timeline()
         {
             TLRENDER_P();
-            p.thread.running = false;
+            p.stopProbe();
+            {
+                // Set the flag with the mutex locked so the thread cannot
+                // miss the notification between checking the predicate and
+                // waiting.
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.thread.running = false;
+            }
+            p.thread.cv.notify_one();
             if (p.thread.thread.joinable())
             {
                 p.thread.thread.join();
             }
+            for (const auto& read : p.readCache.getValues())
+            {
+                if (read)
+                {
+                    read->setRequestCallback(nullptr);
+                }
+            }
         }
 
         const std::weak_ptr<system::Context>& Timeline::getContext() const
@@ -215,17 +268,25 @@ namespace tl
             return _p->timelineChanges;
         }
 
+        std::shared_ptr<observer::IValue<bool> > Timeline::observeTimelineReady() const
+        {
+            return _p->timelineReady;
+        }
+
         void Timeline::setTimeline(const otio::SerializableObject::Retainer<otio::Timeline>& value)
         {
             TLRENDER_P();
             p.otioTimeline = value;
             if (p.otioTimeline.value)
                 p.timeRange = timeline::getTimeRange(p.otioTimeline.value);
-            std::unique_lock<std::mutex> lock(p.mutex.mutex);
-            if (!p.mutex.stopped)
             {
-                p.mutex.otioTimeline = value;
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (!p.mutex.stopped)
+                {
+                    p.mutex.otioTimeline = value;
+                }
             }
+            p.thread.cv.notify_one();
         }
 
         const file::Path& Timeline::getPath() const
@@ -253,6 +314,13 @@ namespace tl
             return _p->ioInfo;
         }
 
+        ReadStats Timeline::getReadStats() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.readStats;
+        }
+
         VideoRequest Timeline::getVideo(
             const otime::RationalTime& time,
             const io::Options& options)
@@ -355,6 +423,22 @@ namespace tl
             }
         }
 
+        uint64_t Timeline::addRequestCallback(const std::function<void(void)>& value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.requestCallback.mutex);
+            const uint64_t id = ++p.requestCallback.id;
+            p.requestCallback.callbacks[id] = value;
+            return id;
+        }
+
+        void Timeline::removeRequestCallback(uint64_t id)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.requestCallback.mutex);
+            p.requestCallback.callbacks.erase(id);
+        }
+
         void Timeline::tick()
         {
             TLRENDER_P();
@@ -368,6 +452,22 @@ namespace tl
             {
                 p.timelineChanges->setAlways(true);
             }
+            if (!p.timelineReady->get() &&
+                p.probe.finished >= p.probe.items.size())
+            {
+                p.stopProbe();
+                if (auto context = p.context.lock())
+                {
+                    const auto t1 = std::chrono::steady_clock::now();
+                    const std::chrono::duration<float> diff = t1 - p.probe.startTime;
+                    context->getLogSystem()->print(
+                        string::Format("tl::timeline::Timeline {0}").arg(this),
+                        string::Format("Probed {0} clips in {1} seconds").
+                            arg(p.probe.items.size()).
+                            arg(diff.count()));
+                }
+                p.timelineReady->setIfChanged(true);
+            }
         }
     }
 }
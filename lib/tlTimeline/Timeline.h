@@ -13,6 +13,7 @@
 
 #include <opentimelineio/timeline.h>
 
+#include <functional>
 #include <future>
 
 namespace tl
@@ -45,6 +46,23 @@ namespace tl
             size_t audioRequestCount = 16;
             std::chrono::milliseconds requestTimeout = std::chrono::milliseconds(5);
 
+            //! Number of threads used to probe the clip information in the
+            //! background after the timeline is created. The information is
+            //! stored in the I/O cache, and clips already in the cache are
+            //! not probed. Zero disables probing.
+            size_t probeThreadCount = 4;
+
+            //! Maximum number of open readers. The reader pool grows to fit
+            //! two readers for each track, so the clips on either side of a
+            //! cut can be open at the same time, but never beyond this
+            //! limit to bound the number of open file handles.
+            size_t readerMax = 64;
+
+            //! How far ahead of the requested times readers are opened, so
+            //! clips are already open and probed when their first frames
+            //! are requested. Zero disables opening readers ahead.
+            otime::RationalTime readerLookAhead = otime::RationalTime(2.0, 1.0);
+
             io::Options ioOptions;
 
             file::PathOptions pathOptions;
@@ -71,6 +89,22 @@ namespace tl
             const otime::RationalTime& = time::invalidTime,
             const Options& = Options());
 
+        //! Reader statistics.
+        struct ReadStats
+        {
+            size_t readerMax      = 0;   //!< Current size of the reader pool
+            size_t readerCount    = 0;   //!< Current number of open readers
+            size_t opens          = 0;   //!< Number of readers opened
+            size_t lookAheadOpens = 0;   //!< Number of readers opened ahead of their first request
+            size_t hits           = 0;   //!< Number of requests that found an open reader
+            size_t evictions      = 0;   //!< Number of readers closed to make room for others
+            double openTime       = 0.0; //!< Time spent opening readers in seconds
+            double infoWaitTime   = 0.0; //!< Time spent waiting for reader information in seconds
+
+            bool operator == (const ReadStats&) const;
+            bool operator != (const ReadStats&) const;
+        };
+
         //! Video request.
         struct VideoRequest
         {
@@ -151,6 +185,12 @@ namespace tl
             //! Observe timeline changes.
             std::shared_ptr<observer::IValue<bool> > observeTimelineChanges() const;
 
+            //! Observe when the timeline is ready. The information of the
+            //! first clips is read when the timeline is created, the rest
+            //! of the clips are probed in the background. The timeline is
+            //! ready when all of the clips have been probed.
+            std::shared_ptr<observer::IValue<bool> > observeTimelineReady() const;
+
             //! Set the timeline.
             void setTimeline(const otio::SerializableObject::Retainer<otio::Timeline>&);
 
@@ -173,6 +213,9 @@ namespace tl
             //! the first clip in the timeline.
             const io::Info& getIOInfo() const;
 
+            //! Get the reader statistics.
+            ReadStats getReadStats() const;
+
             ///@}
 
             //! \name Video and Audio Data
@@ -191,6 +234,15 @@ namespace tl
             //! Cancel requests.
             void cancelRequests(const std::vector<uint64_t>&);
 
+            //! Add a callback that is called when requests have finished.
+            //! The callback is called from the timeline thread after the
+            //! futures are ready. Returns an ID for removing the callback.
+            uint64_t addRequestCallback(const std::function<void(void)>&);
+
+            //! Remove a request callback. The callback is not called after
+            //! this function returns.
+            void removeRequestCallback(uint64_t);
+
             ///@}
 
             //! Tick the timeline.
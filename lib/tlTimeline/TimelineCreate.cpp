@@ -17,6 +17,8 @@
 #include <opentimelineio/imageSequenceReference.h>
 #include <opentimelineio/serializableCollection.h>
 
+#include <map>
+
 #include <mz.h>
 #include <mz_strm.h>
 #include <mz_zip.h>
@@ -174,8 +176,88 @@ namespace tl
             void* reader = nullptr;
         };
 
+        namespace
+        {
+            struct ZipEntry
+            {
+                uint64_t diskOffset = 0;
+                uint64_t compressedSize = 0;
+                uint64_t uncompressedSize = 0;
+                uint16_t compressionMethod = MZ_COMPRESS_METHOD_STORE;
+            };
+
+            std::map<std::string, ZipEntry> getZipEntries(void* reader)
+            {
+                std::map<std::string, ZipEntry> out;
+                int32_t err = mz_zip_reader_goto_first_entry(reader);
+                while (MZ_OK == err)
+                {
+                    mz_zip_file* fileInfo = nullptr;
+                    if (MZ_OK == mz_zip_reader_entry_get_info(reader, &fileInfo) &&
+                        fileInfo->filename)
+                    {
+                        ZipEntry entry;
+                        entry.diskOffset = fileInfo->disk_offset;
+                        entry.compressedSize = fileInfo->compressed_size;
+                        entry.uncompressedSize = fileInfo->uncompressed_size;
+                        entry.compressionMethod = fileInfo->compression_method;
+                        out[fileInfo->filename] = entry;
+                    }
+                    err = mz_zip_reader_goto_next_entry(reader);
+                }
+                return out;
+            }
+
+            const uint8_t* getZipEntryData(
+                const std::shared_ptr<file::FileIO>& fileIO,
+                const ZipEntry& entry,
+                const std::string& fileName)
+            {
+                switch (entry.compressionMethod)
+                {
+                case MZ_COMPRESS_METHOD_STORE:
+                case MZ_COMPRESS_METHOD_DEFLATE: break;
+                default:
+                    throw std::runtime_error(string::Format(
+                        "{0}: Unsupported zip compression method").arg(fileName));
+                }
+
+                // The size of the local header can be different than the
+                // central directory information, so read the file name and
+                // extra field lengths from the local header.
+                const uint8_t* start = fileIO->getMemoryStart();
+                const uint64_t size = fileIO->getSize();
+                const size_t localHeaderSize = 30;
+                if (!start || entry.diskOffset + localHeaderSize > size)
+                {
+                    throw std::runtime_error(string::Format(
+                        "{0}: Cannot read zip entry").arg(fileName));
+                }
+                const uint8_t* header = start + entry.diskOffset;
+                if (header[0] != 0x50 || header[1] != 0x4b || header[2] != 0x03 || header[3] != 0x04)
+                {
+                    throw std::runtime_error(string::Format(
+                        "{0}: Invalid zip entry").arg(fileName));
+                }
+                const uint16_t fileNameSize = header[26] | (header[27] << 8);
+                const uint16_t extraFieldSize = header[28] | (header[29] << 8);
+                const uint64_t offset =
+                    entry.diskOffset +
+                    localHeaderSize +
+                    fileNameSize +
+                    extraFieldSize;
+                if (offset + entry.compressedSize > size)
+                {
+                    throw std::runtime_error(string::Format(
+                        "{0}: Cannot read zip entry").arg(fileName));
+                }
+                return start + offset;
+            }
+        }
+
         otio::SerializableObject::Retainer<otio::Timeline> readOTIO(
             const file::Path& path,
+            const std::weak_ptr<log::System>& logSystem,
             otio::ErrorStatus* errorStatus)
         {
             otio::SerializableObject::Retainer<otio::Timeline> out;
@@ -225,23 +307,30 @@ namespace tl
                         throw std::runtime_error(string::Format(
                             "{0}: Cannot get zip entry information").arg(contentFileName));
                     }
-                    ZipReaderFile zipReaderFile(zipReader.reader, contentFileName);
                     std::vector<char> buf;
-                    buf.resize(fileInfo->uncompressed_size + 1);
-                    err = mz_zip_reader_entry_read(
-                        zipReader.reader,
-                        buf.data(),
-                        fileInfo->uncompressed_size);
-                    if (err != fileInfo->uncompressed_size)
                     {
-                        throw std::runtime_error(string::Format(
-                            "{0}: Cannot read zip entry").arg(contentFileName));
+                        ZipReaderFile zipReaderFile(zipReader.reader, contentFileName);
+                        buf.resize(fileInfo->uncompressed_size + 1);
+                        err = mz_zip_reader_entry_read(
+                            zipReader.reader,
+                            buf.data(),
+                            fileInfo->uncompressed_size);
+                        if (err != fileInfo->uncompressed_size)
+                        {
+                            throw std::runtime_error(string::Format(
+                                "{0}: Cannot read zip entry").arg(contentFileName));
+                        }
+                        buf[fileInfo->uncompressed_size] = 0;
                     }
-                    buf[fileInfo->uncompressed_size] = 0;
 
                     out = dynamic_cast<otio::Timeline*>(
                         otio::Timeline::from_json_string(buf.data(), errorStatus));
 
+                    // Index the zip entries with a single pass over the
+                    // central directory. The media is referenced directly
+                    // in the memory mapped file, so opening the file only
+                    // depends on the number of entries and not their size.
+                    const auto zipEntries = getZipEntries(zipReader.reader);
                     auto fileIO = file::FileIO::create(fileName, file::Mode::Read);
                     for (auto clip : out->find_children<otio::Clip>())
                     {
@@ -250,33 +339,33 @@ namespace tl
                         {
                             const std::string mediaFileName = file::Path(
                                 externalReference->target_url()).get();
-
-                            int32_t err = mz_zip_reader_locate_entry(zipReader.reader, mediaFileName.c_str(), 0);
-                            if (err != MZ_OK)
+                            const auto i = zipEntries.find(mediaFileName);
+                            if (i == zipEntries.end())
                             {
                                 throw std::runtime_error(string::Format(
                                     "{0}: Cannot find zip entry").arg(mediaFileName));
                             }
-                            err = mz_zip_reader_entry_get_info(zipReader.reader, &fileInfo);
-                            if (err != MZ_OK)
-                            {
-                                throw std::runtime_error(string::Format(
-                                    "{0}: Cannot get zip entry information").arg(mediaFileName));
-                            }
-
-                            const size_t headerSize =
-                                30 +
-                                fileInfo->filename_size +
-                                fileInfo->extrafield_size;
+                            const uint8_t* data = getZipEntryData(fileIO, i->second, mediaFileName);
+                            const bool compressed = i->second.compressionMethod != MZ_COMPRESS_METHOD_STORE;
                             auto memoryReference = new ZipMemoryReference(
                                 fileIO,
                                 externalReference->target_url(),
-                                fileIO->getMemoryStart() +
-                                fileInfo->disk_offset +
-                                headerSize,
-                                fileInfo->uncompressed_size,
+                                !compressed ? data : nullptr,
+                                !compressed ? i->second.uncompressedSize : 0,
                                 externalReference->available_range(),
                                 externalReference->metadata());
+                            if (compressed)
+                            {
+                                ZipCompressedData::Entry entry;
+                                entry.name = mediaFileName;
+                                entry.data = data;
+                                entry.size = i->second.compressedSize;
+                                entry.uncompressed_size = i->second.uncompressedSize;
+                                memoryReference->set_compressed_data(
+                                    std::make_shared<ZipCompressedData>(
+                                        std::vector<ZipCompressedData::Entry>({ entry }),
+                                        logSystem));
+                            }
                             clip->set_media_reference(memoryReference);
                         }
                         else if (auto imageSequenceReference =
@@ -284,35 +373,38 @@ namespace tl
                         {
                             std::vector<const uint8_t*> memory;
                             std::vector<size_t> memory_sizes;
+                            std::vector<ZipCompressedData::Entry> compressedEntries;
+                            bool compressed = false;
                             for (int number = 0;
                                 number < imageSequenceReference->number_of_images_in_sequence();
                                 ++number)
                             {
                                 const std::string mediaFileName = file::Path(
                                     imageSequenceReference->target_url_for_image_number(number)).get();
-
-                                int32_t err = mz_zip_reader_locate_entry(zipReader.reader, mediaFileName.c_str(), 0);
-                                if (err != MZ_OK)
+                                const auto i = zipEntries.find(mediaFileName);
+                                if (i == zipEntries.end())
                                 {
                                     throw std::runtime_error(string::Format(
                                         "{0}: Cannot find zip entry").arg(mediaFileName));
                                 }
-                                err = mz_zip_reader_entry_get_info(zipReader.reader, &fileInfo);
-                                if (err != MZ_OK)
+                                const uint8_t* data = getZipEntryData(fileIO, i->second, mediaFileName);
+                                ZipCompressedData::Entry entry;
+                                if (i->second.compressionMethod != MZ_COMPRESS_METHOD_STORE)
                                 {
-                                    throw std::runtime_error(string::Format(
-                                        "{0}: Cannot get zip entry information").arg(mediaFileName));
+                                    entry.name = mediaFileName;
+                                    entry.data = data;
+                                    entry.size = i->second.compressedSize;
+                                    entry.uncompressed_size = i->second.uncompressedSize;
+                                    memory.push_back(nullptr);
+                                    memory_sizes.push_back(0);
+                                    compressed = true;
                                 }
-
-                                const size_t headerSize =
-                                    30 +
-                                    fileInfo->filename_size +
-                                    fileInfo->extrafield_size;
-                                memory.push_back(
-                                    fileIO->getMemoryStart() +
-                                    fileInfo->disk_offset +
-                                    headerSize);
-                                memory_sizes.push_back(fileInfo->uncompressed_size);
+                                else
+                                {
+                                    memory.push_back(data);
+                                    memory_sizes.push_back(i->second.uncompressedSize);
+                                }
+                                compressedEntries.push_back(entry);
                             }
                             auto memoryReference = new ZipMemorySequenceReference(
                                 fileIO,
@@ -321,6 +413,13 @@ namespace tl
                                 memory_sizes,
                                 imageSequenceReference->available_range(),
                                 imageSequenceReference->metadata());
+                            if (compressed)
+                            {
+                                memoryReference->set_compressed_data(
+                                    std::make_shared<ZipCompressedData>(
+                                        compressedEntries,
+                                        logSystem));
+                            }
                             clip->set_media_reference(memoryReference);
                         }
                     }
@@ -431,10 +530,9 @@ namespace tl
                 }
 
                 // Is the input a video or audio file?
-                if (auto read = ioSystem->read(path, options.ioOptions))
+                io::Info info;
+                if (ioSystem->getInfo(path, {}, options.ioOptions, info))
                 {
-                    const auto info = read->getInfo().get();
-
                     otime::RationalTime startTime = time::invalidTime;
                     otio::Track* videoTrack = nullptr;
                     otio::Track* audioTrack = nullptr;
@@ -484,7 +582,8 @@ namespace tl
                     // Read the separate audio if provided.
                     if (!audioPath.isEmpty())
                     {
-                        if (auto audioRead = ioSystem->read(audioPath, options.ioOptions))
+                        io::Info audioInfo;
+                        if (ioSystem->getInfo(audioPath, {}, options.ioOptions, audioInfo))
                         {
                             bool protocol = audioPath.isFileProtocol();
                             if (file::exists(
@@ -496,8 +595,6 @@ namespace tl
                                 audioPath = file::Path(cwd + audioPath.get());
                                 protocol = false;
                             }
-                            
-                            const auto audioInfo = audioRead->getInfo().get();
 
                             auto audioClip = new otio::Clip;
                             audioClip->set_source_range(audioInfo.audioTime);
@@ -583,7 +680,7 @@ namespace tl
             if (!out)
             {
                 otio::ErrorStatus errorStatus;
-                out = readOTIO(path, &errorStatus);
+                out = readOTIO(path, logSystem, &errorStatus);
                 if (otio::is_error(errorStatus))
                 {
                     out = nullptr;
@@ -13,13 +13,121 @@
 
 #include <opentimelineio/transition.h>
 
+#include <set>
+
 namespace tl
 {
     namespace timeline
     {
-        namespace
+        void Timeline::Private::startProbe()
+        {
+            probe.index = 0;
+            probe.finished = 0;
+            probe.running = true;
+            auto context = this->context.lock();
+            if (!context || 0 == options.probeThreadCount)
+                return;
+            auto ioSystem = context->getSystem<io::System>();
+            auto cache = ioSystem->getCache();
+
+            // Find the clips that are not in the cache. Clips read from
+            // memory are not cached.
+            std::set<std::string> keys;
+            for (const auto& clip : otioTimeline->find_children<otio::Clip>())
+            {
+                if (isMemoryReference(clip->media_reference()))
+                    continue;
+                ProbeItem item;
+                item.path = timeline::getPath(
+                    clip->media_reference(),
+                    path.getDirectory(),
+                    options.pathOptions);
+                item.options = getReadOptions(clip.value, options.ioOptions);
+                const std::string key = io::getInfoCacheKey(item.path, item.options);
+                if (keys.insert(key).second && !cache->containsInfo(key))
+                {
+                    probe.items.push_back(item);
+                }
+            }
+
+            // Probe the clips in the background.
+            probe.startTime = std::chrono::steady_clock::now();
+            const size_t threadCount = std::min(options.probeThreadCount, probe.items.size());
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                probe.threads.push_back(std::thread(
+                    [this, ioSystem]
+                    {
+                        size_t j = probe.index++;
+                        while (probe.running && j < probe.items.size())
+                        {
+                            try
+                            {
+                                io::Info info;
+                                ioSystem->getInfo(
+                                    probe.items[j].path,
+                                    {},
+                                    probe.items[j].options,
+                                    info);
+                            }
+                            catch (const std::exception&)
+                            {}
+                            ++probe.finished;
+                            j = probe.index++;
+                        }
+                    }));
+            }
+        }
+
+        void Timeline::Private::stopProbe()
+        {
+            probe.running = false;
+            for (auto& i : probe.threads)
+            {
+                if (i.joinable())
+                {
+                    i.join();
+                }
+            }
+            probe.threads.clear();
+        }
+
+        bool Timeline::Private::getInfo(const otio::Clip* clip, io::Info& out)
         {
-            const std::chrono::milliseconds timeout(5);
+            bool found = false;
+            if (auto context = this->context.lock())
+            {
+                // Only check the type of the media reference here, the
+                // memory is not needed until the reader is created.
+                auto cache = context->getSystem<io::System>()->getCache();
+                std::string key;
+                if (!isMemoryReference(clip->media_reference()))
+                {
+                    const auto path = timeline::getPath(
+                        clip->media_reference(),
+                        this->path.getDirectory(),
+                        options.pathOptions);
+                    const io::Options ioOptions = getReadOptions(clip, options.ioOptions);
+                    key = io::getInfoCacheKey(path, ioOptions);
+                    found = cache->getInfo(key, out);
+                }
+                if (!found)
+                {
+                    if (auto read = getRead(clip, options.ioOptions))
+                    {
+                        out = read->getInfo().get();
+                        found = true;
+
+                        // Store the information now so the clip is not
+                        // probed again in the background.
+                        if (!key.empty() && (!out.video.empty() || out.audio.isValid()))
+                        {
+                            cache->addInfo(key, out);
+                        }
+                    }
+                }
+            }
+            return found;
         }
 
         bool Timeline::Private::getVideoInfo(const otio::Composable* composable)
@@ -29,9 +137,9 @@ namespace tl
                 if (auto context = this->context.lock())
                 {
                     // The first video clip defines the video information for the timeline.
-                    if (auto read = getRead(clip, options.ioOptions))
+                    io::Info ioInfo;
+                    if (getInfo(clip, ioInfo))
                     {
-                        const io::Info& ioInfo = read->getInfo().get();
                         this->ioInfo.video = ioInfo.video;
                         this->ioInfo.videoTime = ioInfo.videoTime;
                         this->ioInfo.tags.insert(ioInfo.tags.begin(), ioInfo.tags.end());
@@ -62,9 +170,9 @@ namespace tl
                 if (auto context = this->context.lock())
                 {
                     // The first audio clip defines the audio information for the timeline.
-                    if (auto read = getRead(clip, options.ioOptions))
+                    io::Info ioInfo;
+                    if (getInfo(clip, ioInfo))
                     {
-                        const io::Info& ioInfo = read->getInfo().get();
                         this->ioInfo.audio = ioInfo.audio;
                         this->ioInfo.audioTime = ioInfo.audioTime;
                         this->ioInfo.tags.insert(ioInfo.tags.begin(), ioInfo.tags.end());
@@ -95,12 +203,10 @@ namespace tl
 
         void Timeline::Private::tick()
         {
-            const auto t0 = std::chrono::steady_clock::now();
-
             requests();
 
             // Logging.
-            auto t1 = std::chrono::steady_clock::now();
+            const auto t1 = std::chrono::steady_clock::now();
             const std::chrono::duration<float> diff = t1 - thread.logTimer;
             if (diff.count() > 10.F)
             {
@@ -109,10 +215,12 @@ namespace tl
                 {
                     size_t videoRequestsSize = 0;
                     size_t audioRequestsSize = 0;
+                    ReadStats readStats;
                     {
                         std::unique_lock<std::mutex> lock(mutex.mutex);
                         videoRequestsSize = mutex.videoRequests.size();
                         audioRequestsSize = mutex.audioRequests.size();
+                        readStats = mutex.readStats;
                     }
                     auto logSystem = context->getLogSystem();
                     logSystem->print(
@@ -121,20 +229,27 @@ namespace tl
                         "\n"
                         "    Path: {0}\n"
                         "    Video requests: {1}, {2} in-progress, {3} max\n"
-                        "    Audio requests: {4}, {5} in-progress, {6} max").
+                        "    Audio requests: {4}, {5} in-progress, {6} max\n"
+                        "    Readers: {7}, {8} max\n"
+                        "    Reader opens: {9}, {10} look ahead, {11} hits, {12} evictions\n"
+                        "    Reader time: {13}s opening, {14}s waiting for information").
                         arg(path.get()).
                         arg(videoRequestsSize).
                         arg(thread.videoRequestsInProgress.size()).
                         arg(options.videoRequestCount).
                         arg(audioRequestsSize).
                         arg(thread.audioRequestsInProgress.size()).
-                        arg(options.audioRequestCount));
+                        arg(options.audioRequestCount).
+                        arg(readStats.readerCount).
+                        arg(readStats.readerMax).
+                        arg(readStats.opens).
+                        arg(readStats.lookAheadOpens).
+                        arg(readStats.hits).
+                        arg(readStats.evictions).
+                        arg(readStats.openTime).
+                        arg(readStats.infoWaitTime));
                 }
-                t1 = std::chrono::steady_clock::now();
             }
-
-            // Sleep for a bit.
-            time::sleep(timeout, t0, t1);
         }
 
         void Timeline::Private::requests()
@@ -143,24 +258,38 @@ namespace tl
             std::list<std::shared_ptr<VideoRequest> > newVideoRequests;
             std::list<std::shared_ptr<AudioRequest> > newAudioRequests;
             {
+                // Wait for new requests or for the readers to finish. The
+                // readers signal when their requests have finished, the
+                // timeout is only needed for readers that do not.
                 std::unique_lock<std::mutex> lock(mutex.mutex);
-                thread.cv.wait_for(
-                    lock,
-                    options.requestTimeout,
-                    [this]
+                const auto predicate = [this]
                     {
                         return
+                            !thread.running ||
                             mutex.otioTimeline.value ||
-                            !mutex.videoRequests.empty() ||
-                            !thread.videoRequestsInProgress.empty() ||
-                            !mutex.audioRequests.empty() ||
-                            !thread.audioRequestsInProgress.empty();
-                    });
+                            (!mutex.videoRequests.empty() &&
+                                thread.videoRequestsInProgress.size() < options.videoRequestCount) ||
+                            (!mutex.audioRequests.empty() &&
+                                thread.audioRequestsInProgress.size() < options.audioRequestCount) ||
+                            mutex.readsFinished;
+                    };
+                if (!thread.videoRequestsInProgress.empty() ||
+                    !thread.audioRequestsInProgress.empty() ||
+                    !thread.pendingInfo.empty())
+                {
+                    thread.cv.wait_for(lock, options.requestTimeout, predicate);
+                }
+                else
+                {
+                    thread.cv.wait(lock, predicate);
+                }
+                mutex.readsFinished = false;
                 if (mutex.otioTimeline.value)
                 {
                     thread.otioTimeline = mutex.otioTimeline;
                     mutex.otioTimeline = nullptr;
                     mutex.otioTimelineChanged = true;
+                    thread.trackIndexesChanged = true;
                 }
                 while (!mutex.videoRequests.empty() &&
                     (thread.videoRequestsInProgress.size() + newVideoRequests.size()) < options.videoRequestCount)
@@ -176,63 +305,74 @@ namespace tl
                 }
             }
 
+            // Rebuild the track indexes when the timeline has changed.
+            if (thread.trackIndexesChanged &&
+                (!newVideoRequests.empty() || !newAudioRequests.empty()))
+            {
+                thread.trackIndexesChanged = false;
+                thread.videoIndex = createTrackIndexes(
+                    thread.otioTimeline.value,
+                    otio::Track::Kind::video);
+                thread.audioIndex = createTrackIndexes(
+                    thread.otioTimeline.value,
+                    otio::Track::Kind::audio);
+                updateReaderMax();
+            }
+
             // Traverse the timeline for new video requests.
+            std::vector<const TrackIndexItem*> items;
             for (auto& request : newVideoRequests)
             {
                 try
                 {
-                    for (const auto& otioTrack : thread.otioTimeline->video_tracks())
+                    const auto requestTime = request->time - timeRange.start_time();
+                    const double requestSeconds = requestTime.to_seconds();
+                    for (const auto& trackIndex : thread.videoIndex)
                     {
-                        for (const auto& otioChild : otioTrack->children())
+                        items.clear();
+                        trackIndex.find(requestSeconds, requestSeconds, items);
+                        for (const auto item : items)
                         {
-                            if (auto otioItem = dynamic_cast<otio::Item*>(otioChild.value))
+                            const auto& range = item->range;
+                            if (range.contains(requestTime))
                             {
-                                const auto requestTime = request->time - timeRange.start_time();
-                                otio::ErrorStatus errorStatus;
-                                const auto range = otioItem->trimmed_range_in_parent(&errorStatus);
-                                if (range.has_value() && range.value().contains(requestTime))
+                                VideoLayerData videoData;
+                                if (item->clip)
                                 {
-                                    VideoLayerData videoData;
-                                    if (auto otioClip = dynamic_cast<const otio::Clip*>(otioItem))
-                                    {
-                                        videoData.image = readVideo(otioClip, requestTime, request->options);
-                                    }
-                                    const auto neighbors = otioTrack->neighbors_of(otioItem, &errorStatus);
-                                    if (auto otioTransition = dynamic_cast<otio::Transition*>(neighbors.second.value))
+                                    videoData.image = readVideo(item->clip, requestTime, request->options);
+                                }
+                                if (auto otioTransition = item->outTransition)
+                                {
+                                    if (requestTime > range.end_time_inclusive() - otioTransition->in_offset())
                                     {
-                                        if (requestTime > range.value().end_time_inclusive() - otioTransition->in_offset())
+                                        videoData.transition = toTransition(otioTransition->transition_type());
+                                        videoData.transitionValue = transitionValue(
+                                            requestTime.value(),
+                                            range.end_time_inclusive().value() - otioTransition->in_offset().value(),
+                                            range.end_time_inclusive().value() + otioTransition->out_offset().value() + 1.0);
+                                        if (item->outClip)
                                         {
-                                            videoData.transition = toTransition(otioTransition->transition_type());
-                                            videoData.transitionValue = transitionValue(
-                                                requestTime.value(),
-                                                range.value().end_time_inclusive().value() - otioTransition->in_offset().value(),
-                                                range.value().end_time_inclusive().value() + otioTransition->out_offset().value() + 1.0);
-                                            const auto transitionNeighbors = otioTrack->neighbors_of(otioTransition, &errorStatus);
-                                            if (const auto otioClipB = dynamic_cast<otio::Clip*>(transitionNeighbors.second.value))
-                                            {
-                                                videoData.imageB = readVideo(otioClipB, requestTime, request->options);
-                                            }
+                                            videoData.imageB = readVideo(item->outClip, requestTime, request->options);
                                         }
                                     }
-                                    if (auto otioTransition = dynamic_cast<otio::Transition*>(neighbors.first.value))
+                                }
+                                if (auto otioTransition = item->inTransition)
+                                {
+                                    if (requestTime < range.start_time() + otioTransition->out_offset())
                                     {
-                                        if (requestTime < range.value().start_time() + otioTransition->out_offset())
+                                        std::swap(videoData.image, videoData.imageB);
+                                        videoData.transition = toTransition(otioTransition->transition_type());
+                                        videoData.transitionValue = transitionValue(
+                                            requestTime.value(),
+                                            range.start_time().value() - otioTransition->in_offset().value() - 1.0,
+                                            range.start_time().value() + otioTransition->out_offset().value());
+                                        if (item->inClip)
                                         {
-                                            std::swap(videoData.image, videoData.imageB);
-                                            videoData.transition = toTransition(otioTransition->transition_type());
-                                            videoData.transitionValue = transitionValue(
-                                                requestTime.value(),
-                                                range.value().start_time().value() - otioTransition->in_offset().value() - 1.0,
-                                                range.value().start_time().value() + otioTransition->out_offset().value());
-                                            const auto transitionNeighbors = otioTrack->neighbors_of(otioTransition, &errorStatus);
-                                            if (const auto otioClipB = dynamic_cast<otio::Clip*>(transitionNeighbors.first.value))
-                                            {
-                                                videoData.image = readVideo(otioClipB, requestTime, request->options);
-                                            }
+                                            videoData.image = readVideo(item->inClip, requestTime, request->options);
                                         }
                                     }
-                                    request->layerData.push_back(std::move(videoData));
                                 }
+                                request->layerData.push_back(std::move(videoData));
                             }
                         }
                     }
@@ -250,92 +390,85 @@ namespace tl
             {
                 try
                 {
-                    for (const auto& otioTrack : thread.otioTimeline->audio_tracks())
+                    const double requestSeconds = request->seconds -
+                        timeRange.start_time().rescaled_to(1.0).value();
+                    const otime::TimeRange requestTimeRange = otime::TimeRange(
+                        otime::RationalTime(requestSeconds, 1.0),
+                        otime::RationalTime(1.0, 1.0));
+                    for (const auto& trackIndex : thread.audioIndex)
                     {
-                        for (const auto& otioChild : otioTrack->children())
+                        items.clear();
+                        trackIndex.find(requestSeconds, requestSeconds + 1.0, items);
+                        for (const auto item : items)
                         {
-                            if (auto otioItem = dynamic_cast<otio::Item*>(otioChild.value))
+                            const otime::TimeRange clipTimeRange(
+                                item->range.start_time().rescaled_to(1.0),
+                                item->range.duration().rescaled_to(1.0));
+                            otime::TimeRange transitionRange = clipTimeRange;
+                            
+                            if (auto otioTransition = item->inTransition)
+                            {
+                                const auto inOffset = otioTransition->in_offset().rescaled_to(1.0);
+                                transitionRange = otime::TimeRange(transitionRange.start_time() - inOffset,
+                                                                   transitionRange.duration() + inOffset);
+                            }
+                                
+                            if (auto otioTransition = item->outTransition)
+                            {
+                                const auto outOffset = otioTransition->out_offset().rescaled_to(1.0);
+                                transitionRange = otime::TimeRange(transitionRange.start_time(),
+                                                                   transitionRange.duration() + outOffset);
+                            }
+                            
+                            if (requestTimeRange.intersects(transitionRange))
                             {
-                                const auto rangeOptional = otioItem->trimmed_range_in_parent();
-                                if (rangeOptional.has_value())
+                                AudioLayerData audioData;
+                                audioData.seconds = request->seconds;
+                                //! \bug Why is otime::TimeRange::clamped() not giving us the
+                                //! result we expect?
+                                //audioData.timeRange = requestTimeRange.clamped(clipTimeRange);
+                                const double start = std::max(
+                                    transitionRange.start_time().value(),
+                                    requestTimeRange.start_time().value());
+                                const double end = std::min(
+                                    transitionRange.start_time().value() + transitionRange.duration().value(),
+                                    requestTimeRange.start_time().value() + requestTimeRange.duration().value());
+                                audioData.timeRange = otime::TimeRange(
+                                    otime::RationalTime(start, 1.0),
+                                    otime::RationalTime(end - start, 1.0));
+                                
+                                if (item->clip)
                                 {
-                                    const otime::TimeRange clipTimeRange(
-                                        rangeOptional.value().start_time().rescaled_to(1.0),
-                                        rangeOptional.value().duration().rescaled_to(1.0));
-                                    const double start = request->seconds -
-                                        timeRange.start_time().rescaled_to(1.0).value();
-                                    const otime::TimeRange requestTimeRange = otime::TimeRange(
-                                        otime::RationalTime(start, 1.0),
-                                        otime::RationalTime(1.0, 1.0));
-                                    otime::TimeRange transitionRange = clipTimeRange;
-                                    
-                                    otio::ErrorStatus errorStatus;
-                                    const auto neighbors = otioTrack->neighbors_of(otioItem, &errorStatus);
-                                    if (auto otioTransition = dynamic_cast<otio::Transition*>(neighbors.first.value))
-                                    {
-                                        const auto inOffset = otioTransition->in_offset().rescaled_to(1.0);
-                                        transitionRange = otime::TimeRange(transitionRange.start_time() - inOffset,
-                                                                           transitionRange.duration() + inOffset);
-                                    }
-                                        
-                                    if (auto otioTransition = dynamic_cast<otio::Transition*>(neighbors.second.value))
+                                    audioData.audio = readAudio(item->clip, audioData.timeRange, request->options);
+                                }
+                                
+                                if (auto otioTransition = item->outTransition)
+                                {
+                                    const auto pad = otime::RationalTime(1.0, 1.0);
+                                    const auto inOffset = otioTransition->in_offset().rescaled_to(1.0);
+                                    const auto outOffset = otioTransition->out_offset().rescaled_to(1.0);
+                                    auto transitionRange = otime::TimeRange(clipTimeRange.end_time_inclusive() - inOffset,
+                                                                            inOffset + outOffset + pad);
+                                    if (audioData.timeRange.intersects(transitionRange))  
                                     {
-                                        const auto outOffset = otioTransition->out_offset().rescaled_to(1.0);
-                                        transitionRange = otime::TimeRange(transitionRange.start_time(),
-                                                                           transitionRange.duration() + outOffset);
+                                        audioData.clipTimeRange = clipTimeRange;
+                                        audioData.outTransition = otioTransition;
                                     }
-                                    
-                                    if (requestTimeRange.intersects(transitionRange))
+                                }
+                            
+                                if (auto otioTransition = item->inTransition)
+                                {
+                                    const auto outOffset = otioTransition->out_offset().rescaled_to(1.0);
+                                    const auto inOffset = otioTransition->in_offset().rescaled_to(1.0);
+                                    auto transitionRange = otime::TimeRange(clipTimeRange.start_time() - inOffset,
+                                                                            outOffset + inOffset);
+                                    if (audioData.timeRange.intersects(transitionRange))
                                     {
-                                        AudioLayerData audioData;
-                                        audioData.seconds = request->seconds;
-                                        //! \bug Why is otime::TimeRange::clamped() not giving us the
-                                        //! result we expect?
-                                        //audioData.timeRange = requestTimeRange.clamped(clipTimeRange);
-                                        const double start = std::max(
-                                            transitionRange.start_time().value(),
-                                            requestTimeRange.start_time().value());
-                                        const double end = std::min(
-                                            transitionRange.start_time().value() + transitionRange.duration().value(),
-                                            requestTimeRange.start_time().value() + requestTimeRange.duration().value());
-                                        audioData.timeRange = otime::TimeRange(
-                                            otime::RationalTime(start, 1.0),
-                                            otime::RationalTime(end - start, 1.0));
-                                        
-                                        if (auto otioClip = dynamic_cast<otio::Clip*>(otioItem))
-                                        {
-                                            audioData.audio = readAudio(otioClip, audioData.timeRange, request->options);
-                                        }
-                                        
-                                        if (auto otioTransition = dynamic_cast<otio::Transition*>(neighbors.second.value))
-                                        {
-                                            const auto pad = otime::RationalTime(1.0, 1.0);
-                                            const auto inOffset = otioTransition->in_offset().rescaled_to(1.0);
-                                            const auto outOffset = otioTransition->out_offset().rescaled_to(1.0);
-                                            auto transitionRange = otime::TimeRange(clipTimeRange.end_time_inclusive() - inOffset,
-                                                                                    inOffset + outOffset + pad);
-                                            if (audioData.timeRange.intersects(transitionRange))  
-                                            {
-                                                audioData.clipTimeRange = clipTimeRange;
-                                                audioData.outTransition = otioTransition;
-                                            }
-                                        }
-                                    
-                                        if (auto otioTransition = dynamic_cast<otio::Transition*>(neighbors.first.value))
-                                        {
-                                            const auto outOffset = otioTransition->out_offset().rescaled_to(1.0);
-                                            const auto inOffset = otioTransition->in_offset().rescaled_to(1.0);
-                                            auto transitionRange = otime::TimeRange(clipTimeRange.start_time() - inOffset,
-                                                                                    outOffset + inOffset);
-                                            if (audioData.timeRange.intersects(transitionRange))
-                                            {
-                                                audioData.clipTimeRange = clipTimeRange;
-                                                audioData.inTransition = otioTransition;
-                                            }
-                                        }
-                                        request->layerData.push_back(std::move(audioData));
+                                        audioData.clipTimeRange = clipTimeRange;
+                                        audioData.inTransition = otioTransition;
                                     }
                                 }
+                                request->layerData.push_back(std::move(audioData));
                             }
                         }
                     }
@@ -348,7 +481,41 @@ namespace tl
                 thread.audioRequestsInProgress.push_back(request);
             }
 
+            // Open the readers for the clips coming up after the new
+            // requests.
+            if (options.readerLookAhead.value() > 0.0)
+            {
+                std::set<const otio::Clip*> lookAheadClips;
+                try
+                {
+                    for (const auto& request : newVideoRequests)
+                    {
+                        lookAhead(
+                            thread.videoIndex,
+                            (request->time - timeRange.start_time()).to_seconds(),
+                            request->options,
+                            true,
+                            lookAheadClips);
+                    }
+                    for (const auto& request : newAudioRequests)
+                    {
+                        lookAhead(
+                            thread.audioIndex,
+                            request->seconds - timeRange.start_time().to_seconds(),
+                            request->options,
+                            false,
+                            lookAheadClips);
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    //! \todo How should this be handled?
+                }
+            }
+            cacheInfo();
+
             // Check for finished video requests.
+            bool finished = false;
             auto videoRequestIt = thread.videoRequestsInProgress.begin();
             while (videoRequestIt != thread.videoRequestsInProgress.end())
             {
@@ -395,6 +562,7 @@ namespace tl
                         //! \todo How should this be handled?
                     }
                     (*videoRequestIt)->promise.set_value(data);
+                    finished = true;
                     videoRequestIt = thread.videoRequestsInProgress.erase(videoRequestIt);
                     continue;
                 }
@@ -441,11 +609,28 @@ namespace tl
                         //! \todo How should this be handled?
                     }
                     (*audioRequestIt)->promise.set_value(data);
+                    finished = true;
                     audioRequestIt = thread.audioRequestsInProgress.erase(audioRequestIt);
                     continue;
                 }
                 ++audioRequestIt;
             }
+            if (finished)
+            {
+                requestsFinished();
+            }
+        }
+
+        void Timeline::Private::requestsFinished()
+        {
+            std::unique_lock<std::mutex> lock(requestCallback.mutex);
+            for (const auto& i : requestCallback.callbacks)
+            {
+                if (i.second)
+                {
+                    i.second();
+                }
+            }
         }
 
         void Timeline::Private::finishRequests()
@@ -507,6 +692,10 @@ namespace tl
                     }
                     request->promise.set_value(data);
                 }
+                if (!videoRequests.empty() || !audioRequests.empty())
+                {
+                    requestsFinished();
+                }
             }
         }
 
@@ -521,9 +710,31 @@ namespace tl
             }
         }
 
+        io::Options Timeline::Private::getReadOptions(
+            const otio::Clip* clip,
+            const io::Options& ioOptions) const
+        {
+            io::Options out = ioOptions;
+            out["SequenceIO/DefaultSpeed"] = string::Format("{0}").arg(timeRange.duration().rate());
+            otio::ErrorStatus error;
+            otime::RationalTime startTime = time::invalidTime;
+            const otime::TimeRange availableRange = clip->available_range(&error);
+            if (!otio::is_error(error))
+            {
+                startTime = availableRange.start_time();
+            }
+            else if (clip->source_range().has_value())
+            {
+                startTime = clip->source_range().value().start_time();
+            }
+            out["FFmpeg/StartTime"] = string::Format("{0}").arg(startTime);
+            return out;
+        }
+
         std::shared_ptr<io::IRead> Timeline::Private::getRead(
             const otio::Clip* clip,
-            const io::Options& ioOptions)
+            const io::Options& ioOptions,
+            bool lookAhead)
         {
             std::shared_ptr<io::IRead> out;
             const auto path = timeline::getPath(
@@ -531,30 +742,155 @@ namespace tl
                 this->path.getDirectory(),
                 options.pathOptions);
             const std::string key = getKey(path);
-            if (!readCache.get(key, out))
+            if (readCache.get(key, out))
             {
-                if (auto context = this->context.lock())
+                if (!lookAhead)
+                {
+                    std::unique_lock<std::mutex> lock(mutex.mutex);
+                    ++mutex.readStats.hits;
+                }
+            }
+            else if (auto context = this->context.lock())
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                const auto memoryRead = getMemoryRead(clip->media_reference());
+                const io::Options options = getReadOptions(clip, ioOptions);
+                const auto ioSystem = context->getSystem<io::System>();
+                out = ioSystem->read(path, memoryRead, options);
+                if (out)
+                {
+                    out->setRequestCallback(
+                        [this]
+                        {
+                            {
+                                std::unique_lock<std::mutex> lock(mutex.mutex);
+                                mutex.readsFinished = true;
+                            }
+                            thread.cv.notify_one();
+                        });
+                }
+                const bool evict = readCache.getSize() >= readCache.getMax();
+                readCache.add(key, out);
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<double> diff = t1 - t0;
+                {
+                    std::unique_lock<std::mutex> lock(mutex.mutex);
+                    ++mutex.readStats.opens;
+                    if (lookAhead)
+                    {
+                        ++mutex.readStats.lookAheadOpens;
+                    }
+                    if (evict)
+                    {
+                        ++mutex.readStats.evictions;
+                    }
+                    mutex.readStats.readerCount = readCache.getCount();
+                    mutex.readStats.openTime += diff.count();
+                }
+
+                // Store the information in the cache for the next time
+                // the timeline is created. The information is stored when
+                // the reader has finished opening so the caller is not
+                // blocked.
+                if (out && memoryRead.empty())
+                {
+                    const std::string infoKey = io::getInfoCacheKey(path, options);
+                    if (!ioSystem->getCache()->containsInfo(infoKey))
+                    {
+                        thread.pendingInfo.push_back(std::make_pair(infoKey, out->getInfo()));
+                    }
+                }
+            }
+            return out;
+        }
+
+        void Timeline::Private::lookAhead(
+            const std::vector<TrackIndex>& trackIndexes,
+            double seconds,
+            const io::Options& options,
+            bool video,
+            std::set<const otio::Clip*>& clips)
+        {
+            // Half of the reader pool is reserved for the readers of the
+            // clips being requested.
+            const size_t max = readCache.getMax() / 2;
+            const double lookAheadSeconds = this->options.readerLookAhead.to_seconds();
+            std::vector<const TrackIndexItem*> items;
+            for (const auto& trackIndex : trackIndexes)
+            {
+                items.clear();
+                trackIndex.find(seconds, seconds + lookAheadSeconds, items);
+                for (const auto item : items)
                 {
-                    const auto memoryRead = getMemoryRead(clip->media_reference());
-                    io::Options options = ioOptions;
-                    options["SequenceIO/DefaultSpeed"] = string::Format("{0}").arg(timeRange.duration().rate());
-                    otio::ErrorStatus error;
-                    otime::RationalTime startTime = time::invalidTime;
-                    const otime::TimeRange availableRange = clip->available_range(&error);
-                    if (!otio::is_error(error))
+                    if (clips.size() >= max)
+                        return;
+                    if (item->clip && clips.insert(item->clip).second)
                     {
-                        startTime = availableRange.start_time();
+                        io::Options optionsMerged = io::merge(options, this->options.ioOptions);
+                        if (video)
+                        {
+                            optionsMerged["USD/cameraName"] = item->clip->name();
+                        }
+                        getRead(item->clip, optionsMerged, true);
                     }
-                    else if (clip->source_range().has_value())
+                }
+            }
+        }
+
+        void Timeline::Private::updateReaderMax()
+        {
+            // Fit two readers for each track, the clips on either side of
+            // a cut, but not more than the maximum number of open readers.
+            const size_t layers = thread.videoIndex.size() + thread.audioIndex.size();
+            const size_t max = std::min(
+                std::max(readCache.getMax(), layers * 2),
+                options.readerMax);
+            if (max != readCache.getMax())
+            {
+                const size_t count = readCache.getCount();
+                readCache.setMax(max);
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                mutex.readStats.evictions += count - readCache.getCount();
+            }
+            std::unique_lock<std::mutex> lock(mutex.mutex);
+            mutex.readStats.readerMax = readCache.getMax();
+            mutex.readStats.readerCount = readCache.getCount();
+        }
+
+        void Timeline::Private::cacheInfo()
+        {
+            auto context = this->context.lock();
+            auto i = thread.pendingInfo.begin();
+            while (i != thread.pendingInfo.end())
+            {
+                if (i->second.valid() &&
+                    i->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                {
+                    ++i;
+                    continue;
+                }
+                try
+                {
+                    const io::Info info = i->second.valid() ? i->second.get() : io::Info();
+                    if (context && (!info.video.empty() || info.audio.isValid()))
                     {
-                        startTime = clip->source_range().value().start_time();
+                        context->getSystem<io::System>()->getCache()->addInfo(i->first, info);
                     }
-                    options["FFmpeg/StartTime"] = string::Format("{0}").arg(startTime);
-                    const auto ioSystem = context->getSystem<io::System>();
-                    out = ioSystem->read(path, memoryRead, options);
-                    readCache.add(key, out);
                 }
+                catch (const std::exception&)
+                {}
+                i = thread.pendingInfo.erase(i);
             }
+        }
+
+        io::Info Timeline::Private::getReadInfo(const std::shared_ptr<io::IRead>& read)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            const io::Info out = read->getInfo().get();
+            const auto t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> diff = t1 - t0;
+            std::unique_lock<std::mutex> lock(mutex.mutex);
+            mutex.readStats.infoWaitTime += diff.count();
             return out;
         }
 
@@ -570,7 +906,7 @@ namespace tl
             const auto timeRangeOpt = clip->trimmed_range_in_parent();
             if (read && timeRangeOpt.has_value())
             {
-                const io::Info& ioInfo = read->getInfo().get();
+                const io::Info ioInfo = getReadInfo(read);
                 const auto mediaTime = timeline::toVideoMediaTime(
                     time,
                     timeRangeOpt.value(),
@@ -592,7 +928,7 @@ namespace tl
             const auto timeRangeOpt = clip->trimmed_range_in_parent();
             if (read && timeRangeOpt.has_value())
             {
-                const io::Info& ioInfo = read->getInfo().get();
+                const io::Info ioInfo = getReadInfo(read);
                 const auto mediaRange = timeline::toAudioMediaTime(
                     timeRange,
                     timeRangeOpt.value(),
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <tlTimeline/Timeline.h>
+#include <tlTimeline/TrackIndex.h>
 
 #include <tlIO/Plugin.h>
 
@@ -14,7 +15,9 @@
 
 #include <atomic>
 #include <list>
+#include <map>
 #include <mutex>
+#include <set>
 #include <thread>
 
 namespace tl
@@ -23,6 +26,9 @@ namespace tl
     {
         struct Timeline::Private
         {
+            void startProbe();
+            void stopProbe();
+            bool getInfo(const otio::Clip*, io::Info&);
             bool getVideoInfo(const otio::Composable*);
             bool getAudioInfo(const otio::Composable*);
 
@@ -32,9 +38,22 @@ namespace tl
             void requests();
             void finishRequests();
 
+            io::Options getReadOptions(
+                const otio::Clip*,
+                const io::Options&) const;
             std::shared_ptr<io::IRead> getRead(
                 const otio::Clip*,
-                const io::Options&);
+                const io::Options&,
+                bool lookAhead = false);
+            void lookAhead(
+                const std::vector<TrackIndex>&,
+                double seconds,
+                const io::Options&,
+                bool video,
+                std::set<const otio::Clip*>&);
+            void updateReaderMax();
+            void cacheInfo();
+            io::Info getReadInfo(const std::shared_ptr<io::IRead>&);
             std::future<io::VideoData> readVideo(
                 const otio::Clip*,
                 const otime::RationalTime&,
@@ -43,6 +62,7 @@ namespace tl
                 const otio::Clip*,
                 const otime::TimeRange&,
                 const io::Options&);
+            void requestsFinished();
 
             std::shared_ptr<audio::Audio> padAudioToOneSecond(
                 const std::shared_ptr<audio::Audio>&,
@@ -52,6 +72,7 @@ namespace tl
             std::weak_ptr<system::Context> context;
             otio::SerializableObject::Retainer<otio::Timeline> otioTimeline;
             std::shared_ptr<observer::Value<bool> > timelineChanges;
+            std::shared_ptr<observer::Value<bool> > timelineReady;
             file::Path path;
             file::Path audioPath;
             Options options;
@@ -114,13 +135,48 @@ namespace tl
                 bool otioTimelineChanged = false;
                 std::list<std::shared_ptr<VideoRequest> > videoRequests;
                 std::list<std::shared_ptr<AudioRequest> > audioRequests;
+                bool readsFinished = false;
+                ReadStats readStats;
                 bool stopped = false;
                 std::mutex mutex;
             };
             Mutex mutex;
+
+            // The request callback has a separate mutex so it is not called
+            // with the timeline mutex locked.
+            struct RequestCallback
+            {
+                uint64_t id = 0;
+                std::map<uint64_t, std::function<void(void)> > callbacks;
+                std::mutex mutex;
+            };
+            RequestCallback requestCallback;
+
+            // The clips are probed in the background by a pool of threads
+            // that take the next clip from a shared index.
+            struct ProbeItem
+            {
+                file::Path path;
+                io::Options options;
+            };
+            struct Probe
+            {
+                std::vector<ProbeItem> items;
+                std::atomic<size_t> index;
+                std::atomic<size_t> finished;
+                std::atomic<bool> running;
+                std::vector<std::thread> threads;
+                std::chrono::steady_clock::time_point startTime;
+            };
+            Probe probe;
+
             struct Thread
             {
                 otio::SerializableObject::Retainer<otio::Timeline> otioTimeline;
+                bool trackIndexesChanged = true;
+                std::vector<TrackIndex> videoIndex;
+                std::vector<TrackIndex> audioIndex;
+                std::list<std::pair<std::string, std::future<io::Info> > > pendingInfo;
                 std::list<std::shared_ptr<VideoRequest> > videoRequestsInProgress;
                 std::list<std::shared_ptr<AudioRequest> > audioRequestsInProgress;
                 std::condition_variable cv;
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/TrackIndex.h>
+
+#include <algorithm>
+#include <map>
+
+namespace tl
+{
+    namespace timeline
+    {
+        namespace
+        {
+            // Tolerance for comparing times converted to seconds.
+            const double epsilon = 1.0 / 100000.0;
+        }
+
+        TrackIndex::TrackIndex()
+        {}
+
+        TrackIndex::TrackIndex(otio::Track* track) :
+            _track(track)
+        {
+            if (!track)
+                return;
+
+            // Without a source range the trimmed ranges are the same as
+            // the untrimmed ranges, which can be computed for all of the
+            // children in a single pass.
+            std::map<otio::Composable*, otime::TimeRange> ranges;
+            const bool allRanges = !track->source_range().has_value();
+            if (allRanges)
+            {
+                otio::ErrorStatus errorStatus;
+                ranges = track->range_of_all_children(&errorStatus);
+            }
+
+            const auto& children = track->children();
+            for (size_t i = 0; i < children.size(); ++i)
+            {
+                auto otioItem = dynamic_cast<otio::Item*>(children[i].value);
+                if (!otioItem)
+                    continue;
+
+                TrackIndexItem item;
+                item.index = i;
+                item.item = otioItem;
+                item.clip = dynamic_cast<otio::Clip*>(otioItem);
+                if (allRanges)
+                {
+                    const auto j = ranges.find(otioItem);
+                    if (j == ranges.end())
+                        continue;
+                    item.range = j->second;
+                }
+                else
+                {
+                    otio::ErrorStatus errorStatus;
+                    const auto range = otioItem->trimmed_range_in_parent(&errorStatus);
+                    if (!range.has_value())
+                        continue;
+                    item.range = range.value();
+                }
+
+                item.start = item.range.start_time().to_seconds();
+                item.end = item.range.end_time_exclusive().to_seconds();
+                if (i > 0)
+                {
+                    item.inTransition = dynamic_cast<otio::Transition*>(children[i - 1].value);
+                    if (item.inTransition)
+                    {
+                        item.start -= item.inTransition->in_offset().to_seconds();
+                        if (i > 1)
+                        {
+                            item.inClip = dynamic_cast<otio::Clip*>(children[i - 2].value);
+                        }
+                    }
+                }
+                if (i + 1 < children.size())
+                {
+                    item.outTransition = dynamic_cast<otio::Transition*>(children[i + 1].value);
+                    if (item.outTransition)
+                    {
+                        item.end += item.outTransition->out_offset().to_seconds();
+                        if (i + 2 < children.size())
+                        {
+                            item.outClip = dynamic_cast<otio::Clip*>(children[i + 2].value);
+                        }
+                    }
+                }
+                _items.push_back(item);
+            }
+
+            // Sort by the start including the transitions, so the search
+            // can stop at the first item that starts after the range.
+            std::stable_sort(
+                _items.begin(),
+                _items.end(),
+                [](const TrackIndexItem& a, const TrackIndexItem& b)
+                {
+                    return a.start < b.start;
+                });
+
+            _maxEnd.reserve(_items.size());
+            double maxEnd = 0.0;
+            for (size_t i = 0; i < _items.size(); ++i)
+            {
+                maxEnd = 0 == i ? _items[i].end : std::max(maxEnd, _items[i].end);
+                _maxEnd.push_back(maxEnd);
+            }
+        }
+
+        otio::Track* TrackIndex::getTrack() const
+        {
+            return _track;
+        }
+
+        const std::vector<TrackIndexItem>& TrackIndex::getItems() const
+        {
+            return _items;
+        }
+
+        void TrackIndex::find(
+            double start,
+            double end,
+            std::vector<const TrackIndexItem*>& out) const
+        {
+            // The running maximum of the end times is sorted, so the first
+            // item that can intersect the range is found with a binary
+            // search. The items are sorted by start time, so the search
+            // stops at the first item that starts after the range.
+            const size_t size = out.size();
+            const auto i = std::lower_bound(
+                _maxEnd.begin(),
+                _maxEnd.end(),
+                start - epsilon);
+            for (size_t j = i - _maxEnd.begin(); j < _items.size(); ++j)
+            {
+                const TrackIndexItem& item = _items[j];
+                if (item.start > end + epsilon)
+                    break;
+                if (item.end >= start - epsilon)
+                {
+                    out.push_back(&item);
+                }
+            }
+
+            // Return the items in track order.
+            std::sort(
+                out.begin() + size,
+                out.end(),
+                [](const TrackIndexItem* a, const TrackIndexItem* b)
+                {
+                    return a->index < b->index;
+                });
+        }
+
+        std::vector<TrackIndex> createTrackIndexes(
+            const otio::Timeline* timeline,
+            const std::string& kind)
+        {
+            std::vector<TrackIndex> out;
+            if (timeline)
+            {
+                const auto tracks = otio::Track::Kind::video == kind ?
+                    timeline->video_tracks() :
+                    timeline->audio_tracks();
+                for (const auto& track : tracks)
+                {
+                    out.push_back(TrackIndex(track));
+                }
+            }
+            return out;
+        }
+    }
+}
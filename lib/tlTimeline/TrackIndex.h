@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Time.h>
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
+#include <opentimelineio/transition.h>
+
+#include <vector>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Track index item.
+        struct TrackIndexItem
+        {
+            //! Index of the item in the track's children.
+            size_t index = 0;
+
+            otio::Item* item = nullptr;
+            otio::Clip* clip = nullptr;
+
+            //! Trimmed range of the item in the track.
+            otime::TimeRange range;
+
+            //! Transition before the item, and the clip on the other side.
+            otio::Transition* inTransition = nullptr;
+            otio::Clip* inClip = nullptr;
+
+            //! Transition after the item, and the clip on the other side.
+            otio::Transition* outTransition = nullptr;
+            otio::Clip* outClip = nullptr;
+
+            //! Range of the item in seconds, extended by the transitions.
+            double start = 0.0;
+            double end = 0.0;
+        };
+
+        //! Track index.
+        //!
+        //! The items of a track are stored sorted by start time together
+        //! with the running maximum of their end times, so the items at a
+        //! given time can be found with a binary search instead of walking
+        //! all of the track's children.
+        class TrackIndex
+        {
+        public:
+            TrackIndex();
+            explicit TrackIndex(otio::Track*);
+
+            //! Get the track.
+            otio::Track* getTrack() const;
+
+            //! Get the items.
+            const std::vector<TrackIndexItem>& getItems() const;
+
+            //! Find the items that intersect the given range in seconds,
+            //! including their transitions. The result is conservative,
+            //! the caller should check the exact ranges.
+            void find(
+                double start,
+                double end,
+                std::vector<const TrackIndexItem*>&) const;
+
+        private:
+            otio::Track* _track = nullptr;
+            std::vector<TrackIndexItem> _items;
+            std::vector<double> _maxEnd;
+        };
+
+        //! Create track indexes for the tracks of the given kind.
+        std::vector<TrackIndex> createTrackIndexes(
+            const otio::Timeline*,
+            const std::string& kind);
+    }
+}
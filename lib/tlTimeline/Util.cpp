@@ -371,11 +371,63 @@ namespace tl
             return out;
         }
 
+        bool isMemoryReference(const otio::MediaReference* ref)
+        {
+            // The zip memory references are derived from the raw memory
+            // references.
+            return
+                dynamic_cast<const RawMemoryReference*>(ref) ||
+                dynamic_cast<const SharedMemoryReference*>(ref) ||
+                dynamic_cast<const RawMemorySequenceReference*>(ref) ||
+                dynamic_cast<const SharedMemorySequenceReference*>(ref);
+        }
+
         std::vector<file::MemoryRead> getMemoryRead(
             const otio::MediaReference* ref)
         {
             std::vector<file::MemoryRead> out;
-            if (auto rawMemoryReference =
+            if (auto zipMemoryReference =
+                dynamic_cast<const ZipMemoryReference*>(ref))
+            {
+                const uint8_t* memory = zipMemoryReference->memory();
+                size_t memorySize = zipMemoryReference->memory_size();
+                if (const auto& compressedData = zipMemoryReference->compressed_data())
+                {
+                    const auto& data = compressedData->decompress();
+                    if (!data.empty() && data[0])
+                    {
+                        memory = data[0]->data();
+                        memorySize = data[0]->size();
+                    }
+                }
+                if (memory)
+                {
+                    out.push_back(file::MemoryRead(memory, memorySize));
+                }
+            }
+            else if (auto zipMemorySequenceReference =
+                dynamic_cast<const ZipMemorySequenceReference*>(ref))
+            {
+                const auto& memory = zipMemorySequenceReference->memory();
+                const auto& memory_sizes = zipMemorySequenceReference->memory_sizes();
+                const std::vector<std::shared_ptr<MemoryReferenceData> >* data = nullptr;
+                if (const auto& compressedData = zipMemorySequenceReference->compressed_data())
+                {
+                    data = &compressedData->decompress();
+                }
+                for (size_t i = 0; i < memory.size() && i < memory_sizes.size(); ++i)
+                {
+                    if (data && i < data->size() && (*data)[i])
+                    {
+                        out.push_back(file::MemoryRead((*data)[i]->data(), (*data)[i]->size()));
+                    }
+                    else
+                    {
+                        out.push_back(file::MemoryRead(memory[i], memory_sizes[i]));
+                    }
+                }
+            }
+            else if (auto rawMemoryReference =
                 dynamic_cast<const RawMemoryReference*>(ref))
             {
                 out.push_back(file::MemoryRead(
@@ -80,7 +80,12 @@ namespace tl
             const std::string& directory,
             file::PathOptions);
 
-        //! Get a memory read for a media reference.
+        //! Get whether a media reference is a memory reference. Unlike
+        //! getMemoryRead() this does not decompress any data.
+        bool isMemoryReference(const otio::MediaReference*);
+
+        //! Get a memory read for a media reference. Compressed .otioz
+        //! entries are decompressed the first time this is called.
         std::vector<file::MemoryRead> getMemoryRead(
             const otio::MediaReference*);
 
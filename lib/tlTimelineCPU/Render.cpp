@@ -0,0 +1,1156 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <tlCore/Context.h>
+#include <tlCore/Math.h>
+#include <tlCore/String.h>
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        namespace
+        {
+            //! Minimum number of rows for each thread.
+            const int bandRowsMin = 16;
+
+            size_t getWordSize(image::PixelType value)
+            {
+                size_t out = 0;
+                switch (value)
+                {
+                case image::PixelType::RGB_U10:
+                    out = 4;
+                    break;
+                default:
+                    out = image::getBitDepth(value) / 8;
+                    break;
+                }
+                return out;
+            }
+
+            size_t getRowByteCount(const image::Info& info)
+            {
+                const size_t w = info.size.w;
+                size_t bytes = 0;
+                switch (info.pixelType)
+                {
+                case image::PixelType::RGB_U10:
+                    bytes = w * 4;
+                    break;
+                default:
+                    bytes = w * image::getChannelCount(info.pixelType) * getWordSize(info.pixelType);
+                    break;
+                }
+                return image::getAlignedByteCount(bytes, info.layout.alignment);
+            }
+
+            template<typename T>
+            void convertRow(const uint8_t* in, int channels, float scale, float* out, int w)
+            {
+                const T* p = reinterpret_cast<const T*>(in);
+                switch (channels)
+                {
+                case 1:
+                    for (int x = 0; x < w; ++x, p += 1, out += 4)
+                    {
+                        const float l = static_cast<float>(p[0]) * scale;
+                        out[0] = l;
+                        out[1] = l;
+                        out[2] = l;
+                        out[3] = 1.F;
+                    }
+                    break;
+                case 2:
+                    for (int x = 0; x < w; ++x, p += 2, out += 4)
+                    {
+                        const float l = static_cast<float>(p[0]) * scale;
+                        out[0] = l;
+                        out[1] = l;
+                        out[2] = l;
+                        out[3] = static_cast<float>(p[1]) * scale;
+                    }
+                    break;
+                case 3:
+                    for (int x = 0; x < w; ++x, p += 3, out += 4)
+                    {
+                        out[0] = static_cast<float>(p[0]) * scale;
+                        out[1] = static_cast<float>(p[1]) * scale;
+                        out[2] = static_cast<float>(p[2]) * scale;
+                        out[3] = 1.F;
+                    }
+                    break;
+                case 4:
+                    for (int x = 0; x < w; ++x, p += 4, out += 4)
+                    {
+                        out[0] = static_cast<float>(p[0]) * scale;
+                        out[1] = static_cast<float>(p[1]) * scale;
+                        out[2] = static_cast<float>(p[2]) * scale;
+                        out[3] = static_cast<float>(p[3]) * scale;
+                    }
+                    break;
+                default: break;
+                }
+            }
+
+            void convertRow(const uint8_t* in, image::PixelType pixelType, float* out, int w)
+            {
+                const int channels = image::getChannelCount(pixelType);
+                switch (pixelType)
+                {
+                case image::PixelType::L_U8:
+                case image::PixelType::LA_U8:
+                case image::PixelType::RGB_U8:
+                case image::PixelType::RGBA_U8:
+                    convertRow<uint8_t>(in, channels, 1.F / 255.F, out, w);
+                    break;
+                case image::PixelType::L_U16:
+                case image::PixelType::LA_U16:
+                case image::PixelType::RGB_U16:
+                case image::PixelType::RGBA_U16:
+                    convertRow<uint16_t>(in, channels, 1.F / 65535.F, out, w);
+                    break;
+                case image::PixelType::L_U32:
+                case image::PixelType::LA_U32:
+                case image::PixelType::RGB_U32:
+                case image::PixelType::RGBA_U32:
+                    convertRow<uint32_t>(in, channels, 1.F / 4294967295.F, out, w);
+                    break;
+                case image::PixelType::L_F16:
+                case image::PixelType::LA_F16:
+                case image::PixelType::RGB_F16:
+                case image::PixelType::RGBA_F16:
+                    convertRow<half>(in, channels, 1.F, out, w);
+                    break;
+                case image::PixelType::L_F32:
+                case image::PixelType::LA_F32:
+                case image::PixelType::RGB_F32:
+                case image::PixelType::RGBA_F32:
+                    convertRow<float>(in, channels, 1.F, out, w);
+                    break;
+                case image::PixelType::RGB_U10:
+                {
+                    // The data is stored like GL_UNSIGNED_INT_10_10_10_2.
+                    const uint32_t* p = reinterpret_cast<const uint32_t*>(in);
+                    for (int x = 0; x < w; ++x, ++p, out += 4)
+                    {
+                        out[0] = ((p[0] >> 22) & 0x3ff) / 1023.F;
+                        out[1] = ((p[0] >> 12) & 0x3ff) / 1023.F;
+                        out[2] = ((p[0] >> 2) & 0x3ff) / 1023.F;
+                        out[3] = 1.F;
+                    }
+                    break;
+                }
+                default:
+                    std::fill(out, out + w * 4, 0.F);
+                    break;
+                }
+            }
+
+            template<typename T>
+            void convertYUVRow(
+                const std::shared_ptr<image::Image>& image,
+                image::VideoLevels videoLevels,
+                int y,
+                float* out)
+            {
+                const auto& info = image->getInfo();
+                const int w = info.size.w;
+                const int h = info.size.h;
+                int w2 = w;
+                int h2 = h;
+                switch (info.pixelType)
+                {
+                case image::PixelType::YUV_420P_U8:
+                case image::PixelType::YUV_420P_U16:
+                    w2 = w / 2;
+                    h2 = h / 2;
+                    break;
+                case image::PixelType::YUV_422P_U8:
+                case image::PixelType::YUV_422P_U16:
+                    w2 = w / 2;
+                    break;
+                default: break;
+                }
+                const int xShift = w2 < w ? 1 : 0;
+                const int y2 = std::min(h2 < h ? y / 2 : y, std::max(h2 - 1, 0));
+                const T* yPlane = reinterpret_cast<const T*>(image->getData()) + y * w;
+                const T* uPlane = reinterpret_cast<const T*>(image->getData()) + w * h + y2 * w2;
+                const T* vPlane = reinterpret_cast<const T*>(image->getData()) + w * h + w2 * h2 + y2 * w2;
+                const bool swap =
+                    sizeof(T) > 1 &&
+                    info.layout.endian != memory::getEndian();
+                const float scale = 1.F / static_cast<float>(std::numeric_limits<T>::max());
+                const math::Vector4f c = image::getYUVCoefficients(info.yuvCoefficients);
+                for (int x = 0; x < w; ++x, out += 4)
+                {
+                    const int x2 = std::min(x >> xShift, std::max(w2 - 1, 0));
+                    T yv = yPlane[x];
+                    T uv = uPlane[x2];
+                    T vv = vPlane[x2];
+                    if (swap)
+                    {
+                        memory::endian(&yv, 1, sizeof(T));
+                        memory::endian(&uv, 1, sizeof(T));
+                        memory::endian(&vv, 1, sizeof(T));
+                    }
+                    float luma = yv * scale;
+                    float cb = uv * scale;
+                    float cr = vv * scale;
+                    if (image::VideoLevels::LegalRange == videoLevels)
+                    {
+                        luma = (luma - (16.F / 255.F)) * (255.F / (235.F - 16.F));
+                        cb = (cb - (16.F / 255.F)) * (255.F / (240.F - 16.F));
+                        cr = (cr - (16.F / 255.F)) * (255.F / (240.F - 16.F));
+                    }
+                    cb -= .5F;
+                    cr -= .5F;
+                    out[0] = luma + c.x * cr;
+                    out[1] = luma - c.y * cr - c.z * cb;
+                    out[2] = luma + c.w * cb;
+                    out[3] = 1.F;
+                }
+            }
+
+            template<typename T>
+            void readRow(const float* in, int channels, float scale, bool clamp, uint8_t* out, int w)
+            {
+                T* p = reinterpret_cast<T*>(out);
+                for (int x = 0; x < w; ++x, in += 4, p += channels)
+                {
+                    for (int c = 0; c < channels; ++c)
+                    {
+                        const float v = in[1 == channels ? 0 : (2 == channels && 1 == c ? 3 : c)];
+                        p[c] = clamp ?
+                            static_cast<T>(std::min(std::max(v, 0.F), 1.F) * scale + .5F) :
+                            static_cast<T>(v);
+                    }
+                }
+            }
+
+            void readRow(const float* in, image::PixelType pixelType, uint8_t* out, int w)
+            {
+                const int channels = image::getChannelCount(pixelType);
+                switch (pixelType)
+                {
+                case image::PixelType::L_U8:
+                case image::PixelType::LA_U8:
+                case image::PixelType::RGB_U8:
+                case image::PixelType::RGBA_U8:
+                    readRow<uint8_t>(in, channels, 255.F, true, out, w);
+                    break;
+                case image::PixelType::L_U16:
+                case image::PixelType::LA_U16:
+                case image::PixelType::RGB_U16:
+                case image::PixelType::RGBA_U16:
+                    readRow<uint16_t>(in, channels, 65535.F, true, out, w);
+                    break;
+                case image::PixelType::L_U32:
+                case image::PixelType::LA_U32:
+                case image::PixelType::RGB_U32:
+                case image::PixelType::RGBA_U32:
+                    readRow<uint32_t>(in, channels, 4294967295.F, true, out, w);
+                    break;
+                case image::PixelType::L_F16:
+                case image::PixelType::LA_F16:
+                case image::PixelType::RGB_F16:
+                case image::PixelType::RGBA_F16:
+                    readRow<half>(in, channels, 1.F, false, out, w);
+                    break;
+                case image::PixelType::L_F32:
+                case image::PixelType::LA_F32:
+                case image::PixelType::RGB_F32:
+                case image::PixelType::RGBA_F32:
+                    readRow<float>(in, channels, 1.F, false, out, w);
+                    break;
+                case image::PixelType::RGB_U10:
+                {
+                    uint32_t* p = reinterpret_cast<uint32_t*>(out);
+                    for (int x = 0; x < w; ++x, in += 4, ++p)
+                    {
+                        const uint32_t r = static_cast<uint32_t>(std::min(std::max(in[0], 0.F), 1.F) * 1023.F + .5F);
+                        const uint32_t g = static_cast<uint32_t>(std::min(std::max(in[1], 0.F), 1.F) * 1023.F + .5F);
+                        const uint32_t b = static_cast<uint32_t>(std::min(std::max(in[2], 0.F), 1.F) * 1023.F + .5F);
+                        p[0] = (r << 22) | (g << 12) | (b << 2);
+                    }
+                    break;
+                }
+                default: break;
+                }
+            }
+
+            void mirrorRow(float* row, int w)
+            {
+                for (int x = 0; x < w / 2; ++x)
+                {
+                    std::swap_ranges(row + x * 4, row + x * 4 + 4, row + (w - 1 - x) * 4);
+                }
+            }
+        }
+
+        void convertImage(
+            const std::shared_ptr<image::Image>& image,
+            image::VideoLevels videoLevels,
+            const std::shared_ptr<image::Image>& out,
+            int y0,
+            int y1)
+        {
+            const auto& info = image->getInfo();
+            const int w = info.size.w;
+            const int h = info.size.h;
+            const size_t rowByteCount = getRowByteCount(info);
+            const size_t wordSize = getWordSize(info.pixelType);
+            const bool swap = wordSize > 1 && info.layout.endian != memory::getEndian();
+            std::vector<uint8_t> tmp;
+            for (int y = y0; y < y1; ++y)
+            {
+                // Without mirroring the first row of the image data is the
+                // bottom of the image.
+                const int imageY = info.layout.mirror.y ? y : (h - 1 - y);
+                float* outP = reinterpret_cast<float*>(out->getData()) + y * w * 4;
+                switch (info.pixelType)
+                {
+                case image::PixelType::YUV_420P_U8:
+                case image::PixelType::YUV_422P_U8:
+                case image::PixelType::YUV_444P_U8:
+                    convertYUVRow<uint8_t>(image, videoLevels, imageY, outP);
+                    break;
+                case image::PixelType::YUV_420P_U16:
+                case image::PixelType::YUV_422P_U16:
+                case image::PixelType::YUV_444P_U16:
+                    convertYUVRow<uint16_t>(image, videoLevels, imageY, outP);
+                    break;
+                default:
+                {
+                    const uint8_t* p = image->getData() + imageY * rowByteCount;
+                    if (swap)
+                    {
+                        tmp.resize(rowByteCount);
+                        memory::endian(p, tmp.data(), rowByteCount / wordSize, wordSize);
+                        p = tmp.data();
+                    }
+                    convertRow(p, info.pixelType, outP, w);
+                    if (image::VideoLevels::LegalRange == videoLevels)
+                    {
+                        const bool gray = image::getChannelCount(info.pixelType) < 3;
+                        const float rScale = 255.F / (235.F - 16.F);
+                        const float gbScale = gray ? rScale : (255.F / (240.F - 16.F));
+                        float* q = outP;
+                        for (int x = 0; x < w; ++x, q += 4)
+                        {
+                            q[0] = (q[0] - (16.F / 255.F)) * rScale;
+                            q[1] = (q[1] - (16.F / 255.F)) * gbScale;
+                            q[2] = (q[2] - (16.F / 255.F)) * gbScale;
+                        }
+                    }
+                    break;
+                }
+                }
+                if (info.layout.mirror.x)
+                {
+                    mirrorRow(outP, w);
+                }
+            }
+        }
+
+        void readImage(
+            const std::shared_ptr<image::Image>& image,
+            const std::shared_ptr<image::Image>& out,
+            int y0,
+            int y1)
+        {
+            const auto& info = out->getInfo();
+            const int w = info.size.w;
+            const int h = info.size.h;
+            const size_t rowByteCount = getRowByteCount(info);
+            const size_t wordSize = getWordSize(info.pixelType);
+            const bool swap = wordSize > 1 && info.layout.endian != memory::getEndian();
+            for (int y = y0; y < y1; ++y)
+            {
+                // Like glReadPixels() the rows are stored bottom to top and
+                // the mirror flags are ignored.
+                const float* inP = reinterpret_cast<const float*>(image->getData()) + (h - 1 - y) * w * 4;
+                uint8_t* outP = out->getData() + y * rowByteCount;
+                readRow(inP, info.pixelType, outP, w);
+                if (swap)
+                {
+                    memory::endian(outP, rowByteCount / wordSize, wordSize);
+                }
+            }
+        }
+
+        void Render::_init(
+            const std::shared_ptr<system::Context>& context,
+            size_t threadCount)
+        {
+            IRender::_init(context);
+            TLRENDER_P();
+
+            p.threadCount = threadCount > 0 ?
+                threadCount :
+                std::max(std::thread::hardware_concurrency(), 1U);
+            p.workerPool.reset(new WorkerPool(p.threadCount));
+
+            p.logTimer = std::chrono::steady_clock::now();
+        }
+
+        WorkerPool::WorkerPool(size_t threadCount)
+        {
+            for (size_t i = 1; i < threadCount; ++i)
+            {
+                _threads.push_back(std::thread(
+                    [this]
+                    {
+                        while (true)
+                        {
+                            {
+                                std::unique_lock<std::mutex> lock(_mutex);
+                                _cv.wait(
+                                    lock,
+                                    [this]
+                                    {
+                                        return !_running || (_function && _next < _bands);
+                                    });
+                                if (!_running)
+                                    break;
+                            }
+                            _runBand();
+                        }
+                    }));
+            }
+        }
+
+        WorkerPool::~WorkerPool()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _running = false;
+            }
+            _cv.notify_all();
+            for (auto& thread : _threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+
+        void WorkerPool::run(
+            int y0,
+            int y1,
+            int bands,
+            const std::function<void(int, int)>& function)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _function = &function;
+                _y0 = y0;
+                _rows = y1 - y0;
+                _bands = bands;
+                _next = 0;
+                _done = 0;
+            }
+            _cv.notify_all();
+            while (_runBand())
+                ;
+            std::unique_lock<std::mutex> lock(_mutex);
+            _doneCV.wait(
+                lock,
+                [this]
+                {
+                    return _done == _bands;
+                });
+            _function = nullptr;
+        }
+
+        bool WorkerPool::_runBand()
+        {
+            const std::function<void(int, int)>* function = nullptr;
+            int a = 0;
+            int b = 0;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (!_function || _next >= _bands)
+                    return false;
+                function = _function;
+                a = _y0 + _rows * _next / _bands;
+                b = _y0 + _rows * (_next + 1) / _bands;
+                ++_next;
+            }
+            (*function)(a, b);
+            bool done = false;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                ++_done;
+                done = _done == _bands;
+            }
+            if (done)
+            {
+                _doneCV.notify_one();
+            }
+            return true;
+        }
+
+        Render::Render() :
+            _p(new Private)
+        {}
+
+        Render::~Render()
+        {}
+
+        std::shared_ptr<Render> Render::create(
+            const std::shared_ptr<system::Context>& context,
+            size_t threadCount)
+        {
+            auto out = std::shared_ptr<Render>(new Render);
+            out->_init(context, threadCount);
+            return out;
+        }
+
+        size_t Render::getThreadCount() const
+        {
+            return _p->threadCount;
+        }
+
+        const std::shared_ptr<image::Image>& Render::getImage() const
+        {
+            return _p->image;
+        }
+
+        void Render::read(const std::shared_ptr<image::Image>& value) const
+        {
+            TLRENDER_P();
+            const auto& info = value->getInfo();
+            if (!p.image ||
+                info.size.w != p.image->getWidth() ||
+                info.size.h != p.image->getHeight())
+            {
+                throw std::runtime_error("The image size does not match the render size");
+            }
+            if (0 == getWordSize(info.pixelType) ||
+                image::PixelType::ARGB_4444_Premult == info.pixelType ||
+                (info.pixelType >= image::PixelType::YUV_420P_U8 &&
+                    info.pixelType <= image::PixelType::YUV_444P_U16))
+            {
+                throw std::runtime_error(string::Format("Cannot read the pixel type: {0}").
+                    arg(info.pixelType));
+            }
+            p.parallel(
+                0,
+                info.size.h,
+                [this, &value](int y0, int y1)
+                {
+                    readImage(_p->image, value, y0, y1);
+                });
+        }
+
+        void Render::begin(
+            const math::Size2i& renderSize,
+            const timeline::RenderOptions& renderOptions)
+        {
+            TLRENDER_P();
+
+            p.timer = std::chrono::steady_clock::now();
+
+            p.renderSize = renderSize;
+            p.renderOptions = renderOptions;
+            p.imageCache.setMax(renderOptions.textureCacheByteCount);
+
+            if (!p.image ||
+                p.image->getWidth() != renderSize.w ||
+                p.image->getHeight() != renderSize.h)
+            {
+                p.image = image::Image::create(
+                    renderSize.w,
+                    renderSize.h,
+                    image::PixelType::RGBA_F32);
+                p.image->zero();
+            }
+            p.target = p.image;
+            p.wipe = Private::Wipe();
+
+            setViewport(math::Box2i(0, 0, renderSize.w, renderSize.h));
+            if (renderOptions.clear)
+            {
+                clearViewport(renderOptions.clearColor);
+            }
+            setTransform(math::ortho(
+                0.F,
+                static_cast<float>(renderSize.w),
+                static_cast<float>(renderSize.h),
+                0.F,
+                -1.F,
+                1.F));
+        }
+
+        void Render::end()
+        {
+            TLRENDER_P();
+
+            const auto now = std::chrono::steady_clock::now();
+            const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(now - p.timer);
+            p.currentStats.time = diff.count();
+            p.stats.push_back(p.currentStats);
+            p.currentStats = Private::Stats();
+            while (p.stats.size() > 60)
+            {
+                p.stats.pop_front();
+            }
+
+            const std::chrono::duration<float> logDiff = now - p.logTimer;
+            if (logDiff.count() > 10.F)
+            {
+                p.logTimer = now;
+                if (auto context = _context.lock())
+                {
+                    Private::Stats average;
+                    const size_t size = p.stats.size();
+                    if (size > 0)
+                    {
+                        for (const auto& i : p.stats)
+                        {
+                            average.time += i.time;
+                            average.rects += i.rects;
+                            average.meshes += i.meshes;
+                            average.meshTriangles += i.meshTriangles;
+                            average.text += i.text;
+                            average.images += i.images;
+                            average.imageConversions += i.imageConversions;
+                        }
+                        average.time /= p.stats.size();
+                        average.rects /= p.stats.size();
+                        average.meshes /= p.stats.size();
+                        average.meshTriangles /= p.stats.size();
+                        average.text /= p.stats.size();
+                        average.images /= p.stats.size();
+                        average.imageConversions /= p.stats.size();
+                    }
+
+                    context->log(
+                        string::Format("tl::timeline::CPURender {0}").arg(this),
+                        string::Format(
+                            "\n"
+                            "    Average render time: {0}ms\n"
+                            "    Average rectangle count: {1}\n"
+                            "    Average mesh count: {2}\n"
+                            "    Average mesh triangles: {3}\n"
+                            "    Average text count: {4}\n"
+                            "    Average image count: {5}\n"
+                            "    Average image conversions: {6}\n"
+                            "    Image cache: {7}%\n"
+                            "    Threads: {8}").
+                        arg(average.time).
+                        arg(average.rects).
+                        arg(average.meshes).
+                        arg(average.meshTriangles).
+                        arg(average.text).
+                        arg(average.images).
+                        arg(average.imageConversions).
+                        arg(p.imageCache.getPercentage()).
+                        arg(p.threadCount));
+                }
+            }
+        }
+
+        math::Size2i Render::getRenderSize() const
+        {
+            return _p->renderSize;
+        }
+
+        void Render::setRenderSize(const math::Size2i& value)
+        {
+            _p->renderSize = value;
+        }
+
+        math::Box2i Render::getViewport() const
+        {
+            return _p->viewport;
+        }
+
+        void Render::setViewport(const math::Box2i& value)
+        {
+            _p->viewport = value;
+        }
+
+        void Render::clearViewport(const image::Color4f& value)
+        {
+            TLRENDER_P();
+            if (!p.target)
+                return;
+
+            // Like glClear() the viewport is ignored, but not the clipping
+            // rectangle.
+            math::Box2i box(0, 0, p.target->getWidth(), p.target->getHeight());
+            if (p.target == p.image && p.clipRectEnabled)
+            {
+                box = math::Box2i(
+                    math::Vector2i(
+                        std::max(box.min.x, p.clipRect.min.x),
+                        std::max(box.min.y, p.clipRect.min.y)),
+                    math::Vector2i(
+                        std::min(box.max.x, p.clipRect.max.x),
+                        std::min(box.max.y, p.clipRect.max.y)));
+            }
+            if (box.max.x < box.min.x || box.max.y < box.min.y)
+                return;
+            const int w = p.target->getWidth();
+            float* data = reinterpret_cast<float*>(p.target->getData());
+            p.parallel(
+                box.min.y,
+                box.max.y + 1,
+                [data, w, box, value](int y0, int y1)
+                {
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        float* d = data + (y * w + box.min.x) * 4;
+                        for (int x = box.min.x; x <= box.max.x; ++x, d += 4)
+                        {
+                            d[0] = value.r;
+                            d[1] = value.g;
+                            d[2] = value.b;
+                            d[3] = value.a;
+                        }
+                    }
+                });
+        }
+
+        bool Render::getClipRectEnabled() const
+        {
+            return _p->clipRectEnabled;
+        }
+
+        void Render::setClipRectEnabled(bool value)
+        {
+            _p->clipRectEnabled = value;
+        }
+
+        math::Box2i Render::getClipRect() const
+        {
+            return _p->clipRect;
+        }
+
+        void Render::setClipRect(const math::Box2i& value)
+        {
+            _p->clipRect = value;
+        }
+
+        math::Matrix4x4f Render::getTransform() const
+        {
+            return _p->transform;
+        }
+
+        void Render::setTransform(const math::Matrix4x4f& value)
+        {
+            _p->transform = value;
+        }
+
+        void Render::setOCIOOptions(const timeline::OCIOOptions& value)
+        {
+            TLRENDER_P();
+            if (value == p.ocioOptions)
+                return;
+
+#if defined(TLRENDER_OCIO)
+            p.ocioData.reset();
+#endif // TLRENDER_OCIO
+
+            p.ocioOptions = value;
+
+#if defined(TLRENDER_OCIO)
+            if (p.ocioOptions.enabled)
+            {
+                auto ocioData = std::make_unique<OCIOData>();
+
+                if (!p.ocioOptions.fileName.empty())
+                {
+                    ocioData->config = OCIO::Config::CreateFromFile(p.ocioOptions.fileName.c_str());
+                }
+                else
+                {
+                    ocioData->config = OCIO::GetCurrentConfig();
+                }
+                if (!ocioData->config)
+                {
+                    throw std::runtime_error("Cannot get OCIO configuration");
+                }
+
+                if (!p.ocioOptions.input.empty())
+                {
+                    OCIO::ConstColorSpaceRcPtr srcCS =
+                        ocioData->config->getColorSpace(p.ocioOptions.input.c_str());
+                    OCIO::ConstColorSpaceRcPtr dstCS =
+                        ocioData->config->getColorSpace(OCIO::ROLE_SCENE_LINEAR);
+                    OCIO::ConstProcessorRcPtr processor = ocioData->config->getProcessor(
+                        ocioData->config->getCurrentContext(),
+                        srcCS,
+                        dstCS);
+                    if (!processor)
+                    {
+                        throw std::runtime_error("Cannot get OCIO processor");
+                    }
+                    ocioData->icsProcessor = processor->getDefaultCPUProcessor();
+                    if (!ocioData->icsProcessor)
+                    {
+                        throw std::runtime_error("Cannot get OCIO CPU processor for ICS");
+                    }
+                }
+                if (!p.ocioOptions.display.empty() &&
+                    !p.ocioOptions.view.empty())
+                {
+                    ocioData->transform = OCIO::DisplayViewTransform::Create();
+                    if (!ocioData->transform)
+                    {
+                        throw std::runtime_error("Cannot create OCIO transform");
+                    }
+                    ocioData->transform->setSrc(OCIO::ROLE_SCENE_LINEAR);
+                    ocioData->transform->setDisplay(p.ocioOptions.display.c_str());
+                    ocioData->transform->setView(p.ocioOptions.view.c_str());
+
+                    ocioData->lvp = OCIO::LegacyViewingPipeline::Create();
+                    if (!ocioData->lvp)
+                    {
+                        throw std::runtime_error("Cannot create OCIO viewing pipeline");
+                    }
+                    ocioData->lvp->setDisplayViewTransform(ocioData->transform);
+                    ocioData->lvp->setLooksOverrideEnabled(true);
+                    ocioData->lvp->setLooksOverride(p.ocioOptions.look.c_str());
+
+                    OCIO::ConstProcessorRcPtr processor = ocioData->lvp->getProcessor(
+                        ocioData->config,
+                        ocioData->config->getCurrentContext());
+                    if (!processor)
+                    {
+                        throw std::runtime_error("Cannot get OCIO processor");
+                    }
+                    ocioData->displayProcessor = processor->getDefaultCPUProcessor();
+                    if (!ocioData->displayProcessor)
+                    {
+                        throw std::runtime_error("Cannot get OCIO CPU processor");
+                    }
+                }
+                p.ocioData = std::move(ocioData);
+            }
+#endif // TLRENDER_OCIO
+        }
+
+        void Render::setLUTOptions(const timeline::LUTOptions& value)
+        {
+            TLRENDER_P();
+            if (value == p.lutOptions)
+                return;
+
+#if defined(TLRENDER_OCIO)
+            p.lutData.reset();
+#endif // TLRENDER_OCIO
+
+            p.lutOptions = value;
+
+#if defined(TLRENDER_OCIO)
+            if (p.lutOptions.enabled && !p.lutOptions.fileName.empty())
+            {
+                auto lutData = std::make_unique<OCIOLUTData>();
+
+                lutData->config = OCIO::Config::CreateRaw();
+                if (!lutData->config)
+                {
+                    throw std::runtime_error("Cannot create OCIO configuration");
+                }
+
+                lutData->transform = OCIO::FileTransform::Create();
+                if (!lutData->transform)
+                {
+                    throw std::runtime_error("Cannot create OCIO transform");
+                }
+                lutData->transform->setSrc(p.lutOptions.fileName.c_str());
+                lutData->transform->validate();
+
+                OCIO::ConstProcessorRcPtr processor = lutData->config->getProcessor(lutData->transform);
+                if (!processor)
+                {
+                    throw std::runtime_error("Cannot get OCIO processor");
+                }
+                lutData->processor = processor->getDefaultCPUProcessor();
+                if (!lutData->processor)
+                {
+                    throw std::runtime_error("Cannot get OCIO CPU processor");
+                }
+                p.lutData = std::move(lutData);
+            }
+#endif // TLRENDER_OCIO
+        }
+
+        void Render::setHDROptions(const timeline::HDROptions& value)
+        {
+            TLRENDER_P();
+            if (value == p.hdrOptions)
+                return;
+            p.hdrOptions = value;
+            if (p.hdrOptions.tonemap)
+            {
+                // Tone mapping is only supported by the OpenGL renderer
+                // with libplacebo, the images are drawn without it.
+                if (auto context = _context.lock())
+                {
+                    context->log(
+                        string::Format("tl::timeline::CPURender {0}").arg(this),
+                        "Tone mapping is not supported by the CPU renderer",
+                        log::Type::Warning);
+                }
+            }
+        }
+
+        void Render::Private::parallel(
+            int y0,
+            int y1,
+            const std::function<void(int, int)>& function) const
+        {
+            const int rows = y1 - y0;
+            if (rows <= 0)
+                return;
+            const int bands = std::min(static_cast<int>(threadCount), rows / bandRowsMin);
+            if (bands <= 1)
+            {
+                function(y0, y1);
+                return;
+            }
+            workerPool->run(y0, y1, bands, function);
+        }
+
+        math::Vector2f Render::Private::toPixels(const math::Vector2f& value) const
+        {
+            math::Vector2f out = value;
+            if (target == image)
+            {
+                const math::Vector3f ndc = transform * math::Vector3f(value.x, value.y, 0.F);
+                out.x = viewport.min.x + (ndc.x + 1.F) / 2.F * viewport.w();
+                out.y = viewport.min.y + (1.F - ndc.y) / 2.F * viewport.h();
+            }
+            return out;
+        }
+
+        math::Box2f Render::Private::toPixels(const math::Box2i& value) const
+        {
+            const math::Vector2f a = toPixels(math::Vector2f(value.min.x, value.min.y));
+            const math::Vector2f b = toPixels(math::Vector2f(value.max.x + 1, value.max.y + 1));
+            return math::Box2f(
+                math::Vector2f(std::min(a.x, b.x), std::min(a.y, b.y)),
+                math::Vector2f(std::max(a.x, b.x), std::max(a.y, b.y)));
+        }
+
+        math::Box2i Render::Private::getClip() const
+        {
+            math::Box2i out(0, 0, target->getWidth(), target->getHeight());
+            if (target == image)
+            {
+                std::vector<math::Box2i> boxes = { viewport };
+                if (clipRectEnabled)
+                {
+                    boxes.push_back(clipRect);
+                }
+                for (const auto& box : boxes)
+                {
+                    out = math::Box2i(
+                        math::Vector2i(
+                            std::max(out.min.x, box.min.x),
+                            std::max(out.min.y, box.min.y)),
+                        math::Vector2i(
+                            std::min(out.max.x, box.max.x),
+                            std::min(out.max.y, box.max.y)));
+                }
+            }
+            return out;
+        }
+
+        math::Box2i Render::Private::getPixels(const math::Box2f& value) const
+        {
+            const math::Box2i clip = getClip();
+            return math::Box2i(
+                math::Vector2i(
+                    std::max(static_cast<int>(std::ceil(value.min.x - .5F)), clip.min.x),
+                    std::max(static_cast<int>(std::ceil(value.min.y - .5F)), clip.min.y)),
+                math::Vector2i(
+                    std::min(static_cast<int>(std::ceil(value.max.x - .5F)) - 1, clip.max.x),
+                    std::min(static_cast<int>(std::ceil(value.max.y - .5F)) - 1, clip.max.y)));
+        }
+
+        std::shared_ptr<image::Image> Render::Private::getBuffer(
+            const std::string& name,
+            const math::Size2i& size)
+        {
+            auto& out = buffers[name];
+            if (!out ||
+                out->getWidth() != size.w ||
+                out->getHeight() != size.h)
+            {
+                out = image::Image::create(size.w, size.h, image::PixelType::RGBA_F32);
+            }
+            out->zero();
+            return out;
+        }
+
+        std::shared_ptr<image::Image> Render::Private::getFloatImage(
+            const std::shared_ptr<image::Image>& value,
+            const timeline::ImageOptions& imageOptions)
+        {
+            const auto& info = value->getInfo();
+            image::VideoLevels videoLevels = info.videoLevels;
+            switch (imageOptions.videoLevels)
+            {
+            case timeline::InputVideoLevels::FullRange:
+                videoLevels = image::VideoLevels::FullRange;
+                break;
+            case timeline::InputVideoLevels::LegalRange:
+                videoLevels = image::VideoLevels::LegalRange;
+                break;
+            default: break;
+            }
+
+            std::shared_ptr<image::Image> out;
+            if (imageOptions.cache &&
+                imageCache.get(value, out) &&
+                out->getInfo().videoLevels == videoLevels)
+            {
+                return out;
+            }
+
+            ++currentStats.imageConversions;
+            image::Info outInfo(info.size, image::PixelType::RGBA_F32);
+            outInfo.videoLevels = videoLevels;
+            out = image::Image::create(outInfo);
+            parallel(
+                0,
+                info.size.h,
+                [&value, videoLevels, &out](int y0, int y1)
+                {
+                    convertImage(value, videoLevels, out, y0, y1);
+                });
+            if (imageOptions.cache)
+            {
+                imageCache.add(value, out, out->getDataByteCount());
+            }
+            return out;
+        }
+
+        void Render::Private::drawRows(
+            const std::shared_ptr<image::Image>& src,
+            const math::Box2i& box,
+            const timeline::ImageFilters& imageFilters,
+            const RowFunc& function)
+        {
+            const math::Box2f pixels = toPixels(box);
+            const math::Box2i clip = getPixels(pixels);
+            const int srcW = src->getWidth();
+            const int srcH = src->getHeight();
+            if (clip.max.x < clip.min.x ||
+                clip.max.y < clip.min.y ||
+                srcW <= 0 ||
+                srcH <= 0)
+                return;
+
+            // Map the pixel centers to the source image.
+            const float pw = pixels.max.x - pixels.min.x;
+            const float ph = pixels.max.y - pixels.min.y;
+            const bool linear =
+                timeline::ImageFilter::Linear ==
+                (pw >= srcW && ph >= srcH ? imageFilters.magnify : imageFilters.minify);
+            const int count = clip.max.x - clip.min.x + 1;
+            std::vector<int> xs(count * 2);
+            std::vector<float> xf(count);
+            for (int i = 0; i < count; ++i)
+            {
+                float u = (clip.min.x + i + .5F - pixels.min.x) / pw * srcW;
+                if (linear)
+                {
+                    u -= .5F;
+                    const float x0 = std::floor(u);
+                    xs[i * 2] = math::clamp(static_cast<int>(x0), 0, srcW - 1);
+                    xs[i * 2 + 1] = math::clamp(static_cast<int>(x0) + 1, 0, srcW - 1);
+                    xf[i] = u - x0;
+                }
+                else
+                {
+                    xs[i * 2] = xs[i * 2 + 1] = math::clamp(static_cast<int>(std::floor(u)), 0, srcW - 1);
+                    xf[i] = 0.F;
+                }
+            }
+
+            const float* srcData = reinterpret_cast<const float*>(src->getData());
+            const int dstW = target->getWidth();
+            float* dstData = reinterpret_cast<float*>(target->getData());
+            parallel(
+                clip.min.y,
+                clip.max.y + 1,
+                [&](int y0, int y1)
+                {
+                    std::vector<float> row(count * 4);
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        float v = (y + .5F - pixels.min.y) / ph * srcH;
+                        int r0 = 0;
+                        int r1 = 0;
+                        float yf = 0.F;
+                        if (linear)
+                        {
+                            v -= .5F;
+                            const float y0f = std::floor(v);
+                            r0 = math::clamp(static_cast<int>(y0f), 0, srcH - 1);
+                            r1 = math::clamp(static_cast<int>(y0f) + 1, 0, srcH - 1);
+                            yf = v - y0f;
+                        }
+                        else
+                        {
+                            r0 = r1 = math::clamp(static_cast<int>(std::floor(v)), 0, srcH - 1);
+                        }
+                        const float* row0 = srcData + r0 * srcW * 4;
+                        const float* row1 = srcData + r1 * srcW * 4;
+                        float* out = row.data();
+                        for (int i = 0; i < count; ++i, out += 4)
+                        {
+                            const float* a = row0 + xs[i * 2] * 4;
+                            const float* b = row0 + xs[i * 2 + 1] * 4;
+                            const float* c = row1 + xs[i * 2] * 4;
+                            const float* d = row1 + xs[i * 2 + 1] * 4;
+                            const float fx = xf[i];
+                            for (int k = 0; k < 4; ++k)
+                            {
+                                const float top = a[k] + (b[k] - a[k]) * fx;
+                                const float bottom = c[k] + (d[k] - c[k]) * fx;
+                                out[k] = top + (bottom - top) * yf;
+                            }
+                        }
+                        function(
+                            row.data(),
+                            dstData + (y * dstW + clip.min.x) * 4,
+                            count,
+                            clip.min.x,
+                            y);
+                    }
+                });
+        }
+
+        bool Render::Private::isInsideWipe(int x, int y) const
+        {
+            bool out = true;
+            if (wipe.enabled && target == image)
+            {
+                const float px = x + .5F;
+                const float py = y + .5F;
+                const float s =
+                    (wipe.b.x - wipe.a.x) * (py - wipe.a.y) -
+                    (wipe.b.y - wipe.a.y) * (px - wipe.a.x);
+                out = s * wipe.side >= 0.F;
+            }
+            return out;
+        }
+    }
+}
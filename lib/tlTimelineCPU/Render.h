@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/IRender.h>
+
+namespace tl
+{
+    //! Timeline CPU support
+    namespace timeline_cpu
+    {
+        //! CPU renderer.
+        //!
+        //! The renderer draws into a floating point RGBA image without an
+        //! OpenGL context, for example to convert files on machines without
+        //! a GPU. The pixels are processed in bands of rows by a number of
+        //! threads.
+        //!
+        //! The transforms are limited to scaling and translation, and
+        //! drawing OpenGL textures (drawTexture()) and tone mapping are not
+        //! supported. A warning is logged when they are used.
+        class Render : public timeline::IRender
+        {
+            TLRENDER_NON_COPYABLE(Render);
+
+        protected:
+            void _init(
+                const std::shared_ptr<system::Context>&,
+                size_t threadCount);
+
+            Render();
+
+        public:
+            virtual ~Render();
+
+            //! Create a new renderer. If the thread count is zero the
+            //! number of hardware threads is used.
+            static std::shared_ptr<Render> create(
+                const std::shared_ptr<system::Context>&,
+                size_t threadCount = 0);
+
+            //! Get the number of threads.
+            size_t getThreadCount() const;
+
+            //! Get the rendered image. The pixel type is RGBA_F32 and the
+            //! first row is the top of the render.
+            const std::shared_ptr<image::Image>& getImage() const;
+
+            //! Copy the rendered image, converting it to the pixel type,
+            //! alignment, and endian of the given image. The rows are
+            //! stored bottom to top to match reading the OpenGL renderer
+            //! with glReadPixels(). YUV pixel types are not supported.
+            void read(const std::shared_ptr<image::Image>&) const;
+
+            void begin(
+                const math::Size2i&,
+                const timeline::RenderOptions& = timeline::RenderOptions()) override;
+            void end() override;
+
+            math::Size2i getRenderSize() const override;
+            void setRenderSize(const math::Size2i&) override;
+            math::Box2i getViewport() const override;
+            void setViewport(const math::Box2i&) override;
+            void clearViewport(const image::Color4f&) override;
+            bool getClipRectEnabled() const override;
+            void setClipRectEnabled(bool) override;
+            math::Box2i getClipRect() const override;
+            void setClipRect(const math::Box2i&) override;
+            math::Matrix4x4f getTransform() const override;
+            void setTransform(const math::Matrix4x4f&) override;
+            void setOCIOOptions(const timeline::OCIOOptions&) override;
+            void setLUTOptions(const timeline::LUTOptions&) override;
+            void setHDROptions(const timeline::HDROptions&) override;
+
+            void drawRect(
+                const math::Box2i&,
+                const image::Color4f&) override;
+            void drawMesh(
+                const geom::TriangleMesh2&,
+                const math::Vector2i& position,
+                const image::Color4f&) override;
+            void drawColorMesh(
+                const geom::TriangleMesh2&,
+                const math::Vector2i& position,
+                const image::Color4f&) override;
+            void drawText(
+                const std::vector<std::shared_ptr<image::Glyph> >& glyphs,
+                const math::Vector2i& position,
+                const image::Color4f&) override;
+            void drawTexture(
+                unsigned int,
+                const math::Box2i&,
+                const image::Color4f& = image::Color4f(1.F, 1.F, 1.F)) override;
+            void drawImage(
+                const std::shared_ptr<image::Image>&,
+                const math::Box2i&,
+                const image::Color4f& = image::Color4f(1.F, 1.F, 1.F),
+                const timeline::ImageOptions& = timeline::ImageOptions()) override;
+            void drawVideo(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>& = {},
+                const std::vector<timeline::DisplayOptions>& = {},
+                const timeline::CompareOptions& = timeline::CompareOptions(),
+                const timeline::BackgroundOptions& = timeline::BackgroundOptions()) override;
+
+        private:
+            void _drawBackground(
+                const std::vector<math::Box2i>&,
+                const timeline::BackgroundOptions&);
+            void _drawVideoA(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoB(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoWipe(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoOverlay(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoDifference(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoTile(
+                const std::vector<timeline::VideoData>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideo(
+                const timeline::VideoData&,
+                const math::Box2i&,
+                const std::shared_ptr<timeline::ImageOptions>&,
+                const timeline::DisplayOptions&);
+            std::shared_ptr<image::Image> _drawVideoBuffer(
+                const std::string&,
+                const timeline::VideoData&,
+                const math::Size2i&,
+                const std::shared_ptr<timeline::ImageOptions>&,
+                const timeline::DisplayOptions&);
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
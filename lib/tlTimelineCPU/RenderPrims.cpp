@@ -0,0 +1,326 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <tlCore/Context.h>
+#include <tlCore/FontSystem.h>
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        namespace
+        {
+            float edge(
+                const math::Vector2f& a,
+                const math::Vector2f& b,
+                float x,
+                float y)
+            {
+                return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+            }
+
+            //! Whether pixels exactly on an edge are drawn, so that pixels on
+            //! edges shared by two triangles are only drawn once.
+            bool isEdgeIncluded(const math::Vector2f& a, const math::Vector2f& b)
+            {
+                const float dx = b.x - a.x;
+                const float dy = b.y - a.y;
+                return dy > 0.F || (0.F == dy && dx < 0.F);
+            }
+
+            bool isInside(float value, bool edgeIncluded)
+            {
+                return value > 0.F || (0.F == value && edgeIncluded);
+            }
+        }
+
+        void Render::Private::drawTriangles(
+            const geom::TriangleMesh2& mesh,
+            const math::Vector2i& position,
+            const image::Color4f& color,
+            bool vertexColors)
+        {
+            const int w = target->getWidth();
+            float* data = reinterpret_cast<float*>(target->getData());
+            const image::Color4f white(1.F, 1.F, 1.F, 1.F);
+            for (const auto& triangle : mesh.triangles)
+            {
+                math::Vector2f v[3];
+                image::Color4f c[3];
+                bool valid = true;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    const size_t index = triangle.v[i].v;
+                    if (index < 1 || index > mesh.v.size())
+                    {
+                        valid = false;
+                        break;
+                    }
+                    const math::Vector2f& p = mesh.v[index - 1];
+                    v[i] = toPixels(math::Vector2f(p.x + position.x, p.y + position.y));
+                    const size_t colorIndex = triangle.v[i].c;
+                    if (vertexColors && colorIndex >= 1 && colorIndex <= mesh.c.size())
+                    {
+                        const math::Vector4f& mc = mesh.c[colorIndex - 1];
+                        c[i] = image::Color4f(mc.x, mc.y, mc.z, mc.w);
+                    }
+                    else
+                    {
+                        c[i] = white;
+                    }
+                }
+                if (!valid)
+                    continue;
+
+                // Use the same winding for all of the triangles.
+                float area = edge(v[0], v[1], v[2].x, v[2].y);
+                if (0.F == area)
+                    continue;
+                if (area < 0.F)
+                {
+                    std::swap(v[1], v[2]);
+                    std::swap(c[1], c[2]);
+                    area = -area;
+                }
+                const bool e0 = isEdgeIncluded(v[1], v[2]);
+                const bool e1 = isEdgeIncluded(v[2], v[0]);
+                const bool e2 = isEdgeIncluded(v[0], v[1]);
+
+                const math::Box2i pixels = getPixels(math::Box2f(
+                    math::Vector2f(
+                        std::min(std::min(v[0].x, v[1].x), v[2].x),
+                        std::min(std::min(v[0].y, v[1].y), v[2].y)),
+                    math::Vector2f(
+                        std::max(std::max(v[0].x, v[1].x), v[2].x),
+                        std::max(std::max(v[0].y, v[1].y), v[2].y))));
+                if (pixels.max.x < pixels.min.x || pixels.max.y < pixels.min.y)
+                    continue;
+                parallel(
+                    pixels.min.y,
+                    pixels.max.y + 1,
+                    [&](int y0, int y1)
+                    {
+                        for (int y = y0; y < y1; ++y)
+                        {
+                            const float py = y + .5F;
+                            float* d = data + (y * w + pixels.min.x) * 4;
+                            for (int x = pixels.min.x; x <= pixels.max.x; ++x, d += 4)
+                            {
+                                const float px = x + .5F;
+                                const float w0 = edge(v[1], v[2], px, py);
+                                const float w1 = edge(v[2], v[0], px, py);
+                                const float w2 = edge(v[0], v[1], px, py);
+                                if (isInside(w0, e0) && isInside(w1, e1) && isInside(w2, e2))
+                                {
+                                    const float l0 = w0 / area;
+                                    const float l1 = w1 / area;
+                                    const float l2 = w2 / area;
+                                    blendPrims(
+                                        d,
+                                        (c[0].r * l0 + c[1].r * l1 + c[2].r * l2) * color.r,
+                                        (c[0].g * l0 + c[1].g * l1 + c[2].g * l2) * color.g,
+                                        (c[0].b * l0 + c[1].b * l1 + c[2].b * l2) * color.b,
+                                        (c[0].a * l0 + c[1].a * l1 + c[2].a * l2) * color.a);
+                                }
+                            }
+                        }
+                    });
+            }
+        }
+
+        void Render::drawRect(
+            const math::Box2i& box,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.rects);
+
+            const math::Box2i pixels = p.getPixels(p.toPixels(box));
+            if (pixels.max.x < pixels.min.x || pixels.max.y < pixels.min.y)
+                return;
+            const int w = p.target->getWidth();
+            float* data = reinterpret_cast<float*>(p.target->getData());
+            p.parallel(
+                pixels.min.y,
+                pixels.max.y + 1,
+                [data, w, pixels, color](int y0, int y1)
+                {
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        float* d = data + (y * w + pixels.min.x) * 4;
+                        for (int x = pixels.min.x; x <= pixels.max.x; ++x, d += 4)
+                        {
+                            blendPrims(d, color.r, color.g, color.b, color.a);
+                        }
+                    }
+                });
+        }
+
+        void Render::drawMesh(
+            const geom::TriangleMesh2& mesh,
+            const math::Vector2i& position,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.meshes);
+            p.currentStats.meshTriangles += mesh.triangles.size();
+            p.drawTriangles(mesh, position, color, false);
+        }
+
+        void Render::drawColorMesh(
+            const geom::TriangleMesh2& mesh,
+            const math::Vector2i& position,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.meshes);
+            p.currentStats.meshTriangles += mesh.triangles.size();
+            p.drawTriangles(mesh, position, color, true);
+        }
+
+        void Render::drawText(
+            const std::vector<std::shared_ptr<image::Glyph> >& glyphs,
+            const math::Vector2i& pos,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.text);
+
+            const int w = p.target->getWidth();
+            float* data = reinterpret_cast<float*>(p.target->getData());
+            int x = 0;
+            int32_t rsbDeltaPrev = 0;
+            for (const auto& glyph : glyphs)
+            {
+                if (glyph)
+                {
+                    if (rsbDeltaPrev - glyph->lsbDelta > 32)
+                    {
+                        x -= 1;
+                    }
+                    else if (rsbDeltaPrev - glyph->lsbDelta < -31)
+                    {
+                        x += 1;
+                    }
+                    rsbDeltaPrev = glyph->rsbDelta;
+
+                    if (glyph->image && glyph->image->isValid())
+                    {
+                        // The glyph images are stored top to bottom with
+                        // the coverage in the first channel.
+                        const auto& info = glyph->image->getInfo();
+                        const math::Vector2i& offset = glyph->offset;
+                        const math::Box2i box(
+                            pos.x + x + offset.x,
+                            pos.y - offset.y,
+                            info.size.w,
+                            info.size.h);
+                        const math::Box2f boxPixels = p.toPixels(box);
+                        const math::Box2i pixels = p.getPixels(boxPixels);
+                        const size_t channels = image::getChannelCount(info.pixelType);
+                        const size_t rowByteCount = image::getAlignedByteCount(
+                            info.size.w * channels,
+                            info.layout.alignment);
+                        const uint8_t* glyphData = glyph->image->getData();
+                        const float sx = info.size.w / (boxPixels.max.x - boxPixels.min.x);
+                        const float sy = info.size.h / (boxPixels.max.y - boxPixels.min.y);
+                        for (int y = pixels.min.y; y <= pixels.max.y; ++y)
+                        {
+                            const int gy = math::clamp(
+                                static_cast<int>((y + .5F - boxPixels.min.y) * sy),
+                                0,
+                                info.size.h - 1);
+                            const uint8_t* g = glyphData + gy * rowByteCount;
+                            float* d = data + (y * w + pixels.min.x) * 4;
+                            for (int px = pixels.min.x; px <= pixels.max.x; ++px, d += 4)
+                            {
+                                const int gx = math::clamp(
+                                    static_cast<int>((px + .5F - boxPixels.min.x) * sx),
+                                    0,
+                                    info.size.w - 1);
+                                const float a = g[gx * channels] / 255.F * color.a;
+                                blendPrims(d, color.r, color.g, color.b, a);
+                            }
+                        }
+                    }
+
+                    x += glyph->advance;
+                }
+            }
+        }
+
+        void Render::drawTexture(
+            unsigned int,
+            const math::Box2i&,
+            const image::Color4f&)
+        {
+            // OpenGL textures are not supported by the CPU renderer, warn
+            // the first time one is drawn.
+            TLRENDER_P();
+            if (!p.drawTextureWarning)
+            {
+                p.drawTextureWarning = true;
+                if (auto context = _context.lock())
+                {
+                    context->log(
+                        string::Format("tl::timeline::CPURender {0}").arg(this),
+                        "Drawing OpenGL textures is not supported by the CPU renderer",
+                        log::Type::Warning);
+                }
+            }
+        }
+
+        void Render::drawImage(
+            const std::shared_ptr<image::Image>& image,
+            const math::Box2i& box,
+            const image::Color4f& color,
+            const timeline::ImageOptions& imageOptions)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.images);
+
+            const auto floatImage = p.getFloatImage(image, imageOptions);
+            const timeline::AlphaBlend alphaBlend = imageOptions.alphaBlend;
+            const Private& cp = p;
+            p.drawRows(
+                floatImage,
+                box,
+                imageOptions.imageFilters,
+                [&cp, color, alphaBlend](float* src, float* dst, int count, int x, int y)
+                {
+                    for (int i = 0; i < count; ++i, src += 4, dst += 4)
+                    {
+                        if (!cp.isInsideWipe(x + i, y))
+                            continue;
+                        const float r = src[0] * color.r;
+                        const float g = src[1] * color.g;
+                        const float b = src[2] * color.b;
+                        const float a = src[3] * color.a;
+                        switch (alphaBlend)
+                        {
+                        case timeline::AlphaBlend::None:
+                            dst[0] = r;
+                            dst[1] = g;
+                            dst[2] = b;
+                            dst[3] = a;
+                            break;
+                        case timeline::AlphaBlend::Straight:
+                            blendStraight(dst, r, g, b, a);
+                            break;
+                        case timeline::AlphaBlend::Premultiplied:
+                            blendPremultiplied(dst, r, g, b, a);
+                            break;
+                        default: break;
+                        }
+                    }
+                });
+        }
+    }
+}
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimelineCPU/Render.h>
+
+#include <tlCore/LRUCache.h>
+
+#if defined(TLRENDER_OCIO)
+#include <OpenColorIO/OpenColorIO.h>
+#endif // TLRENDER_OCIO
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+
+#if defined(TLRENDER_OCIO)
+namespace OCIO = OCIO_NAMESPACE;
+#endif // TLRENDER_OCIO
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        //! Cache of images converted to RGBA_F32.
+        typedef memory::LRUCache<
+            std::shared_ptr<image::Image>,
+            std::shared_ptr<image::Image> > ImageCache;
+
+        //! Convert an image to RGBA_F32. The first row of the result is the
+        //! top of the image, and the video levels are converted to full
+        //! range.
+        void convertImage(
+            const std::shared_ptr<image::Image>&,
+            image::VideoLevels,
+            const std::shared_ptr<image::Image>& out,
+            int y0,
+            int y1);
+
+        //! Copy RGBA_F32 rows into an image, converting the pixel type. The
+        //! rows of the output image are stored bottom to top.
+        void readImage(
+            const std::shared_ptr<image::Image>&,
+            const std::shared_ptr<image::Image>& out,
+            int y0,
+            int y1);
+
+#if defined(TLRENDER_OCIO)
+        struct OCIOData
+        {
+            OCIO::ConstConfigRcPtr config;
+            OCIO::DisplayViewTransformRcPtr transform;
+            OCIO::LegacyViewingPipelineRcPtr lvp;
+            OCIO::ConstCPUProcessorRcPtr icsProcessor;
+            OCIO::ConstCPUProcessorRcPtr displayProcessor;
+        };
+
+        struct OCIOLUTData
+        {
+            OCIO::ConstConfigRcPtr config;
+            OCIO::FileTransformRcPtr transform;
+            OCIO::ConstCPUProcessorRcPtr processor;
+        };
+#endif // TLRENDER_OCIO
+
+        //! Function called for the rows of a draw, with the sampled source
+        //! colors, the destination pixels, the number of pixels, and the
+        //! position of the first pixel.
+        typedef std::function<void(float*, float*, int, int, int)> RowFunc;
+
+        //! Persistent threads for drawing bands of rows in parallel. The
+        //! calling thread also draws bands, so there is one less thread
+        //! than the thread count.
+        class WorkerPool
+        {
+        public:
+            WorkerPool(size_t threadCount);
+            ~WorkerPool();
+
+            //! Run a function over the bands of a range of rows and wait for
+            //! them to finish.
+            void run(int y0, int y1, int bands, const std::function<void(int, int)>&);
+
+        private:
+            bool _runBand();
+
+            std::vector<std::thread> _threads;
+            std::mutex _mutex;
+            std::condition_variable _cv;
+            std::condition_variable _doneCV;
+            const std::function<void(int, int)>* _function = nullptr;
+            int _y0 = 0;
+            int _rows = 0;
+            int _bands = 0;
+            int _next = 0;
+            int _done = 0;
+            bool _running = true;
+        };
+
+        struct Render::Private
+        {
+            size_t threadCount = 1;
+            std::unique_ptr<WorkerPool> workerPool;
+            math::Size2i renderSize;
+            timeline::OCIOOptions ocioOptions;
+            timeline::LUTOptions lutOptions;
+            timeline::HDROptions hdrOptions;
+            timeline::RenderOptions renderOptions;
+
+#if defined(TLRENDER_OCIO)
+            std::unique_ptr<OCIOData> ocioData;
+            std::unique_ptr<OCIOLUTData> lutData;
+#endif // TLRENDER_OCIO
+
+            math::Box2i viewport;
+            math::Matrix4x4f transform;
+            bool clipRectEnabled = false;
+            math::Box2i clipRect;
+
+            //! The rendered image, and the image currently being drawn
+            //! into, which is either the rendered image or an offscreen
+            //! buffer.
+            std::shared_ptr<image::Image> image;
+            std::shared_ptr<image::Image> target;
+            std::map<std::string, std::shared_ptr<image::Image> > buffers;
+            ImageCache imageCache;
+
+            //! The wipe is a half plane through two points in pixel
+            //! coordinates.
+            struct Wipe
+            {
+                bool enabled = false;
+                math::Vector2f a;
+                math::Vector2f b;
+                float side = 1.F;
+            };
+            Wipe wipe;
+
+            std::chrono::steady_clock::time_point timer;
+            struct Stats
+            {
+                int time = 0;
+                size_t rects = 0;
+                size_t meshes = 0;
+                size_t meshTriangles = 0;
+                size_t text = 0;
+                size_t images = 0;
+                size_t imageConversions = 0;
+            };
+            Stats currentStats;
+            std::list<Stats> stats;
+            std::chrono::steady_clock::time_point logTimer;
+            bool drawTextureWarning = false;
+
+            //! Run a function over a range of rows, split into bands for
+            //! each thread.
+            void parallel(int y0, int y1, const std::function<void(int, int)>&) const;
+
+            //! Convert world coordinates to pixel coordinates of the target.
+            math::Vector2f toPixels(const math::Vector2f&) const;
+            math::Box2f toPixels(const math::Box2i&) const;
+
+            //! Get the pixels of the target that can be drawn.
+            math::Box2i getClip() const;
+
+            //! Get the pixels whose centers are inside of the given box.
+            math::Box2i getPixels(const math::Box2f&) const;
+
+            //! Get an offscreen buffer cleared to zero.
+            std::shared_ptr<image::Image> getBuffer(
+                const std::string&,
+                const math::Size2i&);
+
+            //! Get an image converted to RGBA_F32.
+            std::shared_ptr<image::Image> getFloatImage(
+                const std::shared_ptr<image::Image>&,
+                const timeline::ImageOptions&);
+
+            //! Resample an RGBA_F32 image into the given box of the target.
+            void drawRows(
+                const std::shared_ptr<image::Image>&,
+                const math::Box2i&,
+                const timeline::ImageFilters&,
+                const RowFunc&);
+
+            //! Draw the triangles of a mesh.
+            void drawTriangles(
+                const geom::TriangleMesh2&,
+                const math::Vector2i& position,
+                const image::Color4f&,
+                bool vertexColors);
+
+            //! Is the pixel inside of the wipe?
+            bool isInsideWipe(int x, int y) const;
+        };
+
+        //! Blend a color into a pixel like the primitives of the OpenGL
+        //! renderer, glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA).
+        inline void blendPrims(float* dst, float r, float g, float b, float a)
+        {
+            const float ia = 1.F - a;
+            dst[0] = r * a + dst[0] * ia;
+            dst[1] = g * a + dst[1] * ia;
+            dst[2] = b * a + dst[2] * ia;
+            dst[3] = a * a + dst[3] * ia;
+        }
+
+        //! Blend a color into a pixel with straight alpha.
+        inline void blendStraight(float* dst, float r, float g, float b, float a)
+        {
+            const float ia = 1.F - a;
+            dst[0] = r * a + dst[0] * ia;
+            dst[1] = g * a + dst[1] * ia;
+            dst[2] = b * a + dst[2] * ia;
+            dst[3] = a + dst[3] * ia;
+        }
+
+        //! Blend a color into a pixel with premultiplied alpha.
+        inline void blendPremultiplied(float* dst, float r, float g, float b, float a)
+        {
+            const float ia = 1.F - a;
+            dst[0] = r + dst[0] * ia;
+            dst[1] = g + dst[1] * ia;
+            dst[2] = b + dst[2] * ia;
+            dst[3] = a + dst[3] * ia;
+        }
+    }
+}
@@ -0,0 +1,816 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <tlCore/Math.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        void Render::drawVideo(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions,
+            const timeline::BackgroundOptions& backgroundOptions)
+        {
+            if (!videoData.empty() && !videoData.front().layers.empty())
+            {
+                _drawBackground(boxes, backgroundOptions);
+            }
+            switch (compareOptions.mode)
+            {
+            case timeline::CompareMode::A:
+                _drawVideoA(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::B:
+                _drawVideoB(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::Wipe:
+                _drawVideoWipe(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::Overlay:
+                _drawVideoOverlay(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::Difference:
+                if (videoData.size() > 1)
+                {
+                    _drawVideoDifference(
+                        videoData,
+                        boxes,
+                        imageOptions,
+                        displayOptions,
+                        compareOptions);
+                }
+                else
+                {
+                    _drawVideoA(
+                        videoData,
+                        boxes,
+                        imageOptions,
+                        displayOptions,
+                        compareOptions);
+                }
+                break;
+            case timeline::CompareMode::Horizontal:
+            case timeline::CompareMode::Vertical:
+            case timeline::CompareMode::Tile:
+                _drawVideoTile(
+                    videoData,
+                    boxes,
+                    imageOptions,
+                    displayOptions,
+                    compareOptions);
+                break;
+            default: break;
+            }
+        }
+
+        void Render::_drawBackground(
+            const std::vector<math::Box2i>& boxes,
+            const timeline::BackgroundOptions& options)
+        {
+            for (const auto& box : boxes)
+            {
+                switch (options.type)
+                {
+                case timeline::Background::Solid:
+                    drawRect(box, options.color0);
+                    break;
+                case timeline::Background::Checkers:
+                    drawColorMesh(
+                        geom::checkers(box, options.color0, options.color1, options.checkersSize),
+                        math::Vector2i(),
+                        image::Color4f(1.F, 1.F, 1.F));
+                    break;
+                case timeline::Background::Gradient:
+                {
+                    geom::TriangleMesh2 mesh;
+                    mesh.v.push_back(math::Vector2f(box.min.x, box.min.y));
+                    mesh.v.push_back(math::Vector2f(box.max.x, box.min.y));
+                    mesh.v.push_back(math::Vector2f(box.max.x, box.max.y));
+                    mesh.v.push_back(math::Vector2f(box.min.x, box.max.y));
+                    mesh.c.push_back(math::Vector4f(
+                        options.color0.r,
+                        options.color0.g,
+                        options.color0.b,
+                        options.color0.a));
+                    mesh.c.push_back(math::Vector4f(
+                        options.color1.r,
+                        options.color1.g,
+                        options.color1.b,
+                        options.color1.a));
+                    mesh.triangles.push_back({
+                        geom::Vertex2(1, 0, 1),
+                        geom::Vertex2(2, 0, 1),
+                        geom::Vertex2(3, 0, 2), });
+                    mesh.triangles.push_back({
+                        geom::Vertex2(3, 0, 2),
+                        geom::Vertex2(4, 0, 2),
+                        geom::Vertex2(1, 0, 1), });
+                    drawColorMesh(
+                        mesh,
+                        math::Vector2i(),
+                        image::Color4f(1.F, 1.F, 1.F));
+                    break;
+                }
+                default: break;
+                }
+            }
+        }
+
+        void Render::_drawVideoA(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            if (!videoData.empty() && !boxes.empty())
+            {
+                _drawVideo(
+                    videoData[0],
+                    boxes[0],
+                    !imageOptions.empty() ? std::make_shared<timeline::ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : timeline::DisplayOptions());
+            }
+        }
+
+        void Render::_drawVideoB(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            if (videoData.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoData[1],
+                    boxes[1],
+                    imageOptions.size() > 1 ? std::make_shared<timeline::ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : timeline::DisplayOptions());
+            }
+        }
+
+        void Render::_drawVideoWipe(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+
+            float radius = 0.F;
+            float x = 0.F;
+            float y = 0.F;
+            if (!boxes.empty())
+            {
+                radius = std::max(boxes[0].w(), boxes[0].h()) * 2.5F;
+                x = boxes[0].w() * compareOptions.wipeCenter.x;
+                y = boxes[0].h() * compareOptions.wipeCenter.y;
+            }
+            const float rotation = compareOptions.wipeRotation;
+            math::Vector2f pts[4];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                float rad = math::deg2rad(rotation + 90.F * i + 90.F);
+                pts[i] = p.toPixels(math::Vector2f(
+                    cos(rad) * radius + x,
+                    sin(rad) * radius + y));
+            }
+
+            // Instead of the stencil buffer used by the OpenGL renderer the
+            // pixels are tested against the line between the first and
+            // third points.
+            auto side = [&pts](const math::Vector2f& value)
+            {
+                const float s =
+                    (pts[2].x - pts[0].x) * (value.y - pts[0].y) -
+                    (pts[2].y - pts[0].y) * (value.x - pts[0].x);
+                return s < 0.F ? -1.F : 1.F;
+            };
+            p.wipe.enabled = true;
+            p.wipe.a = pts[0];
+            p.wipe.b = pts[2];
+            p.wipe.side = side(pts[1]);
+            if (!videoData.empty() && !boxes.empty())
+            {
+                _drawVideo(
+                    videoData[0],
+                    boxes[0],
+                    !imageOptions.empty() ? std::make_shared<timeline::ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : timeline::DisplayOptions());
+            }
+            p.wipe.side = side(pts[3]);
+            if (videoData.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoData[1],
+                    boxes[1],
+                    imageOptions.size() > 1 ? std::make_shared<timeline::ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : timeline::DisplayOptions());
+            }
+            p.wipe = Private::Wipe();
+        }
+
+        void Render::_drawVideoOverlay(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+
+            if (videoData.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoData[1],
+                    boxes[1],
+                    imageOptions.size() > 1 ? std::make_shared<timeline::ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : timeline::DisplayOptions());
+            }
+            if (!videoData.empty() && !boxes.empty())
+            {
+                const auto buffer = _drawVideoBuffer(
+                    "overlay",
+                    videoData[0],
+                    boxes[0].getSize(),
+                    !imageOptions.empty() ? std::make_shared<timeline::ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : timeline::DisplayOptions());
+
+                const float overlay = compareOptions.overlay;
+                p.drawRows(
+                    buffer,
+                    boxes[0],
+                    !displayOptions.empty() ? displayOptions[0].imageFilters : timeline::ImageFilters(),
+                    [overlay](float* src, float* dst, int count, int, int)
+                    {
+                        for (int i = 0; i < count; ++i, src += 4, dst += 4)
+                        {
+                            const float a = src[3] * overlay;
+                            const float ia = 1.F - a;
+                            dst[0] = src[0] * a + dst[0] * ia;
+                            dst[1] = src[1] * a + dst[1] * ia;
+                            dst[2] = src[2] * a + dst[2] * ia;
+                            dst[3] = a + dst[3];
+                        }
+                    });
+            }
+        }
+
+        void Render::_drawVideoDifference(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+            if (videoData.size() > 1 && !boxes.empty())
+            {
+                const math::Size2i size = boxes[0].getSize();
+                const auto buffer0 = _drawVideoBuffer(
+                    "difference0",
+                    videoData[0],
+                    size,
+                    !imageOptions.empty() ? std::make_shared<timeline::ImageOptions>(imageOptions[0]) : nullptr,
+                    !displayOptions.empty() ? displayOptions[0] : timeline::DisplayOptions());
+                const auto buffer1 = _drawVideoBuffer(
+                    "difference1",
+                    videoData[1],
+                    size,
+                    imageOptions.size() > 1 ? std::make_shared<timeline::ImageOptions>(imageOptions[1]) : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1] : timeline::DisplayOptions());
+
+                // Both buffers are the same size, so the difference is
+                // computed before resampling.
+                const auto buffer = p.getBuffer("difference", size);
+                const float* a = reinterpret_cast<const float*>(buffer0->getData());
+                const float* b = reinterpret_cast<const float*>(buffer1->getData());
+                float* c = reinterpret_cast<float*>(buffer->getData());
+                p.parallel(
+                    0,
+                    size.h,
+                    [a, b, c, size](int y0, int y1)
+                    {
+                        for (int i = y0 * size.w * 4; i < y1 * size.w * 4; i += 4)
+                        {
+                            c[i + 0] = std::abs(a[i + 0] - b[i + 0]);
+                            c[i + 1] = std::abs(a[i + 1] - b[i + 1]);
+                            c[i + 2] = std::abs(a[i + 2] - b[i + 2]);
+                            c[i + 3] = std::max(a[i + 3], b[i + 3]);
+                        }
+                    });
+
+                p.drawRows(
+                    buffer,
+                    boxes[0],
+                    !displayOptions.empty() ? displayOptions[0].imageFilters : timeline::ImageFilters(),
+                    [](float* src, float* dst, int count, int, int)
+                    {
+                        for (int i = 0; i < count; ++i, src += 4, dst += 4)
+                        {
+                            const float ia = 1.F - src[3];
+                            dst[0] = src[0] + dst[0] * ia;
+                            dst[1] = src[1] + dst[1] * ia;
+                            dst[2] = src[2] + dst[2] * ia;
+                            dst[3] = src[3] + dst[3];
+                        }
+                    });
+            }
+        }
+
+        void Render::_drawVideoTile(
+            const std::vector<timeline::VideoData>& videoData,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            for (size_t i = 0; i < videoData.size() && i < boxes.size(); ++i)
+            {
+                _drawVideo(
+                    videoData[i],
+                    boxes[i],
+                    i < imageOptions.size() ? std::make_shared<timeline::ImageOptions>(imageOptions[i]) : nullptr,
+                    i < displayOptions.size() ? displayOptions[i] : timeline::DisplayOptions());
+            }
+        }
+
+        namespace
+        {
+            float knee(float x, float f)
+            {
+                return logf(x * f + 1.F) / f;
+            }
+
+            float knee2(float x, float y)
+            {
+                float f0 = 0.F;
+                float f1 = 1.F;
+                while (knee(x, f1) > y)
+                {
+                    f0 = f1;
+                    f1 = f1 * 2.F;
+                }
+                for (size_t i = 0; i < 30; ++i)
+                {
+                    const float f2 = (f0 + f1) / 2.F;
+                    if (knee(x, f2) < y)
+                    {
+                        f1 = f2;
+                    }
+                    else
+                    {
+                        f0 = f2;
+                    }
+                }
+                return (f0 + f1) / 2.F;
+            }
+
+            //! Display values computed once for each draw.
+            struct DisplayData
+            {
+                timeline::DisplayOptions options;
+                bool colorEnabled = false;
+                math::Matrix4x4f colorMatrix;
+                bool colorInvert = false;
+                float levelsGamma = 1.F;
+                float exrV = 0.F;
+                float exrD = 0.F;
+                float exrK = 0.F;
+                float exrF = 0.F;
+                float exrG = 1.F;
+                float exrS = 1.F;
+                float softClip = 0.F;
+            };
+
+            DisplayData getDisplayData(const timeline::DisplayOptions& options)
+            {
+                DisplayData out;
+                out.options = options;
+                out.colorEnabled =
+                    options.color != timeline::Color() &&
+                    options.color.enabled;
+                if (out.colorEnabled)
+                {
+                    out.colorMatrix = timeline::color(options.color);
+                }
+                out.colorInvert = options.color.enabled ? options.color.invert : false;
+                out.levelsGamma = options.levels.gamma > 0.F ? (1.F / options.levels.gamma) : 1000000.F;
+                if (options.exrDisplay.enabled)
+                {
+                    out.exrV = powf(2.F, options.exrDisplay.exposure + 2.47393F);
+                    out.exrD = options.exrDisplay.defog;
+                    out.exrK = powf(2.F, options.exrDisplay.kneeLow);
+                    out.exrF = knee2(
+                        powf(2.F, options.exrDisplay.kneeHigh) - out.exrK,
+                        powf(2.F, 3.5F) - out.exrK);
+                    out.exrG = out.levelsGamma;
+                    out.exrS = powf(2.F, -3.5F * out.exrG);
+                }
+                out.softClip = options.softClip.enabled ? options.softClip.value : 0.F;
+                return out;
+            }
+
+            //! Apply the display options to pixels, matching the display
+            //! shader of the OpenGL renderer. The OpenColorIO transforms are
+            //! applied separately.
+            void displayColor(float* value, const DisplayData& data)
+            {
+                const timeline::DisplayOptions& options = data.options;
+                if (data.colorEnabled)
+                {
+                    const float tmp[4] =
+                    {
+                        value[0] + options.color.add.x,
+                        value[1] + options.color.add.y,
+                        value[2] + options.color.add.z,
+                        1.F
+                    };
+                    const float* e = data.colorMatrix.e;
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        value[j] =
+                            tmp[0] * e[j * 4 + 0] +
+                            tmp[1] * e[j * 4 + 1] +
+                            tmp[2] * e[j * 4 + 2] +
+                            tmp[3] * e[j * 4 + 3];
+                    }
+                }
+                if (data.colorInvert)
+                {
+                    value[0] = 1.F - value[0];
+                    value[1] = 1.F - value[1];
+                    value[2] = 1.F - value[2];
+                }
+                if (options.exrDisplay.enabled)
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        float c = std::max(0.F, value[j] - data.exrD) * data.exrV;
+                        if (c > data.exrK)
+                        {
+                            c = data.exrK + knee(c - data.exrK, data.exrF);
+                        }
+                        if (c > 0.F)
+                        {
+                            c = powf(c, data.exrG);
+                        }
+                        value[j] = c * data.exrS;
+                    }
+                }
+                if (data.softClip > 0.F)
+                {
+                    const float tmp = 1.F - data.softClip;
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        if (value[j] > tmp)
+                        {
+                            value[j] = tmp + (1.F - expf(-(value[j] - tmp) / data.softClip)) * data.softClip;
+                        }
+                    }
+                }
+            }
+
+            void displayLevels(float* value, const DisplayData& data)
+            {
+                const timeline::DisplayOptions& options = data.options;
+                if (options.levels.enabled)
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        float c = (value[j] - options.levels.inLow) / options.levels.inHigh;
+                        if (c >= 0.F)
+                        {
+                            c = powf(c, data.levelsGamma);
+                        }
+                        value[j] = c * options.levels.outHigh + options.levels.outLow;
+                    }
+                }
+                if (options.normalize.enabled)
+                {
+                    const math::Vector4f& min = options.normalize.minimum;
+                    const math::Vector4f& max = options.normalize.maximum;
+                    value[0] = (value[0] - min.x) / (max.x - min.x);
+                    value[1] = (value[1] - min.y) / (max.y - min.y);
+                    value[2] = (value[2] - min.z) / (max.z - min.z);
+                    value[3] = (value[3] - min.w) / (max.w - min.w);
+                }
+                if (options.invalidValues)
+                {
+                    if (value[0] < 0.F || value[0] > 1.F ||
+                        value[1] < 0.F || value[1] > 1.F ||
+                        value[2] < 0.F || value[2] > 1.F ||
+                        value[3] < 0.F || value[3] > 1.F)
+                    {
+                        value[0] = 1.F;
+                        value[1] *= .5F;
+                        value[2] *= .5F;
+                    }
+                }
+                switch (options.channels)
+                {
+                case timeline::Channels::Red:
+                    value[1] = value[0];
+                    value[2] = value[0];
+                    break;
+                case timeline::Channels::Green:
+                    value[0] = value[1];
+                    value[2] = value[1];
+                    break;
+                case timeline::Channels::Blue:
+                    value[0] = value[2];
+                    value[1] = value[2];
+                    break;
+                case timeline::Channels::Alpha:
+                    value[0] = value[3];
+                    value[1] = value[3];
+                    value[2] = value[3];
+                    break;
+                case timeline::Channels::Lumma:
+                {
+                    const float l = (value[0] + value[1] + value[2]) / 3.F;
+                    value[0] = l;
+                    value[1] = l;
+                    value[2] = l;
+                    break;
+                }
+                default: break;
+                }
+            }
+
+            void mirror(const std::shared_ptr<image::Image>& image, const image::Mirror& value)
+            {
+                const int w = image->getWidth();
+                const int h = image->getHeight();
+                float* data = reinterpret_cast<float*>(image->getData());
+                if (value.x)
+                {
+                    for (int y = 0; y < h; ++y)
+                    {
+                        float* row = data + y * w * 4;
+                        for (int x = 0; x < w / 2; ++x)
+                        {
+                            std::swap_ranges(row + x * 4, row + x * 4 + 4, row + (w - 1 - x) * 4);
+                        }
+                    }
+                }
+                if (value.y)
+                {
+                    for (int y = 0; y < h / 2; ++y)
+                    {
+                        std::swap_ranges(
+                            data + y * w * 4,
+                            data + (y + 1) * w * 4,
+                            data + (h - 1 - y) * w * 4);
+                    }
+                }
+            }
+
+            bool isFloat(image::PixelType value)
+            {
+                bool out = false;
+                switch (value)
+                {
+                case image::PixelType::L_F16:
+                case image::PixelType::L_F32:
+                case image::PixelType::LA_F16:
+                case image::PixelType::LA_F32:
+                case image::PixelType::RGB_F16:
+                case image::PixelType::RGB_F32:
+                case image::PixelType::RGBA_F16:
+                case image::PixelType::RGBA_F32:
+                    out = true;
+                    break;
+                default: break;
+                }
+                return out;
+            }
+        }
+
+        void Render::_drawVideo(
+            const timeline::VideoData& videoData,
+            const math::Box2i& box,
+            const std::shared_ptr<timeline::ImageOptions>& imageOptions,
+            const timeline::DisplayOptions& displayOptions)
+        {
+            TLRENDER_P();
+
+            const math::Size2i size = box.getSize();
+            if (size.w <= 0 || size.h <= 0)
+                return;
+            const math::Box2i bufferBox(0, 0, size.w, size.h);
+            const auto video = p.getBuffer("video", size);
+            const auto targetPrev = p.target;
+            p.target = video;
+            for (const auto& layer : videoData.layers)
+            {
+                switch (layer.transition)
+                {
+                case timeline::Transition::Dissolve:
+                {
+                    if (layer.image && layer.imageB)
+                    {
+                        const auto dissolve = p.getBuffer("dissolve", size);
+                        p.target = dissolve;
+                        auto dissolveImageOptions = imageOptions.get() ? *imageOptions : layer.imageOptions;
+                        dissolveImageOptions.alphaBlend = timeline::AlphaBlend::Straight;
+                        drawImage(
+                            layer.image,
+                            image::getBox(layer.image->getAspect(), bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F, 1.F - layer.transitionValue),
+                            dissolveImageOptions);
+
+                        const auto dissolve2 = p.getBuffer("dissolve2", size);
+                        p.target = dissolve2;
+                        dissolveImageOptions = imageOptions.get() ? *imageOptions : layer.imageOptionsB;
+                        dissolveImageOptions.alphaBlend = timeline::AlphaBlend::Straight;
+                        drawImage(
+                            layer.imageB,
+                            image::getBox(layer.imageB->getAspect(), bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F, layer.transitionValue),
+                            dissolveImageOptions);
+
+                        p.target = video;
+                        float* d = reinterpret_cast<float*>(video->getData());
+                        const float* a = reinterpret_cast<const float*>(dissolve->getData());
+                        const float* b = reinterpret_cast<const float*>(dissolve2->getData());
+                        p.parallel(
+                            0,
+                            size.h,
+                            [d, a, b, size](int y0, int y1)
+                            {
+                                for (int i = y0 * size.w * 4; i < y1 * size.w * 4; i += 4)
+                                {
+                                    for (const float* s : { a + i, b + i })
+                                    {
+                                        const float ia = 1.F - s[3];
+                                        d[i + 0] = s[0] + d[i + 0] * ia;
+                                        d[i + 1] = s[1] + d[i + 1] * ia;
+                                        d[i + 2] = s[2] + d[i + 2] * ia;
+                                        d[i + 3] = s[3] + d[i + 3];
+                                    }
+                                }
+                            });
+                    }
+                    else if (layer.image)
+                    {
+                        drawImage(
+                            layer.image,
+                            image::getBox(layer.image->getAspect(), bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F, 1.F - layer.transitionValue),
+                            imageOptions.get() ? *imageOptions : layer.imageOptions);
+                    }
+                    else if (layer.imageB)
+                    {
+                        drawImage(
+                            layer.imageB,
+                            image::getBox(layer.imageB->getAspect(), bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F, layer.transitionValue),
+                            imageOptions.get() ? *imageOptions : layer.imageOptionsB);
+                    }
+                    break;
+                }
+                default:
+                    if (layer.image)
+                    {
+                        drawImage(
+                            layer.image,
+                            image::getBox(layer.image->getAspect(), bufferBox),
+                            image::Color4f(1.F, 1.F, 1.F),
+                            imageOptions.get() ? *imageOptions : layer.imageOptions);
+                    }
+                    break;
+                }
+            }
+            p.target = targetPrev;
+
+            // Match the precision of the OpenGL offscreen buffers.
+            if (!isFloat(p.renderOptions.colorBuffer))
+            {
+                float* d = reinterpret_cast<float*>(video->getData());
+                p.parallel(
+                    0,
+                    size.h,
+                    [d, size](int y0, int y1)
+                    {
+                        for (int i = y0 * size.w * 4; i < y1 * size.w * 4; ++i)
+                        {
+                            d[i] = math::clamp(d[i], 0.F, 1.F);
+                        }
+                    });
+            }
+            mirror(video, displayOptions.mirror);
+
+            const DisplayData displayData = getDisplayData(displayOptions);
+            const Private& cp = p;
+            p.drawRows(
+                video,
+                box,
+                displayOptions.imageFilters,
+                [&cp, &displayData](float* src, float* dst, int count, int x, int y)
+                {
+                    if (image::VideoLevels::LegalRange == displayData.options.videoLevels)
+                    {
+                        const float scale = (940.F - 64.F) / 1023.F;
+                        const float offset = 64.F / 1023.F;
+                        float* s = src;
+                        for (int i = 0; i < count; ++i, s += 4)
+                        {
+                            s[0] = s[0] * scale + offset;
+                            s[1] = s[1] * scale + offset;
+                            s[2] = s[2] * scale + offset;
+                        }
+                    }
+#if defined(TLRENDER_OCIO)
+                    OCIO::PackedImageDesc desc(src, count, 1, 4);
+                    if (cp.lutData &&
+                        timeline::LUTOrder::PreColorConfig == cp.lutOptions.order)
+                    {
+                        cp.lutData->processor->apply(desc);
+                    }
+                    if (cp.ocioData && cp.ocioData->icsProcessor)
+                    {
+                        cp.ocioData->icsProcessor->apply(desc);
+                    }
+                    if (cp.lutData &&
+                        timeline::LUTOrder::PostColorConfig == cp.lutOptions.order)
+                    {
+                        cp.lutData->processor->apply(desc);
+                    }
+#endif // TLRENDER_OCIO
+                    float* s = src;
+                    for (int i = 0; i < count; ++i, s += 4)
+                    {
+                        displayColor(s, displayData);
+                    }
+#if defined(TLRENDER_OCIO)
+                    if (cp.ocioData && cp.ocioData->displayProcessor)
+                    {
+                        cp.ocioData->displayProcessor->apply(desc);
+                    }
+#endif // TLRENDER_OCIO
+                    s = src;
+                    for (int i = 0; i < count; ++i, s += 4, dst += 4)
+                    {
+                        displayLevels(s, displayData);
+                        if (cp.isInsideWipe(x + i, y))
+                        {
+                            blendPremultiplied(dst, s[0], s[1], s[2], s[3]);
+                        }
+                    }
+                });
+        }
+
+        std::shared_ptr<image::Image> Render::_drawVideoBuffer(
+            const std::string& name,
+            const timeline::VideoData& videoData,
+            const math::Size2i& size,
+            const std::shared_ptr<timeline::ImageOptions>& imageOptions,
+            const timeline::DisplayOptions& displayOptions)
+        {
+            TLRENDER_P();
+            const auto out = p.getBuffer(name, size);
+            const auto targetPrev = p.target;
+            p.target = out;
+            _drawVideo(
+                videoData,
+                math::Box2i(0, 0, size.w, size.h),
+                imageOptions,
+                displayOptions);
+            p.target = targetPrev;
+            return out;
+        }
+    }
+}
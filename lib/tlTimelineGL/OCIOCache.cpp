@@ -0,0 +1,374 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineGL/OCIOCache.h>
+
+#include <tlTimelineGL/RenderPrivate.h>
+
+#include <tlCore/FileInfo.h>
+#include <tlCore/LRUCache.h>
+#include <tlCore/StringFormat.h>
+
+#include <mutex>
+
+namespace tl
+{
+    namespace timeline_gl
+    {
+        bool OCIOCacheStats::operator == (const OCIOCacheStats& other) const
+        {
+            return
+                hits == other.hits &&
+                misses == other.misses &&
+                count == other.count;
+        }
+
+        bool OCIOCacheStats::operator != (const OCIOCacheStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        namespace
+        {
+#if defined(TLRENDER_OCIO)
+            // The file name and modification time, so the items are
+            // created again when a file changes.
+            std::string getFileKey(const std::string& fileName)
+            {
+                time_t time = 0;
+                if (!fileName.empty())
+                {
+                    time = file::FileInfo(file::Path(fileName)).getTime();
+                }
+                return string::Format("{0}\n{1}").
+                    arg(fileName).
+                    arg(static_cast<int64_t>(time));
+            }
+
+            std::string getOCIOKey(
+                const std::string& fileKey,
+                const timeline::OCIOOptions& options)
+            {
+                return string::Format("{0}\n{1}\n{2}\n{3}\n{4}").
+                    arg(fileKey).
+                    arg(options.input).
+                    arg(options.display).
+                    arg(options.view).
+                    arg(options.look);
+            }
+
+            OCIO::ConstConfigRcPtr createConfig(const std::string& fileName)
+            {
+                OCIO::ConstConfigRcPtr out;
+                if (!fileName.empty())
+                {
+                    out = OCIO::Config::CreateFromFile(fileName.c_str());
+                }
+                else
+                {
+                    out = OCIO::GetCurrentConfig();
+                }
+                if (!out)
+                {
+                    throw std::runtime_error("Cannot get OCIO configuration");
+                }
+                return out;
+            }
+
+            std::shared_ptr<OCIOData> createOCIOData(
+                const OCIO::ConstConfigRcPtr& config,
+                const timeline::OCIOOptions& options)
+            {
+                auto out = std::make_shared<OCIOData>();
+                out->config = config;
+
+                out->transform = OCIO::DisplayViewTransform::Create();
+                if (!out->transform)
+                {
+                    throw std::runtime_error("Cannot create OCIO transform");
+                }
+                if (!options.input.empty())
+                {
+                    OCIO::ConstColorSpaceRcPtr srcCS =
+                        out->config->getColorSpace(
+                            options.input.c_str());
+                    OCIO::ConstColorSpaceRcPtr dstCS =
+                        out->config->getColorSpace(
+                            OCIO::ROLE_SCENE_LINEAR);
+                    out->processor = out->config->getProcessor(
+                        out->config->getCurrentContext(),
+                        srcCS, dstCS);
+                    if (!out->processor)
+                    {
+                        throw std::runtime_error("Cannot get OCIO processor");
+                    }
+
+                    out->gpuProcessor =
+                        out->processor->getOptimizedGPUProcessor(
+                            OCIO::OPTIMIZATION_DEFAULT);
+                    if (!out->gpuProcessor)
+                    {
+                        throw std::runtime_error("Cannot get OCIO GPU processor for ICS");
+                    }
+                    out->icsDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+                    if (!out->icsDesc)
+                    {
+                        throw std::runtime_error("Cannot create OCIO ICS shader description");
+                    }
+
+                    out->icsDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+                    out->icsDesc->setFunctionName("ocioICSFunc");
+                    out->icsDesc->setResourcePrefix("ocioICS"); // ocio?
+                    out->gpuProcessor->extractGpuShaderInfo(out->icsDesc);
+                }
+                if (!options.display.empty() &&
+                    !options.view.empty())
+                {
+                    out->transform->setSrc(OCIO::ROLE_SCENE_LINEAR);
+                    out->transform->setDisplay(options.display.c_str());
+                    out->transform->setView(options.view.c_str());
+
+                    out->lvp = OCIO::LegacyViewingPipeline::Create();
+                    if (!out->lvp)
+                    {
+                        throw std::runtime_error("Cannot create OCIO viewing pipeline");
+                    }
+                    out->lvp->setDisplayViewTransform(out->transform);
+                    out->lvp->setLooksOverrideEnabled(true);
+                    out->lvp->setLooksOverride(options.look.c_str());
+
+                    out->processor = out->lvp->getProcessor(
+                        out->config,
+                        out->config->getCurrentContext());
+                    if (!out->processor)
+                    {
+                        throw std::runtime_error("Cannot get OCIO processor");
+                    }
+                    out->gpuProcessor =
+                        out->processor->getOptimizedGPUProcessor(
+                            OCIO::OPTIMIZATION_DEFAULT);
+                    if (!out->gpuProcessor)
+                    {
+                        throw std::runtime_error("Cannot get OCIO GPU processor");
+                    }
+                    out->shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+                    if (!out->shaderDesc)
+                    {
+                        throw std::runtime_error("Cannot create OCIO shader description");
+                    }
+                    out->shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+                    out->shaderDesc->setFunctionName("ocioDisplayFunc");
+                    out->shaderDesc->setResourcePrefix("ocio");
+                    out->gpuProcessor->extractGpuShaderInfo(out->shaderDesc);
+                }
+                return out;
+            }
+
+            std::shared_ptr<OCIOLUTData> createLUTData(const timeline::LUTOptions& options)
+            {
+                auto out = std::make_shared<OCIOLUTData>();
+
+                out->config = OCIO::Config::CreateRaw();
+                if (!out->config)
+                {
+                    throw std::runtime_error("Cannot create OCIO configuration");
+                }
+
+                out->transform = OCIO::FileTransform::Create();
+                if (!out->transform)
+                {
+                    throw std::runtime_error("Cannot create OCIO transform");
+                }
+                out->transform->setSrc(options.fileName.c_str());
+                out->transform->validate();
+
+                out->processor = out->config->getProcessor(out->transform);
+                if (!out->processor)
+                {
+                    throw std::runtime_error("Cannot get OCIO processor");
+                }
+                out->gpuProcessor = out->processor->getDefaultGPUProcessor();
+                if (!out->gpuProcessor)
+                {
+                    throw std::runtime_error("Cannot get OCIO GPU processor");
+                }
+                out->shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+                if (!out->shaderDesc)
+                {
+                    throw std::runtime_error("Cannot create OCIO shader description");
+                }
+                out->shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+                out->shaderDesc->setFunctionName("lutFunc");
+                out->shaderDesc->setResourcePrefix("lut");
+                out->gpuProcessor->extractGpuShaderInfo(out->shaderDesc);
+                return out;
+            }
+#endif // TLRENDER_OCIO
+        }
+
+        struct OCIOCache::Private
+        {
+#if defined(TLRENDER_OCIO)
+            memory::LRUCache<std::string, OCIO::ConstConfigRcPtr> configs;
+            memory::LRUCache<std::string, std::shared_ptr<OCIOData> > ocioData;
+            memory::LRUCache<std::string, std::shared_ptr<OCIOLUTData> > lutData;
+#endif // TLRENDER_OCIO
+            size_t max = 0;
+            OCIOCacheStats stats;
+            mutable std::mutex mutex;
+        };
+
+        void OCIOCache::_init(size_t max)
+        {
+            TLRENDER_P();
+            p.max = max;
+#if defined(TLRENDER_OCIO)
+            p.configs.setMax(max);
+            p.ocioData.setMax(max);
+            p.lutData.setMax(max);
+#endif // TLRENDER_OCIO
+        }
+
+        OCIOCache::OCIOCache() :
+            _p(new Private)
+        {}
+
+        OCIOCache::~OCIOCache()
+        {}
+
+        std::shared_ptr<OCIOCache> OCIOCache::create(size_t max)
+        {
+            auto out = std::shared_ptr<OCIOCache>(new OCIOCache);
+            out->_init(max);
+            return out;
+        }
+
+        size_t OCIOCache::getMax() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.max;
+        }
+
+        void OCIOCache::setMax(size_t value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.max = value;
+#if defined(TLRENDER_OCIO)
+            p.configs.setMax(value);
+            p.ocioData.setMax(value);
+            p.lutData.setMax(value);
+#endif // TLRENDER_OCIO
+        }
+
+        std::shared_ptr<OCIOData> OCIOCache::getOCIOData(const timeline::OCIOOptions& options)
+        {
+            std::shared_ptr<OCIOData> out;
+#if defined(TLRENDER_OCIO)
+            TLRENDER_P();
+            const std::string fileKey = getFileKey(options.fileName);
+            const std::string key = getOCIOKey(fileKey, options);
+            OCIO::ConstConfigRcPtr config;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.ocioData.get(key, out))
+                {
+                    ++(p.stats.hits);
+                    return out;
+                }
+                p.configs.get(fileKey, config);
+            }
+
+            // The data is created outside of the lock, if two threads
+            // request the same data it is created twice.
+            if (!config)
+            {
+                config = createConfig(options.fileName);
+            }
+            out = createOCIOData(config, options);
+            out->key = key;
+
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.configs.add(fileKey, config);
+            p.ocioData.add(key, out);
+            ++(p.stats.misses);
+#endif // TLRENDER_OCIO
+            return out;
+        }
+
+        std::shared_ptr<OCIOData> OCIOCache::peekOCIOData(const timeline::OCIOOptions& options) const
+        {
+            std::shared_ptr<OCIOData> out;
+#if defined(TLRENDER_OCIO)
+            TLRENDER_P();
+            const std::string fileKey = getFileKey(options.fileName);
+            const std::string key = getOCIOKey(fileKey, options);
+            OCIO::ConstConfigRcPtr config;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.ocioData.peek(key, out))
+                {
+                    return out;
+                }
+                p.configs.peek(fileKey, config);
+            }
+            if (!config)
+            {
+                config = createConfig(options.fileName);
+            }
+            out = createOCIOData(config, options);
+            out->key = key;
+#endif // TLRENDER_OCIO
+            return out;
+        }
+
+        std::shared_ptr<OCIOLUTData> OCIOCache::getLUTData(const timeline::LUTOptions& options)
+        {
+            std::shared_ptr<OCIOLUTData> out;
+#if defined(TLRENDER_OCIO)
+            TLRENDER_P();
+            const std::string key = getFileKey(options.fileName);
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.lutData.get(key, out))
+                {
+                    ++(p.stats.hits);
+                    return out;
+                }
+            }
+
+            out = createLUTData(options);
+            out->key = key;
+
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.lutData.add(key, out);
+            ++(p.stats.misses);
+#endif // TLRENDER_OCIO
+            return out;
+        }
+
+        OCIOCacheStats OCIOCache::getStats() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            OCIOCacheStats out = p.stats;
+#if defined(TLRENDER_OCIO)
+            out.count = p.ocioData.getCount() + p.lutData.getCount();
+#endif // TLRENDER_OCIO
+            return out;
+        }
+
+        void OCIOCache::clear()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+#if defined(TLRENDER_OCIO)
+            p.configs.clear();
+            p.ocioData.clear();
+            p.lutData.clear();
+#endif // TLRENDER_OCIO
+        }
+    }
+}
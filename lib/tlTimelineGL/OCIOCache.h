@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/LUTOptions.h>
+#include <tlTimeline/OCIOOptions.h>
+
+#include <tlCore/Util.h>
+
+#include <memory>
+
+namespace tl
+{
+    namespace timeline_gl
+    {
+        struct OCIOData;
+        struct OCIOLUTData;
+
+        //! OpenColorIO cache statistics.
+        struct OCIOCacheStats
+        {
+            size_t hits = 0;
+            size_t misses = 0;
+
+            //! Number of items in the cache.
+            size_t count = 0;
+
+            bool operator == (const OCIOCacheStats&) const;
+            bool operator != (const OCIOCacheStats&) const;
+        };
+
+        //! OpenColorIO cache.
+        //!
+        //! The OpenColorIO processors and shader descriptions, including the
+        //! baked LUT values, are kept so they are not created again when
+        //! switching back to a recently used configuration, display, view,
+        //! look, or LUT. Items are looked up by the options and the
+        //! modification time of the configuration or LUT file, so changes
+        //! to the files are loaded.
+        //!
+        //! The cache does not use OpenGL, so it can be shared between
+        //! renderers in different threads and contexts. Each renderer keeps
+        //! the textures for the items it has recently used.
+        //!
+        //! Without OpenColorIO support the cache is always empty.
+        class OCIOCache : public std::enable_shared_from_this<OCIOCache>
+        {
+            TLRENDER_NON_COPYABLE(OCIOCache);
+
+        protected:
+            void _init(size_t max);
+
+            OCIOCache();
+
+        public:
+            ~OCIOCache();
+
+            //! Create a new OpenColorIO cache.
+            static std::shared_ptr<OCIOCache> create(size_t max = 16);
+
+            //! Get the maximum number of items.
+            size_t getMax() const;
+
+            //! Set the maximum number of items.
+            void setMax(size_t);
+
+            //! Get the OpenColorIO data for the given options, creating it
+            //! if it is not in the cache. An exception is thrown if the data
+            //! cannot be created.
+            std::shared_ptr<OCIOData> getOCIOData(const timeline::OCIOOptions&);
+
+            //! Get the OpenColorIO data for the given options without
+            //! changing the cache. Data in the cache is not marked as
+            //! recently used, and new data is not added. This is used for
+            //! data that may not be needed, like precompiling the display
+            //! shaders for the other views. An exception is thrown if the
+            //! data cannot be created.
+            std::shared_ptr<OCIOData> peekOCIOData(const timeline::OCIOOptions&) const;
+
+            //! Get the LUT data for the given options, creating it if it is
+            //! not in the cache. An exception is thrown if the data cannot
+            //! be created.
+            std::shared_ptr<OCIOLUTData> getLUTData(const timeline::LUTOptions&);
+
+            //! Get the statistics.
+            OCIOCacheStats getStats() const;
+
+            //! Remove the items from the cache.
+            void clear();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
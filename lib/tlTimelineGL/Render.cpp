@@ -42,76 +42,83 @@ namespace tl
         namespace
         {
             const int pboSizeMin = 1024;
+            const size_t ocioTexturesCacheMax = 8;
         }
 
         std::vector<std::shared_ptr<gl::Texture> > getTextures(
             const image::Info& info,
             const timeline::ImageFilters& imageFilters,
+            const std::shared_ptr<gl::TexturePool>& pool,
             size_t offset)
         {
             std::vector<std::shared_ptr<gl::Texture> > out;
             gl::TextureOptions options;
             options.filters = imageFilters;
-            options.pbo = info.size.w >= pboSizeMin || info.size.h >= pboSizeMin;
+            auto create = [pool, &options](const image::Info& info)
+            {
+                return pool ?
+                    pool->getTexture(info, options) :
+                    gl::Texture::create(info, options);
+            };
             switch (info.pixelType)
             {
             case image::PixelType::YUV_420P_U8:
             {
                 auto infoTmp = image::Info(info.size, image::PixelType::L_U8);
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
                 infoTmp = image::Info(image::Size(info.size.w / 2, info.size.h / 2), image::PixelType::L_U8);
-                out.push_back(gl::Texture::create(infoTmp, options));
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
+                out.push_back(create(infoTmp));
                 break;
             }
             case image::PixelType::YUV_422P_U8:
             {
                 auto infoTmp = image::Info(info.size, image::PixelType::L_U8);
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
                 infoTmp = image::Info(image::Size(info.size.w / 2, info.size.h), image::PixelType::L_U8);
-                out.push_back(gl::Texture::create(infoTmp, options));
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
+                out.push_back(create(infoTmp));
                 break;
             }
             case image::PixelType::YUV_444P_U8:
             {
                 auto infoTmp = image::Info(info.size, image::PixelType::L_U8);
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
                 infoTmp = image::Info(info.size, image::PixelType::L_U8);
-                out.push_back(gl::Texture::create(infoTmp, options));
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
+                out.push_back(create(infoTmp));
                 break;
             }
             case image::PixelType::YUV_420P_U16:
             {
                 auto infoTmp = image::Info(info.size, image::PixelType::L_U16);
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
                 infoTmp = image::Info(image::Size(info.size.w / 2, info.size.h / 2), image::PixelType::L_U16);
-                out.push_back(gl::Texture::create(infoTmp, options));
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
+                out.push_back(create(infoTmp));
                 break;
             }
             case image::PixelType::YUV_422P_U16:
             {
                 auto infoTmp = image::Info(info.size, image::PixelType::L_U16);
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
                 infoTmp = image::Info(image::Size(info.size.w / 2, info.size.h), image::PixelType::L_U16);
-                out.push_back(gl::Texture::create(infoTmp, options));
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
+                out.push_back(create(infoTmp));
                 break;
             }
             case image::PixelType::YUV_444P_U16:
             {
                 auto infoTmp = image::Info(info.size, image::PixelType::L_U16);
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
                 infoTmp = image::Info(info.size, image::PixelType::L_U16);
-                out.push_back(gl::Texture::create(infoTmp, options));
-                out.push_back(gl::Texture::create(infoTmp, options));
+                out.push_back(create(infoTmp));
+                out.push_back(create(infoTmp));
                 break;
             }
             default:
             {
-                auto texture = gl::Texture::create(info, options);
+                auto texture = create(info);
                 out.push_back(texture);
                 break;
             }
@@ -122,22 +129,39 @@ namespace tl
         void copyTextures(
             const std::shared_ptr<image::Image>& image,
             const std::vector<std::shared_ptr<gl::Texture> >& textures,
+            const std::shared_ptr<gl::TextureUpload>& upload,
             size_t offset)
         {
             const auto& info = image->getInfo();
+            const bool useUpload =
+                upload &&
+                (info.size.w >= pboSizeMin || info.size.h >= pboSizeMin);
+            auto copy = [upload, useUpload](
+                const std::shared_ptr<gl::Texture>& texture,
+                const uint8_t* data)
+            {
+                if (useUpload)
+                {
+                    upload->copy(data, texture->getInfo(), texture);
+                }
+                else
+                {
+                    texture->copy(data, texture->getInfo());
+                }
+            };
             switch (info.pixelType)
             {
             case image::PixelType::YUV_420P_U8:
             {
                 if (3 == textures.size())
                 {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
+                    copy(textures[0], image->getData());
                     const std::size_t w = info.size.w;
                     const std::size_t h = info.size.h;
                     const std::size_t w2 = w / 2;
                     const std::size_t h2 = h / 2;
-                    textures[1]->copy(image->getData() + (w * h), textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) + (w2 * h2), textures[2]->getInfo());
+                    copy(textures[1], image->getData() + (w * h));
+                    copy(textures[2], image->getData() + (w * h) + (w2 * h2));
                 }
                 break;
             }
@@ -145,12 +169,12 @@ namespace tl
             {
                 if (3 == textures.size())
                 {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
+                    copy(textures[0], image->getData());
                     const std::size_t w = info.size.w;
                     const std::size_t h = info.size.h;
                     const std::size_t w2 = w / 2;
-                    textures[1]->copy(image->getData() + (w * h), textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) + (w2 * h), textures[2]->getInfo());
+                    copy(textures[1], image->getData() + (w * h));
+                    copy(textures[2], image->getData() + (w * h) + (w2 * h));
                 }
                 break;
             }
@@ -158,11 +182,11 @@ namespace tl
             {
                 if (3 == textures.size())
                 {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
+                    copy(textures[0], image->getData());
                     const std::size_t w = info.size.w;
                     const std::size_t h = info.size.h;
-                    textures[1]->copy(image->getData() + (w * h), textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) + (w * h), textures[2]->getInfo());
+                    copy(textures[1], image->getData() + (w * h));
+                    copy(textures[2], image->getData() + (w * h) + (w * h));
                 }
                 break;
             }
@@ -170,13 +194,13 @@ namespace tl
             {
                 if (3 == textures.size())
                 {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
+                    copy(textures[0], image->getData());
                     const std::size_t w = info.size.w;
                     const std::size_t h = info.size.h;
                     const std::size_t w2 = w / 2;
                     const std::size_t h2 = h / 2;
-                    textures[1]->copy(image->getData() + (w * h) * 2, textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) * 2 + (w2 * h2) * 2, textures[2]->getInfo());
+                    copy(textures[1], image->getData() + (w * h) * 2);
+                    copy(textures[2], image->getData() + (w * h) * 2 + (w2 * h2) * 2);
                 }
                 break;
             }
@@ -184,12 +208,12 @@ namespace tl
             {
                 if (3 == textures.size())
                 {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
+                    copy(textures[0], image->getData());
                     const std::size_t w = info.size.w;
                     const std::size_t h = info.size.h;
                     const std::size_t w2 = w / 2;
-                    textures[1]->copy(image->getData() + (w * h) * 2, textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) * 2 + (w2 * h) * 2, textures[2]->getInfo());
+                    copy(textures[1], image->getData() + (w * h) * 2);
+                    copy(textures[2], image->getData() + (w * h) * 2 + (w2 * h) * 2);
                 }
                 break;
             }
@@ -197,18 +221,25 @@ namespace tl
             {
                 if (3 == textures.size())
                 {
-                    textures[0]->copy(image->getData(), textures[0]->getInfo());
+                    copy(textures[0], image->getData());
                     const std::size_t w = info.size.w;
                     const std::size_t h = info.size.h;
-                    textures[1]->copy(image->getData() + (w * h) * 2, textures[1]->getInfo());
-                    textures[2]->copy(image->getData() + (w * h) * 2 + (w * h) * 2, textures[2]->getInfo());
+                    copy(textures[1], image->getData() + (w * h) * 2);
+                    copy(textures[2], image->getData() + (w * h) * 2 + (w * h) * 2);
                 }
                 break;
             }
             default:
                 if (1 == textures.size())
                 {
-                    textures[0]->copy(image);
+                    if (useUpload)
+                    {
+                        upload->copy(image, textures[0]);
+                    }
+                    else
+                    {
+                        textures[0]->copy(image);
+                    }
                 }
                 break;
             }
@@ -316,15 +347,7 @@ namespace tl
 #endif
 
 #if defined(TLRENDER_OCIO)
-        OCIOData::~OCIOData()
-        {
-            for (size_t i = 0; i < textures.size(); ++i)
-            {
-                glDeleteTextures(1, &textures[i].id);
-            }
-        }
-
-        OCIOLUTData::~OCIOLUTData()
+        OCIOTextures::~OCIOTextures()
         {
             for (size_t i = 0; i < textures.size(); ++i)
             {
@@ -408,6 +431,15 @@ namespace tl
             {
                 p.textureCache = std::make_shared<TextureCache>();
             }
+            p.textureUpload = gl::TextureUpload::create(
+                gl::textureUploadCountDefault,
+                context->getLogSystem());
+            p.texturePool = gl::TexturePool::create(timeline::RenderOptions().texturePoolByteCount);
+            p.shaderCache = gl::ShaderCache::create();
+            p.ocioCache = OCIOCache::create();
+#if defined(TLRENDER_OCIO)
+            p.ocioTexturesCache.setMax(ocioTexturesCacheMax);
+#endif // TLRENDER_OCIO
 
             p.glyphTextureAtlas = gl::TextureAtlas::create(
                 1,
@@ -423,7 +455,9 @@ namespace tl
         {}
 
         Render::~Render()
-        {}
+        {
+            _p->timingRelease();
+        }
 
         std::shared_ptr<Render> Render::create(
             const std::shared_ptr<system::Context>& context,
@@ -439,6 +473,46 @@ namespace tl
             return _p->textureCache;
         }
 
+        void Render::setTextureStream(const std::shared_ptr<TextureStream>& value)
+        {
+            _p->textureStream = value;
+        }
+
+        void Render::setShaderCache(const std::shared_ptr<gl::ShaderCache>& value)
+        {
+            TLRENDER_P();
+            p.shaderCache = value ? value : gl::ShaderCache::create();
+        }
+
+        void Render::setShaderCompiler(const std::shared_ptr<ShaderCompiler>& value)
+        {
+            TLRENDER_P();
+            p.shaderCompiler = value;
+            if (value)
+            {
+                p.shaderCache = value->getCache();
+            }
+            p.precompile = Private::Precompile();
+            _precompileDisplayShaders();
+        }
+
+        const std::shared_ptr<OCIOCache>& Render::getOCIOCache() const
+        {
+            return _p->ocioCache;
+        }
+
+        void Render::setOCIOCache(const std::shared_ptr<OCIOCache>& value)
+        {
+            TLRENDER_P();
+            p.ocioCache = value ? value : OCIOCache::create();
+        }
+
+        size_t Render::getDrawCallCount() const
+        {
+            TLRENDER_P();
+            return !p.stats.empty() ? p.stats.back().drawCalls : 0;
+        }
+
         void Render::begin(
             const math::Size2i& renderSize,
             const timeline::RenderOptions& renderOptions)
@@ -446,78 +520,60 @@ namespace tl
             TLRENDER_P();
 
             p.timer = std::chrono::steady_clock::now();
+            p.timingBegin();
 
             p.renderSize = renderSize;
             p.renderOptions = renderOptions;
             p.textureCache->setMax(renderOptions.textureCacheByteCount);
+            p.texturePool->setMax(renderOptions.texturePoolByteCount);
 
             glEnable(GL_BLEND);
             glBlendEquation(GL_FUNC_ADD);
 
-            if (!p.shaders["rect"])
+            if (!p.shaders["batch"])
             {
-                p.shaders["rect"] = gl::Shader::create(
-                    vertexSource(),
-                    meshFragmentSource());
-            }
-            if (!p.shaders["mesh"])
-            {
-                p.shaders["mesh"] = gl::Shader::create(
-                    vertexSource(),
-                    meshFragmentSource());
-            }
-            if (!p.shaders["colorMesh"])
-            {
-                p.shaders["colorMesh"] = gl::Shader::create(
-                    colorMeshVertexSource(),
-                    colorMeshFragmentSource());
-            }
-            if (!p.shaders["text"])
-            {
-                p.shaders["text"] = gl::Shader::create(
-                    vertexSource(),
-                    textFragmentSource());
+                p.shaders["batch"] = p.shaderCache->getShader({
+                    batchVertexSource(),
+                    batchFragmentSource() });
             }
             if (!p.shaders["texture"])
             {
-                p.shaders["texture"] = gl::Shader::create(
+                p.shaders["texture"] = p.shaderCache->getShader({
                     vertexSource(),
-                    textureFragmentSource());
+                    textureFragmentSource() });
             }
             if (!p.shaders["image"])
             {
-                p.shaders["image"] = gl::Shader::create(
+                p.shaders["image"] = p.shaderCache->getShader({
                     vertexSource(),
-                    imageFragmentSource());
+                    imageFragmentSource() });
             }
             if (!p.shaders["wipe"])
             {
-                p.shaders["wipe"] = gl::Shader::create(
+                p.shaders["wipe"] = p.shaderCache->getShader({
                     vertexSource(),
-                    meshFragmentSource());
+                    meshFragmentSource() });
             }
             if (!p.shaders["overlay"])
             {
-                p.shaders["overlay"] = gl::Shader::create(
+                p.shaders["overlay"] = p.shaderCache->getShader({
                     vertexSource(),
-                    textureFragmentSource());
+                    textureFragmentSource() });
             }
             if (!p.shaders["difference"])
             {
-                p.shaders["difference"] = gl::Shader::create(
+                p.shaders["difference"] = p.shaderCache->getShader({
                     vertexSource(),
-                    differenceFragmentSource());
+                    differenceFragmentSource() });
             }
             if (!p.shaders["dissolve"])
             {
-                p.shaders["dissolve"] = gl::Shader::create(
+                p.shaders["dissolve"] = p.shaderCache->getShader({
                     vertexSource(),
-                    textureFragmentSource());
+                    textureFragmentSource() });
             }
             _displayShader();
 
-            p.vbos["rect"] = gl::VBO::create(2 * 3, gl::VBOType::Pos2_F32);
-            p.vaos["rect"] = gl::VAO::create(p.vbos["rect"]->getType(), p.vbos["rect"]->getID());
             p.vbos["texture"] = gl::VBO::create(2 * 3, gl::VBOType::Pos2_F32_UV_U16);
             p.vaos["texture"] = gl::VAO::create(p.vbos["texture"]->getType(), p.vbos["texture"]->getID());
             p.vbos["image"] = gl::VBO::create(2 * 3, gl::VBOType::Pos2_F32_UV_U16);
@@ -547,10 +603,9 @@ namespace tl
 
             //! \bug Should these be reset periodically?
             //p.glyphIDs.clear();
-            //p.vbos["mesh"].reset();
-            //p.vaos["mesh"].reset();
-            //p.vbos["text"].reset();
-            //p.vaos["text"].reset();
+
+            p.batchFlush();
+            p.timingEnd();
 
             const auto now = std::chrono::steady_clock::now();
             const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(now - p.timer);
@@ -582,6 +637,7 @@ namespace tl
                             average.textTriangles += i.textTriangles;
                             average.textures += i.textures;
                             average.images += i.images;
+                            average.drawCalls += i.drawCalls;
                         }
                         average.time /= p.stats.size();
                         average.rects /= p.stats.size();
@@ -591,8 +647,10 @@ namespace tl
                         average.textTriangles /= p.stats.size();
                         average.textures /= p.stats.size();
                         average.images /= p.stats.size();
+                        average.drawCalls /= p.stats.size();
                     }
 
+                    const gl::TexturePoolStats poolStats = p.texturePool->getStats();
                     context->log(
                         string::Format("tl::timeline::GLRender {0}").arg(this),
                         string::Format(
@@ -605,8 +663,13 @@ namespace tl
                             "    Average text triangles: {5}\n"
                             "    Average texture count: {6}\n"
                             "    Average image count: {7}\n"
-                            "    Glyph texture atlas: {8}%\n"
-                            "    Glyph IDs: {9}").
+                            "    Average draw calls: {8}\n"
+                            "    Glyph texture atlas: {9}%\n"
+                            "    Glyph IDs: {10}\n"
+                            "    Texture pool hits/misses: {11}/{12}\n"
+                            "    Offscreen buffer pool hits/misses: {13}/{14}\n"
+                            "    Texture pool evictions: {15}\n"
+                            "    Texture pool idle: {16} ({17}MB)").
                         arg(average.time).
                         arg(average.rects).
                         arg(average.meshes).
@@ -615,12 +678,25 @@ namespace tl
                         arg(average.textTriangles).
                         arg(average.textures).
                         arg(average.images).
+                        arg(average.drawCalls).
                         arg(p.glyphTextureAtlas->getPercentageUsed()).
-                        arg(p.glyphIDs.size()));
+                        arg(p.glyphIDs.size()).
+                        arg(poolStats.textureHits).
+                        arg(poolStats.textureMisses).
+                        arg(poolStats.bufferHits).
+                        arg(poolStats.bufferMisses).
+                        arg(poolStats.evictions).
+                        arg(poolStats.count).
+                        arg(poolStats.byteCount / memory::megabyte));
                 }
             }
         }
 
+        void Render::flush()
+        {
+            _p->batchFlush();
+        }
+
         math::Size2i Render::getRenderSize() const
         {
             return _p->renderSize;
@@ -628,7 +704,9 @@ namespace tl
 
         void Render::setRenderSize(const math::Size2i& value)
         {
-            _p->renderSize = value;
+            TLRENDER_P();
+            p.batchFlush();
+            p.renderSize = value;
         }
 
         math::Box2i Render::getViewport() const
@@ -639,7 +717,9 @@ namespace tl
         void Render::setViewport(const math::Box2i& value)
         {
             TLRENDER_P();
+            p.batchFlush();
             p.viewport = value;
+            p.pixelAlignedUpdate();
             glViewport(
                 value.x(),
                 p.renderSize.h - value.h() - value.y(),
@@ -649,6 +729,7 @@ namespace tl
 
         void Render::clearViewport(const image::Color4f& value)
         {
+            _p->batchFlush();
             glClearColor(value.r, value.g, value.b, value.a);
             glClear(GL_COLOR_BUFFER_BIT);
         }
@@ -699,7 +780,9 @@ namespace tl
         void Render::setTransform(const math::Matrix4x4f& value)
         {
             TLRENDER_P();
+            p.batchFlush();
             p.transform = value;
+            p.pixelAlignedUpdate();
             for (auto i : p.shaders)
             {
                 i.second->bind();
@@ -830,6 +913,46 @@ namespace tl
                                            (height > 1) ? GL_TEXTURE_2D : GL_TEXTURE_1D));
                 }
             }
+
+            std::shared_ptr<OCIOTextures> getOCIOTextures(
+                memory::LRUCache<std::string, std::shared_ptr<OCIOTextures> >& cache,
+                const std::string& key,
+                const std::vector<OCIO::GpuShaderDescRcPtr>& shaderDescs)
+            {
+                std::shared_ptr<OCIOTextures> out;
+                if (!cache.get(key, out))
+                {
+                    out = std::make_shared<OCIOTextures>();
+                    for (const auto& shaderDesc : shaderDescs)
+                    {
+                        if (shaderDesc)
+                        {
+                            addGPUTextures(out->textures, shaderDesc);
+                        }
+                    }
+                    cache.add(key, out);
+                }
+                return out;
+            }
+
+            void getOCIOSource(
+                const OCIOData* data,
+                std::string& ocioICSDef,
+                std::string& ocioICS,
+                std::string& ocioDef,
+                std::string& ocio)
+            {
+                if (data && data->icsDesc)
+                {
+                    ocioICSDef = data->icsDesc->getShaderText();
+                    ocioICS = "outColor = ocioICSFunc(outColor);";
+                }
+                if (data && data->shaderDesc)
+                {
+                    ocioDef = data->shaderDesc->getShaderText();
+                    ocio = "outColor = ocioDisplayFunc(outColor);";
+                }
+            }
 #endif // TLRENDER_OCIO
 
 #if defined(TLRENDER_LIBPLACEBO)
@@ -1233,6 +1356,7 @@ namespace tl
 
 #if defined(TLRENDER_OCIO)
             p.ocioData.reset();
+            p.ocioTextures.reset();
 #endif // TLRENDER_OCIO
 
             p.ocioOptions = value;
@@ -1240,133 +1364,25 @@ namespace tl
 #if defined(TLRENDER_OCIO)
             if (p.ocioOptions.enabled)
             {
-                p.ocioData.reset(new OCIOData);
-
-                if (!p.ocioOptions.fileName.empty())
-                {
-                    p.ocioData->config = OCIO::Config::CreateFromFile(p.ocioOptions.fileName.c_str());
-                }
-                else
-                {
-                    p.ocioData->config = OCIO::GetCurrentConfig();
-                }
-                if (!p.ocioData->config)
+                p.ocioData = p.ocioCache->getOCIOData(p.ocioOptions);
+                try
                 {
-                    throw std::runtime_error("Cannot get OCIO configuration");
+                    p.ocioTextures = getOCIOTextures(
+                        p.ocioTexturesCache,
+                        p.ocioData->key,
+                        { p.ocioData->icsDesc, p.ocioData->shaderDesc });
                 }
-
-                p.ocioData->transform = OCIO::DisplayViewTransform::Create();
-                if (!p.ocioData->transform)
+                catch (const std::exception&)
                 {
                     p.ocioData.reset();
-                    throw std::runtime_error("Cannot create OCIO transform");
-                }
-                if (!p.ocioOptions.input.empty())
-                {
-                    OCIO::ConstColorSpaceRcPtr srcCS =
-                        p.ocioData->config->getColorSpace(
-                            p.ocioOptions.input.c_str());
-                    OCIO::ConstColorSpaceRcPtr dstCS =
-                        p.ocioData->config->getColorSpace(
-                            OCIO::ROLE_SCENE_LINEAR);
-                    p.ocioData->processor = p.ocioData->config->getProcessor(
-                        p.ocioData->config->getCurrentContext(),
-                        srcCS, dstCS);
-                    if (!p.ocioData->processor)
-                    {
-                        p.ocioData.reset();
-                        throw std::runtime_error("Cannot get OCIO processor");
-                    }
-
-                    p.ocioData->gpuProcessor =
-                        p.ocioData->processor->getOptimizedGPUProcessor(
-                            OCIO::OPTIMIZATION_DEFAULT);
-                    if (!p.ocioData->gpuProcessor)
-                    {
-                        p.ocioData.reset();
-                        throw std::runtime_error("Cannot get OCIO GPU processor for ICS");
-                    }
-                    p.ocioData->icsDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
-                    if (!p.ocioData->icsDesc)
-                    {
-                        p.ocioData.reset();
-                        throw std::runtime_error("Cannot create OCIO ICS shader description");
-                    }
-                    
-                    p.ocioData->icsDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
-                    p.ocioData->icsDesc->setFunctionName("ocioICSFunc");
-                    p.ocioData->icsDesc->setResourcePrefix("ocioICS"); // ocio?
-                    p.ocioData->gpuProcessor->extractGpuShaderInfo(p.ocioData->icsDesc);
-                    try
-                    {
-                        addGPUTextures(p.ocioData->textures,
-                                       p.ocioData->icsDesc);
-                    }
-                    catch(const std::exception& e)
-                    {
-                        p.ocioData.reset();
-                        throw e;
-                    }
-                }
-                if (!p.ocioOptions.display.empty() &&
-                    !p.ocioOptions.view.empty())
-                {
-                    p.ocioData->transform->setSrc(OCIO::ROLE_SCENE_LINEAR);
-                    p.ocioData->transform->setDisplay(p.ocioOptions.display.c_str());
-                    p.ocioData->transform->setView(p.ocioOptions.view.c_str());
-
-                    p.ocioData->lvp = OCIO::LegacyViewingPipeline::Create();
-                    if (!p.ocioData->lvp)
-                    {
-                        p.ocioData.reset();
-                        throw std::runtime_error("Cannot create OCIO viewing pipeline");
-                    }
-                    p.ocioData->lvp->setDisplayViewTransform(p.ocioData->transform);
-                    p.ocioData->lvp->setLooksOverrideEnabled(true);
-                    p.ocioData->lvp->setLooksOverride(p.ocioOptions.look.c_str());
-                
-                    p.ocioData->processor = p.ocioData->lvp->getProcessor(
-                        p.ocioData->config,
-                        p.ocioData->config->getCurrentContext());
-                    if (!p.ocioData->processor)
-                    {
-                        p.ocioData.reset();
-                        throw std::runtime_error("Cannot get OCIO processor");
-                    }
-                    p.ocioData->gpuProcessor =
-                        p.ocioData->processor->getOptimizedGPUProcessor(
-                            OCIO::OPTIMIZATION_DEFAULT);
-                    if (!p.ocioData->gpuProcessor)
-                    {
-                        p.ocioData.reset();
-                        throw std::runtime_error("Cannot get OCIO GPU processor");
-                    }
-                    p.ocioData->shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
-                    if (!p.ocioData->shaderDesc)
-                    {
-                        p.ocioData.reset();
-                        throw std::runtime_error("Cannot create OCIO shader description");
-                    }
-                    p.ocioData->shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
-                    p.ocioData->shaderDesc->setFunctionName("ocioDisplayFunc");
-                    p.ocioData->shaderDesc->setResourcePrefix("ocio");
-                    p.ocioData->gpuProcessor->extractGpuShaderInfo(p.ocioData->shaderDesc);
-                    try
-                    {
-                        addGPUTextures(p.ocioData->textures,
-                                       p.ocioData->shaderDesc);
-                    }
-                    catch(const std::exception& e)
-                    {
-                        p.ocioData.reset();
-                        throw e;
-                    }
+                    throw;
                 }
             }
 #endif // TLRENDER_OCIO
 
             p.shaders["display"].reset();
             _displayShader();
+            _precompileDisplayShaders();
         }
 
         void Render::setLUTOptions(const timeline::LUTOptions& value)
@@ -1377,6 +1393,7 @@ namespace tl
 
 #if defined(TLRENDER_OCIO)
             p.lutData.reset();
+            p.lutTextures.reset();
 #endif // TLRENDER_OCIO
 
             p.lutOptions = value;
@@ -1384,60 +1401,25 @@ namespace tl
 #if defined(TLRENDER_OCIO)
             if (p.lutOptions.enabled && !p.lutOptions.fileName.empty())
             {
-                p.lutData.reset(new OCIOLUTData);
-
-                p.lutData->config = OCIO::Config::CreateRaw();
-                if (!p.lutData->config)
-                {
-                    throw std::runtime_error("Cannot create OCIO configuration");
-                }
-
-                p.lutData->transform = OCIO::FileTransform::Create();
-                if (!p.lutData->transform)
-                {
-                    p.lutData.reset();
-                    throw std::runtime_error("Cannot create OCIO transform");
-                }
-                p.lutData->transform->setSrc(p.lutOptions.fileName.c_str());
-                p.lutData->transform->validate();
-
-                p.lutData->processor = p.lutData->config->getProcessor(p.lutData->transform);
-                if (!p.lutData->processor)
-                {
-                    p.lutData.reset();
-                    throw std::runtime_error("Cannot get OCIO processor");
-                }
-                p.lutData->gpuProcessor = p.lutData->processor->getDefaultGPUProcessor();
-                if (!p.lutData->gpuProcessor)
-                {
-                    p.lutData.reset();
-                    throw std::runtime_error("Cannot get OCIO GPU processor");
-                }
-                p.lutData->shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
-                if (!p.lutData->shaderDesc)
-                {
-                    p.lutData.reset();
-                    throw std::runtime_error("Cannot create OCIO shader description");
-                }
-                p.lutData->shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
-                p.lutData->shaderDesc->setFunctionName("lutFunc");
-                p.lutData->shaderDesc->setResourcePrefix("lut");
-                p.lutData->gpuProcessor->extractGpuShaderInfo(p.lutData->shaderDesc);
+                p.lutData = p.ocioCache->getLUTData(p.lutOptions);
                 try
                 {
-                    addGPUTextures(p.lutData->textures,
-                                   p.lutData->shaderDesc);
+                    p.lutTextures = getOCIOTextures(
+                        p.ocioTexturesCache,
+                        p.lutData->key,
+                        { p.lutData->shaderDesc });
                 }
-                catch(const std::exception& e)
+                catch (const std::exception&)
                 {
-                    p.ocioData.reset();
-                    throw e;
+                    p.lutData.reset();
+                    throw;
                 }
             }
 #endif // TLRENDER_OCIO
 
             p.shaders["display"].reset();
             _displayShader();
+            _precompileDisplayShaders();
         }
         
         void Render::setHDROptions(const timeline::HDROptions& value)
@@ -1457,6 +1439,7 @@ namespace tl
             
             p.shaders["display"].reset();
             _displayShader();
+            _precompileDisplayShaders();
         }
 
         void Render::_displayShader()
@@ -1465,32 +1448,8 @@ namespace tl
                 
             if (!p.shaders["display"])
             {
-                std::string ocioICSDef;
-                std::string ocioICS;
-                std::string ocioDef;
-                std::string ocio;
-                std::string lutDef;
-                std::string lut;
                 std::string toneMapDef;
                 std::string toneMap;
-
-#if defined(TLRENDER_OCIO)
-                if (p.ocioData && p.ocioData->icsDesc)
-                {
-                    ocioICSDef = p.ocioData->icsDesc->getShaderText();
-                    ocioICS = "outColor = ocioICSFunc(outColor);";
-                }
-                if (p.ocioData && p.ocioData->shaderDesc)
-                {
-                    ocioDef = p.ocioData->shaderDesc->getShaderText();
-                    ocio = "outColor = ocioDisplayFunc(outColor);";
-                }
-                if (p.lutData && p.lutData->shaderDesc)
-                {
-                    lutDef = p.lutData->shaderDesc->getShaderText();
-                    lut = "outColor = lutFunc(outColor);";
-                }
-#endif // TLRENDER_OCIO
 #if defined(TLRENDER_LIBPLACEBO)
                 if (p.hdrOptions.tonemap)
                 {   
@@ -1870,13 +1829,16 @@ namespace tl
                     pl_shader_free(&shader);
                 }
 #endif
-                const std::string source = displayFragmentSource(
-                    ocioICSDef,
-                    ocioICS,
-                    ocioDef,
-                    ocio,
-                    lutDef,
-                    lut,
+                p.toneMapDef = toneMapDef;
+                p.toneMap = toneMap;
+                const std::string source = displaySource(
+#if defined(TLRENDER_OCIO)
+                    p.ocioData.get(),
+                    p.lutData.get(),
+#else // TLRENDER_OCIO
+                    nullptr,
+                    nullptr,
+#endif // TLRENDER_OCIO
                     p.lutOptions.order,
                     toneMapDef,
                     toneMap);
@@ -1884,31 +1846,31 @@ namespace tl
                 {
                     context->log("tl::gl::GLRender", "Creating display shader");
                 }
-                p.shaders["display"] = gl::Shader::create(vertexSource(), source);
+                p.shaders["display"] = p.shaderCache->getShader({ vertexSource(), source });
             }
             p.shaders["display"]->bind();
             p.shaders["display"]->setUniform("transform.mvp", p.transform);
             size_t texturesOffset = 1;
 #if defined(TLRENDER_OCIO)
-            if (p.ocioData)
+            if (p.ocioTextures)
             {
-                for (size_t i = 0; i < p.ocioData->textures.size(); ++i)
+                for (size_t i = 0; i < p.ocioTextures->textures.size(); ++i)
                 {
                     p.shaders["display"]->setUniform(
-                        p.ocioData->textures[i].sampler,
+                        p.ocioTextures->textures[i].sampler,
                         static_cast<int>(texturesOffset + i));
                 }
-                texturesOffset += p.ocioData->textures.size();
+                texturesOffset += p.ocioTextures->textures.size();
             }
-            if (p.lutData)
+            if (p.lutTextures)
             {
-                for (size_t i = 0; i < p.lutData->textures.size(); ++i)
+                for (size_t i = 0; i < p.lutTextures->textures.size(); ++i)
                 {
                     p.shaders["display"]->setUniform(
-                        p.lutData->textures[i].sampler,
+                        p.lutTextures->textures[i].sampler,
                         static_cast<int>(texturesOffset + i));
                 }
-                texturesOffset += p.lutData->textures.size();
+                texturesOffset += p.lutTextures->textures.size();
             }
 #endif // TLRENDER_OCIO
 #if defined(TLRENDER_LIBPLACEBO)
@@ -1924,5 +1886,73 @@ namespace tl
             }
 #endif
         }
+
+        void Render::_precompileDisplayShaders()
+        {
+#if defined(TLRENDER_OCIO)
+            TLRENDER_P();
+            if (p.shaderCompiler &&
+                p.ocioData &&
+                p.ocioData->config &&
+                !p.ocioOptions.display.empty())
+            {
+                // Only precompile when something other than the view
+                // changes, the other views are already compiled.
+                Private::Precompile precompile;
+                precompile.ocioOptions = p.ocioOptions;
+                precompile.ocioOptions.view.clear();
+                precompile.lutOptions = p.lutOptions;
+                precompile.hdrOptions = p.hdrOptions;
+                if (precompile.ocioOptions == p.precompile.ocioOptions &&
+                    precompile.lutOptions == p.precompile.lutOptions &&
+                    precompile.hdrOptions == p.precompile.hdrOptions)
+                    return;
+                p.precompile = precompile;
+
+                // The shader sources are created on the compiler thread.
+                DisplayShaderOptions options;
+                options.ocioCache = p.ocioCache;
+                options.ocioOptions = p.ocioOptions;
+                options.lutData = p.lutData;
+                options.lutOrder = p.lutOptions.order;
+                options.toneMapDef = p.toneMapDef;
+                options.toneMap = p.toneMap;
+                p.shaderCompiler->compileDisplay(options);
+            }
+#endif // TLRENDER_OCIO
+        }
+
+        std::string displaySource(
+            const OCIOData* ocioData,
+            const OCIOLUTData* lutData,
+            timeline::LUTOrder lutOrder,
+            const std::string& toneMapDef,
+            const std::string& toneMap)
+        {
+            std::string ocioICSDef;
+            std::string ocioICS;
+            std::string ocioDef;
+            std::string ocio;
+            std::string lutDef;
+            std::string lut;
+#if defined(TLRENDER_OCIO)
+            getOCIOSource(ocioData, ocioICSDef, ocioICS, ocioDef, ocio);
+            if (lutData && lutData->shaderDesc)
+            {
+                lutDef = lutData->shaderDesc->getShaderText();
+                lut = "outColor = lutFunc(outColor);";
+            }
+#endif // TLRENDER_OCIO
+            return displayFragmentSource(
+                ocioICSDef,
+                ocioICS,
+                ocioDef,
+                ocio,
+                lutDef,
+                lut,
+                lutOrder,
+                toneMapDef,
+                toneMap);
+        }
     }
 }
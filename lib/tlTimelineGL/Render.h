@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <tlTimelineGL/RenderTiming.h>
+
 #include <tlTimeline/IRender.h>
 
 #include <tlGL/Texture.h>
@@ -12,15 +14,30 @@
 
 namespace tl
 {
+    namespace gl
+    {
+        class ShaderCache;
+    }
+
     //! Timeline OpenGL support
     namespace timeline_gl
     {
+        class OCIOCache;
+        class ShaderCompiler;
+        class TextureStream;
+
         //! Texture cache.
         typedef memory::LRUCache<
             std::shared_ptr<image::Image>,
             std::vector<std::shared_ptr<gl::Texture> > > TextureCache;
 
         //! OpenGL renderer.
+        //!
+        //! Rectangles, meshes, and text are batched and drawn together when
+        //! the render state changes, at the end of the frame, or when the
+        //! render size, viewport, or transform is queried. Code that changes
+        //! the OpenGL framebuffer during a frame should save the render state
+        //! first (see timeline::ViewportState and friends).
         class Render : public timeline::IRender
         {
             TLRENDER_NON_COPYABLE(Render);
@@ -43,10 +60,61 @@ namespace tl
             //! Get the texture cache.
             const std::shared_ptr<TextureCache>& getTextureCache() const;
 
+            //! Set the texture stream. Images that are not in the texture
+            //! cache are taken from the stream when they have already been
+            //! uploaded.
+            void setTextureStream(const std::shared_ptr<TextureStream>&);
+
+            //! Set the shader cache. By default shaders are only cached in
+            //! memory by the renderer.
+            void setShaderCache(const std::shared_ptr<gl::ShaderCache>&);
+
+            //! Set the shader compiler. When the OpenColorIO configuration,
+            //! display, or look changes, the display shaders for the other
+            //! views are compiled in the background. This also sets the
+            //! shader cache to the compiler's cache.
+            void setShaderCompiler(const std::shared_ptr<ShaderCompiler>&);
+
+            //! Get the OpenColorIO cache.
+            const std::shared_ptr<OCIOCache>& getOCIOCache() const;
+
+            //! Set the OpenColorIO cache. The cache can be shared between
+            //! renderers so they do not each create the same OpenColorIO
+            //! and LUT data. By default each renderer has its own cache.
+            void setOCIOCache(const std::shared_ptr<OCIOCache>&);
+
+            //! Get the number of draw calls in the last frame.
+            size_t getDrawCallCount() const;
+
+            //! Get whether render timing is enabled.
+            bool isTimingEnabled() const;
+
+            //! Set whether render timing is enabled. Timing is disabled by
+            //! default since the OpenGL timer queries add a small overhead.
+            //! Disabling timing waits for the GPU results of the remaining
+            //! frames.
+            void setTimingEnabled(bool);
+
+            //! Get the timing of the most recent frames, oldest first.
+            //!
+            //! A frame is finished by the next call to begin(), so stages
+            //! after end() like reading back the pixels are included. The GPU
+            //! times are read one or two frames later to avoid waiting on the
+            //! GPU, so the most recent frames are not available yet.
+            const std::list<RenderTiming>& getTiming() const;
+
+            //! Start timing a stage that is not part of the renderer, for
+            //! example reading back the pixels. Stages may be nested.
+            void beginStage(RenderStage);
+
+            //! Finish timing the current stage.
+            void endStage();
+
             void begin(
                 const math::Size2i&,
                 const timeline::RenderOptions& = timeline::RenderOptions()) override;
             void end() override;
+            void flush() override;
 
             math::Size2i getRenderSize() const override;
             void setRenderSize(const math::Size2i&) override;
@@ -97,6 +165,7 @@ namespace tl
 
         private:
             void _displayShader();
+            void _precompileDisplayShaders();
 
             void _drawBackground(
                 const std::vector<math::Box2i>&,
@@ -6,147 +6,364 @@
 
 #include <tlGL/GL.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 namespace tl
 {
     namespace timeline_gl
     {
-        void Render::drawRect(
-            const math::Box2i& box,
-            const image::Color4f& color)
+        void Render::Private::pixelAlignedUpdate()
         {
-            TLRENDER_P();
-            ++(p.currentStats.rects);
-
-            p.shaders["rect"]->bind();
-            p.shaders["rect"]->setUniform("color", color);
+            pixelAligned = false;
+            const auto& e = transform.e;
+            if (0.F == e[3] && 0.F == e[7] && 1.F == e[15] &&
+                viewport.w() > 0 && viewport.h() > 0)
+            {
+                auto toPixel = [this](float x, float y)
+                {
+                    const math::Vector3f v = transform * math::Vector3f(x, y, 0.F);
+                    return math::Vector2f(
+                        viewport.x() + (v.x + 1.F) / 2.F * viewport.w(),
+                        viewport.y() + (1.F - v.y) / 2.F * viewport.h());
+                };
+                const math::Vector2f o = toPixel(0.F, 0.F);
+                const math::Vector2f x = toPixel(1.F, 0.F);
+                const math::Vector2f y = toPixel(0.F, 1.F);
+                const float epsilon = .001F;
+                pixelOffset.x = std::round(o.x);
+                pixelOffset.y = std::round(o.y);
+                pixelAligned =
+                    std::fabs(x.x - o.x - 1.F) < epsilon &&
+                    std::fabs(x.y - o.y) < epsilon &&
+                    std::fabs(y.x - o.x) < epsilon &&
+                    std::fabs(y.y - o.y - 1.F) < epsilon &&
+                    std::fabs(o.x - pixelOffset.x) < epsilon &&
+                    std::fabs(o.y - pixelOffset.y) < epsilon;
+            }
+        }
 
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        bool Render::Private::batchClip(
+            const math::Box2f& box,
+            bool& clipRectEnabledOut) const
+        {
+            bool out = true;
+            clipRectEnabledOut = false;
+            if (clipRectEnabled)
+            {
+                if (pixelAligned)
+                {
+                    // The primitive is drawn without a clipping rectangle if
+                    // it is completely inside.
+                    const math::Box2f clip(
+                        math::Vector2f(
+                            clipRect.min.x - pixelOffset.x,
+                            clipRect.min.y - pixelOffset.y),
+                        math::Vector2f(
+                            clipRect.max.x + 1 - pixelOffset.x,
+                            clipRect.max.y + 1 - pixelOffset.y));
+                    if (box.max.x <= clip.min.x ||
+                        box.min.x >= clip.max.x ||
+                        box.max.y <= clip.min.y ||
+                        box.min.y >= clip.max.y)
+                    {
+                        out = false;
+                    }
+                    else
+                    {
+                        clipRectEnabledOut =
+                            box.min.x < clip.min.x ||
+                            box.max.x > clip.max.x ||
+                            box.min.y < clip.min.y ||
+                            box.max.y > clip.max.y;
+                    }
+                }
+                else
+                {
+                    clipRectEnabledOut = true;
+                }
+            }
+            return out;
+        }
 
-            if (p.vbos["rect"])
+        void Render::Private::batchPrepare(
+            bool clipRectEnabled,
+            unsigned int texture,
+            size_t size)
+        {
+            if (batch.size > 0 &&
+                (clipRectEnabled != batch.clipRectEnabled ||
+                (clipRectEnabled && clipRect != batch.clipRect) ||
+                (texture && batch.texture && texture != batch.texture)))
             {
-                p.vbos["rect"]->copy(convert(geom::box(box), p.vbos["rect"]->getType()));
+                batchFlush();
             }
-            if (p.vaos["rect"])
+            batch.clipRectEnabled = clipRectEnabled;
+            batch.clipRect = clipRect;
+            if (texture)
             {
-                p.vaos["rect"]->bind();
-                p.vaos["rect"]->draw(GL_TRIANGLES, 0, p.vbos["rect"]->getSize());
+                batch.texture = texture;
             }
+            batch.data.reserve(batch.data.size() + size * gl::getByteCount(gl::VBOType::Pos2_F32_UV_F32_Color_F32));
         }
 
-        void Render::drawMesh(
-            const geom::TriangleMesh2& mesh,
-            const math::Vector2i& position,
+        void Render::Private::batchVertex(
+            const math::Vector2f& pos,
+            const math::Vector2f& uv,
             const image::Color4f& color)
         {
-            TLRENDER_P();
-            ++(p.currentStats.meshes);
-            const size_t size = mesh.triangles.size();
-            p.currentStats.meshTriangles += mesh.triangles.size();
-            if (size > 0)
+            const float v[] =
             {
-                p.shaders["mesh"]->bind();
-                const auto transform =
-                    p.transform *
-                    math::translate(math::Vector3f(
-                        position.x,
-                        position.y,
-                        0.F));
-                p.shaders["mesh"]->setUniform("transform.mvp", transform);
-                p.shaders["mesh"]->setUniform("color", color);
-
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-                if (!p.vbos["mesh"] || (p.vbos["mesh"] && p.vbos["mesh"]->getSize() < size * 3))
+                pos.x, pos.y,
+                uv.x, uv.y,
+                color.r, color.g, color.b, color.a
+            };
+            const size_t offset = batch.data.size();
+            batch.data.resize(offset + sizeof(v));
+            memcpy(batch.data.data() + offset, v, sizeof(v));
+            ++batch.size;
+        }
+
+        void Render::Private::batchQuad(
+            const math::Box2f& box,
+            const math::Box2f& uv,
+            const image::Color4f& color,
+            unsigned int texture)
+        {
+            bool clipRectEnabledTmp = false;
+            if (batchClip(box, clipRectEnabledTmp))
+            {
+                math::Box2f box2 = box;
+                math::Box2f uv2 = uv;
+                if (clipRectEnabledTmp && pixelAligned)
                 {
-                    p.vbos["mesh"] = gl::VBO::create(size * 3, gl::VBOType::Pos2_F32);
-                    p.vaos["mesh"].reset();
+                    // Clip the quad and the texture coordinates.
+                    box2.min.x = std::max(box.min.x, static_cast<float>(clipRect.min.x - pixelOffset.x));
+                    box2.min.y = std::max(box.min.y, static_cast<float>(clipRect.min.y - pixelOffset.y));
+                    box2.max.x = std::min(box.max.x, static_cast<float>(clipRect.max.x + 1 - pixelOffset.x));
+                    box2.max.y = std::min(box.max.y, static_cast<float>(clipRect.max.y + 1 - pixelOffset.y));
+                    const float w = box.max.x - box.min.x;
+                    const float h = box.max.y - box.min.y;
+                    if (w > 0.F)
+                    {
+                        const float uw = uv.max.x - uv.min.x;
+                        uv2.min.x = uv.min.x + (box2.min.x - box.min.x) / w * uw;
+                        uv2.max.x = uv.min.x + (box2.max.x - box.min.x) / w * uw;
+                    }
+                    if (h > 0.F)
+                    {
+                        const float vh = uv.max.y - uv.min.y;
+                        uv2.min.y = uv.min.y + (box2.min.y - box.min.y) / h * vh;
+                        uv2.max.y = uv.min.y + (box2.max.y - box.min.y) / h * vh;
+                    }
+                    clipRectEnabledTmp = false;
                 }
-                if (p.vbos["mesh"])
+                batchPrepare(clipRectEnabledTmp, texture, 6);
+                const math::Vector2f v[] =
                 {
-                    p.vbos["mesh"]->copy(convert(mesh, gl::VBOType::Pos2_F32));
-                }
-
-                if (!p.vaos["mesh"] && p.vbos["mesh"])
+                    box2.min,
+                    math::Vector2f(box2.max.x, box2.min.y),
+                    box2.max,
+                    math::Vector2f(box2.min.x, box2.max.y)
+                };
+                const math::Vector2f t[] =
                 {
-                    p.vaos["mesh"] = gl::VAO::create(p.vbos["mesh"]->getType(), p.vbos["mesh"]->getID());
-                }
-                if (p.vaos["mesh"] && p.vbos["mesh"])
+                    uv2.min,
+                    math::Vector2f(uv2.max.x, uv2.min.y),
+                    uv2.max,
+                    math::Vector2f(uv2.min.x, uv2.max.y)
+                };
+                for (size_t i : { 0, 1, 2, 2, 3, 0 })
                 {
-                    p.vaos["mesh"]->bind();
-                    p.vaos["mesh"]->draw(GL_TRIANGLES, 0, size * 3);
+                    batchVertex(v[i], t[i], color);
                 }
             }
         }
 
-        void Render::drawColorMesh(
+        void Render::Private::batchMesh(
             const geom::TriangleMesh2& mesh,
             const math::Vector2i& position,
-            const image::Color4f& color)
+            const image::Color4f& color,
+            bool vertexColors)
         {
-            TLRENDER_P();
-            ++(p.currentStats.meshes);
-            const size_t size = mesh.triangles.size();
-            p.currentStats.meshTriangles += mesh.triangles.size();
-            if (size > 0)
+            if (!mesh.triangles.empty() && !mesh.v.empty())
             {
-                p.shaders["colorMesh"]->bind();
-                const auto transform =
-                    p.transform *
-                    math::translate(math::Vector3f(
-                        position.x,
-                        position.y,
-                        0.F));
-                p.shaders["colorMesh"]->setUniform("transform.mvp", transform);
-                p.shaders["colorMesh"]->setUniform("color", color);
-
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-                if (!p.vbos["colorMesh"] || (p.vbos["colorMesh"] && p.vbos["colorMesh"]->getSize() < size * 3))
+                math::Box2f box(mesh.v.front(), mesh.v.front());
+                for (const auto& v : mesh.v)
                 {
-                    p.vbos["colorMesh"] = gl::VBO::create(size * 3, gl::VBOType::Pos2_F32_Color_F32);
-                    p.vaos["colorMesh"].reset();
+                    box.min.x = std::min(box.min.x, v.x);
+                    box.min.y = std::min(box.min.y, v.y);
+                    box.max.x = std::max(box.max.x, v.x);
+                    box.max.y = std::max(box.max.y, v.y);
                 }
-                if (p.vbos["colorMesh"])
+                box.min.x += position.x;
+                box.min.y += position.y;
+                box.max.x += position.x;
+                box.max.y += position.y;
+                bool clipRectEnabledTmp = false;
+                if (batchClip(box, clipRectEnabledTmp))
                 {
-                    p.vbos["colorMesh"]->copy(convert(mesh, gl::VBOType::Pos2_F32_Color_F32));
+                    batchPrepare(clipRectEnabledTmp, 0, mesh.triangles.size() * 3);
+                    const math::Vector2f uv(-1.F, -1.F);
+                    for (const auto& triangle : mesh.triangles)
+                    {
+                        for (size_t k = 0; k < 3; ++k)
+                        {
+                            const size_t v = triangle.v[k].v;
+                            const size_t c = triangle.v[k].c;
+                            image::Color4f vertexColor = color;
+                            if (vertexColors && c)
+                            {
+                                const auto& mc = mesh.c[c - 1];
+                                vertexColor = image::Color4f(
+                                    mc.x * color.r,
+                                    mc.y * color.g,
+                                    mc.z * color.b,
+                                    mc.w * color.a);
+                            }
+                            batchVertex(
+                                v ?
+                                math::Vector2f(mesh.v[v - 1].x + position.x, mesh.v[v - 1].y + position.y) :
+                                math::Vector2f(position.x, position.y),
+                                uv,
+                                vertexColor);
+                        }
+                    }
                 }
+            }
+        }
 
-                if (!p.vaos["colorMesh"] && p.vbos["colorMesh"])
+        namespace
+        {
+            void setScissor(
+                bool enabled,
+                const math::Box2i& value,
+                const math::Size2i& renderSize)
+            {
+                if (enabled)
                 {
-                    p.vaos["colorMesh"] = gl::VAO::create(p.vbos["colorMesh"]->getType(), p.vbos["colorMesh"]->getID());
+                    glEnable(GL_SCISSOR_TEST);
+                    if (value.w() > 0 && value.h() > 0)
+                    {
+                        glScissor(
+                            value.x(),
+                            renderSize.h - value.h() - value.y(),
+                            value.w(),
+                            value.h());
+                    }
                 }
-                if (p.vaos["colorMesh"] && p.vbos["colorMesh"])
+                else
                 {
-                    p.vaos["colorMesh"]->bind();
-                    p.vaos["colorMesh"]->draw(GL_TRIANGLES, 0, size * 3);
+                    glDisable(GL_SCISSOR_TEST);
                 }
             }
         }
 
-        void Render::Private::drawTextMesh(const geom::TriangleMesh2& mesh)
+        void Render::Private::batchFlush()
         {
-            const size_t size = mesh.triangles.size();
-            currentStats.textTriangles += size;
-            if (size > 0)
+            if (0 == batch.size)
+                return;
+
+            if (!batch.vbo || batch.vbo->getSize() < batch.size)
             {
-                if (!vbos["text"] || (vbos["text"] && vbos["text"]->getSize() < size * 3))
-                {
-                    vbos["text"] = gl::VBO::create(size * 3, gl::VBOType::Pos2_F32_UV_U16);
-                    vaos["text"].reset();
-                }
-                if (vbos["text"])
-                {
-                    vbos["text"]->copy(convert(mesh, vbos["text"]->getType()));
-                }
-                if (!vaos["text"] && vbos["text"])
-                {
-                    vaos["text"] = gl::VAO::create(vbos["text"]->getType(), vbos["text"]->getID());
-                }
-                if (vaos["text"] && vbos["text"])
-                {
-                    vaos["text"]->bind();
-                    vaos["text"]->draw(GL_TRIANGLES, 0, size * 3);
-                }
+                const size_t size = std::max(
+                    batch.size,
+                    batch.vbo ? batch.vbo->getSize() * 2 : static_cast<size_t>(6 * 1024));
+                batch.vbo = gl::VBO::create(size, gl::VBOType::Pos2_F32_UV_F32_Color_F32);
+                batch.vao = gl::VAO::create(batch.vbo->getType(), batch.vbo->getID());
+            }
+            else
+            {
+                // Orphan the previous contents so the copy does not wait
+                // for the previous draw to finish.
+                glBindBuffer(GL_ARRAY_BUFFER, batch.vbo->getID());
+                glBufferData(
+                    GL_ARRAY_BUFFER,
+                    batch.vbo->getSize() * gl::getByteCount(batch.vbo->getType()),
+                    NULL,
+                    GL_DYNAMIC_DRAW);
+            }
+            batch.vbo->copy(batch.data);
+
+            shaders["batch"]->bind();
+            shaders["batch"]->setUniform("textureSampler", 0);
+
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+            glActiveTexture(static_cast<GLenum>(GL_TEXTURE0));
+            glBindTexture(
+                GL_TEXTURE_2D,
+                batch.texture ? batch.texture : glyphTextureAtlas->getTextures()[0]);
+
+            const bool scissor =
+                batch.clipRectEnabled != clipRectEnabled ||
+                (batch.clipRectEnabled && batch.clipRect != clipRect);
+            if (scissor)
+            {
+                setScissor(batch.clipRectEnabled, batch.clipRect, renderSize);
+            }
+            batch.vao->bind();
+            batch.vao->draw(GL_TRIANGLES, 0, batch.size);
+            ++(currentStats.drawCalls);
+            if (scissor)
+            {
+                setScissor(clipRectEnabled, clipRect, renderSize);
+            }
+
+            batch.data.clear();
+            batch.size = 0;
+            batch.texture = 0;
+        }
+
+        void Render::drawRect(
+            const math::Box2i& box,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.rects);
+            p.batchQuad(
+                math::Box2f(
+                    math::Vector2f(box.min.x, box.min.y),
+                    math::Vector2f(box.max.x + 1, box.max.y + 1)),
+                math::Box2f(
+                    math::Vector2f(-1.F, -1.F),
+                    math::Vector2f(-1.F, -1.F)),
+                color,
+                0);
+            if (!p.renderOptions.batchPrimitives)
+            {
+                p.batchFlush();
+            }
+        }
+
+        void Render::drawMesh(
+            const geom::TriangleMesh2& mesh,
+            const math::Vector2i& position,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.meshes);
+            p.currentStats.meshTriangles += mesh.triangles.size();
+            p.batchMesh(mesh, position, color, false);
+            if (!p.renderOptions.batchPrimitives)
+            {
+                p.batchFlush();
+            }
+        }
+
+        void Render::drawColorMesh(
+            const geom::TriangleMesh2& mesh,
+            const math::Vector2i& position,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            ++(p.currentStats.meshes);
+            p.currentStats.meshTriangles += mesh.triangles.size();
+            p.batchMesh(mesh, position, color, true);
+            if (!p.renderOptions.batchPrimitives)
+            {
+                p.batchFlush();
             }
         }
 
@@ -158,21 +375,9 @@ namespace tl
             TLRENDER_P();
             ++(p.currentStats.text);
 
-            p.shaders["text"]->bind();
-            p.shaders["text"]->setUniform("color", color);
-            p.shaders["text"]->setUniform("textureSampler", 0);
-
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-            glActiveTexture(static_cast<GLenum>(GL_TEXTURE0));
-            uint8_t textureIndex = 0;
             const auto textures = p.glyphTextureAtlas->getTextures();
-            glBindTexture(GL_TEXTURE_2D, textures[textureIndex]);
-
             int x = 0;
             int32_t rsbDeltaPrev = 0;
-            geom::TriangleMesh2 mesh;
-            size_t meshIndex = 0;
             for (const auto& glyph : glyphs)
             {
                 if (glyph)
@@ -198,18 +403,12 @@ namespace tl
                         gl::TextureAtlasItem item;
                         if (!p.glyphTextureAtlas->getItem(id, item))
                         {
+                            // Adding a glyph may replace one that is used by
+                            // the batch.
+                            p.batchFlush();
                             id = p.glyphTextureAtlas->addItem(glyph->image, item);
                             p.glyphIDs[glyph->info] = id;
                         }
-                        if (item.textureIndex != textureIndex)
-                        {
-                            textureIndex = item.textureIndex;
-                            glBindTexture(GL_TEXTURE_2D, textures[textureIndex]);
-
-                            p.drawTextMesh(mesh);
-                            mesh = geom::TriangleMesh2();
-                            meshIndex = 0;
-                        }
 
                         const math::Vector2i& offset = glyph->offset;
                         const math::Box2i box(
@@ -217,41 +416,25 @@ namespace tl
                             pos.y - offset.y,
                             glyph->image->getWidth(),
                             glyph->image->getHeight());
-                        const auto& min = box.min;
-                        const auto& max = box.max;
-
-                        mesh.v.push_back(math::Vector2f(min.x, min.y));
-                        mesh.v.push_back(math::Vector2f(max.x + 1, min.y));
-                        mesh.v.push_back(math::Vector2f(max.x + 1, max.y + 1));
-                        mesh.v.push_back(math::Vector2f(min.x, max.y + 1));
-                        mesh.t.push_back(math::Vector2f(item.textureU.getMin(), item.textureV.getMin()));
-                        mesh.t.push_back(math::Vector2f(item.textureU.getMax(), item.textureV.getMin()));
-                        mesh.t.push_back(math::Vector2f(item.textureU.getMax(), item.textureV.getMax()));
-                        mesh.t.push_back(math::Vector2f(item.textureU.getMin(), item.textureV.getMax()));
-
-                        geom::Triangle2 triangle;
-                        triangle.v[0].v = meshIndex + 1;
-                        triangle.v[1].v = meshIndex + 2;
-                        triangle.v[2].v = meshIndex + 3;
-                        triangle.v[0].t = meshIndex + 1;
-                        triangle.v[1].t = meshIndex + 2;
-                        triangle.v[2].t = meshIndex + 3;
-                        mesh.triangles.push_back(triangle);
-                        triangle.v[0].v = meshIndex + 3;
-                        triangle.v[1].v = meshIndex + 4;
-                        triangle.v[2].v = meshIndex + 1;
-                        triangle.v[0].t = meshIndex + 3;
-                        triangle.v[1].t = meshIndex + 4;
-                        triangle.v[2].t = meshIndex + 1;
-                        mesh.triangles.push_back(triangle);
-
-                        meshIndex += 4;
+                        p.batchQuad(
+                            math::Box2f(
+                                math::Vector2f(box.min.x, box.min.y),
+                                math::Vector2f(box.max.x + 1, box.max.y + 1)),
+                            math::Box2f(
+                                math::Vector2f(item.textureU.getMin(), item.textureV.getMin()),
+                                math::Vector2f(item.textureU.getMax(), item.textureV.getMax())),
+                            color,
+                            textures[item.textureIndex]);
+                        p.currentStats.textTriangles += 2;
                     }
 
                     x += glyph->advance;
                 }
             }
-            p.drawTextMesh(mesh);
+            if (!p.renderOptions.batchPrimitives)
+            {
+                p.batchFlush();
+            }
         }
 
         void Render::drawTexture(
@@ -260,6 +443,7 @@ namespace tl
             const image::Color4f& color)
         {
             TLRENDER_P();
+            p.batchFlush();
             ++(p.currentStats.textures);
 
             p.shaders["texture"]->bind();
@@ -279,6 +463,7 @@ namespace tl
             {
                 p.vaos["texture"]->bind();
                 p.vaos["texture"]->draw(GL_TRIANGLES, 0, p.vbos["texture"]->getSize());
+                ++(p.currentStats.drawCalls);
             }
         }
 
@@ -289,19 +474,36 @@ namespace tl
             const timeline::ImageOptions& imageOptions)
         {
             TLRENDER_P();
+            p.batchFlush();
             ++(p.currentStats.images);
 
             const auto& info = image->getInfo();
             std::vector<std::shared_ptr<gl::Texture> > textures;
             if (!imageOptions.cache)
             {
-                textures = getTextures(info, imageOptions.imageFilters);
-                copyTextures(image, textures);
+                Private::TimingStage timingStage(p, RenderStage::Upload);
+                textures = getTextures(info, imageOptions.imageFilters, p.texturePool);
+                copyTextures(image, textures, p.textureUpload);
             }
             else if (!p.textureCache->get(image, textures))
             {
-                textures = getTextures(info, imageOptions.imageFilters);
-                copyTextures(image, textures);
+                if (p.textureStream && p.textureStream->take(image, textures))
+                {
+                    // The textures were created by the stream, make sure
+                    // they use the current filters.
+                    for (const auto& texture : textures)
+                    {
+                        texture->bind();
+                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl::getTextureFilter(imageOptions.imageFilters.minify));
+                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl::getTextureFilter(imageOptions.imageFilters.magnify));
+                    }
+                }
+                else
+                {
+                    Private::TimingStage timingStage(p, RenderStage::Upload);
+                    textures = getTextures(info, imageOptions.imageFilters, p.texturePool);
+                    copyTextures(image, textures, p.textureUpload);
+                }
                 p.textureCache->add(image, textures, image->getDataByteCount());
             }
             setActiveTextures(info, textures);
@@ -366,6 +568,7 @@ namespace tl
             {
                 p.vaos["image"]->bind();
                 p.vaos["image"]->draw(GL_TRIANGLES, 0, p.vbos["image"]->getSize());
+                ++(p.currentStats.drawCalls);
             }
         }
     }
@@ -11,12 +11,18 @@ extern "C"
 }
 #endif
 
+#include <tlTimelineGL/OCIOCache.h>
 #include <tlTimelineGL/Render.h>
+#include <tlTimelineGL/ShaderCompiler.h>
+#include <tlTimelineGL/TextureStream.h>
 
 #include <tlGL/Mesh.h>
 #include <tlGL/OffscreenBuffer.h>
 #include <tlGL/Shader.h>
+#include <tlGL/ShaderCache.h>
 #include <tlGL/TextureAtlas.h>
+#include <tlGL/TexturePool.h>
+#include <tlGL/TextureUpload.h>
 
 #if defined(TLRENDER_OCIO)
 #include <OpenColorIO/OpenColorIO.h>
@@ -37,6 +43,8 @@ namespace tl
         std::string colorMeshVertexSource();
         std::string colorMeshFragmentSource();
         std::string textFragmentSource();
+        std::string batchVertexSource();
+        std::string batchFragmentSource();
         std::string textureFragmentSource();
         std::string imageFragmentSource();
         std::string displayFragmentSource(
@@ -51,14 +59,24 @@ namespace tl
             const std::string& toneMap);
         std::string differenceFragmentSource();
 
+        //! Get the display shader source for the given OpenColorIO data.
+        std::string displaySource(
+            const OCIOData*,
+            const OCIOLUTData*,
+            timeline::LUTOrder,
+            const std::string& toneMapDef,
+            const std::string& toneMap);
+
         std::vector<std::shared_ptr<gl::Texture> > getTextures(
             const image::Info&,
             const timeline::ImageFilters&,
+            const std::shared_ptr<gl::TexturePool>& = nullptr,
             size_t offset = 0);
 
         void copyTextures(
             const std::shared_ptr<image::Image>&,
             const std::vector<std::shared_ptr<gl::Texture> >&,
+            const std::shared_ptr<gl::TextureUpload>& = nullptr,
             size_t offset = 0);
 
         void setActiveTextures(
@@ -85,8 +103,7 @@ namespace tl
 #if defined(TLRENDER_OCIO)        
         struct OCIOData
         {
-            ~OCIOData();
-            
+            std::string key;
             OCIO::ConstConfigRcPtr config;
             OCIO::DisplayViewTransformRcPtr transform;
             OCIO::LegacyViewingPipelineRcPtr lvp;
@@ -94,18 +111,24 @@ namespace tl
             OCIO::ConstGPUProcessorRcPtr gpuProcessor;
             OCIO::GpuShaderDescRcPtr icsDesc;
             OCIO::GpuShaderDescRcPtr shaderDesc;
-            std::vector<OCIOTexture> textures;
         }; 
         
         struct OCIOLUTData
         {
-            ~OCIOLUTData();
-
+            std::string key;
             OCIO::ConstConfigRcPtr config;
             OCIO::FileTransformRcPtr transform;
             OCIO::ConstProcessorRcPtr processor;
             OCIO::ConstGPUProcessorRcPtr gpuProcessor;
             OCIO::GpuShaderDescRcPtr shaderDesc;
+        };
+
+        //! The textures for OpenColorIO data are created by each renderer
+        //! since the data may be shared between contexts.
+        struct OCIOTextures
+        {
+            ~OCIOTextures();
+
             std::vector<OCIOTexture> textures;
         };
         
@@ -131,24 +154,43 @@ namespace tl
             timeline::HDROptions hdrOptions;
             timeline::RenderOptions renderOptions;
 
+            std::shared_ptr<OCIOCache> ocioCache;
 #if defined(TLRENDER_OCIO)
-            //! \todo Add a cache for OpenColorIO data.
-            std::unique_ptr<OCIOData> ocioData;
-            std::unique_ptr<OCIOLUTData> lutData;
+            std::shared_ptr<OCIOData> ocioData;
+            std::shared_ptr<OCIOLUTData> lutData;
+            std::shared_ptr<OCIOTextures> ocioTextures;
+            std::shared_ptr<OCIOTextures> lutTextures;
+            memory::LRUCache<std::string, std::shared_ptr<OCIOTextures> > ocioTexturesCache;
 #endif // TLRENDER_OCIO
 
 #if defined(TLRENDER_LIBPLACEBO)
             std::unique_ptr<LibPlaceboData> placeboData;
 #endif
+            std::string toneMapDef;
+            std::string toneMap;
+
+            //! The options the display shaders were last precompiled for.
+            struct Precompile
+            {
+                timeline::OCIOOptions ocioOptions;
+                timeline::LUTOptions lutOptions;
+                timeline::HDROptions hdrOptions;
+            };
+            Precompile precompile;
 
             math::Box2i viewport;
             math::Matrix4x4f transform;
             bool clipRectEnabled = false;
             math::Box2i clipRect;
 
+            std::shared_ptr<gl::ShaderCache> shaderCache;
+            std::shared_ptr<ShaderCompiler> shaderCompiler;
             std::map<std::string, std::shared_ptr<gl::Shader> > shaders;
             std::map<std::string, std::shared_ptr<gl::OffscreenBuffer> > buffers;
             std::shared_ptr<TextureCache> textureCache;
+            std::shared_ptr<gl::TextureUpload> textureUpload;
+            std::shared_ptr<gl::TexturePool> texturePool;
+            std::shared_ptr<TextureStream> textureStream;
             std::shared_ptr<gl::TextureAtlas> glyphTextureAtlas;
             std::map<image::GlyphInfo, gl::TextureAtlasID> glyphIDs;
             std::map<std::string, std::shared_ptr<gl::VBO> > vbos;
@@ -165,12 +207,96 @@ namespace tl
                 size_t textTriangles = 0;
                 size_t textures = 0;
                 size_t images = 0;
+                size_t drawCalls = 0;
             };
             Stats currentStats;
             std::list<Stats> stats;
             std::chrono::steady_clock::time_point logTimer;
 
-            void drawTextMesh(const geom::TriangleMesh2&);
+            //! Render timing. The frame is split into segments at the start
+            //! and end of each stage, and each segment has a CPU timer and an
+            //! OpenGL timer query. The query results are read once they are
+            //! available, or when too many frames are pending.
+            struct Timing
+            {
+                bool enabled = false;
+                uint64_t frame = 0;
+                std::chrono::steady_clock::time_point startTime;
+                bool frameOpen = false;
+                bool inFrame = false;
+                std::vector<RenderStage> stages;
+
+                bool segment = false;
+                RenderStage segmentStage = RenderStage::Count;
+                std::chrono::steady_clock::time_point segmentStart;
+                unsigned int segmentQuery = 0;
+
+                struct Frame
+                {
+                    RenderTiming timing;
+                    std::vector<std::pair<RenderStage, unsigned int> > queries;
+                };
+                Frame current;
+                std::list<Frame> pending;
+                std::vector<unsigned int> queries;
+                std::list<RenderTiming> completed;
+            };
+            Timing timing;
+
+            //! Time a stage for the lifetime of the object.
+            class TimingStage
+            {
+            public:
+                TimingStage(Private&, RenderStage);
+                ~TimingStage();
+
+            private:
+                Private& _p;
+                bool _active = false;
+            };
+
+            void timingSegment();
+            void timingBegin();
+            void timingEnd();
+            void timingBeginStage(RenderStage);
+            void timingEndStage();
+            void timingFinish(bool wait);
+            void timingRelease();
+
+            //! Rectangles, meshes, and text are accumulated into a batch
+            //! that is drawn when the render state changes. When the
+            //! transform maps directly to pixels the clipping rectangle is
+            //! applied to the primitives on the CPU, so changing it does not
+            //! require a new batch.
+            struct Batch
+            {
+                std::vector<uint8_t> data;
+                size_t size = 0;
+                unsigned int texture = 0;
+                bool clipRectEnabled = false;
+                math::Box2i clipRect;
+                std::shared_ptr<gl::VBO> vbo;
+                std::shared_ptr<gl::VAO> vao;
+            };
+            Batch batch;
+            bool pixelAligned = false;
+            math::Vector2f pixelOffset;
+
+            void pixelAlignedUpdate();
+            bool batchClip(const math::Box2f&, bool& clipRectEnabled) const;
+            void batchPrepare(bool clipRectEnabled, unsigned int texture, size_t size);
+            void batchVertex(const math::Vector2f&, const math::Vector2f&, const image::Color4f&);
+            void batchQuad(
+                const math::Box2f&,
+                const math::Box2f&,
+                const image::Color4f&,
+                unsigned int texture);
+            void batchMesh(
+                const geom::TriangleMesh2&,
+                const math::Vector2i&,
+                const image::Color4f&,
+                bool vertexColors);
+            void batchFlush();
         };
     }
 }
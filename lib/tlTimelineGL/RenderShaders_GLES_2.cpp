@@ -106,6 +106,54 @@ namespace tl
                 "}\n";
         }
 
+        std::string batchVertexSource()
+        {
+            return
+                "precision mediump float;\n"
+                "\n"
+                "attribute vec3 vPos;\n"
+                "attribute vec2 vTexture;\n"
+                "attribute vec4 vColor;\n"
+                "varying vec2 fTexture;\n"
+                "varying vec4 fColor;\n"
+                "\n"
+                "struct Transform\n"
+                "{\n"
+                "    mat4 mvp;\n"
+                "};\n"
+                "\n"
+                "uniform Transform transform;\n"
+                "\n"
+                "void main()\n"
+                "{\n"
+                "    gl_Position = transform.mvp * vec4(vPos, 1.0);\n"
+                "    fTexture = vTexture;\n"
+                "    fColor = vColor;\n"
+                "}\n";
+        }
+
+        std::string batchFragmentSource()
+        {
+            return
+                "precision mediump float;\n"
+                "\n"
+                "varying vec2 fTexture;\n"
+                "varying vec4 fColor;\n"
+                "\n"
+                "uniform sampler2D textureSampler;\n"
+                "\n"
+                "void main()\n"
+                "{\n"
+                "    // Negative texture coordinates mark untextured vertices.\n"
+                "    float t = texture2D(textureSampler, fTexture).r;\n"
+                "    gl_FragColor = fColor;\n"
+                "    if (fTexture.x >= 0.0)\n"
+                "    {\n"
+                "        gl_FragColor.a *= t;\n"
+                "    }\n"
+                "}\n";
+        }
+
         std::string textureFragmentSource()
         {
             return
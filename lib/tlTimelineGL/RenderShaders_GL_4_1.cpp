@@ -110,6 +110,55 @@ namespace tl
                 "}\n";
         }
 
+        std::string batchVertexSource()
+        {
+            return
+                "#version 410\n"
+                "\n"
+                "layout(location = 0) in vec3 vPos;\n"
+                "layout(location = 1) in vec2 vTexture;\n"
+                "layout(location = 2) in vec4 vColor;\n"
+                "out vec2 fTexture;\n"
+                "out vec4 fColor;\n"
+                "\n"
+                "struct Transform\n"
+                "{\n"
+                "    mat4 mvp;\n"
+                "};\n"
+                "\n"
+                "uniform Transform transform;\n"
+                "\n"
+                "void main()\n"
+                "{\n"
+                "    gl_Position = transform.mvp * vec4(vPos, 1.0);\n"
+                "    fTexture = vTexture;\n"
+                "    fColor = vColor;\n"
+                "}\n";
+        }
+
+        std::string batchFragmentSource()
+        {
+            return
+                "#version 410\n"
+                "\n"
+                "in vec2 fTexture;\n"
+                "in vec4 fColor;\n"
+                "out vec4 outColor;\n"
+                "\n"
+                "uniform sampler2D textureSampler;\n"
+                "\n"
+                "void main()\n"
+                "{\n"
+                "    // Negative texture coordinates mark untextured vertices.\n"
+                "    float t = texture(textureSampler, fTexture).r;\n"
+                "    outColor = fColor;\n"
+                "    if (fTexture.x >= 0.0)\n"
+                "    {\n"
+                "        outColor.a *= t;\n"
+                "    }\n"
+                "}\n";
+        }
+
         std::string textureFragmentSource()
         {
             return
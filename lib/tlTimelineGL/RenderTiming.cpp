@@ -0,0 +1,416 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineGL/RenderPrivate.h>
+
+#include <tlGL/GL.h>
+
+#include <tlCore/Error.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/String.h>
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+
+namespace tl
+{
+    namespace timeline_gl
+    {
+        TLRENDER_ENUM_IMPL(
+            RenderStage,
+            "Upload",
+            "Video",
+            "Display",
+            "Compare",
+            "Readback");
+        TLRENDER_ENUM_SERIALIZE_IMPL(RenderStage);
+
+        bool RenderStageTiming::operator == (const RenderStageTiming& other) const
+        {
+            return
+                count == other.count &&
+                cpu == other.cpu &&
+                gpu == other.gpu;
+        }
+
+        bool RenderStageTiming::operator != (const RenderStageTiming& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool RenderTiming::operator == (const RenderTiming& other) const
+        {
+            return
+                frame == other.frame &&
+                start == other.start &&
+                cpu == other.cpu &&
+                gpu == other.gpu &&
+                stages == other.stages;
+        }
+
+        bool RenderTiming::operator != (const RenderTiming& other) const
+        {
+            return !(*this == other);
+        }
+
+        void writeTrace(const std::string& fileName, const std::list<RenderTiming>& timing)
+        {
+            // Chrome trace event timestamps are in microseconds.
+            nlohmann::json events = nlohmann::json::array();
+            for (const auto& i : timing)
+            {
+                const double ts = i.start * 1000.0;
+                events.push_back(
+                    {
+                        { "name", "Frame" },
+                        { "ph", "X" },
+                        { "ts", ts },
+                        { "dur", i.cpu * 1000.0 },
+                        { "pid", 1 },
+                        { "tid", 1 },
+                        { "args", { { "frame", i.frame }, { "gpu", i.gpu } } }
+                    });
+                nlohmann::json cpu = nlohmann::json::object();
+                nlohmann::json gpu = nlohmann::json::object();
+                for (const auto& stage : i.stages)
+                {
+                    const std::string label = getLabel(stage.first);
+                    cpu[label] = stage.second.cpu;
+                    if (stage.second.gpu >= 0.0)
+                    {
+                        gpu[label] = stage.second.gpu;
+                    }
+                }
+                events.push_back(
+                    {
+                        { "name", "CPU" },
+                        { "ph", "C" },
+                        { "ts", ts },
+                        { "pid", 1 },
+                        { "args", cpu }
+                    });
+                if (!gpu.empty())
+                {
+                    events.push_back(
+                        {
+                            { "name", "GPU" },
+                            { "ph", "C" },
+                            { "ts", ts },
+                            { "pid", 1 },
+                            { "args", gpu }
+                        });
+                }
+            }
+            const nlohmann::json json =
+            {
+                { "traceEvents", events },
+                { "displayTimeUnit", "ms" }
+            };
+            const std::string contents = json.dump();
+            auto io = file::FileIO::create(fileName, file::Mode::Write);
+            io->write(contents.c_str(), contents.size());
+        }
+
+        void to_json(nlohmann::json& json, const RenderStageTiming& value)
+        {
+            json = nlohmann::json
+            {
+                { "count", value.count },
+                { "cpu", value.cpu },
+                { "gpu", value.gpu }
+            };
+        }
+
+        void to_json(nlohmann::json& json, const RenderTiming& value)
+        {
+            nlohmann::json stages = nlohmann::json::object();
+            for (const auto& i : value.stages)
+            {
+                stages[getLabel(i.first)] = i.second;
+            }
+            json = nlohmann::json
+            {
+                { "frame", value.frame },
+                { "start", value.start },
+                { "cpu", value.cpu },
+                { "gpu", value.gpu },
+                { "stages", stages }
+            };
+        }
+
+        void from_json(const nlohmann::json& json, RenderStageTiming& value)
+        {
+            json.at("count").get_to(value.count);
+            json.at("cpu").get_to(value.cpu);
+            json.at("gpu").get_to(value.gpu);
+        }
+
+        void from_json(const nlohmann::json& json, RenderTiming& value)
+        {
+            json.at("frame").get_to(value.frame);
+            json.at("start").get_to(value.start);
+            json.at("cpu").get_to(value.cpu);
+            json.at("gpu").get_to(value.gpu);
+            value.stages.clear();
+            for (const auto& i : json.at("stages").items())
+            {
+                RenderStage stage = RenderStage::First;
+                nlohmann::json(i.key()).get_to(stage);
+                i.value().get_to(value.stages[stage]);
+            }
+        }
+
+        namespace
+        {
+            const size_t timingMax = 60;
+
+            // The number of frames waiting for GPU results before the
+            // renderer waits for the oldest.
+            const size_t timingPendingMax = 2;
+        }
+
+        Render::Private::TimingStage::TimingStage(Private& p, RenderStage stage) :
+            _p(p),
+            _active(p.timing.enabled && p.timing.frameOpen)
+        {
+            if (_active)
+            {
+                _p.timingBeginStage(stage);
+            }
+        }
+
+        Render::Private::TimingStage::~TimingStage()
+        {
+            if (_active)
+            {
+                _p.timingEndStage();
+            }
+        }
+
+        void Render::Private::timingSegment()
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (timing.segment)
+            {
+                const std::chrono::duration<double, std::milli> diff =
+                    now - timing.segmentStart;
+                timing.current.timing.cpu += diff.count();
+                if (timing.segmentStage != RenderStage::Count)
+                {
+                    timing.current.timing.stages[timing.segmentStage].cpu += diff.count();
+                }
+#if defined(TLRENDER_API_GL_4_1)
+                glEndQuery(GL_TIME_ELAPSED);
+                timing.current.queries.push_back({ timing.segmentStage, timing.segmentQuery });
+                timing.segmentQuery = 0;
+#endif // TLRENDER_API_GL_4_1
+                timing.segment = false;
+            }
+            if (timing.frameOpen && (timing.inFrame || !timing.stages.empty()))
+            {
+                timing.segment = true;
+                timing.segmentStage = !timing.stages.empty() ?
+                    timing.stages.back() :
+                    RenderStage::Count;
+                timing.segmentStart = now;
+#if defined(TLRENDER_API_GL_4_1)
+                if (!timing.queries.empty())
+                {
+                    timing.segmentQuery = timing.queries.back();
+                    timing.queries.pop_back();
+                }
+                else
+                {
+                    glGenQueries(1, &timing.segmentQuery);
+                }
+                glBeginQuery(GL_TIME_ELAPSED, timing.segmentQuery);
+#endif // TLRENDER_API_GL_4_1
+            }
+        }
+
+        void Render::Private::timingBegin()
+        {
+            if (timing.enabled)
+            {
+                timingFinish(false);
+                timing.frameOpen = true;
+                timing.inFrame = true;
+                timing.current = Timing::Frame();
+                timing.current.timing.frame = timing.frame;
+                ++timing.frame;
+                const std::chrono::duration<double, std::milli> diff =
+                    std::chrono::steady_clock::now() - timing.startTime;
+                timing.current.timing.start = diff.count();
+                timingSegment();
+            }
+        }
+
+        void Render::Private::timingEnd()
+        {
+            if (timing.enabled && timing.inFrame)
+            {
+                timing.inFrame = false;
+                timingSegment();
+            }
+        }
+
+        void Render::Private::timingBeginStage(RenderStage stage)
+        {
+            ++(timing.current.timing.stages[stage].count);
+            timing.stages.push_back(stage);
+            timingSegment();
+        }
+
+        void Render::Private::timingEndStage()
+        {
+            if (!timing.stages.empty())
+            {
+                timing.stages.pop_back();
+                timingSegment();
+            }
+        }
+
+        void Render::Private::timingFinish(bool wait)
+        {
+            if (timing.frameOpen)
+            {
+                timing.inFrame = false;
+                timing.stages.clear();
+                timingSegment();
+                timing.frameOpen = false;
+                timing.pending.push_back(std::move(timing.current));
+                timing.current = Timing::Frame();
+            }
+
+            // Get the results of the oldest frames. The results are usually
+            // available a frame or two later, so the renderer only waits
+            // when there are too many frames pending.
+            while (!timing.pending.empty())
+            {
+                auto& frame = timing.pending.front();
+#if defined(TLRENDER_API_GL_4_1)
+                if (!frame.queries.empty())
+                {
+                    GLint available = 0;
+                    glGetQueryObjectiv(
+                        frame.queries.back().second,
+                        GL_QUERY_RESULT_AVAILABLE,
+                        &available);
+                    if (!available &&
+                        !wait &&
+                        timing.pending.size() <= timingPendingMax)
+                    {
+                        break;
+                    }
+                    frame.timing.gpu = 0.0;
+                    for (const auto& i : frame.queries)
+                    {
+                        GLuint64 ns = 0;
+                        glGetQueryObjectui64v(i.second, GL_QUERY_RESULT, &ns);
+                        const double ms = ns / 1000000.0;
+                        frame.timing.gpu += ms;
+                        if (i.first != RenderStage::Count)
+                        {
+                            auto& stage = frame.timing.stages[i.first];
+                            stage.gpu = std::max(stage.gpu, 0.0) + ms;
+                        }
+                        timing.queries.push_back(i.second);
+                    }
+                }
+#endif // TLRENDER_API_GL_4_1
+                timing.completed.push_back(std::move(frame.timing));
+                timing.pending.pop_front();
+            }
+            while (timing.completed.size() > timingMax)
+            {
+                timing.completed.pop_front();
+            }
+        }
+
+        void Render::Private::timingRelease()
+        {
+#if defined(TLRENDER_API_GL_4_1)
+            if (timing.segment)
+            {
+                glEndQuery(GL_TIME_ELAPSED);
+                timing.queries.push_back(timing.segmentQuery);
+                timing.segmentQuery = 0;
+            }
+            for (const auto& i : timing.current.queries)
+            {
+                timing.queries.push_back(i.second);
+            }
+            for (const auto& frame : timing.pending)
+            {
+                for (const auto& i : frame.queries)
+                {
+                    timing.queries.push_back(i.second);
+                }
+            }
+            if (!timing.queries.empty())
+            {
+                glDeleteQueries(
+                    static_cast<GLsizei>(timing.queries.size()),
+                    timing.queries.data());
+            }
+#endif // TLRENDER_API_GL_4_1
+            timing.segment = false;
+            timing.frameOpen = false;
+            timing.inFrame = false;
+            timing.stages.clear();
+            timing.current = Timing::Frame();
+            timing.pending.clear();
+            timing.queries.clear();
+        }
+
+        void Render::setTimingEnabled(bool value)
+        {
+            TLRENDER_P();
+            if (value == p.timing.enabled)
+                return;
+            if (value)
+            {
+                p.timing.enabled = true;
+                p.timing.frame = 0;
+                p.timing.startTime = std::chrono::steady_clock::now();
+                p.timing.completed.clear();
+            }
+            else
+            {
+                p.timingFinish(true);
+                p.timingRelease();
+                p.timing.enabled = false;
+            }
+        }
+
+        bool Render::isTimingEnabled() const
+        {
+            return _p->timing.enabled;
+        }
+
+        const std::list<RenderTiming>& Render::getTiming() const
+        {
+            return _p->timing.completed;
+        }
+
+        void Render::beginStage(RenderStage stage)
+        {
+            TLRENDER_P();
+            if (p.timing.enabled && p.timing.frameOpen)
+            {
+                p.timingBeginStage(stage);
+            }
+        }
+
+        void Render::endStage()
+        {
+            TLRENDER_P();
+            if (p.timing.enabled)
+            {
+                p.timingEndStage();
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Util.h>
+
+#include <nlohmann/json.hpp>
+
+#include <list>
+#include <map>
+
+namespace tl
+{
+    namespace timeline_gl
+    {
+        //! Render stages.
+        enum class RenderStage
+        {
+            Upload,   //!< Copying image data to textures
+            Video,    //!< Drawing the video layers and transitions
+            Display,  //!< Color management and display options
+            Compare,  //!< Compositing the compare modes
+            Readback, //!< Reading pixels back from the GPU
+
+            Count,
+            First = Upload
+        };
+        TLRENDER_ENUM(RenderStage);
+        TLRENDER_ENUM_SERIALIZE(RenderStage);
+
+        //! Render stage timing. The times are in milliseconds.
+        struct RenderStageTiming
+        {
+            //! Number of times the stage was started.
+            size_t count = 0;
+
+            double cpu = 0.0;
+
+            //! The GPU time is -1 when timer queries are not supported.
+            double gpu = -1.0;
+
+            bool operator == (const RenderStageTiming&) const;
+            bool operator != (const RenderStageTiming&) const;
+        };
+
+        //! Render timing for a frame. The times are in milliseconds.
+        //!
+        //! Time spent in a nested stage is only counted for the innermost
+        //! stage, so the stage times can be added together. Time that is not
+        //! spent in a stage is only counted in the frame total.
+        struct RenderTiming
+        {
+            //! Frame number, starting from zero when timing is enabled.
+            uint64_t frame = 0;
+
+            //! Start of the frame relative to when timing was enabled.
+            double start = 0.0;
+
+            double cpu = 0.0;
+
+            //! The GPU time is -1 when timer queries are not supported.
+            double gpu = -1.0;
+
+            std::map<RenderStage, RenderStageTiming> stages;
+
+            bool operator == (const RenderTiming&) const;
+            bool operator != (const RenderTiming&) const;
+        };
+
+        //! Write render timing to a JSON file in the Chrome trace event
+        //! format, which can be viewed with "chrome://tracing" or Perfetto.
+        //! Each frame is written as an event, and the stage times as
+        //! counters.
+        void writeTrace(const std::string& fileName, const std::list<RenderTiming>&);
+
+        void to_json(nlohmann::json&, const RenderStageTiming&);
+        void to_json(nlohmann::json&, const RenderTiming&);
+
+        void from_json(const nlohmann::json&, RenderStageTiming&);
+        void from_json(const nlohmann::json&, RenderTiming&);
+    }
+}
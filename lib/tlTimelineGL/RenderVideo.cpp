@@ -24,10 +24,12 @@ namespace tl
         {
             //! \todo Render the background only if there is valid video data and a
             //! valid layer?
+            TLRENDER_P();
             if (!videoData.empty() && !videoData.front().layers.empty())
             {
                 _drawBackground(boxes, backgroundOptions);
             }
+            p.batchFlush();
             switch (compareOptions.mode)
             {
             case timeline::CompareMode::A:
@@ -193,6 +195,7 @@ namespace tl
             const timeline::CompareOptions& compareOptions)
         {
             TLRENDER_P();
+            const Private::TimingStage timingStage(p, RenderStage::Compare);
 
             float radius = 0.F;
             float x = 0.F;
@@ -243,6 +246,7 @@ namespace tl
                 {
                     p.vaos["wipe"]->bind();
                     p.vaos["wipe"]->draw(GL_TRIANGLES, 0, p.vbos["wipe"]->getSize());
+                    ++(p.currentStats.drawCalls);
                 }
             }
             glStencilFunc(GL_EQUAL, 1, 0xFF);
@@ -284,6 +288,7 @@ namespace tl
                 {
                     p.vaos["wipe"]->bind();
                     p.vaos["wipe"]->draw(GL_TRIANGLES, 0, p.vbos["wipe"]->getSize());
+                    ++(p.currentStats.drawCalls);
                 }
             }
             glStencilFunc(GL_EQUAL, 1, 0xFF);
@@ -306,6 +311,7 @@ namespace tl
             const timeline::CompareOptions& compareOptions)
         {
             TLRENDER_P();
+            const Private::TimingStage timingStage(p, RenderStage::Compare);
 
             if (videoData.size() > 1 && boxes.size() > 1)
             {
@@ -331,7 +337,7 @@ namespace tl
                     offscreenBufferSize,
                     offscreenBufferOptions))
                 {
-                    p.buffers["overlay"] = gl::OffscreenBuffer::create(
+                    p.buffers["overlay"] = p.texturePool->getOffscreenBuffer(
                         offscreenBufferSize,
                         offscreenBufferOptions);
                 }
@@ -397,6 +403,7 @@ namespace tl
                     {
                         p.vaos["video"]->bind();
                         p.vaos["video"]->draw(GL_TRIANGLES, 0, p.vbos["video"]->getSize());
+                        ++(p.currentStats.drawCalls);
                     }
                 }
             }
@@ -410,6 +417,7 @@ namespace tl
             const timeline::CompareOptions& compareOptions)
         {
             TLRENDER_P();
+            const Private::TimingStage timingStage(p, RenderStage::Compare);
             if (!videoData.empty() && !boxes.empty())
             {
                 const math::Size2i offscreenBufferSize(
@@ -426,7 +434,7 @@ namespace tl
                     offscreenBufferSize,
                     offscreenBufferOptions))
                 {
-                    p.buffers["difference0"] = gl::OffscreenBuffer::create(
+                    p.buffers["difference0"] = p.texturePool->getOffscreenBuffer(
                         offscreenBufferSize,
                         offscreenBufferOptions);
                 }
@@ -478,7 +486,7 @@ namespace tl
                         offscreenBufferSize,
                         offscreenBufferOptions))
                     {
-                        p.buffers["difference1"] = gl::OffscreenBuffer::create(
+                        p.buffers["difference1"] = p.texturePool->getOffscreenBuffer(
                             offscreenBufferSize,
                             offscreenBufferOptions);
                     }
@@ -549,6 +557,7 @@ namespace tl
                     {
                         p.vaos["video"]->bind();
                         p.vaos["video"]->draw(GL_TRIANGLES, 0, p.vbos["video"]->getSize());
+                        ++(p.currentStats.drawCalls);
                     }
                 }
             }
@@ -633,13 +642,14 @@ namespace tl
                 offscreenBufferSize,
                 offscreenBufferOptions))
             {
-                p.buffers["video"] = gl::OffscreenBuffer::create(
+                p.buffers["video"] = p.texturePool->getOffscreenBuffer(
                     offscreenBufferSize,
                     offscreenBufferOptions);
             }
 
             if (p.buffers["video"])
             {
+                Private::TimingStage timingStage(p, RenderStage::Video);
                 const gl::SetAndRestore scissorTest(GL_SCISSOR_TEST, GL_FALSE);
 
                 gl::OffscreenBufferBinding binding(p.buffers["video"]);
@@ -660,7 +670,7 @@ namespace tl
                                     offscreenBufferSize,
                                     offscreenBufferOptions))
                                 {
-                                    p.buffers["dissolve"] = gl::OffscreenBuffer::create(
+                                    p.buffers["dissolve"] = p.texturePool->getOffscreenBuffer(
                                         offscreenBufferSize,
                                         offscreenBufferOptions);
                                 }
@@ -669,7 +679,7 @@ namespace tl
                                     offscreenBufferSize,
                                     offscreenBufferOptions))
                                 {
-                                    p.buffers["dissolve2"] = gl::OffscreenBuffer::create(
+                                    p.buffers["dissolve2"] = p.texturePool->getOffscreenBuffer(
                                         offscreenBufferSize,
                                         offscreenBufferOptions);
                                 }
@@ -728,6 +738,7 @@ namespace tl
                                     {
                                         p.vaos["video"]->bind();
                                         p.vaos["video"]->draw(GL_TRIANGLES, 0, p.vbos["video"]->getSize());
+                                        ++(p.currentStats.drawCalls);
                                     }
 
                                     glBindTexture(GL_TEXTURE_2D, p.buffers["dissolve2"]->getColorID());
@@ -741,6 +752,7 @@ namespace tl
                                     {
                                         p.vaos["video"]->bind();
                                         p.vaos["video"]->draw(GL_TRIANGLES, 0, p.vbos["video"]->getSize());
+                                        ++(p.currentStats.drawCalls);
                                     }
                                 }
                             }
@@ -784,6 +796,7 @@ namespace tl
 
             if (p.buffers["video"])
             {
+                Private::TimingStage timingStage(p, RenderStage::Display);
                 glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
                 glViewport(
@@ -855,27 +868,27 @@ namespace tl
                 glBindTexture(GL_TEXTURE_2D, p.buffers["video"]->getColorID());
                 size_t texturesOffset = 1;
 #if defined(TLRENDER_OCIO)
-                if (p.ocioData)
+                if (p.ocioTextures)
                 {
-                    for (size_t i = 0; i < p.ocioData->textures.size(); ++i)
+                    for (size_t i = 0; i < p.ocioTextures->textures.size(); ++i)
                     {
                         glActiveTexture(GL_TEXTURE0 + texturesOffset + i);
                         glBindTexture(
-                            p.ocioData->textures[i].type,
-                            p.ocioData->textures[i].id);
+                            p.ocioTextures->textures[i].type,
+                            p.ocioTextures->textures[i].id);
                     }
-                    texturesOffset += p.ocioData->textures.size();
+                    texturesOffset += p.ocioTextures->textures.size();
                 }
-                if (p.lutData)
+                if (p.lutTextures)
                 {
-                    for (size_t i = 0; i < p.lutData->textures.size(); ++i)
+                    for (size_t i = 0; i < p.lutTextures->textures.size(); ++i)
                     {
                         glActiveTexture(GL_TEXTURE0 + texturesOffset + i);
                         glBindTexture(
-                            p.lutData->textures[i].type,
-                            p.lutData->textures[i].id);
+                            p.lutTextures->textures[i].type,
+                            p.lutTextures->textures[i].id);
                     }
-                    texturesOffset += p.lutData->textures.size();
+                    texturesOffset += p.lutTextures->textures.size();
                 }
 #endif // TLRENDER_OCIO
 #if defined(TLRENDER_LIBPLACEBO)
@@ -888,7 +901,7 @@ namespace tl
                             p.placeboData->textures[i].type,
                             p.placeboData->textures[i].id);
                     }
-                    texturesOffset += p.ocioData->textures.size();
+                    texturesOffset += p.placeboData->textures.size();
                 }
 #endif // TLRENDER_LIBPLACEBO
 
@@ -902,6 +915,7 @@ namespace tl
                 {
                     p.vaos["video"]->bind();
                     p.vaos["video"]->draw(GL_TRIANGLES, 0, p.vbos["video"]->getSize());
+                    ++(p.currentStats.drawCalls);
                 }
             }
 
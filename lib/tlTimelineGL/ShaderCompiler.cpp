@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineGL/ShaderCompiler.h>
+
+#include <tlTimelineGL/RenderPrivate.h>
+
+#include <tlGL/GLFWWindow.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace tl
+{
+    namespace timeline_gl
+    {
+        struct ShaderCompiler::Private
+        {
+            std::shared_ptr<gl::GLFWWindow> window;
+            std::shared_ptr<gl::ShaderCache> cache;
+
+            struct Mutex
+            {
+                std::list<gl::ShaderSource> sources;
+                bool display = false;
+                DisplayShaderOptions displayOptions;
+                bool compiling = false;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+
+            struct Thread
+            {
+                std::condition_variable cv;
+                std::thread thread;
+                std::atomic<bool> running;
+            };
+            Thread thread;
+        };
+
+        void ShaderCompiler::_init(
+            const std::shared_ptr<gl::GLFWWindow>& window,
+            const std::shared_ptr<gl::ShaderCache>& cache)
+        {
+            TLRENDER_P();
+
+            p.window = window;
+            p.cache = cache;
+
+            p.thread.running = true;
+            p.thread.thread = std::thread(
+                [this]
+                {
+                    TLRENDER_P();
+                    p.window->makeCurrent();
+                    while (p.thread.running)
+                    {
+                        _run();
+                    }
+                    p.window->doneCurrent();
+                });
+        }
+
+        ShaderCompiler::ShaderCompiler() :
+            _p(new Private)
+        {}
+
+        ShaderCompiler::~ShaderCompiler()
+        {
+            TLRENDER_P();
+            {
+                // Set the flag with the mutex locked so the thread cannot
+                // miss the notification between checking the predicate and
+                // waiting.
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.thread.running = false;
+            }
+            p.thread.cv.notify_one();
+            if (p.thread.thread.joinable())
+            {
+                p.thread.thread.join();
+            }
+        }
+
+        std::shared_ptr<ShaderCompiler> ShaderCompiler::create(
+            const std::shared_ptr<gl::GLFWWindow>& window,
+            const std::shared_ptr<gl::ShaderCache>& cache)
+        {
+            auto out = std::shared_ptr<ShaderCompiler>(new ShaderCompiler);
+            out->_init(window, cache);
+            return out;
+        }
+
+        const std::shared_ptr<gl::ShaderCache>& ShaderCompiler::getCache() const
+        {
+            return _p->cache;
+        }
+
+        void ShaderCompiler::compile(const std::vector<gl::ShaderSource>& sources)
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.sources = std::list<gl::ShaderSource>(sources.begin(), sources.end());
+                p.mutex.display = false;
+                p.mutex.displayOptions = DisplayShaderOptions();
+            }
+            p.thread.cv.notify_one();
+        }
+
+        void ShaderCompiler::compileDisplay(const DisplayShaderOptions& options)
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.sources.clear();
+                p.mutex.display = true;
+                p.mutex.displayOptions = options;
+            }
+            p.thread.cv.notify_one();
+        }
+
+        size_t ShaderCompiler::getCount() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return
+                p.mutex.sources.size() +
+                (p.mutex.display ? 1 : 0) +
+                (p.mutex.compiling ? 1 : 0);
+        }
+
+        void ShaderCompiler::_run()
+        {
+            TLRENDER_P();
+            gl::ShaderSource source;
+            bool compile = false;
+            DisplayShaderOptions displayOptions;
+            bool display = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.thread.cv.wait(
+                    lock,
+                    [this]
+                    {
+                        return
+                            !_p->mutex.sources.empty() ||
+                            _p->mutex.display ||
+                            !_p->thread.running;
+                    });
+                if (!p.thread.running)
+                    return;
+                if (p.mutex.display)
+                {
+                    displayOptions = p.mutex.displayOptions;
+                    p.mutex.display = false;
+                    p.mutex.displayOptions = DisplayShaderOptions();
+                    p.mutex.compiling = true;
+                    display = true;
+                }
+                else if (!p.mutex.sources.empty())
+                {
+                    source = p.mutex.sources.front();
+                    p.mutex.sources.pop_front();
+                    p.mutex.compiling = true;
+                    compile = true;
+                }
+            }
+            if (display)
+            {
+                std::vector<gl::ShaderSource> sources = _displaySources(displayOptions);
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (!p.mutex.display)
+                {
+                    p.mutex.sources = std::list<gl::ShaderSource>(sources.begin(), sources.end());
+                }
+                p.mutex.compiling = false;
+            }
+            else if (compile)
+            {
+                if (!p.cache->contains(source))
+                {
+                    try
+                    {
+                        // Only the program binary is kept, the renderer
+                        // creates its own program from it.
+                        p.cache->getShader(source);
+                    }
+                    catch (const std::exception&)
+                    {
+                        // Errors are reported when the renderer uses the
+                        // shader.
+                    }
+                }
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.compiling = false;
+            }
+        }
+
+        std::vector<gl::ShaderSource> ShaderCompiler::_displaySources(const DisplayShaderOptions& options)
+        {
+            std::vector<gl::ShaderSource> out;
+#if defined(TLRENDER_OCIO)
+            TLRENDER_P();
+            if (options.ocioCache)
+            {
+                try
+                {
+                    // Peek at the cache so the data for the other views
+                    // does not replace the data the renderer is using.
+                    auto data = options.ocioCache->peekOCIOData(options.ocioOptions);
+                    if (data && data->config)
+                    {
+                        const char* display = options.ocioOptions.display.c_str();
+                        for (int i = 0; i < data->config->getNumViews(display); ++i)
+                        {
+                            // Stop if there is a newer request.
+                            {
+                                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                                if (p.mutex.display || !p.thread.running)
+                                {
+                                    out.clear();
+                                    break;
+                                }
+                            }
+                            const std::string view = data->config->getView(display, i);
+                            if (view == options.ocioOptions.view)
+                                continue;
+                            timeline::OCIOOptions ocioOptions = options.ocioOptions;
+                            ocioOptions.view = view;
+                            try
+                            {
+                                auto viewData = options.ocioCache->peekOCIOData(ocioOptions);
+                                out.push_back({
+                                    vertexSource(),
+                                    displaySource(
+                                        viewData.get(),
+                                        options.lutData.get(),
+                                        options.lutOrder,
+                                        options.toneMapDef,
+                                        options.toneMap) });
+                            }
+                            catch (const std::exception&)
+                            {
+                                // Errors are reported when the renderer uses
+                                // the view.
+                            }
+                        }
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    // Errors are reported by the renderer.
+                }
+            }
+#endif // TLRENDER_OCIO
+            return out;
+        }
+    }
+}
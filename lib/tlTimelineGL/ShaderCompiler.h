@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimelineGL/OCIOCache.h>
+
+#include <tlGL/ShaderCache.h>
+
+namespace tl
+{
+    namespace gl
+    {
+        class GLFWWindow;
+    }
+
+    namespace timeline_gl
+    {
+        //! Display shader options. These are used to create the display
+        //! shaders for the other views of an OpenColorIO display.
+        struct DisplayShaderOptions
+        {
+            std::shared_ptr<OCIOCache> ocioCache;
+            timeline::OCIOOptions ocioOptions;
+            std::shared_ptr<OCIOLUTData> lutData;
+            timeline::LUTOrder lutOrder = timeline::LUTOrder::First;
+            std::string toneMapDef;
+            std::string toneMap;
+        };
+
+        //! Shader compiler.
+        //!
+        //! Shaders that may be needed soon, like the display shaders for the
+        //! other views of an OpenColorIO configuration, are compiled on a
+        //! background thread and their program binaries are added to a shader
+        //! cache. The thread uses the OpenGL context of a window created with
+        //! the same driver as the renderer context.
+        class ShaderCompiler : public std::enable_shared_from_this<ShaderCompiler>
+        {
+            TLRENDER_NON_COPYABLE(ShaderCompiler);
+
+        protected:
+            void _init(
+                const std::shared_ptr<gl::GLFWWindow>&,
+                const std::shared_ptr<gl::ShaderCache>&);
+
+            ShaderCompiler();
+
+        public:
+            ~ShaderCompiler();
+
+            //! Create a new shader compiler. The window provides the OpenGL
+            //! context for the compiler thread.
+            static std::shared_ptr<ShaderCompiler> create(
+                const std::shared_ptr<gl::GLFWWindow>&,
+                const std::shared_ptr<gl::ShaderCache>&);
+
+            //! Get the shader cache.
+            const std::shared_ptr<gl::ShaderCache>& getCache() const;
+
+            //! Set the shaders to compile, replacing any that have not
+            //! been compiled yet.
+            void compile(const std::vector<gl::ShaderSource>&);
+
+            //! Set the display shaders to compile, replacing any shaders
+            //! that have not been compiled yet. The shader sources are
+            //! created on the compiler thread, and the OpenColorIO data is
+            //! not added to the cache.
+            void compileDisplay(const DisplayShaderOptions&);
+
+            //! Get the number of shaders waiting to be compiled.
+            size_t getCount() const;
+
+        private:
+            void _run();
+            std::vector<gl::ShaderSource> _displaySources(const DisplayShaderOptions&);
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
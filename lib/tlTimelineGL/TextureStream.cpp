@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineGL/TextureStream.h>
+
+#include <tlTimelineGL/RenderPrivate.h>
+
+#include <tlGL/GL.h>
+#include <tlGL/GLFWWindow.h>
+#include <tlGL/TextureUpload.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace tl
+{
+    namespace timeline_gl
+    {
+        struct TextureStream::Private
+        {
+            std::shared_ptr<gl::GLFWWindow> window;
+
+            struct Request
+            {
+                std::shared_ptr<image::Image> image;
+                timeline::ImageFilters imageFilters;
+            };
+
+            typedef std::vector<std::shared_ptr<gl::Texture> > Textures;
+
+            struct Mutex
+            {
+                std::set<std::shared_ptr<image::Image> > images;
+                std::list<Request> requests;
+                std::shared_ptr<image::Image> current;
+                std::set<std::shared_ptr<image::Image> > uploaded;
+                std::map<std::shared_ptr<image::Image>, Textures> textures;
+                std::vector<Textures> release;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+
+            struct Thread
+            {
+                std::shared_ptr<gl::TextureUpload> upload;
+                std::condition_variable cv;
+                std::thread thread;
+                std::atomic<bool> running;
+            };
+            Thread thread;
+        };
+
+        void TextureStream::_init(
+            const std::shared_ptr<gl::GLFWWindow>& window,
+            const std::weak_ptr<log::System>& logSystem)
+        {
+            TLRENDER_P();
+
+            p.window = window;
+
+            p.thread.running = true;
+            p.thread.thread = std::thread(
+                [this, logSystem]
+                {
+                    TLRENDER_P();
+                    p.window->makeCurrent();
+                    p.thread.upload = gl::TextureUpload::create(
+                        gl::textureUploadCountDefault,
+                        logSystem);
+                    while (p.thread.running)
+                    {
+                        _run();
+                    }
+                    {
+                        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                        p.mutex.textures.clear();
+                        p.mutex.release.clear();
+                    }
+                    p.thread.upload.reset();
+                    p.window->doneCurrent();
+                });
+        }
+
+        TextureStream::TextureStream() :
+            _p(new Private)
+        {}
+
+        TextureStream::~TextureStream()
+        {
+            TLRENDER_P();
+            {
+                // Set the flag with the mutex locked so the thread cannot
+                // miss the notification between checking the predicate and
+                // waiting.
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.thread.running = false;
+            }
+            p.thread.cv.notify_one();
+            if (p.thread.thread.joinable())
+            {
+                p.thread.thread.join();
+            }
+        }
+
+        std::shared_ptr<TextureStream> TextureStream::create(
+            const std::shared_ptr<gl::GLFWWindow>& window,
+            const std::weak_ptr<log::System>& logSystem)
+        {
+            auto out = std::shared_ptr<TextureStream>(new TextureStream);
+            out->_init(window, logSystem);
+            return out;
+        }
+
+        void TextureStream::setVideo(const std::vector<timeline::VideoData>& videoData)
+        {
+            TLRENDER_P();
+            std::set<std::shared_ptr<image::Image> > images;
+            std::list<Private::Request> requests;
+            auto addRequest = [&images, &requests](
+                const std::shared_ptr<image::Image>& image,
+                const timeline::ImageOptions& imageOptions)
+            {
+                if (image && imageOptions.cache && images.insert(image).second)
+                {
+                    requests.push_back({ image, imageOptions.imageFilters });
+                }
+            };
+            for (const auto& i : videoData)
+            {
+                for (const auto& layer : i.layers)
+                {
+                    addRequest(layer.image, layer.imageOptions);
+                    addRequest(layer.imageB, layer.imageOptionsB);
+                }
+            }
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+
+                // Skip the images that are already uploaded or in progress.
+                for (auto i = requests.begin(); i != requests.end();)
+                {
+                    if (i->image == p.mutex.current ||
+                        p.mutex.uploaded.find(i->image) != p.mutex.uploaded.end())
+                    {
+                        i = requests.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                p.mutex.requests = std::move(requests);
+
+                // Release the textures that are no longer needed. The
+                // textures are deleted by the thread where the OpenGL
+                // context is current.
+                for (auto i = p.mutex.textures.begin(); i != p.mutex.textures.end();)
+                {
+                    if (images.find(i->first) == images.end())
+                    {
+                        p.mutex.release.push_back(std::move(i->second));
+                        i = p.mutex.textures.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                for (auto i = p.mutex.uploaded.begin(); i != p.mutex.uploaded.end();)
+                {
+                    if (images.find(*i) == images.end())
+                    {
+                        i = p.mutex.uploaded.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                p.mutex.images = std::move(images);
+            }
+            p.thread.cv.notify_one();
+        }
+
+        bool TextureStream::take(
+            const std::shared_ptr<image::Image>& image,
+            std::vector<std::shared_ptr<gl::Texture> >& textures)
+        {
+            TLRENDER_P();
+            bool out = false;
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            const auto i = p.mutex.textures.find(image);
+            if (i != p.mutex.textures.end())
+            {
+                textures = std::move(i->second);
+                p.mutex.textures.erase(i);
+                out = true;
+            }
+            return out;
+        }
+
+        size_t TextureStream::getCount() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.textures.size();
+        }
+
+        void TextureStream::_run()
+        {
+            TLRENDER_P();
+            Private::Request request;
+            std::vector<Private::Textures> release;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.thread.cv.wait(
+                    lock,
+                    [this]
+                    {
+                        return
+                            !_p->mutex.requests.empty() ||
+                            !_p->mutex.release.empty() ||
+                            !_p->thread.running;
+                    });
+                if (!p.mutex.requests.empty())
+                {
+                    request = p.mutex.requests.front();
+                    p.mutex.requests.pop_front();
+                    p.mutex.current = request.image;
+                }
+                release = std::move(p.mutex.release);
+                p.mutex.release.clear();
+            }
+            release.clear();
+            if (request.image)
+            {
+                auto textures = getTextures(
+                    request.image->getInfo(),
+                    request.imageFilters);
+                copyTextures(request.image, textures, p.thread.upload);
+
+                // Wait for the uploads to finish before the textures are
+                // used by the renderer context.
+#if defined(TLRENDER_API_GL_4_1)
+                if (GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0))
+                {
+                    GLenum status = GL_TIMEOUT_EXPIRED;
+                    while (GL_TIMEOUT_EXPIRED == status && p.thread.running)
+                    {
+                        status = glClientWaitSync(
+                            sync,
+                            GL_SYNC_FLUSH_COMMANDS_BIT,
+                            1000000000);
+                    }
+                    glDeleteSync(sync);
+                }
+#elif defined(TLRENDER_API_GLES_2)
+                glFinish();
+#endif // TLRENDER_API_GL_4_1
+
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.current.reset();
+                if (p.mutex.images.find(request.image) != p.mutex.images.end())
+                {
+                    p.mutex.textures[request.image] = std::move(textures);
+                    p.mutex.uploaded.insert(request.image);
+                }
+                else
+                {
+                    p.mutex.release.push_back(std::move(textures));
+                }
+            }
+        }
+    }
+}
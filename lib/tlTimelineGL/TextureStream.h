@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/Video.h>
+
+#include <tlGL/Texture.h>
+
+#include <tlCore/LogSystem.h>
+
+namespace tl
+{
+    namespace gl
+    {
+        class GLFWWindow;
+    }
+
+    namespace timeline_gl
+    {
+        //! Texture stream.
+        //!
+        //! Video that will be displayed soon is uploaded to textures on a
+        //! background thread, so the renderer can draw it without copying
+        //! the image data first. The thread uses the OpenGL context of a
+        //! window that shares objects with the renderer context, and the
+        //! textures are only handed to the renderer once the uploads have
+        //! finished.
+        class TextureStream : public std::enable_shared_from_this<TextureStream>
+        {
+            TLRENDER_NON_COPYABLE(TextureStream);
+
+        protected:
+            void _init(
+                const std::shared_ptr<gl::GLFWWindow>&,
+                const std::weak_ptr<log::System>&);
+
+            TextureStream();
+
+        public:
+            ~TextureStream();
+
+            //! Create a new texture stream. The window provides the OpenGL
+            //! context for the upload thread.
+            static std::shared_ptr<TextureStream> create(
+                const std::shared_ptr<gl::GLFWWindow>&,
+                const std::weak_ptr<log::System>& = std::weak_ptr<log::System>());
+
+            //! Set the video to upload, in the order it will be displayed.
+            //! Uploaded textures for video that is no longer in the list are
+            //! released.
+            void setVideo(const std::vector<timeline::VideoData>&);
+
+            //! Take the uploaded textures for an image. Returns false if the
+            //! image has not been uploaded yet.
+            bool take(
+                const std::shared_ptr<image::Image>&,
+                std::vector<std::shared_ptr<gl::Texture> >&);
+
+            //! Get the number of images that have been uploaded and not
+            //! taken.
+            size_t getCount() const;
+
+        private:
+            void _run();
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -413,6 +413,7 @@ namespace tl
                 }
                 if (p.buffer)
                 {
+                    event.render->flush();
                     gl::OffscreenBufferBinding binding(p.buffer);
                     event.render->setRenderSize(size);
                     event.render->setViewport(math::Box2i(0, 0, g.w(), g.h()));
@@ -10,6 +10,7 @@
 
 #include <tlIO/System.h>
 
+#include <tlGL/AsyncReadback.h>
 #include <tlGL/GL.h>
 #include <tlGL/GLFWWindow.h>
 #include <tlGL/OffscreenBuffer.h>
@@ -285,10 +286,18 @@ namespace tl
             };
             InfoThread infoThread;
 
+            struct ThumbnailReadback
+            {
+                std::shared_ptr<ThumbnailRequest> request;
+                std::string key;
+            };
+
             struct ThumbnailThread
             {
                 std::shared_ptr<timeline_gl::Render> render;
                 std::shared_ptr<gl::OffscreenBuffer> buffer;
+                std::shared_ptr<gl::AsyncReadback> readback;
+                std::list<ThumbnailReadback> readbacks;
                 memory::LRUCache<std::string, std::shared_ptr<io::IRead> > ioCache;
                 std::condition_variable cv;
                 std::thread thread;
@@ -362,6 +371,8 @@ namespace tl
                         std::unique_lock<std::mutex> lock(p.thumbnailMutex.mutex);
                         p.thumbnailMutex.stopped = true;
                     }
+                    _thumbnailFinish(p.thumbnailThread.readbacks.size());
+                    p.thumbnailThread.readback.reset();
                     p.thumbnailThread.buffer.reset();
                     p.thumbnailThread.render.reset();
                     p.window->doneCurrent();
@@ -487,6 +498,9 @@ namespace tl
             request->height = height;
             request->time = time;
             request->options = options;
+            // Use the embedded previews of RAW images for thumbnails.
+            request->options.insert({ "RAW/Quality", "Preview" });
+            request->options.insert({ "RAW/Refine", "0" });
             ThumbnailRequest out;
             out.id = p.requestId;
             out.height = height;
@@ -672,10 +686,13 @@ namespace tl
             TLRENDER_P();
             std::shared_ptr<Private::ThumbnailRequest> request;
             {
+                // Only wait a short time for new requests while thumbnails
+                // are being read back, so the readbacks are checked again
+                // soon without spinning.
                 std::unique_lock<std::mutex> lock(p.thumbnailMutex.mutex);
                 if (p.thumbnailThread.cv.wait_for(
                     lock,
-                    std::chrono::milliseconds(5),
+                    std::chrono::milliseconds(p.thumbnailThread.readbacks.empty() ? 5 : 1),
                     [this]
                     {
                         return !_p->thumbnailMutex.requests.empty();
@@ -693,6 +710,28 @@ namespace tl
                     request->path,
                     request->time,
                     request->options);
+
+                // Start reading back the thumbnail from the offscreen
+                // buffer. The request is finished when the readback is
+                // done, so the next thumbnail can be rendered meanwhile.
+                bool readback = false;
+                auto startReadback = [this, &p, &request, &key, &readback](const math::Size2i& size)
+                {
+                    const image::Info info(size.w, size.h, image::PixelType::RGBA_U8);
+                    if (!p.thumbnailThread.readback ||
+                        p.thumbnailThread.readback->getInfo() != info)
+                    {
+                        _thumbnailFinish(p.thumbnailThread.readbacks.size());
+                        p.thumbnailThread.readback = gl::AsyncReadback::create(info);
+                    }
+                    else if (p.thumbnailThread.readback->isFull())
+                    {
+                        _thumbnailFinish(1);
+                    }
+                    p.thumbnailThread.readback->start();
+                    p.thumbnailThread.readbacks.push_back({ request, key });
+                    readback = true;
+                };
                 if (!p.cache->getThumbnail(key, image))
                 {
                     if (auto context = p.context.lock())
@@ -741,19 +780,7 @@ namespace tl
                                         videoData.image,
                                         { math::Box2i(0, 0, size.w, size.h) });
                                     p.thumbnailThread.render->end();
-                                    image = image::Image::create(
-                                        size.w,
-                                        size.h,
-                                        image::PixelType::RGBA_U8);
-                                    glPixelStorei(GL_PACK_ALIGNMENT, 1);
-                                    glReadPixels(
-                                        0,
-                                        0,
-                                        size.w,
-                                        size.h,
-                                        GL_RGBA,
-                                        GL_UNSIGNED_BYTE,
-                                        image->getData());
+                                    startReadback(size);
                                 }
                             }
                             else if (
@@ -801,19 +828,7 @@ namespace tl
                                             { videoData },
                                             { math::Box2i(0, 0, size.w, size.h) });
                                         p.thumbnailThread.render->end();
-                                        image = image::Image::create(
-                                            size.w,
-                                            size.h,
-                                            image::PixelType::RGBA_U8);
-                                        glPixelStorei(GL_PACK_ALIGNMENT, 1);
-                                        glReadPixels(
-                                            0,
-                                            0,
-                                            size.w,
-                                            size.h,
-                                            GL_RGBA,
-                                            GL_UNSIGNED_BYTE,
-                                            image->getData());
+                                        startReadback(size);
                                     }
                                 }
                             }
@@ -823,8 +838,42 @@ namespace tl
                         }
                     }
                 }
-                request->promise.set_value(image);
-                p.cache->addThumbnail(key, image);
+                if (!readback)
+                {
+                    request->promise.set_value(image);
+                    p.cache->addThumbnail(key, image);
+                }
+            }
+
+            // Finish the readbacks that are done, or all of them when there
+            // are no more requests.
+            _thumbnailFinish(!request ? p.thumbnailThread.readbacks.size() : 0);
+        }
+
+        void ThumbnailGenerator::_thumbnailFinish(size_t count)
+        {
+            TLRENDER_P();
+            while (!p.thumbnailThread.readbacks.empty() &&
+                (count > 0 || p.thumbnailThread.readback->isReady()))
+            {
+                const auto readback = p.thumbnailThread.readbacks.front();
+                p.thumbnailThread.readbacks.pop_front();
+                std::shared_ptr<image::Image> image;
+                try
+                {
+                    image = image::Image::create(p.thumbnailThread.readback->getInfo());
+                    p.thumbnailThread.readback->finish(image);
+                }
+                catch (const std::exception&)
+                {
+                    image.reset();
+                }
+                readback.request->promise.set_value(image);
+                p.cache->addThumbnail(readback.key, image);
+                if (count > 0)
+                {
+                    --count;
+                }
             }
         }
 
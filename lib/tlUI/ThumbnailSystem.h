@@ -203,6 +203,7 @@ namespace tl
         private:
             void _infoRun();
             void _thumbnailRun();
+            void _thumbnailFinish(size_t);
             void _waveformRun();
             void _infoCancel();
             void _thumbnailCancel();
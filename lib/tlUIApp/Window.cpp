@@ -170,6 +170,10 @@ namespace tl
             bool refresh = false;
             int modifiers = 0;
             std::shared_ptr<timeline_gl::TextureCache> textureCache;
+            std::shared_ptr<timeline_gl::TextureStream> textureStream;
+            std::shared_ptr<gl::ShaderCache> shaderCache;
+            std::shared_ptr<timeline_gl::ShaderCompiler> shaderCompiler;
+            std::shared_ptr<timeline_gl::OCIOCache> ocioCache;
             std::shared_ptr<timeline_gl::Render> render;
             std::shared_ptr<gl::OffscreenBuffer> offscreenBuffer;
 #if defined(TLRENDER_API_GLES_2)
@@ -403,6 +407,46 @@ namespace tl
             return _p->glfwWindow;
         }
 
+        void Window::setTextureStream(const std::shared_ptr<timeline_gl::TextureStream>& value)
+        {
+            TLRENDER_P();
+            p.textureStream = value;
+            if (p.render)
+            {
+                p.render->setTextureStream(value);
+            }
+        }
+
+        void Window::setShaderCache(const std::shared_ptr<gl::ShaderCache>& value)
+        {
+            TLRENDER_P();
+            p.shaderCache = value;
+            if (p.render)
+            {
+                p.render->setShaderCache(value);
+            }
+        }
+
+        void Window::setShaderCompiler(const std::shared_ptr<timeline_gl::ShaderCompiler>& value)
+        {
+            TLRENDER_P();
+            p.shaderCompiler = value;
+            if (p.render)
+            {
+                p.render->setShaderCompiler(value);
+            }
+        }
+
+        void Window::setOCIOCache(const std::shared_ptr<timeline_gl::OCIOCache>& value)
+        {
+            TLRENDER_P();
+            p.ocioCache = value;
+            if (p.render)
+            {
+                p.render->setOCIOCache(value);
+            }
+        }
+
         void Window::setGeometry(const math::Box2i& value)
         {
             IWindow::setGeometry(value);
@@ -466,6 +510,19 @@ namespace tl
                     p.render = timeline_gl::Render::create(
                         _context.lock(),
                         p.textureCache);
+                    p.render->setTextureStream(p.textureStream);
+                    if (p.shaderCache)
+                    {
+                        p.render->setShaderCache(p.shaderCache);
+                    }
+                    if (p.shaderCompiler)
+                    {
+                        p.render->setShaderCompiler(p.shaderCompiler);
+                    }
+                    if (p.ocioCache)
+                    {
+                        p.render->setOCIOCache(p.ocioCache);
+                    }
                 }
 
                 gl::OffscreenBufferOptions offscreenBufferOptions;
@@ -482,6 +539,7 @@ namespace tl
                 if (p.offscreenBuffer)
                 {
                     {
+                        p.render->flush();
                         gl::OffscreenBufferBinding binding(p.offscreenBuffer);
                         timeline::RenderOptions renderOptions;
                         renderOptions.colorBuffer = p.colorBuffer->get();
@@ -11,6 +11,14 @@ namespace tl
     namespace gl
     {
         class GLFWWindow;
+        class ShaderCache;
+    }
+
+    namespace timeline_gl
+    {
+        class OCIOCache;
+        class ShaderCompiler;
+        class TextureStream;
     }
 
     namespace ui_app
@@ -85,6 +93,18 @@ namespace tl
             //! Get the GLFW window.
             const std::shared_ptr<gl::GLFWWindow>& getGLFWWindow() const;
 
+            //! Set the texture stream used by the renderer.
+            void setTextureStream(const std::shared_ptr<timeline_gl::TextureStream>&);
+
+            //! Set the shader cache used by the renderer.
+            void setShaderCache(const std::shared_ptr<gl::ShaderCache>&);
+
+            //! Set the shader compiler used by the renderer.
+            void setShaderCompiler(const std::shared_ptr<timeline_gl::ShaderCompiler>&);
+
+            //! Set the OpenColorIO cache used by the renderer.
+            void setOCIOCache(const std::shared_ptr<timeline_gl::OCIOCache>&);
+
             void setGeometry(const math::Box2i&) override;
             void setVisible(bool) override;
             void tickEvent(
@@ -46,6 +46,21 @@ namespace tl
                 c.clear();
                 TLRENDER_ASSERT(!c.contains(0));
             }
+            {
+                // Peeking at a value does not mark it as recently used.
+                LRUCache<int, int> c;
+                c.setMax(2);
+                c.add(1, 2);
+                c.add(2, 3);
+                int v = 0;
+                TLRENDER_ASSERT(!c.peek(3, v));
+                TLRENDER_ASSERT(c.peek(1, v));
+                TLRENDER_ASSERT(2 == v);
+                c.add(3, 4);
+                TLRENDER_ASSERT(!c.contains(1));
+                TLRENDER_ASSERT(c.contains(2));
+                TLRENDER_ASSERT(c.contains(3));
+            }
             {
                 LRUCache<int, int> c;
                 c.setMax(3);
@@ -227,6 +227,91 @@ namespace tl
                     TLRENDER_ASSERT(seconds == i.seconds);
                 }
             }
+            {
+                struct Data
+                {
+                    otime::TimeRange range;
+                    size_t count = 0;
+                    std::vector<otime::TimeRange> chunks;
+                };
+                const std::vector<Data> data =
+                {
+                    Data({ time::invalidTimeRange, 2, {} }),
+                    Data({
+                        otime::TimeRange(
+                            otime::RationalTime(0.0, 24.0),
+                            otime::RationalTime(10.0, 24.0)),
+                        0,
+                        {
+                            otime::TimeRange(
+                                otime::RationalTime(0.0, 24.0),
+                                otime::RationalTime(10.0, 24.0))
+                        }}),
+                    Data({
+                        otime::TimeRange(
+                            otime::RationalTime(0.0, 24.0),
+                            otime::RationalTime(10.0, 24.0)),
+                        2,
+                        {
+                            otime::TimeRange(
+                                otime::RationalTime(0.0, 24.0),
+                                otime::RationalTime(5.0, 24.0)),
+                            otime::TimeRange(
+                                otime::RationalTime(5.0, 24.0),
+                                otime::RationalTime(5.0, 24.0))
+                        }}),
+                    Data({
+                        otime::TimeRange(
+                            otime::RationalTime(10.0, 24.0),
+                            otime::RationalTime(10.0, 24.0)),
+                        3,
+                        {
+                            otime::TimeRange(
+                                otime::RationalTime(10.0, 24.0),
+                                otime::RationalTime(3.0, 24.0)),
+                            otime::TimeRange(
+                                otime::RationalTime(13.0, 24.0),
+                                otime::RationalTime(3.0, 24.0)),
+                            otime::TimeRange(
+                                otime::RationalTime(16.0, 24.0),
+                                otime::RationalTime(4.0, 24.0))
+                        }}),
+                    Data({
+                        otime::TimeRange(
+                            otime::RationalTime(0.0, 24.0),
+                            otime::RationalTime(3.0, 24.0)),
+                        8,
+                        {
+                            otime::TimeRange(
+                                otime::RationalTime(0.0, 24.0),
+                                otime::RationalTime(1.0, 24.0)),
+                            otime::TimeRange(
+                                otime::RationalTime(1.0, 24.0),
+                                otime::RationalTime(1.0, 24.0)),
+                            otime::TimeRange(
+                                otime::RationalTime(2.0, 24.0),
+                                otime::RationalTime(1.0, 24.0))
+                        }}),
+                    Data({
+                        otime::TimeRange(
+                            otime::RationalTime(1.0, 1.0),
+                            otime::RationalTime(48.0, 24.0)),
+                        2,
+                        {
+                            otime::TimeRange(
+                                otime::RationalTime(24.0, 24.0),
+                                otime::RationalTime(24.0, 24.0)),
+                            otime::TimeRange(
+                                otime::RationalTime(48.0, 24.0),
+                                otime::RationalTime(24.0, 24.0))
+                        }})
+                };
+                for (const auto& i : data)
+                {
+                    const auto chunks = time::split(i.range, i.count);
+                    TLRENDER_ASSERT(chunks == i.chunks);
+                }
+            }
             {
                 struct Data
                 {
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlGLTest/AsyncReadbackTest.h>
+
+#include <tlGL/AsyncReadback.h>
+#include <tlGL/GLFWWindow.h>
+#include <tlGL/GL.h>
+#include <tlGL/OffscreenBuffer.h>
+
+#include <tlCore/Assert.h>
+
+using namespace tl::gl;
+
+namespace tl
+{
+    namespace gl_tests
+    {
+        AsyncReadbackTest::AsyncReadbackTest(const std::shared_ptr<system::Context>& context) :
+            ITest("gl_tests::AsyncReadbackTest", context)
+        {}
+
+        std::shared_ptr<AsyncReadbackTest> AsyncReadbackTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<AsyncReadbackTest>(new AsyncReadbackTest(context));
+        }
+
+        void AsyncReadbackTest::run()
+        {
+            std::shared_ptr<GLFWWindow> window;
+            try
+            {
+                window = GLFWWindow::create(
+                    "AsyncReadbackTest",
+                    math::Size2i(1, 1),
+                    _context,
+                    static_cast<int>(GLFWWindowOptions::MakeCurrent));
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            if (window)
+            {
+                _readback();
+            }
+        }
+
+        void AsyncReadbackTest::_readback()
+        {
+            const image::Info info(4, 2, image::PixelType::RGBA_U8);
+            OffscreenBufferOptions options;
+            options.colorType = info.pixelType;
+            auto buffer = OffscreenBuffer::create(math::Size2i(info.size.w, info.size.h), options);
+            OffscreenBufferBinding binding(buffer);
+
+            for (size_t count : { 1, 3 })
+            {
+                auto readback = AsyncReadback::create(info, count);
+                TLRENDER_ASSERT(info == readback->getInfo());
+                TLRENDER_ASSERT(count == readback->getCount());
+                TLRENDER_ASSERT(0 == readback->getPendingCount());
+                TLRENDER_ASSERT(!readback->isFull());
+                TLRENDER_ASSERT(!readback->isReady());
+
+                // Render frames with different colors, and check that the
+                // readbacks are finished in order.
+                const size_t frames = 8;
+                size_t finished = 0;
+                auto image = image::Image::create(info);
+                auto finish = [readback, image, &finished]
+                {
+                    readback->finish(image);
+                    const uint8_t value = finished * 10;
+                    const uint8_t* data = image->getData();
+                    for (size_t i = 0; i < image->getDataByteCount(); i += 4)
+                    {
+                        TLRENDER_ASSERT(value == data[i]);
+                        TLRENDER_ASSERT(255 == data[i + 3]);
+                    }
+                    ++finished;
+                };
+                for (size_t i = 0; i < frames; ++i)
+                {
+                    if (readback->isFull())
+                    {
+                        finish();
+                    }
+                    glClearColor(i * 10 / 255.F, 0.F, 0.F, 1.F);
+                    glClear(GL_COLOR_BUFFER_BIT);
+                    readback->start();
+                }
+                TLRENDER_ASSERT(count == readback->getPendingCount());
+                TLRENDER_ASSERT(readback->isFull());
+                while (readback->getPendingCount() > 0)
+                {
+                    finish();
+                }
+                TLRENDER_ASSERT(frames == finished);
+                try
+                {
+                    readback->finish(image);
+                    TLRENDER_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+            try
+            {
+                AsyncReadback::create(image::Info(4, 2, image::PixelType::None));
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+        }
+    }
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace gl_tests
+    {
+        class AsyncReadbackTest : public tests::ITest
+        {
+        protected:
+            AsyncReadbackTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<AsyncReadbackTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _readback();
+        };
+    }
+}
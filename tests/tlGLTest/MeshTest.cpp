@@ -62,7 +62,8 @@ namespace tl
             for (auto type : {
                     VBOType::Pos2_F32,
                     VBOType::Pos2_F32_UV_U16,
-                    VBOType::Pos2_F32_Color_F32
+                    VBOType::Pos2_F32_Color_F32,
+                    VBOType::Pos2_F32_UV_F32_Color_F32
                 })
             {
                 auto mesh = geom::box(math::Box2f(0.F, 1.F, 2.F, 3.F));
@@ -90,7 +91,8 @@ namespace tl
             for (auto type : {
                     VBOType::Pos2_F32,
                     VBOType::Pos2_F32_UV_U16,
-                    VBOType::Pos2_F32_Color_F32
+                    VBOType::Pos2_F32_Color_F32,
+                    VBOType::Pos2_F32_UV_F32_Color_F32
                 })
             {
                 auto mesh = geom::box(math::Box2f(0.F, 1.F, 2.F, 3.F));
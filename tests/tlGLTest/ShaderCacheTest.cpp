@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlGLTest/ShaderCacheTest.h>
+
+#include <tlGL/GLFWWindow.h>
+#include <tlGL/GL.h>
+#include <tlGL/ShaderCache.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/Path.h>
+#include <tlCore/StringFormat.h>
+
+#include <filesystem>
+
+using namespace tl::gl;
+
+namespace tl
+{
+    namespace gl_tests
+    {
+        ShaderCacheTest::ShaderCacheTest(const std::shared_ptr<system::Context>& context) :
+            ITest("gl_tests::ShaderCacheTest", context)
+        {}
+
+        std::shared_ptr<ShaderCacheTest> ShaderCacheTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<ShaderCacheTest>(new ShaderCacheTest(context));
+        }
+
+        void ShaderCacheTest::run()
+        {
+            std::shared_ptr<GLFWWindow> window;
+            try
+            {
+                window = GLFWWindow::create(
+                    "ShaderCacheTest",
+                    math::Size2i(1, 1),
+                    _context,
+                    static_cast<int>(GLFWWindowOptions::MakeCurrent));
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            if (window)
+            {
+                _memory();
+                _disk();
+                _prune();
+            }
+        }
+
+        namespace
+        {
+            ShaderSource getSource(float value)
+            {
+                ShaderSource out;
+                out.vertex =
+                    "#version 410\n"
+                    "\n"
+                    "in vec3 vPos;\n"
+                    "\n"
+                    "void main()\n"
+                    "{\n"
+                    "    gl_Position = vec4(vPos, 1.0);\n"
+                    "}\n";
+                out.fragment =
+                    "#version 410\n"
+                    "\n"
+                    "out vec4 fColor;\n"
+                    "\n"
+                    "uniform float value;\n"
+                    "\n"
+                    "void main()\n"
+                    "{\n"
+                    "    fColor = vec4(value, " + std::to_string(value) + ", 1.0, 1.0);\n"
+                    "}\n";
+                return out;
+            }
+        }
+
+        void ShaderCacheTest::_memory()
+        {
+            const ShaderSource a = getSource(0.F);
+            const ShaderSource b = getSource(1.F);
+            TLRENDER_ASSERT(a != b);
+            TLRENDER_ASSERT(getShaderCacheKey(a) == getShaderCacheKey(a));
+            TLRENDER_ASSERT(getShaderCacheKey(a) != getShaderCacheKey(b));
+
+            auto cache = ShaderCache::create(std::string(), 1);
+            TLRENDER_ASSERT(cache->getPath().empty());
+            TLRENDER_ASSERT(1 == cache->getMax());
+            TLRENDER_ASSERT(!cache->contains(a));
+            auto shader = cache->getShader(a);
+            TLRENDER_ASSERT(shader->getVertexSource() == a.vertex);
+            TLRENDER_ASSERT(shader->getFragmentSource() == a.fragment);
+            ShaderCacheStats stats = cache->getStats();
+            TLRENDER_ASSERT(1 == stats.misses);
+#if defined(TLRENDER_API_GL_4_1)
+            TLRENDER_ASSERT(cache->contains(a));
+            TLRENDER_ASSERT(1 == stats.count);
+
+            // Shaders with the same source code are separate programs.
+            auto shader2 = cache->getShader(a);
+            TLRENDER_ASSERT(shader2->getProgram() != shader->getProgram());
+            TLRENDER_ASSERT(1 == cache->getStats().memoryHits);
+
+            // Only one program binary is kept in memory.
+            cache->getShader(b);
+            TLRENDER_ASSERT(cache->contains(b));
+            TLRENDER_ASSERT(!cache->contains(a));
+            cache->setMax(2);
+            cache->getShader(a);
+            TLRENDER_ASSERT(cache->contains(a));
+            TLRENDER_ASSERT(cache->contains(b));
+            TLRENDER_ASSERT(2 == cache->getStats().count);
+#endif // TLRENDER_API_GL_4_1
+
+            cache->clear();
+            TLRENDER_ASSERT(!cache->contains(a));
+            TLRENDER_ASSERT(0 == cache->getStats().count);
+        }
+
+        void ShaderCacheTest::_disk()
+        {
+            const std::string path = file::Path(file::createTempDir(), "shaders").get();
+            const ShaderSource source = getSource(.5F);
+            {
+                auto cache = ShaderCache::create(path);
+                TLRENDER_ASSERT(path == cache->getPath());
+                TLRENDER_ASSERT(file::exists(path));
+                cache->getShader(source);
+                TLRENDER_ASSERT(1 == cache->getStats().misses);
+            }
+#if defined(TLRENDER_API_GL_4_1)
+            const std::string fileName = file::Path(
+                path,
+                getShaderCacheKey(source) + ".bin").get();
+            TLRENDER_ASSERT(file::exists(fileName));
+            {
+                // Load the program binary from disk.
+                auto cache = ShaderCache::create(path);
+                auto shader = cache->getShader(source);
+                TLRENDER_ASSERT(shader->getProgram());
+                const ShaderCacheStats stats = cache->getStats();
+                TLRENDER_ASSERT(1 == stats.diskHits);
+                TLRENDER_ASSERT(0 == stats.misses);
+            }
+            {
+                // Invalid binaries are compiled again.
+                {
+                    auto io = file::FileIO::create(fileName, file::Mode::Write);
+                    io->write("invalid");
+                }
+                auto cache = ShaderCache::create(path);
+                auto shader = cache->getShader(source);
+                TLRENDER_ASSERT(shader->getProgram());
+                TLRENDER_ASSERT(1 == cache->getStats().misses);
+            }
+            {
+                auto cache = ShaderCache::create(path);
+                cache->getShader(source);
+                TLRENDER_ASSERT(1 == cache->getStats().diskHits);
+            }
+#endif // TLRENDER_API_GL_4_1
+        }
+
+        void ShaderCacheTest::_prune()
+        {
+            // Only the most recently used program binaries on disk are kept,
+            // and temporary files are removed.
+            const std::string path = file::Path(file::createTempDir(), "shaders").get();
+            file::mkdir(path);
+            const auto now = std::filesystem::file_time_type::clock::now();
+            std::vector<std::string> fileNames;
+            for (int i = 0; i < 5; ++i)
+            {
+                const std::string fileName = file::Path(
+                    path,
+                    string::Format("{0}.bin").arg(i)).get();
+                {
+                    auto io = file::FileIO::create(fileName, file::Mode::Write);
+                    io->write("binary");
+                }
+                std::filesystem::last_write_time(
+                    std::filesystem::path(fileName),
+                    now - std::chrono::hours(5 - i));
+                fileNames.push_back(fileName);
+            }
+            const std::string tmpFileName = file::Path(path, "5.bin.0.tmp").get();
+            {
+                auto io = file::FileIO::create(tmpFileName, file::Mode::Write);
+                io->write("binary");
+            }
+            auto cache = ShaderCache::create(path, 100, 2);
+            TLRENDER_ASSERT(!file::exists(fileNames[0]));
+            TLRENDER_ASSERT(!file::exists(fileNames[1]));
+            TLRENDER_ASSERT(!file::exists(fileNames[2]));
+            TLRENDER_ASSERT(file::exists(fileNames[3]));
+            TLRENDER_ASSERT(file::exists(fileNames[4]));
+            TLRENDER_ASSERT(!file::exists(tmpFileName));
+        }
+    }
+}
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlGLTest/TexturePoolTest.h>
+
+#include <tlGL/GLFWWindow.h>
+#include <tlGL/TexturePool.h>
+
+#include <tlCore/Assert.h>
+
+using namespace tl::gl;
+
+namespace tl
+{
+    namespace gl_tests
+    {
+        TexturePoolTest::TexturePoolTest(const std::shared_ptr<system::Context>& context) :
+            ITest("gl_tests::TexturePoolTest", context)
+        {}
+
+        std::shared_ptr<TexturePoolTest> TexturePoolTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<TexturePoolTest>(new TexturePoolTest(context));
+        }
+
+        void TexturePoolTest::run()
+        {
+            {
+                TexturePoolStats a;
+                TexturePoolStats b;
+                TLRENDER_ASSERT(a == b);
+                a.textureHits = 1;
+                TLRENDER_ASSERT(a != b);
+            }
+            {
+                OffscreenBufferOptions options;
+                options.colorType = image::PixelType::RGBA_U8;
+                TLRENDER_ASSERT(4 * 3 * 2 == getByteCount(math::Size2i(3, 2), options));
+                options.depth = OffscreenDepth::_24;
+                options.stencil = OffscreenStencil::_8;
+                options.sampling = OffscreenSampling::_4;
+                TLRENDER_ASSERT(4 * (4 + 4) * 3 * 2 == getByteCount(math::Size2i(3, 2), options));
+            }
+
+            std::shared_ptr<GLFWWindow> window;
+            try
+            {
+                window = GLFWWindow::create(
+                    "TexturePoolTest",
+                    math::Size2i(1, 1),
+                    _context,
+                    static_cast<int>(GLFWWindowOptions::MakeCurrent));
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            if (window)
+            {
+                _textures();
+                _buffers();
+                _max();
+            }
+        }
+
+        void TexturePoolTest::_textures()
+        {
+            auto pool = TexturePool::create(memory::megabyte);
+            TLRENDER_ASSERT(memory::megabyte == pool->getMax());
+            const image::Info info(16, 8, image::PixelType::RGBA_U8);
+            unsigned int id = 0;
+            {
+                auto texture = pool->getTexture(info);
+                id = texture->getID();
+                TLRENDER_ASSERT(info.size == texture->getSize());
+                TLRENDER_ASSERT(0 == pool->getStats().count);
+            }
+            auto stats = pool->getStats();
+            TLRENDER_ASSERT(0 == stats.textureHits);
+            TLRENDER_ASSERT(1 == stats.textureMisses);
+            TLRENDER_ASSERT(1 == stats.count);
+            TLRENDER_ASSERT(image::getDataByteCount(info) == stats.byteCount);
+
+            // The released texture is recycled.
+            {
+                auto texture = pool->getTexture(info);
+                TLRENDER_ASSERT(id == texture->getID());
+                stats = pool->getStats();
+                TLRENDER_ASSERT(1 == stats.textureHits);
+                TLRENDER_ASSERT(0 == stats.count);
+                TLRENDER_ASSERT(0 == stats.byteCount);
+
+                // A texture that is in use is not recycled.
+                auto texture2 = pool->getTexture(info);
+                TLRENDER_ASSERT(texture2->getID() != texture->getID());
+            }
+            TLRENDER_ASSERT(2 == pool->getStats().count);
+
+            // Different information or options do not match.
+            {
+                auto texture = pool->getTexture(image::Info(8, 8, image::PixelType::RGBA_U8));
+                TLRENDER_ASSERT(id != texture->getID());
+                TextureOptions options;
+                options.filters.minify = timeline::ImageFilter::Nearest;
+                texture = pool->getTexture(info, options);
+                TLRENDER_ASSERT(id != texture->getID());
+            }
+            stats = pool->getStats();
+            TLRENDER_ASSERT(1 == stats.textureHits);
+            TLRENDER_ASSERT(4 == stats.textureMisses);
+            TLRENDER_ASSERT(4 == stats.count);
+
+            pool->clear();
+            stats = pool->getStats();
+            TLRENDER_ASSERT(0 == stats.count);
+            TLRENDER_ASSERT(0 == stats.byteCount);
+
+            // Textures that outlive the pool are deleted.
+            auto texture = pool->getTexture(info);
+            pool.reset();
+            texture.reset();
+        }
+
+        void TexturePoolTest::_buffers()
+        {
+            auto pool = TexturePool::create(memory::megabyte);
+            OffscreenBufferOptions options;
+            options.colorType = image::PixelType::RGBA_U8;
+            const math::Size2i size(16, 8);
+            unsigned int id = 0;
+            {
+                auto buffer = pool->getOffscreenBuffer(size, options);
+                id = buffer->getID();
+                TLRENDER_ASSERT(size == buffer->getSize());
+                TLRENDER_ASSERT(options == buffer->getOptions());
+            }
+            {
+                auto buffer = pool->getOffscreenBuffer(size, options);
+                TLRENDER_ASSERT(id == buffer->getID());
+                buffer = pool->getOffscreenBuffer(math::Size2i(8, 8), options);
+                TLRENDER_ASSERT(id != buffer->getID());
+            }
+            const auto stats = pool->getStats();
+            TLRENDER_ASSERT(1 == stats.bufferHits);
+            TLRENDER_ASSERT(2 == stats.bufferMisses);
+            TLRENDER_ASSERT(0 == stats.textureHits);
+            TLRENDER_ASSERT(0 == stats.textureMisses);
+            TLRENDER_ASSERT(2 == stats.count);
+            TLRENDER_ASSERT(
+                getByteCount(size, options) + getByteCount(math::Size2i(8, 8), options) ==
+                stats.byteCount);
+        }
+
+        void TexturePoolTest::_max()
+        {
+            const image::Info info(16, 16, image::PixelType::RGBA_U8);
+            const size_t byteCount = image::getDataByteCount(info);
+            auto pool = TexturePool::create(byteCount * 2);
+            {
+                std::vector<std::shared_ptr<Texture> > textures;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    textures.push_back(pool->getTexture(info));
+                }
+            }
+            auto stats = pool->getStats();
+            TLRENDER_ASSERT(4 == stats.count);
+            TLRENDER_ASSERT(0 == stats.evictions);
+
+            // The idle textures over the maximum are evicted the next time
+            // the pool is used.
+            auto texture = pool->getTexture(info);
+            stats = pool->getStats();
+            TLRENDER_ASSERT(2 == stats.evictions);
+            TLRENDER_ASSERT(1 == stats.count);
+            TLRENDER_ASSERT(byteCount == stats.byteCount);
+
+            pool->setMax(0);
+            stats = pool->getStats();
+            TLRENDER_ASSERT(3 == stats.evictions);
+            TLRENDER_ASSERT(0 == stats.count);
+        }
+    }
+}
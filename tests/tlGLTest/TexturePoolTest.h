@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace gl_tests
+    {
+        class TexturePoolTest : public tests::ITest
+        {
+        protected:
+            TexturePoolTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<TexturePoolTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _textures();
+            void _buffers();
+            void _max();
+        };
+    }
+}
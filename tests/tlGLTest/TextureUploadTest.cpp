@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlGLTest/TextureUploadTest.h>
+
+#include <tlGL/GLFWWindow.h>
+#include <tlGL/GL.h>
+#include <tlGL/TextureUpload.h>
+
+#include <tlCore/Assert.h>
+
+#include <cstring>
+
+using namespace tl::gl;
+
+namespace tl
+{
+    namespace gl_tests
+    {
+        TextureUploadTest::TextureUploadTest(const std::shared_ptr<system::Context>& context) :
+            ITest("gl_tests::TextureUploadTest", context)
+        {}
+
+        std::shared_ptr<TextureUploadTest> TextureUploadTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<TextureUploadTest>(new TextureUploadTest(context));
+        }
+
+        void TextureUploadTest::run()
+        {
+            std::shared_ptr<GLFWWindow> window;
+            try
+            {
+                window = GLFWWindow::create(
+                    "TextureUploadTest",
+                    math::Size2i(1, 1),
+                    _context,
+                    static_cast<int>(GLFWWindowOptions::MakeCurrent));
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            if (window)
+            {
+                _upload();
+            }
+        }
+
+        void TextureUploadTest::_upload()
+        {
+            const image::Info info(4, 2, image::PixelType::RGBA_U8);
+            for (size_t count : { 1, 3 })
+            {
+                auto upload = TextureUpload::create(count);
+                TLRENDER_ASSERT(count == upload->getCount());
+                TLRENDER_ASSERT(0 == upload->getByteCount());
+
+                // Upload more images than there are buffers, so the ring
+                // wraps around.
+                auto texture = Texture::create(info);
+                auto image = image::Image::create(info);
+                for (uint8_t i = 0; i < 8; ++i)
+                {
+                    memset(image->getData(), i * 10, image->getDataByteCount());
+                    upload->copy(image, texture);
+                }
+                upload->finish();
+#if defined(TLRENDER_API_GL_4_1)
+                TLRENDER_ASSERT(count * image->getDataByteCount() == upload->getByteCount());
+                std::vector<uint8_t> data(image->getDataByteCount());
+                texture->bind();
+                glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+                for (const auto i : data)
+                {
+                    TLRENDER_ASSERT(70 == i);
+                }
+
+                // Upload part of the texture.
+                const image::Info subInfo(2, 1, image::PixelType::RGBA_U8);
+                const std::vector<uint8_t> subData(image::getDataByteCount(subInfo), 255);
+                upload->copy(subData.data(), subInfo, texture, 2, 1);
+                upload->finish();
+                glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+                for (int y = 0; y < info.size.h; ++y)
+                {
+                    for (int x = 0; x < info.size.w; ++x)
+                    {
+                        const uint8_t value = (x >= 2 && 1 == y) ? 255 : 70;
+                        TLRENDER_ASSERT(value == data[(y * info.size.w + x) * 4]);
+                    }
+                }
+#endif // TLRENDER_API_GL_4_1
+            }
+        }
+    }
+}
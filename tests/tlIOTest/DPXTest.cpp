@@ -8,7 +8,9 @@
 #include <tlIO/System.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
 
+#include <chrono>
 #include <sstream>
 
 using namespace tl::io;
@@ -30,6 +32,7 @@ namespace tl
         {
             _enums();
             _io();
+            _writeThreads();
         }
 
         void DPXTest::_enums()
@@ -57,6 +60,7 @@ namespace tl
                 info.tags = tags;
                 auto write = plugin->write(path, info, options);
                 write->writeVideo(otime::RationalTime(0.0, 24.0), image);
+                write->flush();
             }
 
             void read(
@@ -195,7 +199,8 @@ namespace tl
                 { "DPX/Version", "2.0" },
                 { "DPX/Endian", "Auto" },
                 { "DPX/Endian", "MSB" },
-                { "DPX/Endian", "LSB" }
+                { "DPX/Endian", "LSB" },
+                { "SequenceIO/WriteThreadCount", "4" }
             };
 
             for (const auto& fileName : fileNames)
@@ -242,5 +247,57 @@ namespace tl
                 }
             }
         }
+
+        void DPXTest::_writeThreads()
+        {
+            // Write a sequence with different numbers of threads, and
+            // check that each frame is written to the correct file.
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<dpx::Plugin>();
+            const auto imageInfo = plugin->getWriteInfo(image::Info(
+                image::Size(1920, 1080),
+                image::PixelType::RGB_U10));
+            const int frames = 24;
+            for (size_t threads : { 1, 4, 16 })
+            {
+                Options options;
+                options["SequenceIO/WriteThreadCount"] = string::Format("{0}").arg(threads);
+                const file::Path path(string::Format("DPXTest_threads{0}.0.dpx").arg(threads));
+                Info info;
+                info.video.push_back(imageInfo);
+                info.videoTime = otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(frames, 24.0));
+                auto image = image::Image::create(imageInfo);
+                image->zero();
+                const auto t0 = std::chrono::steady_clock::now();
+                {
+                    auto write = plugin->write(path, info, options);
+                    for (int frame = 0; frame < frames; ++frame)
+                    {
+                        image->setTags({ { "Creator", string::Format("{0}").arg(frame) } });
+                        write->writeVideo(otime::RationalTime(frame, 24.0), image);
+                    }
+                    write->flush();
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<double> diff = t1 - t0;
+                _print(string::Format("Write threads {0}: {1} frames per second").
+                    arg(threads).
+                    arg(frames / diff.count()));
+
+                auto read = plugin->read(path);
+                for (int frame = 0; frame < frames; ++frame)
+                {
+                    const auto videoData = read->readVideo(otime::RationalTime(frame, 24.0)).get();
+                    TLRENDER_ASSERT(videoData.image);
+                    const auto tags = videoData.image->getTags();
+                    const auto i = tags.find("Creator");
+                    TLRENDER_ASSERT(i != tags.end());
+                    TLRENDER_ASSERT(string::Format("{0}").arg(frame) == i->second);
+                }
+                system->getCache()->clear();
+            }
+        }
     }
 }
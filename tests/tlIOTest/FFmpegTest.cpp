@@ -8,7 +8,9 @@
 #include <tlIO/System.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/File.h>
 #include <tlCore/FileIO.h>
+#include <tlCore/StringFormat.h>
 
 #include <array>
 #include <sstream>
@@ -33,6 +35,8 @@ namespace tl
             _enums();
             _util();
             _io();
+            _writeStats();
+            _concat();
         }
 
         void FFmpegTest::_enums()
@@ -186,7 +190,10 @@ namespace tl
                 { "FFmpeg/WriteProfile", "ProRes_LT" },
                 { "FFmpeg/WriteProfile", "ProRes_HQ" },
                 { "FFmpeg/WriteProfile", "ProRes_4444" },
-                { "FFmpeg/WriteProfile", "ProRes_XQ" }
+                { "FFmpeg/WriteProfile", "ProRes_XQ" },
+                { "FFmpeg/WriteThreadCount", "0" },
+                { "FFmpeg/WriteThreadCount", "4" },
+                { "FFmpeg/WriteQueueSize", "1" }
             };
 
             for (const auto& fileName : fileNames)
@@ -234,5 +241,105 @@ namespace tl
                 }
             }
         }
+
+        void FFmpegTest::_writeStats()
+        {
+            // Write through the pipeline with a single frame queue, and
+            // check the statistics.
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ffmpeg::Plugin>();
+            const auto imageInfo = plugin->getWriteInfo(image::Info(
+                image::Size(160, 90),
+                image::PixelType::RGB_U8));
+            Info info;
+            info.video.push_back(imageInfo);
+            const size_t frames = 24;
+            info.videoTime = otime::TimeRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(frames, 24.0));
+            Options options;
+            options["FFmpeg/WriteThreadCount"] = "4";
+            options["FFmpeg/WriteQueueSize"] = "1";
+            auto write = std::dynamic_pointer_cast<ffmpeg::Write>(
+                plugin->write(file::Path("FFmpegTest_stats.mp4"), info, options));
+            TLRENDER_ASSERT(write);
+            auto image = image::Image::create(imageInfo);
+            image->zero();
+            for (size_t i = 0; i < frames; ++i)
+            {
+                write->writeVideo(otime::RationalTime(i, 24.0), image);
+                TLRENDER_ASSERT(write->getStats().queueCount <= 1);
+            }
+            write->flush();
+            const ffmpeg::WriteStats stats = write->getStats();
+            _print(string::Format("Write stats: {0} frames, queue max {1}, packet max {2}").
+                arg(stats.frameCount).
+                arg(stats.queueMax).
+                arg(stats.packetMax));
+            TLRENDER_ASSERT(frames == stats.frameCount);
+            TLRENDER_ASSERT(0 == stats.queueCount);
+            TLRENDER_ASSERT(1 == stats.queueMax);
+            TLRENDER_ASSERT(stats.blockedTime >= 0.0);
+            TLRENDER_ASSERT(stats.convertTime > 0.0);
+            TLRENDER_ASSERT(stats.encodeTime > 0.0);
+        }
+
+        void FFmpegTest::_concat()
+        {
+            // Concatenate two short movies and check the frame count and
+            // duration of the result.
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ffmpeg::Plugin>();
+            const auto imageInfo = plugin->getWriteInfo(image::Info(
+                image::Size(160, 90),
+                image::PixelType::RGB_U8));
+            auto image = image::Image::create(imageInfo);
+            image->zero();
+            const std::vector<std::pair<std::string, otime::RationalTime> > inputs =
+            {
+                { "FFmpegTest_concat0.mp4", otime::RationalTime(12.0, 24.0) },
+                { "FFmpegTest_concat1.mp4", otime::RationalTime(6.0, 24.0) }
+            };
+            std::vector<std::string> fileNames;
+            for (const auto& input : inputs)
+            {
+                write(plugin, image, file::Path(input.first), imageInfo, {}, input.second, {});
+                fileNames.push_back(input.first);
+            }
+            const std::string output = "FFmpegTest_concat.mp4";
+            bool error = false;
+            try
+            {
+                ffmpeg::concat(fileNames, output);
+                auto read = plugin->read(file::Path(output));
+                const auto ioInfo = read->getInfo().get();
+                TLRENDER_ASSERT(!ioInfo.video.empty());
+                _print(string::Format("Concatenated: {0}").arg(ioInfo.videoTime));
+                TLRENDER_ASSERT(otime::RationalTime(18.0, 24.0) == ioInfo.videoTime.duration());
+                size_t frameCount = 0;
+                for (size_t i = 0; i < 18; ++i)
+                {
+                    const auto videoData = read->readVideo(
+                        ioInfo.videoTime.start_time() + otime::RationalTime(i, 24.0)).get();
+                    if (videoData.image)
+                    {
+                        TLRENDER_ASSERT(videoData.image->getSize() == image->getSize());
+                        ++frameCount;
+                    }
+                }
+                TLRENDER_ASSERT(18 == frameCount);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+                error = true;
+            }
+            for (const auto& fileName : fileNames)
+            {
+                file::rm(fileName);
+            }
+            file::rm(output);
+            TLRENDER_ASSERT(!error);
+        }
     }
 }
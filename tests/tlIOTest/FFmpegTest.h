@@ -24,6 +24,8 @@ namespace tl
             void _enums();
             void _util();
             void _io();
+            void _writeStats();
+            void _concat();
         };
     }
 }
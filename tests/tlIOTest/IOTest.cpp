@@ -30,6 +30,7 @@ namespace tl
         void IOTest::run()
         {
             _videoData();
+            _infoCache();
             _ioSystem();
         }
 
@@ -62,6 +63,64 @@ namespace tl
             }
         }
 
+        void IOTest::_infoCache()
+        {
+            Info info;
+            info.video.push_back(image::Info(1920, 1080, image::PixelType::RGBA_F16));
+            info.video[0].name = "Video";
+            info.video[0].size.pixelAspectRatio = 2.F;
+            info.video[0].layout.mirror.y = true;
+            info.videoTime = otime::TimeRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(24.0, 24.0));
+            info.audio = audio::Info(2, audio::DataType::F32, 48000);
+            info.audio.audioInfo.push_back(std::make_shared<audio::Info>(
+                1, audio::DataType::S16, 44100));
+            info.audioTime = otime::TimeRange(
+                otime::RationalTime(0.0, 48000.0),
+                otime::RationalTime(48000.0, 48000.0));
+            info.tags["Key"] = "Value";
+            {
+                nlohmann::json json;
+                to_json(json, info);
+                Info info2;
+                from_json(json, info2);
+                TLRENDER_ASSERT(info == info2);
+                TLRENDER_ASSERT(info.video[0].size.pixelAspectRatio ==
+                    info2.video[0].size.pixelAspectRatio);
+                TLRENDER_ASSERT(1 == info2.audio.audioInfo.size());
+            }
+            {
+                const file::Path path("IOTest.0.dpx");
+                const std::string key = getInfoCacheKey(path, Options());
+                TLRENDER_ASSERT(key == getInfoCacheKey(path, Options()));
+                TLRENDER_ASSERT(key != getInfoCacheKey(path, { { "Key", "Value" } }));
+
+                auto cache = Cache::create();
+                TLRENDER_ASSERT(!cache->containsInfo(key));
+                cache->addInfo(key, info);
+                TLRENDER_ASSERT(cache->containsInfo(key));
+                Info info2;
+                TLRENDER_ASSERT(cache->getInfo(key, info2));
+                TLRENDER_ASSERT(info == info2);
+
+                const std::string fileName = "IOTest_infoCache.json";
+                cache->writeInfo(fileName);
+                auto cache2 = Cache::create();
+                cache2->readInfo(fileName);
+                Info info3;
+                TLRENDER_ASSERT(cache2->getInfo(key, info3));
+                TLRENDER_ASSERT(info == info3);
+
+                cache2->setInfoMax(1);
+                TLRENDER_ASSERT(1 == cache2->getInfoMax());
+                cache2->addInfo("key2", Info());
+                TLRENDER_ASSERT(!cache2->containsInfo(key));
+                cache2->clear();
+                TLRENDER_ASSERT(!cache2->containsInfo("key2"));
+            }
+        }
+
         namespace
         {
             class DummyPlugin : public IPlugin
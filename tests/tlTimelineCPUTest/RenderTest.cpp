@@ -0,0 +1,614 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPUTest/RenderTest.h>
+
+#include <tlTimelineCPU/Render.h>
+
+#if defined(TLRENDER_GLFW)
+#include <tlTimelineGL/Render.h>
+
+#include <tlGL/GL.h>
+#include <tlGL/GLFWWindow.h>
+#include <tlGL/OffscreenBuffer.h>
+#endif // TLRENDER_GLFW
+
+#include <tlCore/Assert.h>
+#include <tlCore/LogSystem.h>
+#include <tlCore/Mesh.h>
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace tl::timeline_cpu;
+
+namespace tl
+{
+    namespace timeline_cpu_tests
+    {
+        RenderTest::RenderTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_cpu_tests::RenderTest", context)
+        {}
+
+        std::shared_ptr<RenderTest> RenderTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<RenderTest>(new RenderTest(context));
+        }
+
+        void RenderTest::run()
+        {
+            _image();
+            _read();
+            _rect();
+            _yuv();
+            _video();
+            _compare();
+            _threads();
+            _unsupported();
+            _gl();
+        }
+
+        namespace
+        {
+            const image::Color4f red(1.F, 0.F, 0.F);
+            const image::Color4f green(0.F, 1.F, 0.F);
+            const image::Color4f blue(0.F, 0.F, 1.F);
+
+            void setPixel(
+                const std::shared_ptr<image::Image>& image,
+                int x,
+                int y,
+                const image::Color4f& color)
+            {
+                uint8_t* p = image->getData() + (y * image->getWidth() + x) * 4;
+                p[0] = static_cast<uint8_t>(color.r * 255.F);
+                p[1] = static_cast<uint8_t>(color.g * 255.F);
+                p[2] = static_cast<uint8_t>(color.b * 255.F);
+                p[3] = static_cast<uint8_t>(color.a * 255.F);
+            }
+
+            std::shared_ptr<image::Image> createImage(
+                int w,
+                int h,
+                const image::Color4f& color,
+                const image::Mirror& mirror = image::Mirror())
+            {
+                image::Info info(w, h, image::PixelType::RGBA_U8);
+                info.layout.mirror = mirror;
+                auto out = image::Image::create(info);
+                for (int y = 0; y < h; ++y)
+                {
+                    for (int x = 0; x < w; ++x)
+                    {
+                        setPixel(out, x, y, color);
+                    }
+                }
+                return out;
+            }
+
+            image::Color4f getPixel(
+                const std::shared_ptr<image::Image>& image,
+                int x,
+                int y)
+            {
+                const float* p = reinterpret_cast<const float*>(image->getData()) +
+                    (y * image->getWidth() + x) * 4;
+                return image::Color4f(p[0], p[1], p[2], p[3]);
+            }
+
+            bool compare(const image::Color4f& a, const image::Color4f& b)
+            {
+                const float e = .01F;
+                return
+                    std::fabs(a.r - b.r) < e &&
+                    std::fabs(a.g - b.g) < e &&
+                    std::fabs(a.b - b.b) < e &&
+                    std::fabs(a.a - b.a) < e;
+            }
+
+            timeline::ImageOptions getNearest()
+            {
+                timeline::ImageOptions out;
+                out.imageFilters.minify = timeline::ImageFilter::Nearest;
+                out.imageFilters.magnify = timeline::ImageFilter::Nearest;
+                out.alphaBlend = timeline::AlphaBlend::None;
+                out.cache = false;
+                return out;
+            }
+
+            timeline::VideoData getVideoData(
+                const std::shared_ptr<image::Image>& image,
+                const std::shared_ptr<image::Image>& imageB = nullptr,
+                float transitionValue = 0.F)
+            {
+                timeline::VideoData out;
+                out.size = image->getSize();
+                timeline::VideoLayer layer;
+                layer.image = image;
+                layer.imageOptions = getNearest();
+                if (imageB)
+                {
+                    layer.imageB = imageB;
+                    layer.imageOptionsB = getNearest();
+                    layer.transition = timeline::Transition::Dissolve;
+                    layer.transitionValue = transitionValue;
+                }
+                out.layers.push_back(layer);
+                return out;
+            }
+        }
+
+        void RenderTest::_image()
+        {
+            auto render = Render::create(_context);
+            {
+                // Images with mirroring store the top row first.
+                auto image = createImage(2, 2, red, image::Mirror(false, true));
+                setPixel(image, 0, 1, green);
+                setPixel(image, 1, 1, green);
+                render->begin(math::Size2i(2, 2));
+                render->drawImage(
+                    image,
+                    math::Box2i(0, 0, 2, 2),
+                    image::Color4f(1.F, 1.F, 1.F),
+                    getNearest());
+                render->end();
+                TLRENDER_ASSERT(compare(red, getPixel(render->getImage(), 0, 0)));
+                TLRENDER_ASSERT(compare(green, getPixel(render->getImage(), 1, 1)));
+
+                // Scale the image.
+                render->begin(math::Size2i(4, 4));
+                render->drawImage(
+                    image,
+                    math::Box2i(0, 0, 4, 4),
+                    image::Color4f(1.F, 1.F, 1.F),
+                    getNearest());
+                render->end();
+                TLRENDER_ASSERT(compare(red, getPixel(render->getImage(), 1, 1)));
+                TLRENDER_ASSERT(compare(green, getPixel(render->getImage(), 2, 2)));
+            }
+            {
+                // Images without mirroring store the bottom row first.
+                auto image = createImage(2, 2, red, image::Mirror(true, false));
+                setPixel(image, 0, 1, green);
+                setPixel(image, 1, 0, blue);
+                render->begin(math::Size2i(2, 2));
+                render->drawImage(
+                    image,
+                    math::Box2i(0, 0, 2, 2),
+                    image::Color4f(1.F, 1.F, 1.F),
+                    getNearest());
+                render->end();
+                TLRENDER_ASSERT(compare(red, getPixel(render->getImage(), 0, 0)));
+                TLRENDER_ASSERT(compare(green, getPixel(render->getImage(), 1, 0)));
+                TLRENDER_ASSERT(compare(blue, getPixel(render->getImage(), 0, 1)));
+            }
+            {
+                // Blend with straight alpha.
+                auto image = createImage(1, 1, image::Color4f(1.F, 1.F, 1.F, .5F));
+                timeline::RenderOptions renderOptions;
+                renderOptions.clearColor = image::Color4f(0.F, 0.F, 0.F, 1.F);
+                render->begin(math::Size2i(1, 1), renderOptions);
+                auto imageOptions = getNearest();
+                imageOptions.alphaBlend = timeline::AlphaBlend::Straight;
+                render->drawImage(
+                    image,
+                    math::Box2i(0, 0, 1, 1),
+                    image::Color4f(1.F, 1.F, 1.F),
+                    imageOptions);
+                render->end();
+                TLRENDER_ASSERT(compare(
+                    image::Color4f(.5F, .5F, .5F, 1.F),
+                    getPixel(render->getImage(), 0, 0)));
+            }
+        }
+
+        void RenderTest::_read()
+        {
+            auto render = Render::create(_context);
+            render->begin(math::Size2i(2, 2));
+            render->drawRect(math::Box2i(0, 0, 2, 1), red);
+            render->drawRect(math::Box2i(0, 1, 2, 1), green);
+            render->end();
+            {
+                // The rows are read bottom to top.
+                auto image = image::Image::create(2, 2, image::PixelType::RGBA_U8);
+                render->read(image);
+                const uint8_t* p = image->getData();
+                TLRENDER_ASSERT(0 == p[0] && 255 == p[1] && 0 == p[2] && 255 == p[3]);
+                p += 2 * 4;
+                TLRENDER_ASSERT(255 == p[0] && 0 == p[1] && 0 == p[2] && 255 == p[3]);
+            }
+            {
+                image::Info info(2, 2, image::PixelType::RGB_U16);
+                info.layout.alignment = 4;
+                auto image = image::Image::create(info);
+                render->read(image);
+                const uint16_t* p = reinterpret_cast<const uint16_t*>(image->getData());
+                TLRENDER_ASSERT(0 == p[0] && 65535 == p[1] && 0 == p[2]);
+            }
+            {
+                auto image = image::Image::create(2, 2, image::PixelType::RGB_U10);
+                render->read(image);
+                const uint32_t* p = reinterpret_cast<const uint32_t*>(image->getData());
+                TLRENDER_ASSERT((1023 << 12) == p[0]);
+            }
+            try
+            {
+                auto image = image::Image::create(1, 1, image::PixelType::RGBA_U8);
+                render->read(image);
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+            try
+            {
+                auto image = image::Image::create(2, 2, image::PixelType::YUV_420P_U8);
+                render->read(image);
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
+        }
+
+        void RenderTest::_rect()
+        {
+            auto render = Render::create(_context);
+            render->begin(math::Size2i(4, 4));
+            render->setClipRectEnabled(true);
+            render->setClipRect(math::Box2i(0, 0, 2, 2));
+            render->drawRect(
+                math::Box2i(0, 0, 4, 4),
+                image::Color4f(1.F, 1.F, 1.F, .5F));
+            render->setClipRectEnabled(false);
+            render->end();
+            TLRENDER_ASSERT(compare(
+                image::Color4f(.5F, .5F, .5F, .25F),
+                getPixel(render->getImage(), 1, 1)));
+            TLRENDER_ASSERT(compare(
+                image::Color4f(0.F, 0.F, 0.F, 0.F),
+                getPixel(render->getImage(), 2, 2)));
+
+            // The triangles of a mesh do not overlap.
+            render->begin(math::Size2i(4, 4));
+            render->drawMesh(
+                geom::box(math::Box2i(0, 0, 4, 4)),
+                math::Vector2i(),
+                image::Color4f(1.F, 1.F, 1.F, .5F));
+            render->end();
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    TLRENDER_ASSERT(compare(
+                        image::Color4f(.5F, .5F, .5F, .25F),
+                        getPixel(render->getImage(), x, y)));
+                }
+            }
+        }
+
+        void RenderTest::_yuv()
+        {
+            auto render = Render::create(_context);
+            for (auto videoLevels : { image::VideoLevels::FullRange, image::VideoLevels::LegalRange })
+            {
+                image::Info info(2, 2, image::PixelType::YUV_420P_U8);
+                info.videoLevels = videoLevels;
+                auto image = image::Image::create(info);
+                uint8_t* p = image->getData();
+                const uint8_t white = image::VideoLevels::FullRange == videoLevels ? 255 : 235;
+                memset(p, white, 4);
+                memset(p + 4, 128, 2);
+                render->begin(math::Size2i(2, 2));
+                render->drawImage(
+                    image,
+                    math::Box2i(0, 0, 2, 2),
+                    image::Color4f(1.F, 1.F, 1.F),
+                    getNearest());
+                render->end();
+                TLRENDER_ASSERT(compare(
+                    image::Color4f(1.F, 1.F, 1.F),
+                    getPixel(render->getImage(), 1, 1)));
+            }
+        }
+
+        void RenderTest::_video()
+        {
+            auto render = Render::create(_context);
+            const math::Box2i box(0, 0, 4, 4);
+            {
+                render->begin(box.getSize());
+                render->drawVideo(
+                    { getVideoData(createImage(4, 4, red)) },
+                    { box });
+                render->end();
+                TLRENDER_ASSERT(compare(red, getPixel(render->getImage(), 3, 3)));
+            }
+            {
+                // The dissolve matches the blending of the OpenGL renderer.
+                render->begin(box.getSize());
+                render->drawVideo(
+                    { getVideoData(createImage(4, 4, red), createImage(4, 4, blue), .5F) },
+                    { box });
+                render->end();
+                TLRENDER_ASSERT(compare(
+                    image::Color4f(.25F, 0.F, .5F, 1.F),
+                    getPixel(render->getImage(), 0, 0)));
+            }
+            {
+                timeline::DisplayOptions displayOptions;
+                displayOptions.channels = timeline::Channels::Red;
+                displayOptions.color.enabled = true;
+                displayOptions.color.invert = true;
+                render->begin(box.getSize());
+                render->drawVideo(
+                    { getVideoData(createImage(4, 4, green)) },
+                    { box },
+                    {},
+                    { displayOptions });
+                render->end();
+                TLRENDER_ASSERT(compare(
+                    image::Color4f(1.F, 1.F, 1.F),
+                    getPixel(render->getImage(), 0, 0)));
+            }
+            {
+                timeline::BackgroundOptions backgroundOptions;
+                backgroundOptions.type = timeline::Background::Solid;
+                backgroundOptions.color0 = green;
+                render->begin(box.getSize());
+                render->drawVideo(
+                    { getVideoData(createImage(4, 4, image::Color4f(0.F, 0.F, 0.F, 0.F))) },
+                    { box },
+                    {},
+                    {},
+                    timeline::CompareOptions(),
+                    backgroundOptions);
+                render->end();
+                TLRENDER_ASSERT(compare(green, getPixel(render->getImage(), 0, 0)));
+            }
+        }
+
+        void RenderTest::_compare()
+        {
+            auto render = Render::create(_context);
+            const std::vector<timeline::VideoData> videoData =
+            {
+                getVideoData(createImage(4, 4, red)),
+                getVideoData(createImage(4, 4, blue))
+            };
+            {
+                timeline::CompareOptions compareOptions;
+                compareOptions.mode = timeline::CompareMode::B;
+                render->begin(math::Size2i(4, 4));
+                render->drawVideo(
+                    videoData,
+                    { math::Box2i(0, 0, 4, 4), math::Box2i(0, 0, 4, 4) },
+                    {},
+                    {},
+                    compareOptions);
+                render->end();
+                TLRENDER_ASSERT(compare(blue, getPixel(render->getImage(), 0, 0)));
+            }
+            {
+                timeline::CompareOptions compareOptions;
+                compareOptions.mode = timeline::CompareMode::Horizontal;
+                render->begin(math::Size2i(8, 4));
+                render->drawVideo(
+                    videoData,
+                    { math::Box2i(0, 0, 4, 4), math::Box2i(4, 0, 4, 4) },
+                    {},
+                    {},
+                    compareOptions);
+                render->end();
+                TLRENDER_ASSERT(compare(red, getPixel(render->getImage(), 3, 0)));
+                TLRENDER_ASSERT(compare(blue, getPixel(render->getImage(), 4, 0)));
+            }
+            {
+                timeline::CompareOptions compareOptions;
+                compareOptions.mode = timeline::CompareMode::Wipe;
+                compareOptions.wipeCenter = math::Vector2f(.5F, .5F);
+                compareOptions.wipeRotation = 0.F;
+                render->begin(math::Size2i(4, 4));
+                render->drawVideo(
+                    videoData,
+                    { math::Box2i(0, 0, 4, 4), math::Box2i(0, 0, 4, 4) },
+                    {},
+                    {},
+                    compareOptions);
+                render->end();
+                TLRENDER_ASSERT(compare(red, getPixel(render->getImage(), 0, 0)));
+                TLRENDER_ASSERT(compare(blue, getPixel(render->getImage(), 3, 3)));
+            }
+            {
+                timeline::CompareOptions compareOptions;
+                compareOptions.mode = timeline::CompareMode::Difference;
+                render->begin(math::Size2i(4, 4));
+                render->drawVideo(
+                    videoData,
+                    { math::Box2i(0, 0, 4, 4), math::Box2i(0, 0, 4, 4) },
+                    {},
+                    {},
+                    compareOptions);
+                render->end();
+                TLRENDER_ASSERT(compare(
+                    image::Color4f(1.F, 0.F, 1.F),
+                    getPixel(render->getImage(), 0, 0)));
+            }
+            {
+                timeline::CompareOptions compareOptions;
+                compareOptions.mode = timeline::CompareMode::Overlay;
+                compareOptions.overlay = .5F;
+                render->begin(math::Size2i(4, 4));
+                render->drawVideo(
+                    videoData,
+                    { math::Box2i(0, 0, 4, 4), math::Box2i(0, 0, 4, 4) },
+                    {},
+                    {},
+                    compareOptions);
+                render->end();
+                const image::Color4f c = getPixel(render->getImage(), 0, 0);
+                TLRENDER_ASSERT(compare(image::Color4f(.5F, 0.F, .5F), image::Color4f(c.r, c.g, c.b)));
+            }
+        }
+
+        void RenderTest::_threads()
+        {
+            // The result does not depend on the number of threads.
+            auto image = image::Image::create(257, 131, image::PixelType::RGBA_F32);
+            float* p = reinterpret_cast<float*>(image->getData());
+            for (int y = 0; y < image->getHeight(); ++y)
+            {
+                for (int x = 0; x < image->getWidth(); ++x, p += 4)
+                {
+                    p[0] = x / 256.F;
+                    p[1] = y / 130.F;
+                    p[2] = (x + y) % 7 / 6.F;
+                    p[3] = 1.F;
+                }
+            }
+            std::vector<std::shared_ptr<image::Image> > images;
+            for (size_t threadCount : { 1, 8 })
+            {
+                auto render = Render::create(_context, threadCount);
+                TLRENDER_ASSERT(threadCount == render->getThreadCount());
+                render->begin(math::Size2i(300, 200));
+                render->drawImage(image, math::Box2i(10, 20, 280, 170));
+                render->end();
+                auto out = image::Image::create(300, 200, image::PixelType::RGBA_F32);
+                render->read(out);
+                images.push_back(out);
+            }
+            TLRENDER_ASSERT(0 == memcmp(
+                images[0]->getData(),
+                images[1]->getData(),
+                images[0]->getDataByteCount()));
+        }
+
+        void RenderTest::_unsupported()
+        {
+            // Unsupported options and calls log a warning once.
+            auto logSystem = _context->getSystem<log::System>();
+            std::vector<log::Item> warnings;
+            auto logObserver = observer::ListObserver<log::Item>::create(
+                logSystem->observeLog(),
+                [&warnings](const std::vector<log::Item>& value)
+                {
+                    for (const auto& i : value)
+                    {
+                        if (log::Type::Warning == i.type &&
+                            i.prefix.find("tl::timeline::CPURender") == 0)
+                        {
+                            warnings.push_back(i);
+                        }
+                    }
+                },
+                observer::CallbackAction::Suppress);
+
+            auto render = Render::create(_context);
+            timeline::HDROptions hdrOptions;
+            hdrOptions.tonemap = true;
+            render->begin(math::Size2i(4, 4));
+            render->setHDROptions(hdrOptions);
+            render->setHDROptions(hdrOptions);
+            render->drawTexture(0, math::Box2i(0, 0, 4, 4));
+            render->drawTexture(0, math::Box2i(0, 0, 4, 4));
+            render->end();
+            logSystem->tick();
+            for (const auto& i : warnings)
+            {
+                _print(i.message);
+            }
+            TLRENDER_ASSERT(2 == warnings.size());
+        }
+
+        void RenderTest::_gl()
+        {
+#if defined(TLRENDER_GLFW)
+            // The same scene rendered with the OpenGL renderer matches within
+            // a tolerance. The test is skipped when an OpenGL context cannot
+            // be created.
+            std::shared_ptr<gl::GLFWWindow> window;
+            try
+            {
+                window = gl::GLFWWindow::create(
+                    "RenderTest",
+                    math::Size2i(1, 1),
+                    _context,
+                    static_cast<int>(gl::GLFWWindowOptions::MakeCurrent));
+            }
+            catch (const std::exception& e)
+            {
+                _print(string::Format("Skipping the OpenGL comparison: {0}").arg(e.what()));
+                return;
+            }
+
+            const math::Size2i size(64, 48);
+            auto image = image::Image::create(size.w, size.h, image::PixelType::RGBA_U8);
+            uint8_t* p = image->getData();
+            for (int y = 0; y < size.h; ++y)
+            {
+                for (int x = 0; x < size.w; ++x, p += 4)
+                {
+                    p[0] = x * 4;
+                    p[1] = y * 5;
+                    p[2] = (x + y) % 7 * 40;
+                    p[3] = 255;
+                }
+            }
+            const auto videoData = getVideoData(image, createImage(size.w, size.h, blue), .25F);
+            const math::Box2i box(0, 0, size.w, size.h);
+            auto draw = [&](timeline::IRender& render)
+                {
+                    render.begin(size);
+                    render.drawVideo({ videoData }, { box });
+                    render.drawRect(
+                        math::Box2i(8, 8, 24, 16),
+                        image::Color4f(1.F, 0.F, 0.F, .5F));
+                    render.drawMesh(
+                        geom::box(math::Box2i(32, 20, 24, 20)),
+                        math::Vector2i(),
+                        image::Color4f(0.F, 1.F, 0.F, .75F));
+                    render.end();
+                };
+
+            auto cpuRender = Render::create(_context);
+            draw(*cpuRender);
+            auto cpuImage = image::Image::create(size.w, size.h, image::PixelType::RGBA_U8);
+            cpuRender->read(cpuImage);
+
+            auto glRender = timeline_gl::Render::create(_context);
+            gl::OffscreenBufferOptions options;
+            options.colorType = image::PixelType::RGBA_U8;
+            auto buffer = gl::OffscreenBuffer::create(size, options);
+            auto glImage = image::Image::create(size.w, size.h, image::PixelType::RGBA_U8);
+            {
+                gl::OffscreenBufferBinding binding(buffer);
+                draw(*glRender);
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                glReadPixels(
+                    0,
+                    0,
+                    size.w,
+                    size.h,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    glImage->getData());
+            }
+
+            // Both images are read bottom to top.
+            int diffMax = 0;
+            const uint8_t* a = cpuImage->getData();
+            const uint8_t* b = glImage->getData();
+            for (size_t i = 0; i < cpuImage->getDataByteCount(); ++i)
+            {
+                diffMax = std::max(diffMax, std::abs(a[i] - b[i]));
+            }
+            _print(string::Format("OpenGL comparison maximum difference: {0}").arg(diffMax));
+            TLRENDER_ASSERT(diffMax <= 2);
+#endif // TLRENDER_GLFW
+        }
+    }
+}
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_cpu_tests
+    {
+        class RenderTest : public tests::ITest
+        {
+        protected:
+            RenderTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<RenderTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _image();
+            void _read();
+            void _rect();
+            void _yuv();
+            void _video();
+            void _compare();
+            void _threads();
+            void _unsupported();
+            void _gl();
+        };
+    }
+}
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineGLTest/OCIOCacheTest.h>
+
+#include <tlTimelineGL/OCIOCache.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/Path.h>
+
+#if defined(TLRENDER_OCIO)
+#include <OpenColorIO/OpenColorIO.h>
+#endif // TLRENDER_OCIO
+
+using namespace tl::timeline_gl;
+
+namespace tl
+{
+    namespace timeline_gl_tests
+    {
+        OCIOCacheTest::OCIOCacheTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_gl_tests::OCIOCacheTest", context)
+        {}
+
+        std::shared_ptr<OCIOCacheTest> OCIOCacheTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<OCIOCacheTest>(new OCIOCacheTest(context));
+        }
+
+        void OCIOCacheTest::run()
+        {
+            {
+                OCIOCacheStats stats;
+                TLRENDER_ASSERT(stats == stats);
+                TLRENDER_ASSERT(stats != OCIOCacheStats({ 1, 0, 0 }));
+            }
+            {
+                auto cache = OCIOCache::create(2);
+                TLRENDER_ASSERT(2 == cache->getMax());
+                cache->setMax(4);
+                TLRENDER_ASSERT(4 == cache->getMax());
+                TLRENDER_ASSERT(OCIOCacheStats() == cache->getStats());
+            }
+            _ocio();
+            _lut();
+        }
+
+        void OCIOCacheTest::_ocio()
+        {
+#if defined(TLRENDER_OCIO)
+            try
+            {
+                // Use the built-in configuration and the first two views of
+                // the default display.
+                timeline::OCIOOptions a;
+                a.enabled = true;
+                a.fileName = "ocio://default";
+                auto config = OCIO_NAMESPACE::Config::CreateFromFile(a.fileName.c_str());
+                a.display = config->getDefaultDisplay();
+                a.view = config->getView(a.display.c_str(), 0);
+                timeline::OCIOOptions b = a;
+                if (config->getNumViews(a.display.c_str()) > 1)
+                {
+                    b.view = config->getView(a.display.c_str(), 1);
+                }
+                else
+                {
+                    b.view.clear();
+                }
+
+                auto cache = OCIOCache::create();
+                auto dataA = cache->getOCIOData(a);
+                TLRENDER_ASSERT(dataA);
+                TLRENDER_ASSERT(OCIOCacheStats({ 0, 1, 1 }) == cache->getStats());
+                auto dataB = cache->getOCIOData(b);
+                TLRENDER_ASSERT(dataB);
+                TLRENDER_ASSERT(dataA != dataB);
+                TLRENDER_ASSERT(OCIOCacheStats({ 0, 2, 2 }) == cache->getStats());
+
+                // Switching back to a recent view uses the cache.
+                TLRENDER_ASSERT(cache->getOCIOData(a) == dataA);
+                TLRENDER_ASSERT(OCIOCacheStats({ 1, 2, 2 }) == cache->getStats());
+
+                // Peeking does not mark the data as recently used.
+                TLRENDER_ASSERT(cache->peekOCIOData(b) == dataB);
+                TLRENDER_ASSERT(OCIOCacheStats({ 1, 2, 2 }) == cache->getStats());
+
+                // The least recently used data is removed.
+                cache->setMax(1);
+                TLRENDER_ASSERT(OCIOCacheStats({ 1, 2, 1 }) == cache->getStats());
+                TLRENDER_ASSERT(cache->getOCIOData(a) == dataA);
+                TLRENDER_ASSERT(cache->getOCIOData(b) != dataB);
+
+                cache->clear();
+                TLRENDER_ASSERT(0 == cache->getStats().count);
+
+                // Peeking does not add new data.
+                TLRENDER_ASSERT(cache->peekOCIOData(a));
+                TLRENDER_ASSERT(0 == cache->getStats().count);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+#else // TLRENDER_OCIO
+            auto cache = OCIOCache::create();
+            TLRENDER_ASSERT(!cache->getOCIOData(timeline::OCIOOptions()));
+            TLRENDER_ASSERT(!cache->peekOCIOData(timeline::OCIOOptions()));
+            TLRENDER_ASSERT(OCIOCacheStats() == cache->getStats());
+#endif // TLRENDER_OCIO
+        }
+
+        void OCIOCacheTest::_lut()
+        {
+#if defined(TLRENDER_OCIO)
+            try
+            {
+                timeline::LUTOptions options;
+                options.enabled = true;
+                options.fileName = file::Path(file::createTempDir(), "OCIOCacheTest.cube").get();
+                file::writeLines(
+                    options.fileName,
+                    {
+                        "LUT_3D_SIZE 2",
+                        "0 0 0",
+                        "1 0 0",
+                        "0 1 0",
+                        "1 1 0",
+                        "0 0 1",
+                        "1 0 1",
+                        "0 1 1",
+                        "1 1 1"
+                    });
+
+                auto cache = OCIOCache::create();
+                auto data = cache->getLUTData(options);
+                TLRENDER_ASSERT(data);
+                TLRENDER_ASSERT(cache->getLUTData(options) == data);
+                TLRENDER_ASSERT(OCIOCacheStats({ 1, 1, 1 }) == cache->getStats());
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+#endif // TLRENDER_OCIO
+        }
+    }
+}
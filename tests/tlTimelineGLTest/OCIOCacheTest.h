@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_gl_tests
+    {
+        class OCIOCacheTest : public tests::ITest
+        {
+        protected:
+            OCIOCacheTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<OCIOCacheTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _ocio();
+            void _lut();
+        };
+    }
+}
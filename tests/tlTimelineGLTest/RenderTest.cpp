@@ -0,0 +1,374 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineGLTest/RenderTest.h>
+
+#include <tlTimelineGL/Render.h>
+
+#include <tlGL/GL.h>
+#include <tlGL/GLFWWindow.h>
+#include <tlGL/OffscreenBuffer.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/Path.h>
+#include <tlCore/FontSystem.h>
+#include <tlCore/Mesh.h>
+#include <tlCore/StringFormat.h>
+
+#include <chrono>
+#include <cstdlib>
+
+using namespace tl::timeline_gl;
+
+namespace tl
+{
+    namespace timeline_gl_tests
+    {
+        RenderTest::RenderTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_gl_tests::RenderTest", context)
+        {}
+
+        std::shared_ptr<RenderTest> RenderTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<RenderTest>(new RenderTest(context));
+        }
+
+        void RenderTest::run()
+        {
+            _enums();
+            std::shared_ptr<gl::GLFWWindow> window;
+            try
+            {
+                window = gl::GLFWWindow::create(
+                    "RenderTest",
+                    math::Size2i(1, 1),
+                    _context,
+                    static_cast<int>(gl::GLFWWindowOptions::MakeCurrent));
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            if (window)
+            {
+                _batch();
+                _timing();
+                _benchmark();
+            }
+        }
+
+        void RenderTest::_enums()
+        {
+            _enum<RenderStage>("RenderStage", getRenderStageEnums);
+            {
+                RenderTiming timing;
+                timing.frame = 1;
+                timing.start = 2.0;
+                timing.cpu = 3.0;
+                timing.stages[RenderStage::Upload].count = 1;
+                timing.stages[RenderStage::Upload].cpu = 1.0;
+                timing.stages[RenderStage::Display].count = 2;
+                timing.stages[RenderStage::Display].cpu = 1.5;
+                timing.stages[RenderStage::Display].gpu = .5;
+                nlohmann::json json;
+                to_json(json, timing);
+                RenderTiming timing2;
+                from_json(json, timing2);
+                TLRENDER_ASSERT(timing == timing2);
+                timing2.stages.clear();
+                TLRENDER_ASSERT(timing != timing2);
+            }
+        }
+
+        namespace
+        {
+            std::vector<uint8_t> readPixels(const math::Size2i& size)
+            {
+                std::vector<uint8_t> out(size.w * size.h * 4);
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                glReadPixels(
+                    0,
+                    0,
+                    size.w,
+                    size.h,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    out.data());
+                return out;
+            }
+        }
+
+        void RenderTest::_batch()
+        {
+            // Draw the same primitives with and without batching and
+            // compare the results.
+            auto render = Render::create(_context);
+            const math::Size2i size(200, 100);
+            gl::OffscreenBufferOptions options;
+            options.colorType = image::PixelType::RGBA_U8;
+            auto buffer = gl::OffscreenBuffer::create(size, options);
+            auto fontSystem = _context->getSystem<image::FontSystem>();
+            const auto glyphs = fontSystem->getGlyphs("Batch 123", image::FontInfo());
+            const auto fontMetrics = fontSystem->getMetrics(image::FontInfo());
+            std::vector<uint8_t> pixels[2];
+            size_t drawCalls[2] = { 0, 0 };
+            for (bool batch : { false, true })
+            {
+                timeline::RenderOptions renderOptions;
+                renderOptions.batchPrimitives = batch;
+                gl::OffscreenBufferBinding binding(buffer);
+                render->begin(size, renderOptions);
+                render->drawRect(
+                    math::Box2i(0, 0, size.w, size.h),
+                    image::Color4f(.2F, .2F, .2F));
+                render->setClipRectEnabled(true);
+                for (int i = 0; i < 4; ++i)
+                {
+                    const math::Box2i box(i * 50, 0, 50, 50);
+                    render->setClipRect(box);
+                    render->drawRect(
+                        math::Box2i(box.min.x - 10, 10, 40, 20),
+                        image::Color4f(1.F, 0.F, 0.F));
+                    render->drawMesh(
+                        geom::box(math::Box2i(0, 0, 10, 10)),
+                        math::Vector2i(box.min.x + 35, 35),
+                        image::Color4f(0.F, 1.F, 0.F, .5F));
+                }
+                render->setClipRect(math::Box2i(0, 50, size.w, 50));
+                render->drawColorMesh(
+                    geom::checkers(
+                        math::Box2i(0, 40, size.w, 20),
+                        image::Color4f(0.F, 0.F, 1.F),
+                        image::Color4f(1.F, 1.F, 0.F),
+                        math::Size2i(10, 10)),
+                    math::Vector2i(),
+                    image::Color4f(1.F, 1.F, 1.F));
+                render->setClipRectEnabled(false);
+                render->drawText(
+                    glyphs,
+                    math::Vector2i(10, 60 + fontMetrics.ascender),
+                    image::Color4f(1.F, 1.F, 1.F));
+                render->end();
+                pixels[batch] = readPixels(size);
+                drawCalls[batch] = render->getDrawCallCount();
+            }
+            _print(string::Format("Draw calls: {0} unbatched, {1} batched").
+                arg(drawCalls[0]).
+                arg(drawCalls[1]));
+            TLRENDER_ASSERT(drawCalls[1] < drawCalls[0]);
+            TLRENDER_ASSERT(pixels[0].size() == pixels[1].size());
+            for (size_t i = 0; i < pixels[0].size(); ++i)
+            {
+                TLRENDER_ASSERT(std::abs(pixels[0][i] - pixels[1][i]) <= 1);
+            }
+
+            // The getters do not flush the batch, flush() does.
+            {
+                gl::OffscreenBufferBinding binding(buffer);
+                render->begin(size);
+                render->drawRect(math::Box2i(0, 0, 10, 10), image::Color4f(1.F, 0.F, 0.F));
+                render->getRenderSize();
+                render->getViewport();
+                render->getTransform();
+                render->drawRect(math::Box2i(10, 0, 10, 10), image::Color4f(0.F, 1.F, 0.F));
+                render->end();
+                const size_t drawCallCount = render->getDrawCallCount();
+                render->begin(size);
+                render->drawRect(math::Box2i(0, 0, 10, 10), image::Color4f(1.F, 0.F, 0.F));
+                render->flush();
+                render->drawRect(math::Box2i(10, 0, 10, 10), image::Color4f(0.F, 1.F, 0.F));
+                render->end();
+                TLRENDER_ASSERT(render->getDrawCallCount() == drawCallCount + 1);
+            }
+        }
+
+        void RenderTest::_timing()
+        {
+            // Render frames with timing enabled, with a readback stage after
+            // the end of each frame.
+            auto render = Render::create(_context);
+            TLRENDER_ASSERT(!render->isTimingEnabled());
+            const math::Size2i size(160, 90);
+            gl::OffscreenBufferOptions options;
+            options.colorType = image::PixelType::RGBA_U8;
+            auto buffer = gl::OffscreenBuffer::create(size, options);
+            auto image = image::Image::create(size.w, size.h, image::PixelType::RGBA_U8);
+            image->zero();
+            timeline::VideoData videoData;
+            videoData.size = image::Size(size.w, size.h);
+            timeline::VideoLayer layer;
+            layer.image = image;
+            videoData.layers.push_back(layer);
+            const std::vector<math::Box2i> boxes =
+            {
+                math::Box2i(0, 0, size.w / 2, size.h),
+                math::Box2i(size.w / 2, 0, size.w / 2, size.h)
+            };
+            timeline::ImageOptions imageOptions;
+            imageOptions.cache = false;
+            timeline::CompareOptions compareOptions;
+            compareOptions.mode = timeline::CompareMode::Difference;
+
+            render->setTimingEnabled(true);
+            TLRENDER_ASSERT(render->isTimingEnabled());
+            const size_t frames = 5;
+            {
+                gl::OffscreenBufferBinding binding(buffer);
+                for (size_t frame = 0; frame < frames; ++frame)
+                {
+                    render->begin(size);
+                    render->drawVideo(
+                        { videoData, videoData },
+                        boxes,
+                        { imageOptions, imageOptions },
+                        {},
+                        compareOptions);
+                    render->end();
+                    render->beginStage(RenderStage::Readback);
+                    readPixels(size);
+                    render->endStage();
+                }
+            }
+            TLRENDER_ASSERT(render->getTiming().size() < frames);
+            render->setTimingEnabled(false);
+            TLRENDER_ASSERT(!render->isTimingEnabled());
+
+            const auto timing = render->getTiming();
+            TLRENDER_ASSERT(frames == timing.size());
+            uint64_t frame = 0;
+            for (const auto& i : timing)
+            {
+                TLRENDER_ASSERT(frame == i.frame);
+                ++frame;
+                TLRENDER_ASSERT(i.cpu > 0.0);
+                double cpu = 0.0;
+                for (const auto& stage : i.stages)
+                {
+                    TLRENDER_ASSERT(stage.second.cpu >= 0.0);
+                    cpu += stage.second.cpu;
+                }
+                TLRENDER_ASSERT(cpu <= i.cpu + .001);
+                TLRENDER_ASSERT(2 == i.stages.at(RenderStage::Upload).count);
+                TLRENDER_ASSERT(2 == i.stages.at(RenderStage::Video).count);
+                TLRENDER_ASSERT(2 == i.stages.at(RenderStage::Display).count);
+                TLRENDER_ASSERT(1 == i.stages.at(RenderStage::Compare).count);
+                TLRENDER_ASSERT(1 == i.stages.at(RenderStage::Readback).count);
+            }
+            const auto& last = timing.back();
+            _print(string::Format("Frame {0}: CPU {1}ms, GPU {2}ms").
+                arg(last.frame).
+                arg(last.cpu).
+                arg(last.gpu));
+            for (const auto& stage : last.stages)
+            {
+                _print(string::Format("    {0}: CPU {1}ms, GPU {2}ms").
+                    arg(stage.first).
+                    arg(stage.second.cpu).
+                    arg(stage.second.gpu));
+            }
+
+            // Write a trace.
+            const std::string fileName = file::Path(file::createTempDir(), "RenderTest.json").get();
+            writeTrace(fileName, timing);
+            const auto json = nlohmann::json::parse(
+                file::readContents(file::FileIO::create(fileName, file::Mode::Read)));
+            TLRENDER_ASSERT(json.at("traceEvents").size() >= frames * 2);
+
+            // Timing that is not enabled is ignored.
+            {
+                gl::OffscreenBufferBinding binding(buffer);
+                render->begin(size);
+                render->beginStage(RenderStage::Readback);
+                render->endStage();
+                render->end();
+            }
+            TLRENDER_ASSERT(timing == render->getTiming());
+        }
+
+        void RenderTest::_benchmark()
+        {
+            // Draw a timeline with 1,000 clips the way the timeline widgets
+            // do, with a clip rectangle, background, labels, and a marker
+            // for each clip.
+            auto render = Render::create(_context);
+            const math::Size2i size(1920, 1080);
+            gl::OffscreenBufferOptions options;
+            options.colorType = image::PixelType::RGBA_U8;
+            auto buffer = gl::OffscreenBuffer::create(size, options);
+            auto fontSystem = _context->getSystem<image::FontSystem>();
+            const image::FontInfo fontInfo;
+            const auto fontMetrics = fontSystem->getMetrics(fontInfo);
+            const size_t clipCount = 1000;
+            const int clipsPerRow = 20;
+            const math::Size2i clipSize(size.w / clipsPerRow, size.h / (clipCount / clipsPerRow));
+            std::vector<std::vector<std::shared_ptr<image::Glyph> > > labels;
+            std::vector<std::vector<std::shared_ptr<image::Glyph> > > durations;
+            for (size_t i = 0; i < clipCount; ++i)
+            {
+                labels.push_back(fontSystem->getGlyphs(
+                    string::Format("Clip {0}").arg(i),
+                    fontInfo));
+                durations.push_back(fontSystem->getGlyphs(
+                    string::Format("{0}").arg(24 + i % 100),
+                    fontInfo));
+            }
+            const size_t frames = 10;
+            for (bool batch : { false, true })
+            {
+                timeline::RenderOptions renderOptions;
+                renderOptions.batchPrimitives = batch;
+                gl::OffscreenBufferBinding binding(buffer);
+                double seconds = 0.0;
+                for (size_t frame = 0; frame < frames; ++frame)
+                {
+                    const auto t0 = std::chrono::steady_clock::now();
+                    render->begin(size, renderOptions);
+                    render->setClipRectEnabled(true);
+                    for (size_t i = 0; i < clipCount; ++i)
+                    {
+                        const math::Box2i box(
+                            (i % clipsPerRow) * clipSize.w,
+                            (i / clipsPerRow) * clipSize.h,
+                            clipSize.w,
+                            clipSize.h);
+                        render->setClipRect(box);
+                        render->drawRect(
+                            box.margin(-1),
+                            image::Color4f(.3F, .4F, .6F));
+                        render->drawText(
+                            labels[i],
+                            math::Vector2i(box.min.x + 2, box.min.y + fontMetrics.ascender),
+                            image::Color4f(1.F, 1.F, 1.F));
+                        render->drawText(
+                            durations[i],
+                            math::Vector2i(box.min.x + clipSize.w / 2, box.min.y + fontMetrics.ascender),
+                            image::Color4f(.8F, .8F, .8F));
+                        render->drawRect(
+                            math::Box2i(box.min.x + 2, box.max.y - 3, 4, 2),
+                            image::Color4f(1.F, .6F, 0.F));
+                    }
+                    render->setClipRectEnabled(false);
+                    render->end();
+                    glFinish();
+                    const auto t1 = std::chrono::steady_clock::now();
+                    seconds += std::chrono::duration<double>(t1 - t0).count();
+                }
+                _print(string::Format("{0}: {1} draw calls per frame, {2}ms per frame").
+                    arg(batch ? "Batched" : "Unbatched").
+                    arg(render->getDrawCallCount()).
+                    arg(seconds / frames * 1000.0, 2));
+                if (batch)
+                {
+                    TLRENDER_ASSERT(render->getDrawCallCount() < clipCount);
+                }
+                else
+                {
+                    TLRENDER_ASSERT(render->getDrawCallCount() >= clipCount * 2);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_gl_tests
+    {
+        class RenderTest : public tests::ITest
+        {
+        protected:
+            RenderTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<RenderTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _enums();
+            void _batch();
+            void _timing();
+            void _benchmark();
+        };
+    }
+}
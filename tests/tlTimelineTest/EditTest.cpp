@@ -53,6 +53,7 @@ namespace tl
         void EditTest::run()
         {
             _move();
+            _diff();
         }
 
         void EditTest::_move()
@@ -365,5 +366,76 @@ namespace tl
                 TLRENDER_ASSERT(video1 == getChild(otioTimeline3, 0, 1)->name());
             }
         }
+
+        void EditTest::_diff()
+        {
+            otio::SerializableObject::Retainer<otio::Timeline> otioTimeline(new otio::Timeline);
+            auto otioTrack = new otio::Track("Video", std::nullopt, otio::Track::Kind::video);
+            otioTimeline->tracks()->append_child(otioTrack);
+            for (size_t i = 0; i < 3; ++i)
+            {
+                otioTrack->append_child(new otio::Clip(
+                    string::Format("Video {0}").arg(i),
+                    nullptr,
+                    otime::TimeRange(
+                        otime::RationalTime(0.0, 24.0),
+                        otime::RationalTime(24.0, 24.0))));
+            }
+            {
+                auto diff = EditDiff::create(otioTimeline, otioTimeline);
+                TLRENDER_ASSERT(diff->isAllChanged());
+                TLRENDER_ASSERT(diff->isVideoChanged(otime::RationalTime(0.0, 24.0)));
+                TLRENDER_ASSERT(!time::isValid(diff->mapVideo(otime::RationalTime(0.0, 24.0))));
+            }
+            {
+                auto diff = EditDiff::create(otioTimeline, copy(otioTimeline));
+                TLRENDER_ASSERT(!diff->isAllChanged());
+                TLRENDER_ASSERT(diff->getVideoRanges().empty());
+                TLRENDER_ASSERT(diff->getAudioRanges().empty());
+                for (double frame = 0.0; frame < 72.0; frame += 1.0)
+                {
+                    const otime::RationalTime time(frame, 24.0);
+                    TLRENDER_ASSERT(!diff->isVideoChanged(time));
+                    TLRENDER_ASSERT(time == diff->mapVideo(time));
+                }
+            }
+            {
+                // Swap the first two clips.
+                MoveData moveData;
+                moveData.fromTrack = 0;
+                moveData.fromIndex = 1;
+                moveData.fromOtioIndex = 1;
+                moveData.toTrack = 0;
+                moveData.toIndex = 0;
+                moveData.toOtioIndex = 0;
+                auto otioTimeline2 = move(otioTimeline, { moveData });
+                auto diff = EditDiff::create(otioTimeline, otioTimeline2);
+                TLRENDER_ASSERT(!diff->isAllChanged());
+                TLRENDER_ASSERT(1 == diff->getVideoRanges().size());
+                TLRENDER_ASSERT(otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(48.0, 24.0)) == diff->getVideoRanges()[0]);
+                TLRENDER_ASSERT(diff->isVideoChanged(otime::RationalTime(0.0, 24.0)));
+                TLRENDER_ASSERT(diff->isVideoChanged(otime::RationalTime(47.0, 24.0)));
+                TLRENDER_ASSERT(!diff->isVideoChanged(otime::RationalTime(48.0, 24.0)));
+                TLRENDER_ASSERT(otime::RationalTime(24.0, 24.0) == diff->mapVideo(otime::RationalTime(0.0, 24.0)));
+                TLRENDER_ASSERT(otime::RationalTime(6.0, 24.0) == diff->mapVideo(otime::RationalTime(30.0, 24.0)));
+                TLRENDER_ASSERT(otime::RationalTime(50.0, 24.0) == diff->mapVideo(otime::RationalTime(50.0, 24.0)));
+            }
+            {
+                // Trim the last clip.
+                auto otioTimeline2 = copy(otioTimeline);
+                auto otioClip = getClip(otioTimeline2, 0, 2);
+                otioClip->set_source_range(otime::TimeRange(
+                    otime::RationalTime(12.0, 24.0),
+                    otime::RationalTime(12.0, 24.0)));
+                auto diff = EditDiff::create(otioTimeline, otioTimeline2);
+                TLRENDER_ASSERT(!diff->isAllChanged());
+                TLRENDER_ASSERT(!diff->isVideoChanged(otime::RationalTime(47.0, 24.0)));
+                TLRENDER_ASSERT(diff->isVideoChanged(otime::RationalTime(48.0, 24.0)));
+                TLRENDER_ASSERT(otime::RationalTime(48.0, 24.0) == diff->mapVideo(otime::RationalTime(60.0, 24.0)));
+                TLRENDER_ASSERT(!time::isValid(diff->mapVideo(otime::RationalTime(48.0, 24.0))));
+            }
+        }
     }
 }
@@ -22,6 +22,7 @@ namespace tl
 
         private:
             void _move();
+            void _diff();
         };
     }
 }
@@ -5,10 +5,13 @@
 #include <tlTimelineTest/MemoryReferenceTest.h>
 
 #include <tlTimeline/MemoryReference.h>
+#include <tlTimeline/Util.h>
 
 #include <tlCore/Assert.h>
 #include <tlCore/String.h>
 
+#include <cstring>
+
 using namespace tl::timeline;
 
 namespace tl
@@ -81,6 +84,51 @@ namespace tl
             {
                 otio::SerializableObject::Retainer<ZipMemorySequenceReference> v(new ZipMemorySequenceReference);
             }
+            {
+                // Raw deflate stream with a single stored block.
+                const uint8_t compressed[] = { 0x01, 0x03, 0x00, 0xfc, 0xff, 'a', 'b', 'c' };
+                const uint8_t stored[] = { 'd', 'e', 'f' };
+                ZipCompressedData::Entry entry;
+                entry.data = compressed;
+                entry.size = sizeof(compressed);
+                entry.uncompressed_size = 3;
+                auto compressedData = std::make_shared<ZipCompressedData>(
+                    std::vector<ZipCompressedData::Entry>({ entry, ZipCompressedData::Entry() }));
+                TLRENDER_ASSERT(2 == compressedData->entries().size());
+                TLRENDER_ASSERT(!compressedData->isDecompressed());
+                const auto& data = compressedData->decompress();
+                TLRENDER_ASSERT(compressedData->isDecompressed());
+                TLRENDER_ASSERT(2 == data.size());
+                TLRENDER_ASSERT(data[0] && 3 == data[0]->size());
+                TLRENDER_ASSERT(0 == memcmp(data[0]->data(), "abc", 3));
+                TLRENDER_ASSERT(!data[1]);
+
+                otio::SerializableObject::Retainer<ZipMemorySequenceReference> v(new ZipMemorySequenceReference);
+                v->set_memory({ nullptr, stored }, { 0, 3 });
+                TLRENDER_ASSERT(isMemoryReference(v.value));
+                v->set_compressed_data(compressedData);
+                TLRENDER_ASSERT(v->compressed_data() == compressedData);
+                const auto memoryRead = getMemoryRead(v.value);
+                TLRENDER_ASSERT(2 == memoryRead.size());
+                TLRENDER_ASSERT(data[0]->data() == memoryRead[0].p);
+                TLRENDER_ASSERT(stored == memoryRead[1].p);
+            }
+            {
+                // Entries that cannot be decompressed are null, and the
+                // error is printed to the log.
+                const uint8_t corrupt[] = { 0xff, 0xff, 0xff, 0xff };
+                ZipCompressedData::Entry entry;
+                entry.name = "corrupt";
+                entry.data = corrupt;
+                entry.size = sizeof(corrupt);
+                entry.uncompressed_size = 3;
+                auto compressedData = std::make_shared<ZipCompressedData>(
+                    std::vector<ZipCompressedData::Entry>({ entry }),
+                    _context->getLogSystem());
+                const auto& data = compressedData->decompress();
+                TLRENDER_ASSERT(1 == data.size());
+                TLRENDER_ASSERT(!data[0]);
+            }
         }
     }
 }
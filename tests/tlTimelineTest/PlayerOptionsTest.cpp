@@ -28,6 +28,8 @@ namespace tl
         {
             {
                 _enum<TimerMode>("TimerMode", getTimerModeEnums);
+                _enum<CacheMode>("CacheMode", getCacheModeEnums);
+                _enum<PlaybackPolicy>("PlaybackPolicy", getPlaybackPolicyEnums);
             }
             {
                 PlayerCacheOptions v;
@@ -35,12 +37,28 @@ namespace tl
                 TLRENDER_ASSERT(v == v);
                 TLRENDER_ASSERT(v != PlayerCacheOptions());
             }
+            {
+                PlayerCacheOptions v;
+                v.mode = CacheMode::Memory;
+                TLRENDER_ASSERT(v != PlayerCacheOptions());
+                v = PlayerCacheOptions();
+                v.memoryBudget = memory::megabyte;
+                TLRENDER_ASSERT(v != PlayerCacheOptions());
+                v = PlayerCacheOptions();
+                v.readAheadMax = otime::RationalTime(1.0, 1.0);
+                TLRENDER_ASSERT(v != PlayerCacheOptions());
+            }
             {
                 PlayerOptions v;
                 v.timerMode = TimerMode::Audio;
                 TLRENDER_ASSERT(v == v);
                 TLRENDER_ASSERT(v != PlayerOptions());
             }
+            {
+                PlayerOptions v;
+                v.playbackPolicy = PlaybackPolicy::RealTime;
+                TLRENDER_ASSERT(v != PlayerOptions());
+            }
         }
     }
 }
@@ -16,7 +16,12 @@
 #include <opentimelineio/externalReference.h>
 #include <opentimelineio/imageSequenceReference.h>
 #include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
 
+#include <ctime>
+#include <future>
+#include <map>
+#include <mutex>
 #include <sstream>
 
 using namespace tl::timeline;
@@ -39,6 +44,13 @@ namespace tl
             _enums();
             _loop();
             _player();
+            _realTime();
+            _compare();
+            _readAhead();
+            _memoryCache();
+            _sharedCompare();
+            _idle();
+            _requestLatency();
         }
 
         void PlayerTest::_enums()
@@ -46,6 +58,7 @@ namespace tl
             ITest::_enum<Playback>("Playback", getPlaybackEnums);
             ITest::_enum<Loop>("Loop", getLoopEnums);
             ITest::_enum<TimeAction>("TimeAction", getTimeActionEnums);
+            ITest::_enum<PlaybackPolicy>("PlaybackPolicy", getPlaybackPolicyEnums);
         }
 
         void PlayerTest::_loop()
@@ -465,7 +478,646 @@ namespace tl
                 }
                 player->setPlayback(Playback::Stop);
                 player->clearCache();
+
+                // Test the memory cache mode.
+                cacheOptions = PlayerCacheOptions();
+                cacheOptions.mode = CacheMode::Memory;
+                cacheOptions.memoryBudget = memory::megabyte;
+                player->setCacheOptions(cacheOptions);
+                TLRENDER_ASSERT(cacheOptions == player->getCacheOptions());
+                PlayerCacheInfo cacheInfo;
+                auto memoryCacheInfoObserver = observer::ValueObserver<PlayerCacheInfo>::create(
+                    player->observeCacheInfo(),
+                    [&cacheInfo](const PlayerCacheInfo& value)
+                    {
+                        cacheInfo = value;
+                    });
+                player->seek(timeRange.start_time());
+                player->setPlayback(Playback::Forward);
+                const auto t = std::chrono::steady_clock::now();
+                std::chrono::duration<float> diff;
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    const auto t2 = std::chrono::steady_clock::now();
+                    diff = t2 - t;
+                } while (diff.count() < 2.F);
+                player->setPlayback(Playback::Stop);
+                TLRENDER_ASSERT(time::isValid(cacheInfo.readAhead));
+                TLRENDER_ASSERT(time::isValid(cacheInfo.readBehind));
+                {
+                    std::stringstream ss;
+                    ss << "Memory cache: " << cacheInfo.readAhead << " read ahead, " <<
+                        cacheInfo.readBehind << " read behind, " <<
+                        cacheInfo.videoByteCount << " bytes";
+                    _print(ss.str());
+                }
+
+                // Test the in/out cache mode.
+                cacheOptions = PlayerCacheOptions();
+                cacheOptions.mode = CacheMode::InOut;
+                if (!ioInfo.video.empty())
+                {
+                    cacheOptions.memoryBudget = 1;
+                    try
+                    {
+                        player->setCacheOptions(cacheOptions);
+                        TLRENDER_ASSERT(false);
+                    }
+                    catch (const std::exception&)
+                    {}
+                    TLRENDER_ASSERT(CacheMode::InOut != player->getCacheOptions().mode);
+                }
+                cacheOptions.memoryBudget = 4 * memory::gigabyte;
+                player->setCacheOptions(cacheOptions);
+                TLRENDER_ASSERT(cacheOptions == player->getCacheOptions());
+                const otime::TimeRange inOutRange(
+                    timeRange.start_time(),
+                    otime::RationalTime(
+                        std::min(timeRange.duration().value(), 10.0),
+                        timeRange.duration().rate()));
+                player->setInOutRange(inOutRange);
+                player->seek(inOutRange.start_time());
+                const auto t3 = std::chrono::steady_clock::now();
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    const auto t2 = std::chrono::steady_clock::now();
+                    diff = t2 - t3;
+                } while (diff.count() < 2.F);
+                TLRENDER_ASSERT(inOutRange == cacheInfo.pinnedRange);
+                TLRENDER_ASSERT(cacheInfo.error.empty());
+                {
+                    std::stringstream ss;
+                    ss << "In/out cache: " << cacheInfo.videoPercentage << "% filled, " <<
+                        cacheInfo.videoByteCount << " bytes";
+                    _print(ss.str());
+                }
+                player->setInOutRange(timeRange);
+                player->setCacheOptions(PlayerCacheOptions());
+                player->clearCache();
+            }
+        }
+
+        namespace
+        {
+            // Number of frames read for each delay.
+            struct SlowReadCount
+            {
+                std::map<int, size_t> count;
+                std::mutex mutex;
+            };
+
+            // Reader that decodes one frame at a time, slower than real-time.
+            // The delay in milliseconds can be set with the "Slow/Delay"
+            // option, and the image size with the "Slow/Size" option.
+            class SlowRead : public io::IRead
+            {
+            protected:
+                SlowRead() :
+                    _mutex(std::make_shared<std::mutex>())
+                {}
+
+            public:
+                static std::shared_ptr<SlowRead> create(
+                    const file::Path& path,
+                    const io::Options& options,
+                    const std::shared_ptr<SlowReadCount>& readCount,
+                    const std::shared_ptr<io::Cache>& cache,
+                    const std::weak_ptr<log::System>& logSystem)
+                {
+                    auto out = std::shared_ptr<SlowRead>(new SlowRead);
+                    out->_init(path, {}, options, cache, logSystem);
+                    auto i = options.find("Slow/Delay");
+                    if (i != options.end())
+                    {
+                        std::stringstream ss(i->second);
+                        ss >> out->_delay;
+                    }
+                    i = options.find("Slow/Size");
+                    if (i != options.end())
+                    {
+                        std::stringstream ss(i->second);
+                        ss >> out->_size;
+                    }
+                    out->_readCount = readCount;
+                    return out;
+                }
+
+                std::future<io::Info> getInfo() override
+                {
+                    io::Info info;
+                    info.video.push_back(image::Info(_size, _size, image::PixelType::RGBA_U8));
+                    info.videoTime = otime::TimeRange(
+                        otime::RationalTime(0.0, 24.0),
+                        otime::RationalTime(240.0, 24.0));
+                    std::promise<io::Info> promise;
+                    promise.set_value(info);
+                    return promise.get_future();
+                }
+
+                std::future<io::VideoData> readVideo(
+                    const otime::RationalTime& time,
+                    const io::Options&) override
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_readCount->mutex);
+                        ++_readCount->count[_delay];
+                    }
+                    auto mutex = _mutex;
+                    const int delay = _delay;
+                    const int size = _size;
+                    return std::async(
+                        std::launch::async,
+                        [mutex, delay, size, time]
+                        {
+                            std::unique_lock<std::mutex> lock(*mutex);
+                            time::sleep(std::chrono::milliseconds(delay));
+                            return io::VideoData(
+                                time,
+                                0,
+                                image::Image::create(size, size, image::PixelType::RGBA_U8));
+                        });
+                }
+
+                void cancelRequests() override
+                {}
+
+            private:
+                std::shared_ptr<std::mutex> _mutex;
+                int _delay = 100;
+                int _size = 16;
+                std::shared_ptr<SlowReadCount> _readCount;
+            };
+
+            class SlowPlugin : public io::IPlugin
+            {
+            protected:
+                SlowPlugin() :
+                    _readCount(std::make_shared<SlowReadCount>())
+                {}
+
+            public:
+                static std::shared_ptr<SlowPlugin> create(
+                    const std::shared_ptr<io::Cache>& cache,
+                    const std::weak_ptr<log::System>& logSystem)
+                {
+                    auto out = std::shared_ptr<SlowPlugin>(new SlowPlugin);
+                    out->_init(
+                        "Slow",
+                        { { ".slow", io::FileType::Movie } },
+                        cache,
+                        logSystem);
+                    return out;
+                }
+
+                size_t getReadCount(int delay) const
+                {
+                    std::unique_lock<std::mutex> lock(_readCount->mutex);
+                    const auto i = _readCount->count.find(delay);
+                    return i != _readCount->count.end() ? i->second : 0;
+                }
+
+                std::shared_ptr<io::IRead> read(
+                    const file::Path& path,
+                    const io::Options& options) override
+                {
+                    return SlowRead::create(path, options, _readCount, _cache, _logSystem);
+                }
+
+                std::shared_ptr<io::IRead> read(
+                    const file::Path& path,
+                    const std::vector<file::MemoryRead>&,
+                    const io::Options& options) override
+                {
+                    return SlowRead::create(path, options, _readCount, _cache, _logSystem);
+                }
+
+                image::Info getWriteInfo(
+                    const image::Info&,
+                    const io::Options&) const override
+                {
+                    return image::Info();
+                }
+
+                std::shared_ptr<io::IWrite> write(
+                    const file::Path&,
+                    const io::Info&,
+                    const io::Options&) override
+                {
+                    return nullptr;
+                }
+
+            private:
+                std::shared_ptr<SlowReadCount> _readCount;
+            };
+
+            std::shared_ptr<Timeline> createSlowTimeline(
+                int delay,
+                const std::shared_ptr<system::Context>& context,
+                int size = 16)
+            {
+                otio::SerializableObject::Retainer<otio::Timeline> otioTimeline(new otio::Timeline);
+                auto otioTrack = new otio::Track("Video", std::nullopt, otio::Track::Kind::video);
+                otioTimeline->tracks()->append_child(otioTrack);
+                otioTrack->append_child(new otio::Clip(
+                    "Slow",
+                    new otio::ExternalReference("PlayerTest.slow"),
+                    otime::TimeRange(
+                        otime::RationalTime(0.0, 24.0),
+                        otime::RationalTime(240.0, 24.0))));
+                Options options;
+                options.ioOptions["Slow/Delay"] = string::Format("{0}").arg(delay);
+                options.ioOptions["Slow/Size"] = string::Format("{0}").arg(size);
+                return Timeline::create(otioTimeline, context, options);
+            }
+        }
+
+        void PlayerTest::_realTime()
+        {
+            auto ioSystem = _context->getSystem<io::System>();
+            auto plugin = SlowPlugin::create(nullptr, _context->getLogSystem());
+            ioSystem->addPlugin(plugin);
+            try
+            {
+                auto timeline = createSlowTimeline(100, _context);
+                PlayerOptions playerOptions;
+                playerOptions.playbackPolicy = PlaybackPolicy::RealTime;
+                auto player = Player::create(timeline, _context, playerOptions);
+                PlayerDropInfo dropInfo;
+                auto dropInfoObserver = observer::ValueObserver<PlayerDropInfo>::create(
+                    player->observeDropInfo(),
+                    [&dropInfo](const PlayerDropInfo& value)
+                    {
+                        dropInfo = value;
+                    });
+
+                // Playback keeps going in real-time while frames are
+                // dropped.
+                player->setPlayback(Playback::Forward);
+                const auto t0 = std::chrono::steady_clock::now();
+                std::chrono::duration<float> diff;
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    diff = std::chrono::steady_clock::now() - t0;
+                } while (diff.count() < 3.F);
+                const otime::RationalTime currentTime = player->getCurrentTime();
+                player->setPlayback(Playback::Stop);
+                _print(string::Format("Real-time playback: {0}, {1} dropped, {2} late, step {3}").
+                    arg(currentTime).
+                    arg(dropInfo.droppedFrames).
+                    arg(dropInfo.lateFrames).
+                    arg(dropInfo.requestStep));
+                TLRENDER_ASSERT(currentTime.value() >= 48.0);
+                TLRENDER_ASSERT(dropInfo.droppedFrames > 0);
+                TLRENDER_ASSERT(!dropInfo.droppedFramesPerSecond.empty());
+                TLRENDER_ASSERT(dropInfo.droppedFramesPerSecond.size() == dropInfo.lateFramesPerSecond.size());
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            ioSystem->removePlugin(plugin);
+        }
+
+        void PlayerTest::_compare()
+        {
+            auto ioSystem = _context->getSystem<io::System>();
+            auto plugin = SlowPlugin::create(nullptr, _context->getLogSystem());
+            ioSystem->addPlugin(plugin);
+            try
+            {
+                // Compare a fast stream with a slow one.
+                auto timeline = createSlowTimeline(10, _context);
+                auto compareTimeline = createSlowTimeline(100, _context);
+                auto player = Player::create(timeline, _context);
+                PlayerCacheOptions cacheOptions;
+                cacheOptions.readAhead = otime::RationalTime(20.0, 1.0);
+                player->setCacheOptions(cacheOptions);
+                player->setCompare({ compareTimeline });
+                PlayerCacheInfo cacheInfo;
+                auto cacheInfoObserver = observer::ValueObserver<PlayerCacheInfo>::create(
+                    player->observeCacheInfo(),
+                    [&cacheInfo](const PlayerCacheInfo& value)
+                    {
+                        cacheInfo = value;
+                    });
+                const auto t0 = std::chrono::steady_clock::now();
+                std::chrono::duration<float> diff;
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    diff = std::chrono::steady_clock::now() - t0;
+                } while (diff.count() < 2.F);
+
+                // The fast stream cannot run ahead of the slow one by more
+                // than the number of frames in flight.
+                size_t cachedFrames = 0;
+                for (const auto& range : cacheInfo.videoFrames)
+                {
+                    cachedFrames += range.duration().value();
+                }
+                const size_t fastReads = plugin->getReadCount(10);
+                const size_t slowReads = plugin->getReadCount(100);
+                _print(string::Format("Compare: {0} cached, {1} fast reads, {2} slow reads").
+                    arg(cachedFrames).
+                    arg(fastReads).
+                    arg(slowReads));
+                TLRENDER_ASSERT(cachedFrames > 0);
+                TLRENDER_ASSERT(fastReads <= slowReads + timeline->getOptions().videoRequestCount);
+                const auto& currentVideo = player->getCurrentVideo();
+                TLRENDER_ASSERT(2 == currentVideo.size());
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            ioSystem->removePlugin(plugin);
+        }
+
+        void PlayerTest::_readAhead()
+        {
+            auto ioSystem = _context->getSystem<io::System>();
+            auto plugin = SlowPlugin::create(nullptr, _context->getLogSystem());
+            ioSystem->addPlugin(plugin);
+            try
+            {
+                auto timeline = createSlowTimeline(10, _context);
+                PlayerOptions playerOptions;
+                playerOptions.readAheadVideoCount = 4;
+                auto player = Player::create(timeline, _context, playerOptions);
+                std::vector<VideoData> readAheadVideo;
+                auto readAheadVideoObserver = observer::ListObserver<VideoData>::create(
+                    player->observeReadAheadVideo(),
+                    [&readAheadVideo](const std::vector<VideoData>& value)
+                    {
+                        readAheadVideo = value;
+                    });
+                const auto t0 = std::chrono::steady_clock::now();
+                std::chrono::duration<float> diff;
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    diff = std::chrono::steady_clock::now() - t0;
+                } while (readAheadVideo.size() < 4 && diff.count() < 2.F);
+
+                // The frames following the current time are provided in
+                // order.
+                TLRENDER_ASSERT(4 == readAheadVideo.size());
+                const otime::RationalTime currentTime = player->getCurrentTime();
+                for (size_t i = 0; i < readAheadVideo.size(); ++i)
+                {
+                    TLRENDER_ASSERT(
+                        currentTime + otime::RationalTime(i + 1, currentTime.rate()) ==
+                        readAheadVideo[i].time);
+                }
+                TLRENDER_ASSERT(readAheadVideo == player->getReadAheadVideo());
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            ioSystem->removePlugin(plugin);
+        }
+
+        void PlayerTest::_memoryCache()
+        {
+            auto ioSystem = _context->getSystem<io::System>();
+            auto plugin = SlowPlugin::create(nullptr, _context->getLogSystem());
+            ioSystem->addPlugin(plugin);
+            try
+            {
+                // The memory cache window depends on the size of the frames.
+                // Start in the time mode so switching to the memory mode
+                // resets the window.
+                const size_t memoryBudget = 2 * memory::megabyte;
+                std::map<int, PlayerCacheInfo> cacheInfos;
+                for (const int size : { 64, 256 })
+                {
+                    auto player = Player::create(createSlowTimeline(1, _context, size), _context);
+                    PlayerCacheInfo cacheInfo;
+                    auto cacheInfoObserver = observer::ValueObserver<PlayerCacheInfo>::create(
+                        player->observeCacheInfo(),
+                        [&cacheInfo](const PlayerCacheInfo& value)
+                        {
+                            cacheInfo = value;
+                        });
+                    for (const auto mode : { CacheMode::Time, CacheMode::Memory })
+                    {
+                        PlayerCacheOptions cacheOptions;
+                        cacheOptions.mode = mode;
+                        cacheOptions.memoryBudget = memoryBudget;
+                        player->setCacheOptions(cacheOptions);
+                        const auto t0 = std::chrono::steady_clock::now();
+                        std::chrono::duration<float> diff;
+                        do
+                        {
+                            player->tick();
+                            time::sleep(std::chrono::milliseconds(10));
+                            diff = std::chrono::steady_clock::now() - t0;
+                        } while (diff.count() < 2.F);
+                    }
+                    _print(string::Format("Memory cache {0}x{0}: {1} read ahead, {2} read behind, {3} bytes").
+                        arg(size).
+                        arg(cacheInfo.readAhead.value()).
+                        arg(cacheInfo.readBehind.value()).
+                        arg(cacheInfo.videoByteCount));
+                    TLRENDER_ASSERT(time::isValid(cacheInfo.readAhead));
+                    TLRENDER_ASSERT(time::isValid(cacheInfo.readBehind));
+                    TLRENDER_ASSERT(cacheInfo.videoByteCount > 0);
+                    TLRENDER_ASSERT(cacheInfo.videoByteCount <= memoryBudget);
+                    cacheInfos[size] = cacheInfo;
+                }
+
+                // Larger frames give a smaller window.
+                TLRENDER_ASSERT(cacheInfos[256].readAhead < cacheInfos[64].readAhead);
+                TLRENDER_ASSERT(cacheInfos[256].readBehind <= cacheInfos[64].readBehind);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            ioSystem->removePlugin(plugin);
+        }
+
+        void PlayerTest::_sharedCompare()
+        {
+            auto ioSystem = _context->getSystem<io::System>();
+            auto plugin = SlowPlugin::create(nullptr, _context->getLogSystem());
+            ioSystem->addPlugin(plugin);
+            try
+            {
+                // Two players share a compare timeline. Destroying one
+                // player must not remove the request callback of the other.
+                // The sleep timeout is long so the second player only makes
+                // progress when it is woken by the request callbacks.
+                auto compareTimeline = createSlowTimeline(10, _context);
+                PlayerOptions playerOptions;
+                playerOptions.sleepTimeout = std::chrono::seconds(10);
+                auto player = Player::create(
+                    createSlowTimeline(10, _context),
+                    _context,
+                    playerOptions);
+                {
+                    auto player2 = Player::create(
+                        createSlowTimeline(10, _context),
+                        _context,
+                        playerOptions);
+                    player2->setCompare({ compareTimeline });
+                }
+                player->setCompare({ compareTimeline });
+                PlayerCacheOptions cacheOptions;
+                cacheOptions.readAhead = otime::RationalTime(1.0, 1.0);
+                cacheOptions.readBehind = otime::RationalTime(0.0, 1.0);
+                player->setCacheOptions(cacheOptions);
+                PlayerCacheInfo cacheInfo;
+                auto cacheInfoObserver = observer::ValueObserver<PlayerCacheInfo>::create(
+                    player->observeCacheInfo(),
+                    [&cacheInfo](const PlayerCacheInfo& value)
+                    {
+                        cacheInfo = value;
+                    });
+                size_t cachedFrames = 0;
+                const auto t0 = std::chrono::steady_clock::now();
+                std::chrono::duration<float> diff;
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    diff = std::chrono::steady_clock::now() - t0;
+                    cachedFrames = 0;
+                    for (const auto& range : cacheInfo.videoFrames)
+                    {
+                        cachedFrames += range.duration().value();
+                    }
+                } while (cachedFrames < 24 && diff.count() < 2.F);
+                _print(string::Format("Shared compare: {0} cached").arg(cachedFrames));
+                TLRENDER_ASSERT(cachedFrames >= 24);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            ioSystem->removePlugin(plugin);
+        }
+
+        void PlayerTest::_idle()
+        {
+            auto ioSystem = _context->getSystem<io::System>();
+            auto plugin = SlowPlugin::create(nullptr, _context->getLogSystem());
+            ioSystem->addPlugin(plugin);
+            try
+            {
+                // Fill the cache, then measure the process CPU time while the
+                // player is stopped. The player, timeline, and reader threads
+                // should all be waiting.
+                auto timeline = createSlowTimeline(10, _context);
+                auto player = Player::create(timeline, _context);
+                PlayerCacheOptions cacheOptions;
+                cacheOptions.readAhead = otime::RationalTime(1.0, 1.0);
+                cacheOptions.readBehind = otime::RationalTime(0.0, 1.0);
+                player->setCacheOptions(cacheOptions);
+                PlayerCacheInfo cacheInfo;
+                auto cacheInfoObserver = observer::ValueObserver<PlayerCacheInfo>::create(
+                    player->observeCacheInfo(),
+                    [&cacheInfo](const PlayerCacheInfo& value)
+                    {
+                        cacheInfo = value;
+                    });
+                size_t cachedFrames = 0;
+                auto t0 = std::chrono::steady_clock::now();
+                std::chrono::duration<float> diff;
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    diff = std::chrono::steady_clock::now() - t0;
+                    cachedFrames = 0;
+                    for (const auto& range : cacheInfo.videoFrames)
+                    {
+                        cachedFrames += range.duration().value();
+                    }
+                } while (cachedFrames < 24 && diff.count() < 2.F);
+
+                const std::clock_t c0 = std::clock();
+                t0 = std::chrono::steady_clock::now();
+                time::sleep(std::chrono::seconds(1));
+                const std::clock_t c1 = std::clock();
+                diff = std::chrono::steady_clock::now() - t0;
+                const double cpu = (c1 - c0) / static_cast<double>(CLOCKS_PER_SEC);
+                _print(string::Format("Idle CPU: {0}ms over {1}ms").
+                    arg(cpu * 1000.0, 2).
+                    arg(diff.count() * 1000.0, 2));
+                TLRENDER_ASSERT(cpu < diff.count() * .5);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            ioSystem->removePlugin(plugin);
+        }
+    
+        void PlayerTest::_requestLatency()
+        {
+            auto ioSystem = _context->getSystem<io::System>();
+            auto plugin = SlowPlugin::create(nullptr, _context->getLogSystem());
+            ioSystem->addPlugin(plugin);
+            try
+            {
+                // Fill the cache and check the request latency histogram.
+                // The sleep timeout is long so a request that is not
+                // signalled shows up in the last bin.
+                auto timeline = createSlowTimeline(1, _context);
+                PlayerOptions playerOptions;
+                playerOptions.sleepTimeout = std::chrono::seconds(10);
+                auto player = Player::create(timeline, _context, playerOptions);
+                PlayerCacheOptions cacheOptions;
+                cacheOptions.readAhead = otime::RationalTime(2.0, 1.0);
+                cacheOptions.readBehind = otime::RationalTime(0.0, 1.0);
+                player->setCacheOptions(cacheOptions);
+                PlayerDropInfo dropInfo;
+                auto dropInfoObserver = observer::ValueObserver<PlayerDropInfo>::create(
+                    player->observeDropInfo(),
+                    [&dropInfo](const PlayerDropInfo& value)
+                    {
+                        dropInfo = value;
+                    });
+                size_t requests = 0;
+                const auto t0 = std::chrono::steady_clock::now();
+                std::chrono::duration<float> diff;
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    diff = std::chrono::steady_clock::now() - t0;
+                    requests = 0;
+                    for (const size_t count : dropInfo.requestLatency)
+                    {
+                        requests += count;
+                    }
+                } while (requests < 48 && diff.count() < 5.F);
+
+                std::vector<std::string> bins;
+                for (size_t i = 0; i < dropInfo.requestLatency.size(); ++i)
+                {
+                    bins.push_back(string::Format("{0}").arg(dropInfo.requestLatency[i]));
+                }
+                _print(string::Format("Request latency: {0}").arg(string::join(bins, " ")));
+                TLRENDER_ASSERT(playerRequestLatencyBins == dropInfo.requestLatency.size());
+                TLRENDER_ASSERT(requests >= 48);
+                TLRENDER_ASSERT(0 == dropInfo.requestLatency.back());
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
             }
+            ioSystem->removePlugin(plugin);
         }
     }
 }
@@ -27,6 +27,13 @@ namespace tl
             void _loop();
             void _player();
             void _player(const std::shared_ptr<timeline::Player>&);
+            void _realTime();
+            void _compare();
+            void _readAhead();
+            void _memoryCache();
+            void _sharedCompare();
+            void _idle();
+            void _requestLatency();
         };
     }
 }
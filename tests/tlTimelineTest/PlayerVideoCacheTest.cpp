@@ -0,0 +1,292 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/PlayerVideoCacheTest.h>
+
+#include <tlTimeline/PlayerVideoCache.h>
+#include <tlTimeline/Util.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <chrono>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        PlayerVideoCacheTest::PlayerVideoCacheTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::PlayerVideoCacheTest", context)
+        {}
+
+        std::shared_ptr<PlayerVideoCacheTest> PlayerVideoCacheTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<PlayerVideoCacheTest>(new PlayerVideoCacheTest(context));
+        }
+
+        void PlayerVideoCacheTest::run()
+        {
+            _cache();
+            _window();
+            _benchmark();
+        }
+
+        namespace
+        {
+            std::vector<VideoData> createVideoData(
+                const otime::RationalTime& time,
+                const std::shared_ptr<image::Image>& image = nullptr)
+            {
+                VideoData videoData;
+                videoData.time = time;
+                VideoLayer layer;
+                layer.image = image;
+                videoData.layers.push_back(layer);
+                return { videoData };
+            }
+        }
+
+        void PlayerVideoCacheTest::_cache()
+        {
+            const otime::TimeRange inOutRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(100.0, 24.0));
+            PlayerVideoCache cache;
+            cache.setWindow(inOutRange, 10);
+            TLRENDER_ASSERT(10 == cache.getCapacity());
+            TLRENDER_ASSERT(0 == cache.getCount());
+            TLRENDER_ASSERT(cache.getRanges().empty());
+
+            auto image = image::Image::create(16, 16, image::PixelType::RGBA_U8);
+            for (double frame : { 0.0, 1.0, 2.0, 4.0 })
+            {
+                const otime::RationalTime time(frame, 24.0);
+                cache.add(time, createVideoData(time, image));
+            }
+            TLRENDER_ASSERT(4 == cache.getCount());
+            TLRENDER_ASSERT(4 * image->getDataByteCount() == cache.getByteCount());
+            TLRENDER_ASSERT(cache.contains(otime::RationalTime(1.0, 24.0)));
+            TLRENDER_ASSERT(!cache.contains(otime::RationalTime(3.0, 24.0)));
+            TLRENDER_ASSERT(!cache.contains(otime::RationalTime(11.0, 24.0)));
+            const auto videoData = cache.get(otime::RationalTime(2.0, 24.0));
+            TLRENDER_ASSERT(videoData);
+            TLRENDER_ASSERT(otime::RationalTime(2.0, 24.0) == videoData->front().time);
+            std::vector<otime::TimeRange> ranges =
+            {
+                otime::TimeRange(otime::RationalTime(0.0, 24.0), otime::RationalTime(3.0, 24.0)),
+                otime::TimeRange(otime::RationalTime(4.0, 24.0), otime::RationalTime(1.0, 24.0))
+            };
+            TLRENDER_ASSERT(ranges == cache.getRanges());
+
+            // Fill the gap and merge the ranges.
+            cache.add(otime::RationalTime(3.0, 24.0), createVideoData(otime::RationalTime(3.0, 24.0)));
+            ranges =
+            {
+                otime::TimeRange(otime::RationalTime(0.0, 24.0), otime::RationalTime(5.0, 24.0))
+            };
+            TLRENDER_ASSERT(ranges == cache.getRanges());
+
+            // Split the range.
+            cache.remove(otime::RationalTime(2.0, 24.0));
+            TLRENDER_ASSERT(4 == cache.getCount());
+            ranges =
+            {
+                otime::TimeRange(otime::RationalTime(0.0, 24.0), otime::RationalTime(2.0, 24.0)),
+                otime::TimeRange(otime::RationalTime(3.0, 24.0), otime::RationalTime(2.0, 24.0))
+            };
+            TLRENDER_ASSERT(ranges == cache.getRanges());
+
+            // Adding a frame to an occupied slot replaces it.
+            cache.add(otime::RationalTime(10.0, 24.0), createVideoData(otime::RationalTime(10.0, 24.0)));
+            TLRENDER_ASSERT(!cache.contains(otime::RationalTime(0.0, 24.0)));
+            TLRENDER_ASSERT(cache.contains(otime::RationalTime(10.0, 24.0)));
+            TLRENDER_ASSERT(4 == cache.getCount());
+            TLRENDER_ASSERT(2 * image->getDataByteCount() == cache.getByteCount());
+
+            // Frames outside of the in/out range.
+            cache.add(otime::RationalTime(200.0, 24.0), createVideoData(otime::RationalTime(200.0, 24.0)));
+            TLRENDER_ASSERT(cache.contains(otime::RationalTime(200.0, 24.0)));
+            TLRENDER_ASSERT(5 == cache.getCount());
+
+            // Remove the frames outside of the window.
+            cache.removeOutside({
+                otime::TimeRange(otime::RationalTime(3.0, 24.0), otime::RationalTime(7.0, 24.0)) });
+            TLRENDER_ASSERT(2 == cache.getCount());
+            TLRENDER_ASSERT(cache.contains(otime::RationalTime(3.0, 24.0)));
+            TLRENDER_ASSERT(cache.contains(otime::RationalTime(4.0, 24.0)));
+
+            auto items = cache.take();
+            TLRENDER_ASSERT(2 == items.size());
+            TLRENDER_ASSERT(0 == cache.getCount());
+            TLRENDER_ASSERT(0 == cache.getByteCount());
+            TLRENDER_ASSERT(cache.getRanges().empty());
+        }
+
+        void PlayerVideoCacheTest::_window()
+        {
+            // A window that wraps around the in/out points does not share
+            // slots.
+            const otime::TimeRange inOutRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(100.0, 24.0));
+            PlayerVideoCache cache;
+            cache.setWindow(inOutRange, 21);
+            TLRENDER_ASSERT(25 == cache.getCapacity());
+            std::vector<otime::RationalTime> times;
+            for (double frame = 90.0; frame < 100.0; frame += 1.0)
+            {
+                times.push_back(otime::RationalTime(frame, 24.0));
+            }
+            for (double frame = 0.0; frame < 11.0; frame += 1.0)
+            {
+                times.push_back(otime::RationalTime(frame, 24.0));
+            }
+            for (const auto& time : times)
+            {
+                cache.add(time, createVideoData(time));
+            }
+            TLRENDER_ASSERT(times.size() == cache.getCount());
+            for (const auto& time : times)
+            {
+                TLRENDER_ASSERT(cache.contains(time));
+            }
+
+            // Changing the window keeps the cached frames.
+            cache.setWindow(inOutRange, 50);
+            TLRENDER_ASSERT(50 == cache.getCapacity());
+            TLRENDER_ASSERT(times.size() == cache.getCount());
+            for (const auto& time : times)
+            {
+                TLRENDER_ASSERT(cache.contains(time));
+            }
+            cache.setWindow(inOutRange, 1000);
+            TLRENDER_ASSERT(100 == cache.getCapacity());
+            cache.clear();
+            TLRENDER_ASSERT(0 == cache.getCount());
+
+            // Shrinking the window after removing the frames outside of it
+            // keeps the frames in the window.
+            for (double frame = 0.0; frame < 100.0; frame += 1.0)
+            {
+                const otime::RationalTime time(frame, 24.0);
+                cache.add(time, createVideoData(time));
+            }
+            TLRENDER_ASSERT(100 == cache.getCount());
+            const std::vector<otime::TimeRange> window =
+            {
+                otime::TimeRange(
+                    otime::RationalTime(40.0, 24.0),
+                    otime::RationalTime(20.0, 24.0))
+            };
+            cache.removeOutside(window);
+            cache.setWindow(inOutRange, 20);
+            TLRENDER_ASSERT(20 == cache.getCapacity());
+            TLRENDER_ASSERT(20 == cache.getCount());
+            for (double frame = 40.0; frame < 60.0; frame += 1.0)
+            {
+                TLRENDER_ASSERT(cache.contains(otime::RationalTime(frame, 24.0)));
+            }
+        }
+
+        void PlayerVideoCacheTest::_benchmark()
+        {
+            // Simulate the cache work of a player tick: move the window
+            // one frame, remove the frames outside of the window, look up
+            // every frame in the window, add the new frame, and get the
+            // cached ranges.
+            const size_t frameCount = 10000;
+            const size_t tickCount = 1000;
+            const double rate = 24.0;
+            const otime::TimeRange inOutRange(
+                otime::RationalTime(0.0, rate),
+                otime::RationalTime(frameCount * 10, rate));
+
+            PlayerVideoCache cache;
+            cache.setWindow(inOutRange, frameCount);
+            std::map<otime::RationalTime, std::vector<VideoData> > map;
+            for (size_t i = 0; i < frameCount; ++i)
+            {
+                const otime::RationalTime time(i, rate);
+                cache.add(time, createVideoData(time));
+                map[time] = createVideoData(time);
+            }
+
+            size_t cacheCount = 0;
+            auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 1; i <= tickCount; ++i)
+            {
+                const std::vector<otime::TimeRange> ranges =
+                {
+                    otime::TimeRange(otime::RationalTime(i, rate), otime::RationalTime(frameCount, rate))
+                };
+                cache.removeOutside(ranges);
+                for (size_t j = i; j < i + frameCount; ++j)
+                {
+                    const otime::RationalTime time(j, rate);
+                    if (!cache.contains(time))
+                    {
+                        cache.add(time, createVideoData(time));
+                    }
+                }
+                cacheCount += cache.getRanges().size();
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> cacheDiff = t1 - t0;
+
+            size_t mapCount = 0;
+            t0 = std::chrono::steady_clock::now();
+            for (size_t i = 1; i <= tickCount; ++i)
+            {
+                const std::vector<otime::TimeRange> ranges =
+                {
+                    otime::TimeRange(otime::RationalTime(i, rate), otime::RationalTime(frameCount, rate))
+                };
+                auto it = map.begin();
+                while (it != map.end())
+                {
+                    const otime::RationalTime t = it->first;
+                    const auto j = std::find_if(
+                        ranges.begin(),
+                        ranges.end(),
+                        [t](const otime::TimeRange& value)
+                        {
+                            return value.contains(t);
+                        });
+                    it = j == ranges.end() ? map.erase(it) : std::next(it);
+                }
+                for (size_t j = i; j < i + frameCount; ++j)
+                {
+                    const otime::RationalTime time(j, rate);
+                    if (map.find(time) == map.end())
+                    {
+                        map[time] = createVideoData(time);
+                    }
+                }
+                std::vector<otime::RationalTime> frames;
+                for (const auto& k : map)
+                {
+                    frames.push_back(k.first);
+                }
+                mapCount += toRanges(frames).size();
+            }
+            t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> mapDiff = t1 - t0;
+
+            TLRENDER_ASSERT(frameCount == cache.getCount());
+            TLRENDER_ASSERT(frameCount == map.size());
+            TLRENDER_ASSERT(cacheCount == mapCount);
+            _print(string::Format("Cache ticks {0} with {1} frames: {2} seconds").
+                arg(tickCount).
+                arg(frameCount).
+                arg(cacheDiff.count()));
+            _print(string::Format("Map ticks {0} with {1} frames: {2} seconds").
+                arg(tickCount).
+                arg(frameCount).
+                arg(mapDiff.count()));
+        }
+    }
+}
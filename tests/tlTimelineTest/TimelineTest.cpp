@@ -4,6 +4,7 @@
 
 #include <tlTimelineTest/TimelineTest.h>
 
+#include <tlTimeline/MemoryReference.h>
 #include <tlTimeline/Timeline.h>
 #include <tlTimeline/Util.h>
 
@@ -11,15 +12,132 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/Path.h>
 #include <tlCore/StringFormat.h>
 
 #include <opentimelineio/clip.h>
 #include <opentimelineio/externalReference.h>
 #include <opentimelineio/imageSequenceReference.h>
 #include <opentimelineio/timeline.h>
+#include <opentimelineio/track.h>
+
+#include <atomic>
 
 using namespace tl::timeline;
 
+namespace tl
+{
+    namespace timeline_tests
+    {
+        namespace
+        {
+            struct ZipEntry
+            {
+                std::string name;
+                std::string data;
+                bool deflate = false;
+            };
+
+            uint32_t crc32(const std::string& data)
+            {
+                uint32_t out = 0xffffffff;
+                for (const char c : data)
+                {
+                    out ^= static_cast<uint8_t>(c);
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        out = (out >> 1) ^ (0xedb88320 & (0 - (out & 1)));
+                    }
+                }
+                return ~out;
+            }
+
+            void append16(std::vector<uint8_t>& out, uint16_t value)
+            {
+                out.push_back(value & 0xff);
+                out.push_back((value >> 8) & 0xff);
+            }
+
+            void append32(std::vector<uint8_t>& out, uint32_t value)
+            {
+                append16(out, value & 0xffff);
+                append16(out, (value >> 16) & 0xffff);
+            }
+
+            //! Write a zip file. Deflated entries use a single stored
+            //! block, which is enough to exercise decompression.
+            void writeZip(const std::string& fileName, const std::vector<ZipEntry>& entries)
+            {
+                std::vector<uint8_t> data;
+                std::vector<uint8_t> centralDirectory;
+                for (const auto& entry : entries)
+                {
+                    std::string compressed = entry.data;
+                    if (entry.deflate)
+                    {
+                        const uint16_t size = static_cast<uint16_t>(entry.data.size());
+                        std::vector<uint8_t> header;
+                        header.push_back(0x01);
+                        append16(header, size);
+                        append16(header, ~size);
+                        compressed = std::string(header.begin(), header.end()) + entry.data;
+                    }
+                    const uint16_t method = entry.deflate ? 8 : 0;
+                    const uint32_t crc = crc32(entry.data);
+                    const uint32_t offset = static_cast<uint32_t>(data.size());
+
+                    append32(data, 0x04034b50);
+                    append16(data, 20);
+                    append16(data, 0);
+                    append16(data, method);
+                    append16(data, 0);
+                    append16(data, 0x21);
+                    append32(data, crc);
+                    append32(data, static_cast<uint32_t>(compressed.size()));
+                    append32(data, static_cast<uint32_t>(entry.data.size()));
+                    append16(data, static_cast<uint16_t>(entry.name.size()));
+                    append16(data, 0);
+                    data.insert(data.end(), entry.name.begin(), entry.name.end());
+                    data.insert(data.end(), compressed.begin(), compressed.end());
+
+                    append32(centralDirectory, 0x02014b50);
+                    append16(centralDirectory, 20);
+                    append16(centralDirectory, 20);
+                    append16(centralDirectory, 0);
+                    append16(centralDirectory, method);
+                    append16(centralDirectory, 0);
+                    append16(centralDirectory, 0x21);
+                    append32(centralDirectory, crc);
+                    append32(centralDirectory, static_cast<uint32_t>(compressed.size()));
+                    append32(centralDirectory, static_cast<uint32_t>(entry.data.size()));
+                    append16(centralDirectory, static_cast<uint16_t>(entry.name.size()));
+                    append16(centralDirectory, 0);
+                    append16(centralDirectory, 0);
+                    append16(centralDirectory, 0);
+                    append16(centralDirectory, 0);
+                    append32(centralDirectory, 0);
+                    append32(centralDirectory, offset);
+                    centralDirectory.insert(centralDirectory.end(), entry.name.begin(), entry.name.end());
+                }
+                const uint32_t centralDirectoryOffset = static_cast<uint32_t>(data.size());
+                data.insert(data.end(), centralDirectory.begin(), centralDirectory.end());
+                append32(data, 0x06054b50);
+                append16(data, 0);
+                append16(data, 0);
+                append16(data, static_cast<uint16_t>(entries.size()));
+                append16(data, static_cast<uint16_t>(entries.size()));
+                append32(data, static_cast<uint32_t>(centralDirectory.size()));
+                append32(data, centralDirectoryOffset);
+                append16(data, 0);
+
+                auto io = file::FileIO::create(fileName, file::Mode::Write);
+                io->write(data.data(), data.size());
+            }
+        }
+    }
+}
+
 namespace tl
 {
     namespace timeline_tests
@@ -43,6 +161,7 @@ namespace tl
             _timeline();
             _separateAudio();
             _setTimeline();
+            _otiozDeflate();
         }
 
         void TimelineTest::_enums()
@@ -57,6 +176,9 @@ namespace tl
             a.fileSequenceAudio = FileSequenceAudio::Directory;
             TLRENDER_ASSERT(a == a);
             TLRENDER_ASSERT(a != Options());
+            Options b;
+            b.readerLookAhead = otime::RationalTime(0.0, 1.0);
+            TLRENDER_ASSERT(b != Options());
         }
 
         void TimelineTest::_util()
@@ -131,6 +253,34 @@ namespace tl
 
         void TimelineTest::_timeline(const std::shared_ptr<timeline::Timeline>& timeline)
         {
+            // Wait for the clips to be probed.
+            bool ready = false;
+            auto readyObserver = observer::ValueObserver<bool>::create(
+                timeline->observeTimelineReady(),
+                [&ready](bool value)
+                {
+                    ready = value;
+                });
+            while (!ready)
+            {
+                timeline->tick();
+                time::sleep(std::chrono::milliseconds(10));
+            }
+
+            // Count the request callbacks.
+            std::atomic<size_t> requestCallbacks(0);
+            std::atomic<size_t> requestCallbacks2(0);
+            const uint64_t requestCallbackId = timeline->addRequestCallback(
+                [&requestCallbacks]
+                {
+                    ++requestCallbacks;
+                });
+            const uint64_t requestCallbackId2 = timeline->addRequestCallback(
+                [&requestCallbacks2]
+                {
+                    ++requestCallbacks2;
+                });
+
             // Get video from the timeline.
             const otime::TimeRange& timeRange = timeline->getTimeRange();
             std::vector<timeline::VideoData> videoData;
@@ -189,6 +339,36 @@ namespace tl
                 }
             }
             TLRENDER_ASSERT(audioRequests.empty());
+            TLRENDER_ASSERT(requestCallbacks > 0);
+            TLRENDER_ASSERT(requestCallbacks2 > 0);
+
+            // Removing a request callback does not affect the others.
+            timeline->removeRequestCallback(requestCallbackId);
+            const size_t requestCallbacksPrev = requestCallbacks;
+            const size_t requestCallbacks2Prev = requestCallbacks2;
+            auto videoRequest = timeline->getVideo(timeRange.start_time());
+            videoRequest.future.get();
+            const auto t0 = std::chrono::steady_clock::now();
+            while (requestCallbacks2 == requestCallbacks2Prev &&
+                std::chrono::steady_clock::now() - t0 < std::chrono::seconds(1))
+            {
+                time::sleep(std::chrono::milliseconds(1));
+            }
+            TLRENDER_ASSERT(requestCallbacks == requestCallbacksPrev);
+            TLRENDER_ASSERT(requestCallbacks2 > requestCallbacks2Prev);
+            timeline->removeRequestCallback(requestCallbackId2);
+
+            // Check the reader statistics.
+            const ReadStats readStats = timeline->getReadStats();
+            TLRENDER_ASSERT(readStats != ReadStats());
+            TLRENDER_ASSERT(readStats.readerCount <= readStats.readerMax);
+            TLRENDER_ASSERT(readStats.readerMax <= timeline->getOptions().readerMax);
+            TLRENDER_ASSERT(readStats.lookAheadOpens <= readStats.opens);
+            _print(string::Format("Readers: {0} opens, {1} look ahead, {2} hits, {3} evictions").
+                arg(readStats.opens).
+                arg(readStats.lookAheadOpens).
+                arg(readStats.hits).
+                arg(readStats.evictions));
 
             // Cancel requests.
             videoData.clear();
@@ -322,5 +502,70 @@ namespace tl
             timeline->setTimeline(otioTimeline);
             TLRENDER_ASSERT(otioTimeline.value == timeline->getTimeline().value);
         }
+
+        void TimelineTest::_otiozDeflate()
+        {
+            try
+            {
+                // Create an .otioz file with a stored clip followed by a
+                // compressed clip.
+                otio::SerializableObject::Retainer<otio::Timeline> otioTimeline(new otio::Timeline);
+                otio::SerializableObject::Retainer<otio::Track> otioTrack(new otio::Track);
+                otioTimeline->tracks()->append_child(otioTrack);
+                for (const std::string& url : { "Stored.ppm", "Deflate.ppm" })
+                {
+                    otio::SerializableObject::Retainer<otio::Clip> otioClip(new otio::Clip);
+                    const otime::TimeRange range(
+                        otime::RationalTime(0.0, 24.0),
+                        otime::RationalTime(1.0, 24.0));
+                    otioClip->set_media_reference(new otio::ExternalReference(url, range));
+                    otioClip->set_source_range(range);
+                    otioTrack->append_child(otioClip);
+                }
+                const std::string ppm = std::string("P6\n2 2\n255\n") + std::string(12, 127);
+                const std::string fileName = file::Path(
+                    file::createTempDir(),
+                    "TimelineTest.otioz").get();
+                writeZip(
+                    fileName,
+                    {
+                        { "content.otio", otioTimeline->to_json_string(), false },
+                        { "Stored.ppm", ppm, false },
+                        { "Deflate.ppm", ppm, true }
+                    });
+
+                // Creating the timeline does not decompress anything, the
+                // information is read from the first clip which is stored.
+                // Readers are not opened ahead so only the requested clips
+                // are read.
+                Options options;
+                options.readerLookAhead = otime::RationalTime(0.0, 1.0);
+                auto timeline = Timeline::create(fileName, _context, time::invalidTime, options);
+                std::shared_ptr<ZipCompressedData> compressedData;
+                for (const auto& clip : timeline->getTimeline()->find_children<otio::Clip>())
+                {
+                    if (auto ref = dynamic_cast<ZipMemoryReference*>(clip->media_reference()))
+                    {
+                        if (ref->compressed_data())
+                        {
+                            compressedData = ref->compressed_data();
+                        }
+                    }
+                }
+                TLRENDER_ASSERT(compressedData);
+                TLRENDER_ASSERT(!compressedData->isDecompressed());
+                auto videoData = timeline->getVideo(otime::RationalTime(0.0, 24.0)).future.get();
+                TLRENDER_ASSERT(!compressedData->isDecompressed());
+
+                // Reading the compressed clip decompresses it.
+                videoData = timeline->getVideo(otime::RationalTime(1.0, 24.0)).future.get();
+                TLRENDER_ASSERT(compressedData->isDecompressed());
+                TLRENDER_ASSERT(!videoData.layers.empty() && videoData.layers[0].image);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
     }
 }
@@ -32,6 +32,7 @@ namespace tl
             void _timeline(const std::shared_ptr<timeline::Timeline>&);
             void _separateAudio();
             void _setTimeline();
+            void _otiozDeflate();
         };
     }
 }
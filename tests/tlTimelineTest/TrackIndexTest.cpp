@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/TrackIndexTest.h>
+
+#include <tlTimeline/TrackIndex.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
+
+#include <chrono>
+#include <cmath>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        TrackIndexTest::TrackIndexTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::TrackIndexTest", context)
+        {}
+
+        std::shared_ptr<TrackIndexTest> TrackIndexTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<TrackIndexTest>(new TrackIndexTest(context));
+        }
+
+        void TrackIndexTest::run()
+        {
+            _find();
+            _transitions();
+            _benchmark();
+        }
+
+        namespace
+        {
+            otio::SerializableObject::Retainer<otio::Timeline> createTimeline(
+                size_t clipCount,
+                size_t transitionInterval)
+            {
+                otio::SerializableObject::Retainer<otio::Timeline> otioTimeline(new otio::Timeline);
+                auto otioTrack = new otio::Track("Video", std::nullopt, otio::Track::Kind::video);
+                otioTimeline->tracks()->append_child(otioTrack);
+                for (size_t i = 0; i < clipCount; ++i)
+                {
+                    if (transitionInterval > 0 && i > 0 && 0 == i % transitionInterval)
+                    {
+                        otioTrack->append_child(new otio::Transition(
+                            "Transition",
+                            otio::Transition::Type::SMPTE_Dissolve,
+                            otime::RationalTime(6.0, 24.0),
+                            otime::RationalTime(6.0, 24.0)));
+                    }
+                    otioTrack->append_child(new otio::Clip(
+                        string::Format("Video {0}").arg(i),
+                        nullptr,
+                        otime::TimeRange(
+                            otime::RationalTime(0.0, 24.0),
+                            otime::RationalTime(24.0, 24.0))));
+                }
+                return otioTimeline;
+            }
+
+            std::vector<const TrackIndexItem*> findLinear(
+                const TrackIndex& trackIndex,
+                const otime::RationalTime& time)
+            {
+                std::vector<const TrackIndexItem*> out;
+                for (const auto& item : trackIndex.getItems())
+                {
+                    if (item.range.contains(time))
+                    {
+                        out.push_back(&item);
+                    }
+                }
+                return out;
+            }
+
+            std::vector<const TrackIndexItem*> findIndex(
+                const TrackIndex& trackIndex,
+                const otime::RationalTime& time)
+            {
+                std::vector<const TrackIndexItem*> items;
+                trackIndex.find(time.to_seconds(), time.to_seconds(), items);
+                std::vector<const TrackIndexItem*> out;
+                for (const auto item : items)
+                {
+                    if (item->range.contains(time))
+                    {
+                        out.push_back(item);
+                    }
+                }
+                return out;
+            }
+        }
+
+        void TrackIndexTest::_find()
+        {
+            {
+                TrackIndex trackIndex;
+                TLRENDER_ASSERT(!trackIndex.getTrack());
+                TLRENDER_ASSERT(trackIndex.getItems().empty());
+                std::vector<const TrackIndexItem*> items;
+                trackIndex.find(0.0, 1.0, items);
+                TLRENDER_ASSERT(items.empty());
+            }
+            {
+                auto otioTimeline = createTimeline(10, 0);
+                const auto trackIndexes = createTrackIndexes(otioTimeline.value, otio::Track::Kind::video);
+                TLRENDER_ASSERT(1 == trackIndexes.size());
+                TLRENDER_ASSERT(createTrackIndexes(otioTimeline.value, otio::Track::Kind::audio).empty());
+                const auto& trackIndex = trackIndexes.front();
+                TLRENDER_ASSERT(10 == trackIndex.getItems().size());
+                for (double frame = 0.0; frame < 240.0; frame += 1.0)
+                {
+                    const otime::RationalTime time(frame, 24.0);
+                    const auto items = findIndex(trackIndex, time);
+                    TLRENDER_ASSERT(1 == items.size());
+                    TLRENDER_ASSERT(static_cast<size_t>(frame / 24.0) == items[0]->index);
+                    TLRENDER_ASSERT(items[0]->clip);
+                }
+                TLRENDER_ASSERT(findIndex(trackIndex, otime::RationalTime(-1.0, 24.0)).empty());
+                TLRENDER_ASSERT(findIndex(trackIndex, otime::RationalTime(240.0, 24.0)).empty());
+
+                std::vector<const TrackIndexItem*> items;
+                trackIndex.find(1.5, 2.5, items);
+                TLRENDER_ASSERT(2 == items.size());
+                TLRENDER_ASSERT(1 == items[0]->index);
+                TLRENDER_ASSERT(2 == items[1]->index);
+            }
+        }
+
+        void TrackIndexTest::_transitions()
+        {
+            auto otioTimeline = createTimeline(3, 1);
+            const auto trackIndexes = createTrackIndexes(otioTimeline.value, otio::Track::Kind::video);
+            TLRENDER_ASSERT(1 == trackIndexes.size());
+            const auto& items = trackIndexes.front().getItems();
+            TLRENDER_ASSERT(3 == items.size());
+
+            TLRENDER_ASSERT(!items[0].inTransition);
+            TLRENDER_ASSERT(items[0].outTransition);
+            TLRENDER_ASSERT(items[0].outClip == items[1].clip);
+            TLRENDER_ASSERT(items[1].inTransition == items[0].outTransition);
+            TLRENDER_ASSERT(items[1].inClip == items[0].clip);
+            TLRENDER_ASSERT(items[1].outClip == items[2].clip);
+            TLRENDER_ASSERT(!items[2].outTransition);
+
+            // The ranges are extended by the transitions.
+            TLRENDER_ASSERT(0.0 == items[0].start);
+            TLRENDER_ASSERT(1.25 == items[0].end);
+            TLRENDER_ASSERT(0.75 == items[1].start);
+            TLRENDER_ASSERT(2.25 == items[1].end);
+
+            std::vector<const TrackIndexItem*> found;
+            trackIndexes.front().find(1.1, 1.1, found);
+            TLRENDER_ASSERT(2 == found.size());
+            TLRENDER_ASSERT(found[0]->clip == items[0].clip);
+            TLRENDER_ASSERT(found[1]->clip == items[1].clip);
+        }
+
+        void TrackIndexTest::_benchmark()
+        {
+            const size_t clipCount = 10000;
+            auto otioTimeline = createTimeline(clipCount, 10);
+
+            auto t0 = std::chrono::steady_clock::now();
+            const auto trackIndexes = createTrackIndexes(otioTimeline.value, otio::Track::Kind::video);
+            auto t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> createDiff = t1 - t0;
+            TLRENDER_ASSERT(1 == trackIndexes.size());
+            const auto& trackIndex = trackIndexes.front();
+            TLRENDER_ASSERT(clipCount == trackIndex.getItems().size());
+
+            const size_t lookupCount = 10000;
+            const double duration = clipCount * 24.0;
+            std::vector<otime::RationalTime> times;
+            for (size_t i = 0; i < lookupCount; ++i)
+            {
+                times.push_back(otime::RationalTime(
+                    std::floor(i * duration / lookupCount), 24.0));
+            }
+
+            size_t indexCount = 0;
+            t0 = std::chrono::steady_clock::now();
+            for (const auto& time : times)
+            {
+                indexCount += findIndex(trackIndex, time).size();
+            }
+            t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> indexDiff = t1 - t0;
+
+            size_t linearCount = 0;
+            t0 = std::chrono::steady_clock::now();
+            for (const auto& time : times)
+            {
+                linearCount += findLinear(trackIndex, time).size();
+            }
+            t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> linearDiff = t1 - t0;
+
+            TLRENDER_ASSERT(lookupCount == indexCount);
+            TLRENDER_ASSERT(indexCount == linearCount);
+            _print(string::Format("Index {0} clips: {1} seconds").
+                arg(clipCount).
+                arg(createDiff.count()));
+            _print(string::Format("Index lookups {0}: {1} seconds").
+                arg(lookupCount).
+                arg(indexDiff.count()));
+            _print(string::Format("Linear lookups {0}: {1} seconds").
+                arg(lookupCount).
+                arg(linearDiff.count()));
+        }
+    }
+}
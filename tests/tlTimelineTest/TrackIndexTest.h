@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        class TrackIndexTest : public tests::ITest
+        {
+        protected:
+            TrackIndexTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<TrackIndexTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _find();
+            void _transitions();
+            void _benchmark();
+        };
+    }
+}
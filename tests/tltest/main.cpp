@@ -7,16 +7,27 @@
 #include <tlQt/Init.h>
 #endif // TLRENDER_QT5 || TLRENDER_QT6
 
+#include <tlGLTest/AsyncReadbackTest.h>
 #include <tlGLTest/GLFWTest.h>
 #include <tlGLTest/MeshTest.h>
 #include <tlGLTest/OffscreenBufferTest.h>
+#include <tlGLTest/ShaderCacheTest.h>
 #include <tlGLTest/ShaderTest.h>
 #include <tlGLTest/TextureTest.h>
+#include <tlGLTest/TexturePoolTest.h>
+#include <tlGLTest/TextureUploadTest.h>
 #include <tlGL/Init.h>
 
 #include <tlAppTest/AppTest.h>
 #include <tlAppTest/CmdLineTest.h>
 
+#include <tlTimelineCPUTest/RenderTest.h>
+
+#if defined(TLRENDER_GLFW)
+#include <tlTimelineGLTest/OCIOCacheTest.h>
+#include <tlTimelineGLTest/RenderTest.h>
+#endif // TLRENDER_GLFW
+
 #include <tlTimelineTest/CompareOptionsTest.h>
 #include <tlTimelineTest/DisplayOptionsTest.h>
 #include <tlTimelineTest/EditTest.h>
@@ -27,7 +38,9 @@
 #include <tlTimelineTest/OCIOOptionsTest.h>
 #include <tlTimelineTest/PlayerOptionsTest.h>
 #include <tlTimelineTest/PlayerTest.h>
+#include <tlTimelineTest/PlayerVideoCacheTest.h>
 #include <tlTimelineTest/TimelineTest.h>
+#include <tlTimelineTest/TrackIndexTest.h>
 #include <tlTimelineTest/UtilTest.h>
 
 #include <tlIOTest/CineonTest.h>
@@ -132,11 +145,15 @@ void glTests(
     const std::shared_ptr<system::Context>& context)
 {
 #if defined(TLRENDER_GLFW)
+    tests.push_back(gl_tests::AsyncReadbackTest::create(context));
     tests.push_back(gl_tests::GLFWTest::create(context));
     tests.push_back(gl_tests::MeshTest::create(context));
     tests.push_back(gl_tests::OffscreenBufferTest::create(context));
+    tests.push_back(gl_tests::ShaderCacheTest::create(context));
     tests.push_back(gl_tests::ShaderTest::create(context));
     tests.push_back(gl_tests::TextureTest::create(context));
+    tests.push_back(gl_tests::TexturePoolTest::create(context));
+    tests.push_back(gl_tests::TextureUploadTest::create(context));
 #endif // TLRENDER_GLFW
 }
 
@@ -183,10 +200,29 @@ void timelineTests(
     tests.push_back(timeline_tests::OCIOOptionsTest::create(context));
     tests.push_back(timeline_tests::PlayerOptionsTest::create(context));
     tests.push_back(timeline_tests::PlayerTest::create(context));
+    tests.push_back(timeline_tests::PlayerVideoCacheTest::create(context));
     tests.push_back(timeline_tests::TimelineTest::create(context));
+    tests.push_back(timeline_tests::TrackIndexTest::create(context));
     tests.push_back(timeline_tests::UtilTest::create(context));
 }
 
+void timelineCPUTests(
+    std::vector<std::shared_ptr<tests::ITest> >& tests,
+    const std::shared_ptr<system::Context>& context)
+{
+    tests.push_back(timeline_cpu_tests::RenderTest::create(context));
+}
+
+void timelineGLTests(
+    std::vector<std::shared_ptr<tests::ITest> >& tests,
+    const std::shared_ptr<system::Context>& context)
+{
+#if defined(TLRENDER_GLFW)
+    tests.push_back(timeline_gl_tests::OCIOCacheTest::create(context));
+    tests.push_back(timeline_gl_tests::RenderTest::create(context));
+#endif // TLRENDER_GLFW
+}
+
 void appTests(
     std::vector<std::shared_ptr<tests::ITest> >& tests,
     const std::shared_ptr<system::Context>& context)
@@ -238,6 +274,8 @@ int main(int argc, char* argv[])
     glTests(tests, context);
     ioTests(tests, context);
     timelineTests(tests, context);
+    timelineCPUTests(tests, context);
+    timelineGLTests(tests, context);
     appTests(tests, context);
     qtTests(tests, context);
 